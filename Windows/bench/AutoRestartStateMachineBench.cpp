@@ -0,0 +1,45 @@
+// Compares the legacy switch-based engine with the table-driven AutoRestartStateMachine.
+// Both replay the same pre-generated random event stream; the figure printed is ns/event.
+
+#include "BenchHarness.h"
+#include "LegacyAutoRestartEngine.h"
+
+#include "AutoRestartStateMachine.h"
+
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+int main() {
+    constexpr std::size_t kStreamSize = 1u << 16;
+    constexpr std::uint64_t kIterations = 20'000'000;
+
+    std::mt19937 rng(42u);
+    std::uniform_int_distribution<int> eventDist(0, static_cast<int>(AutoRestartEvent::ForcedSleepEnded));
+    std::vector<AutoRestartEvent> stream(kStreamSize);
+    for (auto& e : stream) e = static_cast<AutoRestartEvent>(eventDist(rng));
+
+    AutoRestartSettings settings;
+    settings.idleEnabled = true;
+    settings.screenLockEnabled = true;
+    settings.screenLockActionIsRestart = false;
+    settings.screensaverEnabled = true;
+    settings.stayUpLimitEnabled = true;
+
+    legacy::LegacyContext ctx;
+    ctx.settings = settings;
+    AutoRestartState legacyState = AutoRestartState::Idle;
+    bench::measureNsPerOp("legacy switch engine processEvent", kIterations, [&](std::uint64_t i) {
+        const auto action = legacy::processEvent(ctx, legacyState, stream[i & (kStreamSize - 1)]);
+        bench::doNotOptimize(static_cast<unsigned>(action));
+    });
+
+    AutoRestartStateMachine machine(settings);
+    bench::measureNsPerOp("table-driven AutoRestartStateMachine", kIterations, [&](std::uint64_t i) {
+        const auto action = machine.processEvent(stream[i & (kStreamSize - 1)]);
+        bench::doNotOptimize(static_cast<unsigned>(action));
+    });
+
+    return 0;
+}
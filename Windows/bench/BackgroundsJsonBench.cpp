@@ -0,0 +1,137 @@
+// backgrounds.json load cost with 10,000 entries: the single-pass tokenizer (string views, one copy per
+// accepted field) against a replica of the previous loader, which cut each object out with find('{') /
+// find('}') + substr and then searched every key inside the copy. Figures are ns per parsed document and
+// per entry.
+
+#include "BenchHarness.h"
+
+#include "BackgroundsJson.h"
+
+#include <cwchar>
+#include <cwctype>
+#include <string>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::size_t kEntries = 10'000;
+
+    std::wstring makeDocument() {
+        std::wstring out = L"{\n  \"backgrounds\": [\n";
+        for (std::size_t i = 0; i < kEntries; ++i) {
+            const std::wstring name = L"\u58c1\u7eb8_" + std::to_wstring(i) + (i % 4 == 0 ? L".mp4" : L".jpg");
+            out += L"    { \"path\": \"C:\\\\Users\\\\me\\\\Pictures\\\\Wallpapers\\\\" + name + L"\", ";
+            out += i % 4 == 0 ? L"\"type\": \"video\", " : L"\"type\": \"image\", ";
+            out += L"\"name\": \"" + name + L"\", \"playbackRate\": 1 }";
+            out += i + 1 < kEntries ? L",\n" : L"\n";
+        }
+        out += L"  ],\n  \"pomodoroMinutes\": 25,\n  \"breakMinutes\": 5,\n"
+               L"  \"autoStartNextPomodoroAfterRest\": false,\n  \"overlayMessage\": \"\"\n}\n";
+        return out;
+    }
+
+    struct File {
+        std::wstring path;
+        std::wstring type;
+        std::wstring name;
+        double rate{ 1.0 };
+    };
+
+    // 旧实现的等价写法（只保留条目部分）
+    bool LegacyExtractString(const std::wstring& obj, const std::wstring& key, std::wstring& out) {
+        const std::wstring pattern = L"\"" + key + L"\"";
+        auto pos = obj.find(pattern);
+        if (pos == std::wstring::npos) return false;
+        pos = obj.find(L':', pos + pattern.size());
+        if (pos == std::wstring::npos) return false;
+        pos = obj.find(L'"', pos);
+        if (pos == std::wstring::npos) return false;
+        std::wstring raw;
+        for (std::size_t i = pos + 1; i < obj.size(); ++i) {
+            if (obj[i] == L'\\' && i + 1 < obj.size()) {
+                raw.push_back(obj[i]);
+                raw.push_back(obj[++i]);
+            } else if (obj[i] == L'"') {
+                break;
+            } else {
+                raw.push_back(obj[i]);
+            }
+        }
+        out.clear();
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            out.push_back(raw[i] == L'\\' && i + 1 < raw.size() ? raw[++i] : raw[i]);
+        }
+        return true;
+    }
+
+    bool LegacyExtractDouble(const std::wstring& obj, const std::wstring& key, double& out) {
+        const std::wstring pattern = L"\"" + key + L"\"";
+        auto pos = obj.find(pattern);
+        if (pos == std::wstring::npos) return false;
+        pos = obj.find_first_of(L"-0123456789", obj.find(L':', pos + pattern.size()));
+        if (pos == std::wstring::npos) return false;
+        auto end = pos;
+        while (end < obj.size() && (std::iswdigit(obj[end]) || obj[end] == L'.')) ++end;
+        const std::wstring number = obj.substr(pos, end - pos);
+        out = std::wcstod(number.c_str(), nullptr);
+        return true;
+    }
+
+    std::size_t LegacyParse(const std::wstring& json, std::vector<File>& files) {
+        files.clear();
+        auto arrayStart = json.find(L'[', json.find(L"\"backgrounds\""));
+        auto arrayEnd = json.find(L']', arrayStart);
+        const std::wstring array = json.substr(arrayStart + 1, arrayEnd - arrayStart - 1);
+        std::size_t pos = 0;
+        while (true) {
+            auto objStart = array.find(L'{', pos);
+            if (objStart == std::wstring::npos) break;
+            auto objEnd = array.find(L'}', objStart);
+            if (objEnd == std::wstring::npos) break;
+            const std::wstring obj = array.substr(objStart, objEnd - objStart + 1);
+            pos = objEnd + 1;
+            File f;
+            if (!LegacyExtractString(obj, L"path", f.path) || !LegacyExtractString(obj, L"type", f.type)) continue;
+            LegacyExtractString(obj, L"name", f.name);
+            LegacyExtractDouble(obj, L"playbackRate", f.rate);
+            files.push_back(std::move(f));
+        }
+        return files.size();
+    }
+
+} // namespace
+
+int main() {
+    const std::wstring json = makeDocument();
+    std::printf("%-44s %12zu KiB\n", "document size", json.size() * sizeof(wchar_t) / 1024);
+
+    std::vector<File> files;
+    files.reserve(kEntries);
+    const double single = bench::measureNsPerOp("parse 10k entries (single pass)", 50, [&](std::uint64_t) {
+        files.clear();
+        BackgroundsJsonSettings settings;
+        parseBackgroundsJson(json, settings, [&files](const BackgroundJsonEntry& e) {
+            files.push_back(File{ std::wstring(e.path), std::wstring(e.type), std::wstring(e.name), e.playbackRate });
+        });
+        bench::doNotOptimize(files.size());
+    });
+    std::printf("%-44s %12.3f ns/entry\n", "  per entry", single / kEntries);
+
+    const double viewsOnly = bench::measureNsPerOp("parse 10k entries (views only)", 50, [&](std::uint64_t) {
+        std::size_t characters = 0;
+        BackgroundsJsonSettings settings;
+        parseBackgroundsJson(json, settings, [&characters](const BackgroundJsonEntry& e) {
+            characters += e.path.size() + e.name.size();
+        });
+        bench::doNotOptimize(characters);
+    });
+    std::printf("%-44s %12.3f ns/entry\n", "  per entry", viewsOnly / kEntries);
+
+    const double legacy = bench::measureNsPerOp("parse 10k entries (legacy find/substr)", 50, [&](std::uint64_t) {
+        bench::doNotOptimize(LegacyParse(json, files));
+    });
+    std::printf("%-44s %12.3f ns/entry\n", "  per entry", legacy / kEntries);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+// Tiny timing helpers shared by the microbenchmarks in this directory.
+// Each benchmark runs a body `iterations` times after a short warm-up and prints ns/op.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace pomodoro::bench {
+
+    // Keeps a value alive so the optimizer cannot drop the measured work.
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+        static volatile std::uint64_t sink = 0;
+        sink = sink + static_cast<std::uint64_t>(value);
+    }
+
+    template <typename Fn>
+    double measureNsPerOp(const char* name, std::uint64_t iterations, Fn&& body) {
+        using Clock = std::chrono::steady_clock;
+
+        const std::uint64_t warmup = iterations / 10 + 1;
+        for (std::uint64_t i = 0; i < warmup; ++i) body(i);
+
+        const auto start = Clock::now();
+        for (std::uint64_t i = 0; i < iterations; ++i) body(i);
+        const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        const double nsPerOp = iterations ? elapsed / static_cast<double>(iterations) : 0.0;
+        std::printf("%-44s %12.3f ns/op  (%llu ops)\n", name, nsPerOp,
+            static_cast<unsigned long long>(iterations));
+        return nsPerOp;
+    }
+
+} // namespace pomodoro::bench
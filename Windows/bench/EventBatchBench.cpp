@@ -0,0 +1,135 @@
+// Compares one-at-a-time event delivery with the batched, coalescing entry points on a hook-style trace.
+// The trace models what the Win32 hooks deliver: mouse-move bursts at ~1 kHz, idle-timeout / activity
+// pairs, lock/unlock flaps and screensaver episodes. Batches are 64 events, roughly one message-pump drain.
+
+#include "BenchHarness.h"
+
+#include "AutoRestartStateMachine.h"
+#include "PomodoroTimer.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::size_t kBatchSize = 64;
+
+    std::vector<AutoRestartEvent> makeHookTrace(std::size_t length) {
+        using E = AutoRestartEvent;
+        std::mt19937 rng(2024u);
+        std::uniform_int_distribution<int> burst(50, 400);   // 连续的鼠标移动
+        std::uniform_int_distribution<int> other(0, 99);
+
+        std::vector<E> trace;
+        trace.reserve(length);
+        while (trace.size() < length) {
+            for (int n = burst(rng); n > 0; --n) trace.push_back(E::UserActivityDetected);
+
+            const int roll = other(rng);
+            if (roll < 10) {
+                trace.push_back(E::IdleTimeExceeded);
+            } else if (roll < 14) {
+                // 锁屏/解锁抖动（远程桌面、快速切换用户时常见）
+                for (int n = 0; n < 3; ++n) {
+                    trace.push_back(E::ScreenLocked);
+                    trace.push_back(E::ScreenUnlocked);
+                }
+            } else if (roll < 16) {
+                trace.push_back(E::ScreensaverStarted);
+                trace.push_back(E::ScreensaverStopped);
+                trace.push_back(E::ScreenUnlocked);
+            }
+        }
+        trace.resize(length);
+        return trace;
+    }
+
+    PomodoroTimer::Settings benchSettings() {
+        PomodoroTimer::Settings s;
+        s.idleRestartEnabled = true;
+        s.idleActionIsRestart = false;
+        s.screenLockRestartEnabled = true;
+        s.screenLockActionIsRestart = false;
+        s.screensaverRestartEnabled = true;
+        s.screensaverActionIsRestart = false;
+        return s;
+    }
+
+    void deliver(PomodoroTimer& timer, AutoRestartEvent event) {
+        using E = AutoRestartEvent;
+        switch (event) {
+        case E::IdleTimeExceeded: timer.onIdleTimeExceeded(); break;
+        case E::UserActivityDetected: timer.onUserActivity(); break;
+        case E::ScreenLocked: timer.onScreenLocked(); break;
+        case E::ScreenUnlocked: timer.onScreenUnlocked(); break;
+        case E::ScreensaverStarted: timer.onScreensaverStarted(); break;
+        case E::ScreensaverStopped: timer.onScreensaverStopped(); break;
+        default: break;
+        }
+    }
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kTraceSize = 1u << 16;
+    constexpr std::uint64_t kEvents = 8'000'000;
+    constexpr std::uint64_t kBatches = kEvents / kBatchSize;
+    constexpr std::size_t kTraceBatches = kTraceSize / kBatchSize;
+
+    const auto trace = makeHookTrace(kTraceSize);
+
+    {
+        AutoRestartSettings settings;
+        settings.idleEnabled = true;
+        settings.idleActionIsRestart = false;
+        settings.screenLockEnabled = true;
+        settings.screenLockActionIsRestart = false;
+        settings.screensaverEnabled = true;
+        settings.screensaverActionIsRestart = false;
+
+        AutoRestartStateMachine machine(settings);
+        machine.processEvent(AutoRestartEvent::TimerStarted);
+        bench::measureNsPerOp("machine processEvent (per event)", kEvents, [&](std::uint64_t i) {
+            const auto event = trace[i & (kTraceSize - 1)];
+            if (event == AutoRestartEvent::ScreensaverStopped) machine.markScreensaverResumedNow();
+            bench::doNotOptimize(static_cast<unsigned>(machine.processEvent(event)));
+        });
+
+        AutoRestartStateMachine batched(settings);
+        batched.processEvent(AutoRestartEvent::TimerStarted);
+        std::vector<AutoRestartAction> actions;
+        actions.reserve(kBatchSize);
+        const double perBatch = bench::measureNsPerOp("machine processEvents (64-event batch)", kBatches,
+            [&](std::uint64_t i) {
+                actions.clear();
+                batched.processEvents(trace.data() + (i % kTraceBatches) * kBatchSize, kBatchSize, actions);
+                bench::doNotOptimize(actions.size());
+            });
+        std::printf("%-44s %12.3f ns/event\n", "  -> machine processEvents", perBatch / kBatchSize);
+    }
+
+    {
+        PomodoroTimer timer;
+        timer.updateSettings(benchSettings());
+        timer.start();
+        bench::measureNsPerOp("timer on* (per event)", kEvents, [&](std::uint64_t i) {
+            deliver(timer, trace[i & (kTraceSize - 1)]);
+            bench::doNotOptimize(static_cast<unsigned>(timer.isRunning()));
+        });
+
+        PomodoroTimer batched;
+        batched.updateSettings(benchSettings());
+        batched.start();
+        const double perBatch = bench::measureNsPerOp("timer onSystemEvents (64-event batch)", kBatches,
+            [&](std::uint64_t i) {
+                batched.onSystemEvents(trace.data() + (i % kTraceBatches) * kBatchSize, kBatchSize);
+                bench::doNotOptimize(static_cast<unsigned>(batched.isRunning()));
+            });
+        std::printf("%-44s %12.3f ns/event\n", "  -> timer onSystemEvents", perBatch / kBatchSize);
+    }
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Hot-path cost of journaling every AutoRestartStateMachine::processEvent call.
+// Compares the bare state machine with the same trace written to an EventJournal (real steady clock,
+// real memory-mapped file in the temp directory), with the default group commit and with a commit
+// after every record for reference.
+
+#include "BenchHarness.h"
+
+#include "AutoRestartStateMachine.h"
+#include "EventJournal.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    std::vector<AutoRestartEvent> makeTrace(std::size_t length) {
+        using E = AutoRestartEvent;
+        // 真实日志中以状态会变化的事件为主：暂停/恢复、锁屏/解锁、无操作/活动
+        const E pool[] = { E::IdleTimeExceeded, E::UserActivityDetected, E::ScreenLocked, E::ScreenUnlocked,
+            E::TimerPaused, E::TimerStarted, E::ScreensaverStarted, E::ScreensaverStopped };
+        std::mt19937 rng(2024u);
+        std::uniform_int_distribution<std::size_t> pick(0, sizeof(pool) / sizeof(pool[0]) - 1);
+
+        std::vector<E> trace(length);
+        for (auto& e : trace) e = pool[pick(rng)];
+        return trace;
+    }
+
+    AutoRestartSettings benchSettings() {
+        AutoRestartSettings s;
+        s.idleEnabled = true;
+        s.idleActionIsRestart = false;
+        s.screenLockEnabled = true;
+        s.screenLockActionIsRestart = false;
+        s.screensaverEnabled = true;
+        s.screensaverActionIsRestart = false;
+        return s;
+    }
+
+    std::filesystem::path benchJournalPath(const char* name) {
+        auto path = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove(path);
+        return path;
+    }
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kTraceSize = 1u << 16;
+    constexpr std::uint64_t kEvents = 2'000'000;
+    constexpr std::uint64_t kSyncEvents = 20'000;
+
+    const auto trace = makeTrace(kTraceSize);
+
+    {
+        AutoRestartStateMachine machine(benchSettings());
+        bench::measureNsPerOp("processEvent (no journal)", kEvents, [&](std::uint64_t i) {
+            bench::doNotOptimize(static_cast<unsigned>(machine.processEvent(trace[i & (kTraceSize - 1)])));
+        });
+    }
+
+    {
+        const auto path = benchJournalPath("pomodoro_bench.journal");
+        EventJournal journal;
+        EventJournal::Options options;
+        options.initialCapacity = 1u << 16; // 包含按倍数扩展的摊销成本
+        if (!journal.open(path, options)) {
+            std::printf("cannot open %s\n", path.string().c_str());
+            return 1;
+        }
+        AutoRestartStateMachine machine(benchSettings());
+        machine.setTransitionSink(&journal);
+        bench::measureNsPerOp("processEvent + journal (group commit 256)", kEvents, [&](std::uint64_t i) {
+            bench::doNotOptimize(static_cast<unsigned>(machine.processEvent(trace[i & (kTraceSize - 1)])));
+        });
+        std::printf("%-44s %12zu records, %llu dropped\n", "  -> journal", journal.size(),
+            static_cast<unsigned long long>(journal.droppedRecords()));
+        journal.close();
+        std::filesystem::remove(path);
+    }
+
+    {
+        const auto path = benchJournalPath("pomodoro_bench_sync.journal");
+        EventJournal journal;
+        EventJournal::Options options;
+        options.groupCommitRecords = 1;
+        if (!journal.open(path, options)) return 1;
+        AutoRestartStateMachine machine(benchSettings());
+        machine.setTransitionSink(&journal);
+        bench::measureNsPerOp("processEvent + journal (commit every record)", kSyncEvents, [&](std::uint64_t i) {
+            bench::doNotOptimize(static_cast<unsigned>(machine.processEvent(trace[i & (kTraceSize - 1)])));
+        });
+        journal.close();
+        std::filesystem::remove(path);
+    }
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Background scaling cost: 4K and 8K sources resampled (cover fit) to common monitor sizes, for each
+// filter and each instruction set supported on this machine. One op is one full-frame resample; the
+// scalar row is the reference the vector paths must match bit for bit.
+
+#include "BenchHarness.h"
+
+#include "ImageResampler.h"
+
+#include <cstdint>
+#include <cstdio>
+
+using namespace pomodoro;
+
+namespace {
+
+    // 类似照片的内容：平滑渐变叠加细纹理，alpha 不透明（与解码后的壁纸相同）
+    BgraImage makeWallpaper(int w, int h) {
+        BgraImage img(w, h);
+        std::uint32_t seed = 12345;
+        for (int y = 0; y < h; ++y) {
+            std::uint8_t* row = &img.pixels[static_cast<std::size_t>(y) * static_cast<std::size_t>(w) * 4];
+            for (int x = 0; x < w; ++x) {
+                seed = seed * 1664525u + 1013904223u;
+                const int noise = static_cast<int>(seed >> 28);
+                row[x * 4 + 0] = static_cast<std::uint8_t>((x * 200 / w + noise) & 0xFF);
+                row[x * 4 + 1] = static_cast<std::uint8_t>((y * 200 / h + noise) & 0xFF);
+                row[x * 4 + 2] = static_cast<std::uint8_t>(((x + y) * 90 / (w + h) + 60 + noise) & 0xFF);
+                row[x * 4 + 3] = 255;
+            }
+        }
+        return img;
+    }
+
+    struct Size {
+        int width;
+        int height;
+        const char* name;
+    };
+
+} // namespace
+
+int main() {
+    const Size sources[] = { { 3840, 2160, "4K" }, { 7680, 4320, "8K" } };
+    const Size targets[] = {
+        { 1920, 1080, "1080p" }, { 2560, 1440, "1440p" }, { 3440, 1440, "UW1440" }, { 3840, 2160, "2160p" },
+    };
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2, SimdLevel::Neon };
+    const ResampleFilter filters[] = { ResampleFilter::Bicubic, ResampleFilter::Lanczos3 };
+
+    std::printf("%-44s %12s\n", "best instruction set", simdLevelName(bestSimdLevel()));
+
+    for (const Size& source : sources) {
+        const BgraImage src = makeWallpaper(source.width, source.height);
+        for (const Size& target : targets) {
+            BgraImage dst(target.width, target.height);
+            const FitGeometry g = computeFit(FitMode::Cover, src.width, src.height, dst.width, dst.height);
+            for (const ResampleFilter filter : filters) {
+                double scalarNs = 0.0;
+                for (const SimdLevel level : levels) {
+                    if (!simdLevelSupported(level)) continue;
+                    char name[64];
+                    std::snprintf(name, sizeof(name), "%s->%s %s %s", source.name, target.name,
+                        filter == ResampleFilter::Bicubic ? "bicubic" : "lanczos3", simdLevelName(level));
+                    const double ns = bench::measureNsPerOp(name, 3, [&](std::uint64_t) {
+                        resampleBgra(src.view(), dst.mutableView(), g, filter, level);
+                        bench::doNotOptimize(dst.pixels[dst.pixels.size() / 2]);
+                    });
+                    if (level == SimdLevel::Scalar) {
+                        scalarNs = ns;
+                    } else if (scalarNs > 0.0) {
+                        std::printf("%-44s %12.2fx\n", "  speedup vs scalar", scalarNs / ns);
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
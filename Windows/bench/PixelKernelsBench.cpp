@@ -0,0 +1,84 @@
+// Pixel format conversion over one 3840x2160 frame, for each kernel and each instruction set supported
+// on this machine. The first row replays the previous poster decode: memcpy of every row, then a
+// per-pixel loop that stores A = 255. The kernels do the copy and the alpha fix in a single pass.
+
+#include "BenchHarness.h"
+
+#include "PixelKernels.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr int kWidth = 3840;
+    constexpr int kHeight = 2160;
+    constexpr std::size_t kPixels = static_cast<std::size_t>(kWidth) * kHeight;
+
+} // namespace
+
+int main() {
+    std::vector<std::uint8_t> src(kPixels * 4);
+    std::uint32_t seed = 1;
+    for (auto& b : src) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<std::uint8_t>(seed >> 24);
+    }
+    std::vector<std::uint8_t> dst(kPixels * 4);
+
+    std::printf("%-44s %12s\n", "best instruction set", simdLevelName(bestSimdLevel()));
+
+    bench::measureNsPerOp("4K legacy memcpy + alpha loop", 20, [&](std::uint64_t) {
+        const std::size_t rowBytes = static_cast<std::size_t>(kWidth) * 4;
+        for (int y = 0; y < kHeight; ++y) {
+            std::uint8_t* dstRow = dst.data() + y * rowBytes;
+            std::memcpy(dstRow, src.data() + y * rowBytes, rowBytes);
+            for (int x = 0; x < kWidth; ++x) {
+                dstRow[x * 4 + 3] = 0xFF;
+            }
+        }
+        bench::doNotOptimize(dst[kPixels]);
+    });
+
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2, SimdLevel::Neon };
+    for (const SimdLevel level : levels) {
+        const PixelKernels* k = pixelKernelsFor(level);
+        if (!k) continue;
+        char name[64];
+        std::snprintf(name, sizeof(name), "4K bgrxToBgraOpaque %s", simdLevelName(level));
+        bench::measureNsPerOp(name, 20, [&](std::uint64_t) {
+            k->bgrxToBgraOpaque(src.data(), dst.data(), kPixels);
+            bench::doNotOptimize(dst[kPixels]);
+        });
+        std::snprintf(name, sizeof(name), "4K bgrxToBgraOpaque in place %s", simdLevelName(level));
+        bench::measureNsPerOp(name, 20, [&](std::uint64_t) {
+            k->bgrxToBgraOpaque(dst.data(), dst.data(), kPixels);
+            bench::doNotOptimize(dst[kPixels]);
+        });
+        std::snprintf(name, sizeof(name), "4K premultiply %s", simdLevelName(level));
+        bench::measureNsPerOp(name, 20, [&](std::uint64_t) {
+            k->premultiply(src.data(), dst.data(), kPixels);
+            bench::doNotOptimize(dst[kPixels]);
+        });
+        std::snprintf(name, sizeof(name), "4K unpremultiply %s", simdLevelName(level));
+        bench::measureNsPerOp(name, 20, [&](std::uint64_t) {
+            k->unpremultiply(src.data(), dst.data(), kPixels);
+            bench::doNotOptimize(dst[kPixels]);
+        });
+        std::snprintf(name, sizeof(name), "4K scaleAlpha %s", simdLevelName(level));
+        bench::measureNsPerOp(name, 20, [&](std::uint64_t i) {
+            k->scaleAlpha(src.data(), dst.data(), kPixels, static_cast<std::uint8_t>(i));
+            bench::doNotOptimize(dst[kPixels]);
+        });
+        std::snprintf(name, sizeof(name), "4K fill %s", simdLevelName(level));
+        bench::measureNsPerOp(name, 20, [&](std::uint64_t) {
+            k->fill(dst.data(), kPixels, 0);
+            bench::doNotOptimize(dst[kPixels]);
+        });
+    }
+    return 0;
+}
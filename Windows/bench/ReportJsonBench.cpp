@@ -0,0 +1,76 @@
+// Report serialization cost for 1 day, 1 year and 10 years of trend data. Each engine is filled with a
+// synthetic workday (8 pomodoros, breaks, one screen lock); the writer buffer is reused between passes,
+// so after the first pass the figures contain no allocation.
+
+#include "BenchHarness.h"
+
+#include "JsonWriter.h"
+#include "ReportJson.h"
+#include "StatisticsEngine.h"
+#include "StatisticsHeatmap.h"
+
+#include <cstdio>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerHour = 60LL * 60 * 1000;
+    constexpr std::int64_t kMsPerDay = 24 * kMsPerHour;
+    constexpr std::int32_t kLastDay = 20'000;
+
+    StatisticsEvent makeEvent(StatisticsEventType type, std::int64_t at, std::uint32_t durationMs = 0) {
+        StatisticsEvent e;
+        e.type = type;
+        e.timestampMs = at;
+        e.durationMs = durationMs;
+        return e;
+    }
+
+} // namespace
+
+int main() {
+    const struct { std::int32_t days; int iterations; const char* name; } cases[] = {
+        { 1, 20'000, "report json (1 day)" },
+        { 365, 500, "report json (365 days)" },
+        { 3650, 50, "report json (3650 days)" },
+    };
+
+    for (const auto& c : cases) {
+        StatisticsEngine statistics;
+        for (std::int32_t d = kLastDay - c.days + 1; d <= kLastDay; ++d) {
+            const std::int64_t start = d * kMsPerDay + 9 * kMsPerHour;
+            for (int i = 0; i < 8; ++i) {
+                const std::int64_t at = start + i * kMsPerHour;
+                statistics.record(makeEvent(StatisticsEventType::PomodoroCompleted, at, 25 * 60'000));
+                statistics.record(makeEvent(i % 4 == 3 ? StatisticsEventType::LongBreakStarted : StatisticsEventType::ShortBreakStarted, at + 1));
+                statistics.record(makeEvent(StatisticsEventType::BreakFinished, at + 5 * 60'000, 5 * 60'000));
+            }
+            statistics.record(makeEvent(StatisticsEventType::ScreenLocked, start + 4 * kMsPerHour));
+        }
+
+        // 热力图覆盖最后 7 天（天数不足时覆盖部分为空）
+        HeatmapCube cube;
+        const std::int32_t heatmapFirstDay = kLastDay - 6;
+        const auto binner = HeatmapBinner::forWeek(statistics.calendar(), heatmapFirstDay);
+        for (std::int32_t d = heatmapFirstDay; d <= kLastDay; ++d) {
+            const StatisticsEvent e = makeEvent(StatisticsEventType::PomodoroCompleted, d * kMsPerDay + 10 * kMsPerHour);
+            if (d > kLastDay - c.days) binner.bin(&e, 1, cube);
+        }
+
+        ReportRequest request;
+        request.firstDay = kLastDay - c.days + 1;
+        request.lastDay = kLastDay;
+        request.heatmapFirstDay = heatmapFirstDay;
+        request.heatmap = &cube;
+
+        JsonWriter writer;
+        bench::measureNsPerOp(c.name, static_cast<std::uint64_t>(c.iterations), [&](std::uint64_t) {
+            writer.reset();
+            writeReportJson(writer, statistics, request);
+            bench::doNotOptimize(writer.size());
+        });
+        std::printf("%-44s %12zu bytes\n", "  output", writer.size());
+    }
+    return 0;
+}
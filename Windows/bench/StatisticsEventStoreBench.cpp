@@ -0,0 +1,96 @@
+// Query latency of StatisticsEventStore over ten years of events.
+// The data set is deliberately heavy (1000 events per day, ~3.65 M records / 58 MB in the temp
+// directory) so the figures are an upper bound for real usage, which is closer to a few dozen per day.
+
+#include "BenchHarness.h"
+
+#include "StatisticsEventStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerDay = 24LL * 60 * 60 * 1000;
+    constexpr std::int64_t kStartMs = 1'500'000'000'000;
+    constexpr int kDays = 3650;
+    constexpr int kEventsPerDay = 1000;
+
+} // namespace
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() / "pomodoro_bench_store";
+    std::filesystem::remove_all(dir);
+
+    {
+        StatisticsEventStore store;
+        if (!store.open(dir)) {
+            std::printf("cannot open %s\n", dir.string().c_str());
+            return 1;
+        }
+        std::mt19937 rng(3u);
+        std::uniform_int_distribution<int> type(0, static_cast<int>(kStatisticsEventTypeCount) - 1);
+        const auto started = std::chrono::steady_clock::now();
+        for (int d = 0; d < kDays; ++d) {
+            for (int i = 0; i < kEventsPerDay; ++i) {
+                StatisticsEvent e;
+                e.timestampMs = kStartMs + d * kMsPerDay + static_cast<std::int64_t>(i) * (kMsPerDay / kEventsPerDay);
+                e.type = static_cast<StatisticsEventType>(type(rng));
+                store.append(e);
+            }
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        std::printf("%-44s %12.3f ns/op  (%zu records, %.0f ms total)\n", "append (in order)",
+            ms * 1e6 / static_cast<double>(store.size()), store.size(), ms);
+    }
+
+    StatisticsEventStore store;
+    const auto openStart = std::chrono::steady_clock::now();
+    if (!store.open(dir)) return 1;
+    const double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - openStart).count();
+    std::printf("%-44s %12.3f ms  (map %zu records, rebuild index)\n", "open", openMs, store.size());
+
+    std::mt19937 rng(9u);
+    std::uniform_int_distribution<int> day(0, kDays - 8);
+    std::vector<StatisticsEvent> out;
+    out.reserve(31 * kEventsPerDay);
+
+    bench::measureNsPerOp("lowerBound (random instant)", 1'000'000, [&](std::uint64_t) {
+        bench::doNotOptimize(store.lowerBound(kStartMs + day(rng) * kMsPerDay + 12345));
+    });
+    bench::measureNsPerOp("range: 1 day (1000 events)", 100'000, [&](std::uint64_t) {
+        out.clear();
+        const auto from = kStartMs + day(rng) * kMsPerDay;
+        bench::doNotOptimize(store.range(from, from + kMsPerDay, out));
+    });
+    bench::measureNsPerOp("range: 7 days (7000 events)", 20'000, [&](std::uint64_t) {
+        out.clear();
+        const auto from = kStartMs + day(rng) * kMsPerDay;
+        bench::doNotOptimize(store.range(from, from + 7 * kMsPerDay, out));
+    });
+    bench::measureNsPerOp("range: 1 hour", 1'000'000, [&](std::uint64_t) {
+        out.clear();
+        const auto from = kStartMs + day(rng) * kMsPerDay + 3'600'000 * 9;
+        bench::doNotOptimize(store.range(from, from + 3'600'000, out));
+    });
+    bench::measureNsPerOp("recent(100)", 1'000'000, [&](std::uint64_t) {
+        out.clear();
+        bench::doNotOptimize(store.recent(100, out));
+    });
+    bench::measureNsPerOp("visit 1 day (no copy)", 100'000, [&](std::uint64_t) {
+        const auto from = kStartMs + day(rng) * kMsPerDay;
+        std::size_t n = 0;
+        store.visit(store.lowerBound(from), store.lowerBound(from + kMsPerDay),
+            [&n](const StatisticsEvent*, std::size_t count) { n += count; });
+        bench::doNotOptimize(n);
+    });
+
+    store.close();
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Export throughput over 1 M stored events (about ten years of heavy use): CSV and NDJSON event rows to
+// a sink that only counts bytes (formatting cost), the same to a file (includes the disk), and the
+// hourly table (per-event calendar lookup and merge). Figures are ns per exported row and MB/s.
+
+#include "BenchHarness.h"
+
+#include "StatisticsEngine.h"
+#include "StatisticsEventStore.h"
+#include "StatisticsExport.h"
+#include "StatisticsRollups.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kStartMs = 1'400'000'000'000;
+    constexpr std::size_t kEvents = 1'000'000;
+
+    void report(const char* name, double nsPerPass, const ExportResult& result) {
+        std::printf("%-44s %12.3f ns/row  %8.1f MB/s\n", name, nsPerPass / static_cast<double>(result.rows),
+            static_cast<double>(result.bytes) / 1e6 / (nsPerPass / 1e9));
+    }
+
+} // namespace
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() / "pomodoro_export_bench";
+    std::filesystem::remove_all(dir);
+
+    StatisticsEventStore store;
+    if (!store.open(dir)) return 1;
+    std::mt19937 rng(3u);
+    std::uniform_int_distribution<std::int64_t> gap(1, 10 * 60 * 1000);
+    std::uniform_int_distribution<int> type(0, static_cast<int>(kStatisticsEventTypeCount) - 1);
+    std::int64_t t = kStartMs;
+    for (std::size_t i = 0; i < kEvents; ++i) {
+        StatisticsEvent e;
+        t += gap(rng);
+        e.timestampMs = t;
+        e.type = static_cast<StatisticsEventType>(type(rng));
+        e.durationMs = 1'500'000;
+        store.append(e);
+    }
+
+    StatisticsEngine engine(480);
+    StatisticsRollups rollups;
+    ExportResult result;
+    const auto countOnly = [](const char*, std::size_t) { return true; };
+
+    const struct { ExportFormat format; ExportTable table; const char* name; } cases[] = {
+        { ExportFormat::Csv, ExportTable::Events, "export 1M events csv (no io)" },
+        { ExportFormat::Ndjson, ExportTable::Events, "export 1M events ndjson (no io)" },
+        { ExportFormat::Csv, ExportTable::Hourly, "export hourly csv (no io)" },
+    };
+    for (const auto& c : cases) {
+        ExportOptions options;
+        options.format = c.format;
+        options.table = c.table;
+        const double ns = bench::measureNsPerOp(c.name, 5, [&](std::uint64_t) {
+            result = exportStatistics(engine, store, rollups, options, countOnly);
+            bench::doNotOptimize(result.bytes);
+        });
+        report("  per row", ns, result);
+    }
+
+    ExportOptions options;
+    const double ns = bench::measureNsPerOp("export 1M events csv (file)", 5, [&](std::uint64_t) {
+        result = exportStatisticsToFile(dir / "events.csv", engine, store, rollups, options);
+        bench::doNotOptimize(result.bytes);
+    });
+    report("  per row", ns, result);
+
+    store.close();
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,53 @@
+// Heatmap binning throughput: 4 M synthetic events spread over ten days, of which the 7-day window
+// keeps about 70 %. Each kernel bins the whole array into a fresh cube; figures are ns per event.
+
+#include "BenchHarness.h"
+
+#include "StatisticsHeatmap.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerDay = 24LL * 60 * 60 * 1000;
+    constexpr std::int64_t kWeekStart = 1'700'000'000'000;
+    constexpr std::size_t kEvents = 4'000'000;
+
+} // namespace
+
+int main() {
+    std::mt19937_64 rng(17u);
+    std::uniform_int_distribution<std::int64_t> at(kWeekStart - 2 * kMsPerDay, kWeekStart + 8 * kMsPerDay);
+    std::uniform_int_distribution<int> type(0, static_cast<int>(kStatisticsEventTypeCount) - 1);
+    std::vector<StatisticsEvent> events(kEvents);
+    for (auto& e : events) {
+        e.timestampMs = at(rng);
+        e.type = static_cast<StatisticsEventType>(type(rng));
+    }
+
+    const auto binner = HeatmapBinner::uniform(kWeekStart);
+    const struct { SimdLevel level; const char* name; } kernels[] = {
+        { SimdLevel::Scalar, "bin 4M events (scalar)" },
+        { SimdLevel::Sse41, "bin 4M events (SSE4.1)" },
+        { SimdLevel::Avx2, "bin 4M events (AVX2)" },
+    };
+
+    for (const auto& k : kernels) {
+        if (!simdLevelSupported(k.level)) {
+            std::printf("%-44s %12s\n", k.name, "unsupported");
+            continue;
+        }
+        HeatmapCube cube;
+        const double nsPerPass = bench::measureNsPerOp(k.name, 20, [&](std::uint64_t) {
+            cube.clear();
+            binner.bin(events.data(), events.size(), cube, k.level);
+            bench::doNotOptimize(cube.hourTotal(3, 12));
+        });
+        std::printf("%-44s %12.3f ns/event\n", "  per event", nsPerPass / static_cast<double>(kEvents));
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Throughput of the detection-thread -> timer-thread event path.
+// 1) one producer / one consumer on a bare SpscEventRing;
+// 2) three producers (one per detection source) merged by SystemEventQueues::drain.
+// Figures are ns per transferred event, measured end to end including thread start-up.
+
+#include "BenchHarness.h"
+
+#include "SpscEventRing.h"
+#include "SystemEventQueues.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    using BenchClock = std::chrono::steady_clock;
+
+    void report(const char* name, std::uint64_t events, BenchClock::duration elapsed) {
+        const double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        std::printf("%-44s %12.3f ns/event  (%.1f M events/s)\n", name, ns / static_cast<double>(events),
+            static_cast<double>(events) / ns * 1e3);
+    }
+
+} // namespace
+
+int main() {
+    constexpr std::uint64_t kEvents = 20'000'000;
+
+    {
+        static SpscEventRing<1024> ring;
+        const auto start = BenchClock::now();
+        std::thread producer([]() {
+            TimedAutoRestartEvent item;
+            for (std::uint64_t i = 0; i < kEvents; ++i) {
+                item.at = MonotonicClock::time_point(std::chrono::nanoseconds(static_cast<std::int64_t>(i)));
+                while (!ring.tryPush(item)) std::this_thread::yield();
+            }
+        });
+        std::uint64_t received = 0;
+        std::uint64_t checksum = 0;
+        while (received < kEvents) {
+            const std::size_t n = ring.available();
+            for (std::size_t i = 0; i < n; ++i) checksum += static_cast<std::uint64_t>(ring.peek(i).at.time_since_epoch().count());
+            ring.consume(n);
+            received += n;
+            if (n == 0) std::this_thread::yield();
+        }
+        producer.join();
+        report("SpscEventRing 1P/1C", kEvents, BenchClock::now() - start);
+        bench::doNotOptimize(checksum);
+    }
+
+    {
+        constexpr std::uint64_t kPerSource = kEvents / kSystemEventSourceCount;
+        static SystemEventQueues queues;
+        const auto start = BenchClock::now();
+        std::vector<std::thread> producers;
+        for (std::size_t s = 0; s < kSystemEventSourceCount; ++s) {
+            producers.emplace_back([s]() {
+                const auto source = static_cast<SystemEventSource>(s);
+                for (std::uint64_t i = 0; i < kPerSource; ++i) {
+                    const auto stamp = MonotonicClock::time_point(std::chrono::nanoseconds(static_cast<std::int64_t>(i * 3 + s)));
+                    while (!queues.post(source, AutoRestartEvent::UserActivityDetected, stamp)) std::this_thread::yield();
+                }
+            });
+        }
+        std::uint64_t received = 0;
+        TimedAutoRestartEvent out[256];
+        while (received < kPerSource * kSystemEventSourceCount) {
+            const std::size_t n = queues.drain(out, 256);
+            received += n;
+            if (n == 0) std::this_thread::yield();
+        }
+        for (auto& t : producers) t.join();
+        report("SystemEventQueues 3P -> merged drain", received, BenchClock::now() - start);
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+// Per-second time display path: former ostringstream + std::string + UTF-8 -> std::wstring widening
+// (what PomodoroTimer::updateTimeDisplay and TrayIconWin32::updateTime used to do) versus the
+// table-driven formatTimeText writing narrow and wide text into stack buffers.
+
+#include "BenchHarness.h"
+
+#include "TimeTextFormatter.h"
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace pomodoro;
+
+int main() {
+    constexpr std::uint64_t kIterations = 5'000'000;
+
+    bench::measureNsPerOp("ostringstream + std::wstring (former)", kIterations, [](std::uint64_t i) {
+        const int total = static_cast<int>(i % (60 * 60));
+        std::ostringstream oss;
+        oss << std::setw(2) << std::setfill('0') << total / 60
+            << ":" << std::setw(2) << std::setfill('0') << total % 60;
+        const std::string text = oss.str();
+        // 对应 TrayIconWin32 中的 MultiByteToWideChar：逐字符拓宽到新的 wstring
+        std::wstring wide(text.size(), L' ');
+        for (std::size_t k = 0; k < text.size(); ++k) wide[k] = static_cast<wchar_t>(text[k]);
+        bench::doNotOptimize(static_cast<unsigned>(wide[wide.size() - 1]));
+    });
+
+    bench::measureNsPerOp("formatTimeText char + wchar_t", kIterations, [](std::uint64_t i) {
+        const int total = static_cast<int>(i % (60 * 60));
+        char narrow[kTimeTextCapacity];
+        wchar_t wide[kTimeTextCapacity];
+        const std::size_t n = formatTimeText(total, narrow);
+        formatTimeText(total, wide);
+        bench::doNotOptimize(static_cast<unsigned>(narrow[n - 1]) + static_cast<unsigned>(wide[n - 1]));
+    });
+
+    return 0;
+}
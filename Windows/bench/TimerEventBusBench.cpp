@@ -0,0 +1,70 @@
+// Per-second notification cost: the former single onTimeUpdate lambda that re-queries the timer
+// (isInRestPeriod / isInForcedSleep / isRunning / remainingSeconds / isRestTimerRunning, as main.cpp
+// did for tray + overlay) versus three bus subscribers reading the precomputed TimerStateSnapshot.
+// Both drive PomodoroTimer::tick() with a VirtualClock advanced by one second per op.
+
+#include "BenchHarness.h"
+
+#include "PomodoroTimer.h"
+
+#include <chrono>
+
+using namespace pomodoro;
+
+int main() {
+    constexpr std::uint64_t kIterations = 2'000'000;
+
+    {
+        // 基线：没有任何订阅者时 tick 本身的开销，两种方式的净开销都要减去它
+        VirtualClock clock;
+        PomodoroTimer timer(clock);
+        timer.start();
+        bench::measureNsPerOp("baseline tick, no subscribers", kIterations, [&](std::uint64_t) {
+            clock.advance(std::chrono::seconds(1));
+            timer.tick();
+        });
+    }
+
+    {
+        VirtualClock clock;
+        PomodoroTimer timer(clock);
+        std::uint64_t sink = 0;
+        timer.onTimeUpdate = [&timer, &sink](std::string_view text) {
+            sink += text.size();
+            // 托盘
+            sink += static_cast<std::uint64_t>(timer.isInRestPeriod()) + timer.isInForcedSleep() + timer.isRunning();
+            sink += static_cast<std::uint64_t>(timer.remainingSeconds());
+            // 遮罩自动隐藏
+            sink += static_cast<std::uint64_t>(!timer.isInRestPeriod() && !timer.isRestTimerRunning());
+        };
+        timer.start();
+        bench::measureNsPerOp("single callback + state re-query", kIterations, [&](std::uint64_t) {
+            clock.advance(std::chrono::seconds(1));
+            timer.tick();
+        });
+        bench::doNotOptimize(sink);
+    }
+
+    {
+        VirtualClock clock;
+        PomodoroTimer timer(clock);
+        std::uint64_t sink = 0;
+        timer.events.subscribe(kTimerEventTimeUpdated, [&sink](const TimerEvent& e) { sink += e.timeText.size(); });
+        timer.events.subscribe(kTimerEventTimeUpdated, [&sink](const TimerEvent& e) {
+            const auto& s = e.snapshot;
+            sink += static_cast<std::uint64_t>(s.isInRestPeriod) + s.isInForcedSleep + s.isRunning;
+            sink += static_cast<std::uint64_t>(s.remainingSeconds);
+        });
+        timer.events.subscribe(kTimerEventTimeUpdated, [&sink](const TimerEvent& e) {
+            sink += static_cast<std::uint64_t>(!e.snapshot.isInRestPeriod && !e.snapshot.isRestTimerRunning);
+        });
+        timer.start();
+        bench::measureNsPerOp("event bus, 3 subscribers + snapshot", kIterations, [&](std::uint64_t) {
+            clock.advance(std::chrono::seconds(1));
+            timer.tick();
+        });
+        bench::doNotOptimize(sink);
+    }
+
+    return 0;
+}
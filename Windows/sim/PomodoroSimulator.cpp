@@ -0,0 +1,228 @@
+#include "PomodoroSimulator.h"
+
+#include "MonotonicClock.h"
+
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace pomodoro::sim {
+
+    namespace {
+
+        using Clock = PomodoroTimer::Clock;
+        using std::chrono::hours;
+        using std::chrono::minutes;
+        using std::chrono::seconds;
+
+        enum class SimEventKind {
+            NewDay,              // 生成当天脚本
+            UserStart,           // 用户点击“开始”
+            UserActivity,        // 鼠标/键盘活动
+            IdleExceeded,        // 无操作超时
+            ScreenLocked,
+            ScreenUnlocked,
+            ScreensaverStarted,
+            ScreensaverStopped,
+            StayUpBegin,         // 到达熬夜限制时间
+            StayUpEnd,           // 次日早晨结束强制睡眠
+            CancelRest           // 用户点击遮罩上的“取消休息”
+        };
+
+        struct SimEvent {
+            Clock::time_point at;
+            std::uint64_t seq;   // 同一时刻按插入顺序处理，保证可复现
+            SimEventKind kind;
+        };
+
+        struct LaterFirst {
+            bool operator()(const SimEvent& a, const SimEvent& b) const {
+                return (a.at != b.at) ? (a.at > b.at) : (a.seq > b.seq);
+            }
+        };
+
+        class Scheduler {
+        public:
+            void push(Clock::time_point at, SimEventKind kind) { queue_.push(SimEvent{ at, nextSeq_++, kind }); }
+            bool empty() const { return queue_.empty(); }
+            const SimEvent& top() const { return queue_.top(); }
+            void pop() { queue_.pop(); }
+
+        private:
+            std::priority_queue<SimEvent, std::vector<SimEvent>, LaterFirst> queue_;
+            std::uint64_t nextSeq_{ 0 };
+        };
+
+        Clock::duration Minutes(double m) {
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::ratio<60>>(m));
+        }
+
+    } // namespace
+
+    double SimulationReport::eventsPerSecond() const {
+        const double wall = std::chrono::duration<double>(wallTime).count();
+        return wall > 0.0 ? static_cast<double>(eventsProcessed + timerWakeups) / wall : 0.0;
+    }
+
+    PomodoroSimulator::PomodoroSimulator(const SimulationConfig& config)
+        : config_(config) {}
+
+    SimulationReport PomodoroSimulator::run() {
+        const auto wallStart = std::chrono::steady_clock::now();
+
+        SimulationReport report;
+        VirtualClock clock;
+        PomodoroTimer timer(clock);
+        timer.updateSettings(config_.timerSettings);
+
+        std::mt19937_64 rng(config_.seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        auto uniform = [&](double lo, double hi) { return lo + (hi - lo) * unit(rng); };
+        auto exponential = [&](double ratePerHour) {
+            std::exponential_distribution<double> d(ratePerHour / 60.0);
+            return d(rng); // minutes
+        };
+
+        Scheduler scheduler;
+        const auto epoch = clock.now();
+        const auto end = epoch + hours(24) * config_.days;
+
+        timer.onTimerFinished = [&]() {
+            ++report.pomodorosCompleted;
+            if (unit(rng) < config_.cancelRestProbability) {
+                scheduler.push(clock.now() + Minutes(uniform(10.0 / 60.0, 1.0)), SimEventKind::CancelRest);
+            }
+        };
+        if (config_.emitTimeDisplay) {
+            timer.onTimeUpdate = [&](std::string_view) { ++report.timeDisplayUpdates; };
+        }
+        timer.onForcedSleepEndedCallback = [&]() { ++report.forcedSleepsEnded; };
+
+        // 活跃时段：按分钟生成鼠标活动，并穿插无操作和屏保片段（片段内不产生活动事件）
+        auto scriptActiveBlock = [&](Clock::time_point from, Clock::time_point to) {
+            auto t = from;
+            auto nextIdle = t + Minutes(exponential(config_.idleEpisodesPerHour));
+            auto nextSaver = t + Minutes(exponential(config_.screensaverEpisodesPerHour));
+            const double perMinute = config_.activityEventsPerMinute;
+
+            while (t < to) {
+                if (nextIdle <= t) {
+                    const auto back = t + Minutes(uniform(2.0, 20.0));
+                    scheduler.push(t, SimEventKind::IdleExceeded);
+                    scheduler.push(back, SimEventKind::UserActivity);
+                    t = back;
+                    nextIdle = t + Minutes(exponential(config_.idleEpisodesPerHour));
+                    continue;
+                }
+                if (nextSaver <= t) {
+                    const auto back = t + Minutes(uniform(1.0, 10.0));
+                    scheduler.push(t, SimEventKind::ScreensaverStarted);
+                    scheduler.push(back, SimEventKind::ScreensaverStopped);
+                    t = back;
+                    nextSaver = t + Minutes(exponential(config_.screensaverEpisodesPerHour));
+                    continue;
+                }
+                const int count = static_cast<int>(perMinute + unit(rng));
+                for (int i = 0; i < count; ++i) {
+                    scheduler.push(t + Minutes(unit(rng)), SimEventKind::UserActivity);
+                }
+                t += minutes(1);
+            }
+        };
+
+        auto scriptDay = [&](Clock::time_point dayStart, int dayIndex) {
+            if (dayIndex + 1 < config_.days) {
+                scheduler.push(dayStart + hours(24), SimEventKind::NewDay);
+            }
+            const bool weekend = (dayIndex % 7) >= 5;
+            if (weekend) return;
+
+            const auto arrive = dayStart + hours(8) + minutes(30) + Minutes(uniform(0.0, 60.0));
+            const auto lunch = dayStart + hours(12) + Minutes(uniform(0.0, 10.0));
+            const auto back = dayStart + hours(13) + minutes(30) + Minutes(uniform(0.0, 15.0));
+            const auto leave = dayStart + hours(18) + minutes(30) + Minutes(uniform(0.0, 60.0));
+
+            scheduler.push(arrive, SimEventKind::ScreenUnlocked);
+            scheduler.push(arrive, SimEventKind::UserStart);
+            scriptActiveBlock(arrive, lunch);
+            scheduler.push(lunch, SimEventKind::ScreenLocked);
+            scheduler.push(back, SimEventKind::ScreenUnlocked);
+            scriptActiveBlock(back, leave);
+            scheduler.push(leave, SimEventKind::ScreenLocked);
+
+            if (unit(rng) < config_.stayUpNightProbability) {
+                const auto& s = config_.timerSettings;
+                const auto limit = dayStart + hours(s.stayUpLimitHour) + minutes(s.stayUpLimitMinute);
+                const auto evening = limit - minutes(90) + Minutes(uniform(0.0, 30.0));
+                scheduler.push(evening, SimEventKind::ScreenUnlocked);
+                scheduler.push(evening, SimEventKind::UserStart);
+                scriptActiveBlock(evening, limit);
+                scheduler.push(limit, SimEventKind::StayUpBegin);
+                scheduler.push(dayStart + hours(24 + 6), SimEventKind::StayUpEnd);
+            }
+        };
+
+        auto apply = [&](SimEventKind kind) {
+            switch (kind) {
+            case SimEventKind::NewDay: {
+                const auto dayIndex = static_cast<int>((clock.now() - epoch) / hours(24));
+                scriptDay(epoch + hours(24) * dayIndex, dayIndex);
+                break;
+            }
+            case SimEventKind::UserStart:
+                if (!timer.isRunning()) timer.start();
+                break;
+            case SimEventKind::UserActivity: timer.onUserActivity(); break;
+            case SimEventKind::IdleExceeded: timer.onIdleTimeExceeded(); break;
+            case SimEventKind::ScreenLocked: timer.onScreenLocked(); break;
+            case SimEventKind::ScreenUnlocked: timer.onScreenUnlocked(); break;
+            case SimEventKind::ScreensaverStarted: timer.onScreensaverStarted(); break;
+            case SimEventKind::ScreensaverStopped: timer.onScreensaverStopped(); break;
+            case SimEventKind::StayUpBegin:
+                timer.onForcedSleepTriggered();
+                if (timer.isInForcedSleep()) ++report.forcedSleepsEntered;
+                break;
+            case SimEventKind::StayUpEnd:
+                timer.onForcedSleepEnded();
+                break;
+            case SimEventKind::CancelRest:
+                // 与 MultiScreenOverlayManagerWin32 的 onDismissAll 回调一致：直接开始下一轮番茄
+                if (timer.isInRestPeriod()) {
+                    ++report.restsCancelled;
+                    timer.start();
+                }
+                break;
+            }
+        };
+
+        scriptDay(epoch, 0);
+
+        const auto never = Clock::time_point::max();
+        while (true) {
+            const auto wake = config_.emitTimeDisplay ? timer.nextWakeup() : timer.phaseDeadline();
+            const auto nextEvent = scheduler.empty() ? never : scheduler.top().at;
+
+            if (wake != never && wake <= nextEvent && wake < end) {
+                clock.advanceTo(wake);
+                const bool wasResting = timer.isInRestPeriod();
+                timer.tick();
+                ++report.timerWakeups;
+                if (wasResting && !timer.isInRestPeriod()) ++report.restsCompleted;
+                continue;
+            }
+            if (nextEvent == never || nextEvent >= end) break;
+
+            const SimEventKind kind = scheduler.top().kind;
+            scheduler.pop();
+            clock.advanceTo(nextEvent);
+            apply(kind);
+            ++report.eventsProcessed;
+        }
+
+        clock.advanceTo(end);
+        report.simulatedTime = std::chrono::duration_cast<seconds>(clock.now() - epoch);
+        report.wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wallStart);
+        return report;
+    }
+
+} // namespace pomodoro::sim
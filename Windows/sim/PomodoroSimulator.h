@@ -0,0 +1,63 @@
+#pragma once
+
+// Headless simulation harness for the portable core.
+//
+// Drives a real PomodoroTimer (and through it AutoRestartStateMachine) with a VirtualClock and a
+// synthetic user model: workday sessions, mouse-rate activity, idle episodes, lunch / evening screen
+// locks, screensaver episodes, rest-overlay cancels and stay-up nights. Timer wakeups are taken from
+// `nextWakeup()` (or `phaseDeadline()` when per-second display is disabled), exactly like the Win32
+// host loop, so a month of sessions runs in milliseconds and is fully deterministic for a given seed.
+//
+// Intended uses: load-testing scheduling policies (compare reports across PomodoroTimer::Settings)
+// and catching behavioural regressions at millions of events per second.
+
+#include <chrono>
+#include <cstdint>
+
+#include "PomodoroTimer.h"
+
+namespace pomodoro::sim {
+
+    struct SimulationConfig {
+        int days{ 30 };
+        std::uint64_t seed{ 1 };
+
+        PomodoroTimer::Settings timerSettings{};
+
+        // true: wake every visible second and format the time text (like the tray icon does);
+        // false: wake only at phase deadlines (fastest, same phase behaviour).
+        bool emitTimeDisplay{ false };
+
+        double activityEventsPerMinute{ 30.0 };     // UserActivityDetected rate while the user is active
+        double idleEpisodesPerHour{ 1.5 };          // IdleTimeExceeded ... UserActivityDetected pairs
+        double screensaverEpisodesPerHour{ 0.3 };   // ScreensaverStarted ... ScreensaverStopped pairs
+        double cancelRestProbability{ 0.2 };        // user dismisses the rest overlay early
+        double stayUpNightProbability{ 0.2 };       // workday evenings that run into the stay-up limit
+    };
+
+    struct SimulationReport {
+        std::uint64_t eventsProcessed{ 0 };      // synthetic system / user events fed to the timer
+        std::uint64_t timerWakeups{ 0 };         // tick() calls driven by nextWakeup()/phaseDeadline()
+        std::uint64_t timeDisplayUpdates{ 0 };   // onTimeUpdate invocations
+        int pomodorosCompleted{ 0 };
+        int restsCompleted{ 0 };
+        int restsCancelled{ 0 };
+        int forcedSleepsEntered{ 0 };
+        int forcedSleepsEnded{ 0 };
+        std::chrono::seconds simulatedTime{ 0 };
+        std::chrono::nanoseconds wallTime{ 0 };
+
+        double eventsPerSecond() const;
+    };
+
+    class PomodoroSimulator {
+    public:
+        explicit PomodoroSimulator(const SimulationConfig& config);
+
+        SimulationReport run();
+
+    private:
+        SimulationConfig config_;
+    };
+
+} // namespace pomodoro::sim
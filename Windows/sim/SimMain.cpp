@@ -0,0 +1,81 @@
+// PomodoroSim: runs the headless simulator for a few scheduling policies and prints one report each.
+//
+// Usage: PomodoroSim [days=90] [seed=1] [--display]
+//   --display  wake every visible second (like the tray icon) instead of only at phase deadlines.
+
+#include "PomodoroSimulator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace pomodoro;
+using namespace pomodoro::sim;
+
+namespace {
+
+    struct Policy {
+        const char* name;
+        PomodoroTimer::Settings settings;
+    };
+
+    PomodoroTimer::Settings MakeSettings(bool autoHandling, bool restartOnReturn) {
+        PomodoroTimer::Settings s;
+        s.idleRestartEnabled = autoHandling;
+        s.idleActionIsRestart = restartOnReturn;
+        s.screenLockRestartEnabled = autoHandling;
+        s.screenLockActionIsRestart = restartOnReturn;
+        s.screensaverRestartEnabled = autoHandling;
+        s.screensaverActionIsRestart = restartOnReturn;
+        s.stayUpLimitEnabled = true;
+        return s;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SimulationConfig base;
+    base.days = 90;
+
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--display") == 0) {
+            base.emitTimeDisplay = true;
+        } else if (positional == 0) {
+            base.days = std::atoi(argv[i]);
+            ++positional;
+        } else {
+            base.seed = std::strtoull(argv[i], nullptr, 10);
+            ++positional;
+        }
+    }
+    if (base.days <= 0) base.days = 1;
+
+    const Policy policies[] = {
+        { "manual (no auto handling)", MakeSettings(false, false) },
+        { "auto: resume on return", MakeSettings(true, false) },
+        { "auto: restart on return", MakeSettings(true, true) },
+    };
+
+    std::printf("days=%d seed=%llu display=%d\n", base.days,
+        static_cast<unsigned long long>(base.seed), base.emitTimeDisplay ? 1 : 0);
+    std::printf("%-28s %10s %10s %9s %8s %8s %8s %10s %14s\n",
+        "policy", "events", "wakeups", "pomodoro", "rests", "cancel", "sleeps", "wall ms", "events/s");
+
+    for (const auto& p : policies) {
+        SimulationConfig config = base;
+        config.timerSettings = p.settings;
+        const SimulationReport r = PomodoroSimulator(config).run();
+        std::printf("%-28s %10llu %10llu %9d %8d %8d %8d %10.2f %14.0f\n",
+            p.name,
+            static_cast<unsigned long long>(r.eventsProcessed),
+            static_cast<unsigned long long>(r.timerWakeups),
+            r.pomodorosCompleted,
+            r.restsCompleted,
+            r.restsCancelled,
+            r.forcedSleepsEntered,
+            std::chrono::duration<double, std::milli>(r.wallTime).count(),
+            r.eventsPerSecond());
+    }
+    return 0;
+}
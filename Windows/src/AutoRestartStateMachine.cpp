@@ -1,12 +1,18 @@
 #include "AutoRestartStateMachine.h"
+#include "AutoRestartTransitionTable.h"
 
 namespace pomodoro {
 
-    AutoRestartStateMachine::AutoRestartStateMachine(const AutoRestartSettings& settings)
-        : settings_(settings) {}
+    constexpr AutoRestartTransitionTables kAutoRestartTransitionTables = detail::buildAutoRestartTransitionTables();
+
+    AutoRestartStateMachine::AutoRestartStateMachine(const AutoRestartSettings& settings, const MonotonicClock& clock)
+        : settings_(settings)
+        , tableKey_(makeAutoRestartKey(settings, false))
+        , clock_(&clock) {}
 
     void AutoRestartStateMachine::updateSettings(const AutoRestartSettings& settings) {
         settings_ = settings;
+        tableKey_ = makeAutoRestartKey(settings_, isStayUpTime_);
     }
 
     AutoRestartState AutoRestartStateMachine::getCurrentState() const noexcept {
@@ -69,233 +75,117 @@ namespace pomodoro {
     }
 
     AutoRestartAction AutoRestartStateMachine::processEvent(AutoRestartEvent event) {
-        const auto action = determineAction(event, currentState_);
-        const auto newState = determineNewState(event, currentState_);
-        currentState_ = newState;
-        return action;
-    }
-
-    void AutoRestartStateMachine::markScreensaverResumedNow() {
-        lastScreensaverResumeTime_ = Clock::now();
-        hasScreensaverResumeTime_ = true;
-    }
-
-    void AutoRestartStateMachine::setStayUpTime(bool isStayUp) {
-        isStayUpTime_ = isStayUp;
-    }
-
-    bool AutoRestartStateMachine::wasRecentlyResumedByScreensaver() const {
-        if (!hasScreensaverResumeTime_) return false;
-        const auto now = Clock::now();
-        const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastScreensaverResumeTime_);
-        return diff.count() < 1000; // 1 秒内视为刚刚恢复
-    }
-
-    AutoRestartAction AutoRestartStateMachine::determineAction(AutoRestartEvent event, AutoRestartState state) const {
-        using S = AutoRestartState;
-        using E = AutoRestartEvent;
-        using A = AutoRestartAction;
-
-        switch (event) {
-        case E::TimerStarted:
-        case E::TimerStopped:
-        case E::TimerPaused:
-            return A::None;
-
-        case E::IdleTimeExceeded:
-            if (state == S::TimerRunning && settings_.idleEnabled) {
-                return A::PauseTimer;
-            }
-            return A::None;
-
-        case E::UserActivityDetected:
-            if (!settings_.idleEnabled) {
-                // 其他所有状态都忽略
-                return A::None;
-            }
-            if (state == S::TimerPausedByIdle) {
-                return settings_.idleActionIsRestart ? A::RestartTimer : A::ResumeTimer;
-            }
-            if (state == S::TimerPausedBySystem || state == S::ForcedSleep) {
-                // 系统事件暂停或强制睡眠时，用户活动不触发动作
-                return A::None;
-            }
-            return A::None;
-
-        case E::ScreenLocked:
-            if (!settings_.screenLockEnabled) return A::None;
-            if (state == S::TimerRunning || state == S::RestTimerRunning) {
-                return settings_.screenLockActionIsRestart ? A::None : A::PauseTimer;
-            }
-            return A::None;
-
-        case E::ScreenUnlocked:
-            if (!settings_.screenLockEnabled) return A::None;
-            if (state == S::TimerPausedBySystem) {
-                if (wasRecentlyResumedByScreensaver()) {
-                    return A::None;
-                }
-                return settings_.screenLockActionIsRestart ? A::RestartTimer : A::ResumeTimer;
-            }
-            if (state == S::RestTimerPausedBySystem) {
-                if (wasRecentlyResumedByScreensaver()) {
-                    return A::None;
-                }
-                return A::ResumeTimer;
-            }
-            if (state == S::TimerRunning) {
-                if (wasRecentlyResumedByScreensaver()) {
-                    return A::None;
-                }
-                return settings_.screenLockActionIsRestart ? A::RestartTimer : A::None;
-            }
-            if (state == S::ForcedSleep) {
-                if (!isInStayUpTime()) {
-                    return A::ExitForcedSleep;
+        // 只有解锁事件需要参考“屏保刚刚恢复”这一时间相关条件；没有记录器时其他事件不读时钟
+        const bool needsTime = sink_ != nullptr ||
+            (event == AutoRestartEvent::ScreenUnlocked && hasScreensaverResumeTime_);
+        return processEvent(event, needsTime ? clock_->now() : MonotonicClock::time_point{});
+    }
+
+    AutoRestartAction AutoRestartStateMachine::processEvent(AutoRestartEvent event, MonotonicClock::time_point at) {
+        const std::size_t recent = (event == AutoRestartEvent::ScreenUnlocked && wasRecentlyResumedByScreensaver(at)) ? 1 : 0;
+        const auto& t = kAutoRestartTransitionTables[tableKey_][recent]
+            [static_cast<std::size_t>(currentState_)][static_cast<std::size_t>(event)];
+        if (sink_) {
+            sink_->onTransition(AutoRestartTransitionRecord{ at, event, currentState_, t.newState, t.action,
+                static_cast<std::uint8_t>(tableKey_), recent != 0 });
+        }
+        currentState_ = t.newState;
+        return t.action;
+    }
+
+    void AutoRestartStateMachine::processEvents(const AutoRestartEvent* events, std::size_t count,
+        std::vector<AutoRestartAction>& actions) {
+        const auto& table = kAutoRestartTransitionTables[tableKey_];
+        std::size_t recent = wasRecentlyResumedByScreensaver(clock_->now()) ? 1 : 0;
+
+        // 当前状态下已确认为空转（状态不变、无动作）的事件位集；状态一变就作废
+        std::uint32_t knownNoops = 0;
+        // 最近一次追加的 PauseTimer 及其之前的状态，用于抵消紧随其后的 ResumeTimer
+        bool pendingPause = false;
+        AutoRestartState stateBeforePause = currentState_;
+        // 整批视为同一时刻到达：记录转换时只读一次时钟
+        const auto batchTime = sink_ ? clock_->now() : MonotonicClock::time_point{};
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto event = events[i];
+            const std::uint32_t bit = 1u << static_cast<unsigned>(event);
+            if (knownNoops & bit) continue;
+
+            if (event == AutoRestartEvent::ScreensaverStopped) {
+                markScreensaverResumedNow();
+                if (recent == 0) {
+                    recent = 1;
+                    knownNoops &= ~(1u << static_cast<unsigned>(AutoRestartEvent::ScreenUnlocked));
                 }
-                return A::None;
             }
-            return A::None;
 
-        case E::ScreensaverStarted:
-            if (!settings_.screensaverEnabled) return A::None;
-            if (state == S::TimerRunning || state == S::RestTimerRunning) {
-                return settings_.screensaverActionIsRestart ? A::None : A::PauseTimer;
-            }
-            return A::None;
-
-        case E::ScreensaverStopped:
-            if (!settings_.screensaverEnabled) return A::None;
-            if (state == S::TimerPausedBySystem || state == S::RestTimerPausedBySystem) {
-                // 屏保停止后，根据配置选择恢复或重启
-                if (state == S::RestTimerPausedBySystem) {
-                    // 休息期间解屏，一律恢复休息计时
-                    return A::ResumeTimer;
+            const std::size_t r = (event == AutoRestartEvent::ScreenUnlocked) ? recent : 0;
+            const auto& t = table[r][static_cast<std::size_t>(currentState_)][static_cast<std::size_t>(event)];
+            if (sink_) {
+                sink_->onTransition(AutoRestartTransitionRecord{ batchTime, event, currentState_, t.newState, t.action,
+                    static_cast<std::uint8_t>(tableKey_), r != 0 });
+            }
+            if (t.newState == currentState_ && t.action == AutoRestartAction::None) {
+                knownNoops |= bit;
+                continue;
+            }
+
+            const AutoRestartState before = currentState_;
+            if (t.newState != currentState_) {
+                knownNoops = 0;
+                currentState_ = t.newState;
+            }
+
+            switch (t.action) {
+            case AutoRestartAction::None:
+                // 只改变了状态：之后的恢复不再与之前的暂停紧邻
+                pendingPause = false;
+                break;
+            case AutoRestartAction::PauseTimer:
+                actions.push_back(t.action);
+                pendingPause = true;
+                stateBeforePause = before;
+                break;
+            case AutoRestartAction::ResumeTimer:
+                if (pendingPause && currentState_ == stateBeforePause) {
+                    // 同一时刻先暂停再恢复，对上层没有净效果
+                    actions.pop_back();
+                    pendingPause = false;
+                    break;
                 }
-                return settings_.screensaverActionIsRestart ? A::RestartTimer : A::ResumeTimer;
-            }
-            return A::None;
-
-        case E::PomodoroFinished:
-            // 由上层触发休息 overlay 和下一轮番茄钟
-            return A::ShowRestOverlay;
-
-        case E::RestStarted:
-            return A::None;
-
-        case E::RestFinished:
-            // 休息完成，开始下一个番茄钟
-            return A::StartNextPomodoro;
-
-        case E::RestCancelled:
-            // 直接回到空闲或计时状态由状态机状态转换决定
-            return A::None;
-
-        case E::ForcedSleepTriggered:
-            if (settings_.stayUpLimitEnabled) {
-                return A::EnterForcedSleep;
-            }
-            return A::None;
-
-        case E::ForcedSleepEnded:
-            if (state == S::ForcedSleep) {
-                return A::ExitForcedSleep;
+                actions.push_back(t.action);
+                pendingPause = false;
+                break;
+            default:
+                actions.push_back(t.action);
+                pendingPause = false;
+                break;
             }
-            return A::None;
         }
-
-        return A::None;
     }
 
-    AutoRestartState AutoRestartStateMachine::determineNewState(AutoRestartEvent event, AutoRestartState state) const {
-        using S = AutoRestartState;
-        using E = AutoRestartEvent;
-
-        switch (event) {
-        case E::TimerStarted:
-            return S::TimerRunning;
-        case E::TimerStopped:
-            return S::Idle;
-        case E::TimerPaused:
-            return S::TimerPausedByUser;
-
-        case E::IdleTimeExceeded:
-            if (state == S::TimerRunning && settings_.idleEnabled) {
-                return S::TimerPausedByIdle;
-            }
-            return state;
-
-        case E::UserActivityDetected:
-            if (!settings_.idleEnabled) return state;
-            if (state == S::TimerPausedByIdle) {
-                return settings_.idleActionIsRestart ? S::TimerRunning : S::TimerRunning;
-            }
-            return state;
-
-        case E::ScreenLocked:
-            if (!settings_.screenLockEnabled) return state;
-            if (state == S::TimerRunning || state == S::RestTimerRunning) {
-                return S::TimerPausedBySystem;
-            }
-            return state;
-
-        case E::ScreenUnlocked:
-            if (!settings_.screenLockEnabled) return state;
-            if (state == S::TimerPausedBySystem) {
-                return S::TimerRunning;
-            }
-            if (state == S::RestTimerPausedBySystem) {
-                return S::RestTimerRunning;
-            }
-            if (state == S::ForcedSleep && !isInStayUpTime()) {
-                return S::Idle;
-            }
-            return state;
-
-        case E::ScreensaverStarted:
-            if (!settings_.screensaverEnabled) return state;
-            if (state == S::TimerRunning || state == S::RestTimerRunning) {
-                return S::TimerPausedBySystem;
-            }
-            return state;
-
-        case E::ScreensaverStopped:
-            if (!settings_.screensaverEnabled) return state;
-            if (state == S::TimerPausedBySystem) {
-                return S::TimerRunning;
-            }
-            if (state == S::RestTimerPausedBySystem) {
-                return S::RestTimerRunning;
-            }
-            return state;
-
-        case E::PomodoroFinished:
-            // 进入休息前的中间状态，由上层决定是否开始休息计时
-            return S::RestPeriod;
-
-        case E::RestStarted:
-            return S::RestTimerRunning;
+    void AutoRestartStateMachine::markScreensaverResumedNow() {
+        markScreensaverResumedAt(clock_->now());
+    }
 
-        case E::RestFinished:
-            // 休息结束，计入统计后进入空闲或重新开始番茄钟由上层决定
-            return S::Idle;
+    void AutoRestartStateMachine::markScreensaverResumedAt(MonotonicClock::time_point at) {
+        lastScreensaverResumeTime_ = at;
+        hasScreensaverResumeTime_ = true;
+    }
 
-        case E::RestCancelled:
-            // 取消休息，返回空闲
-            return S::Idle;
+    void AutoRestartStateMachine::restoreState(AutoRestartState state) noexcept {
+        currentState_ = state;
+    }
 
-        case E::ForcedSleepTriggered:
-            if (settings_.stayUpLimitEnabled) {
-                return S::ForcedSleep;
-            }
-            return state;
+    void AutoRestartStateMachine::setStayUpTime(bool isStayUp) {
+        isStayUpTime_ = isStayUp;
+        tableKey_ = makeAutoRestartKey(settings_, isStayUpTime_);
+    }
 
-        case E::ForcedSleepEnded:
-            if (state == S::ForcedSleep) {
-                return S::Idle;
-            }
-            return state;
-        }
+    bool AutoRestartStateMachine::wasRecentlyResumedByScreensaver(MonotonicClock::time_point at) const {
+        if (!hasScreensaverResumeTime_) return false;
+        const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(at - lastScreensaverResumeTime_);
+        return diff.count() < 1000; // 1 秒内视为刚刚恢复
     }
 
 } // namespace pomodoro
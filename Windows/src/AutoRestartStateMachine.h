@@ -11,10 +11,15 @@
 // this state machine.
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MonotonicClock.h"
 
 namespace pomodoro {
 
-    enum class AutoRestartState {
+    enum class AutoRestartState : std::uint8_t {
         Idle,                   // 空闲状态，等待事件
         TimerRunning,           // 计时器运行中
         TimerPausedByUser,      // 因用户手动暂停
@@ -28,7 +33,7 @@ namespace pomodoro {
         ForcedSleep             // 强制睡眠状态（熬夜限制触发）
     };
 
-    enum class AutoRestartEvent {
+    enum class AutoRestartEvent : std::uint8_t {
         TimerStarted,          // 计时器启动
         TimerStopped,          // 计时器停止
         TimerPaused,           // 计时器暂停（手动）
@@ -46,7 +51,7 @@ namespace pomodoro {
         ForcedSleepEnded       // 强制睡眠结束（用户取消或时间过了）
     };
 
-    enum class AutoRestartAction {
+    enum class AutoRestartAction : std::uint8_t {
         None,              // 无动作
         PauseTimer,        // 暂停计时器
         ResumeTimer,       // 恢复计时器
@@ -77,11 +82,37 @@ namespace pomodoro {
         int  stayUpLimitMinute{ 0 };   // 限制分钟（0, 15, 30, 45）
     };
 
+    // 带发生时刻的事件（检测线程投递时打上的时间戳，见 SystemEventQueues.h）
+    struct TimedAutoRestartEvent {
+        MonotonicClock::time_point at{};
+        AutoRestartEvent event{ AutoRestartEvent::UserActivityDetected };
+    };
+
+    // 一次 processEvent 的完整记录：时间、事件、转换前后的状态、动作，以及查表所用的键，
+    // 足以离线逐条复核/回放（见 EventJournal.h）
+    struct AutoRestartTransitionRecord {
+        MonotonicClock::time_point at{};
+        AutoRestartEvent event{};
+        AutoRestartState oldState{};
+        AutoRestartState newState{};
+        AutoRestartAction action{};
+        std::uint8_t tableKey{ 0 };          // makeAutoRestartKey(settings, isStayUpTime)
+        bool recentlyResumedByScreensaver{ false };
+    };
+
+    // 转换观察者：在热路径上同步调用，实现必须足够轻（只做内存写入）
+    class AutoRestartTransitionSink {
+    public:
+        virtual ~AutoRestartTransitionSink() = default;
+        virtual void onTransition(const AutoRestartTransitionRecord& transition) = 0;
+    };
+
     class AutoRestartStateMachine {
     public:
         using Clock = std::chrono::steady_clock;
 
-        explicit AutoRestartStateMachine(const AutoRestartSettings& settings);
+        explicit AutoRestartStateMachine(const AutoRestartSettings& settings,
+            const MonotonicClock& clock = SteadyClock::instance());
 
         void updateSettings(const AutoRestartSettings& settings);
 
@@ -96,18 +127,34 @@ namespace pomodoro {
         bool isInPausedState() const noexcept;
         bool isInRunningState() const noexcept;
 
-        // 主入口：根据事件返回需要执行的动作，由上层逻辑决定是否执行
+        // 主入口：根据事件返回需要执行的动作，由上层逻辑决定是否执行。
+        // 转换结果来自编译期生成的转换表（见 AutoRestartTransitionTable.h）。
         AutoRestartAction processEvent(AutoRestartEvent event);
+        // 同上，但按事件实际发生的时刻 at 判断“屏保刚恢复”并记录转换（事件在队列中等待期间不计入）
+        AutoRestartAction processEvent(AutoRestartEvent event, MonotonicClock::time_point at);
+
+        // 批量入口：供系统钩子以鼠标移动频率投递事件时使用，整批视为同一时刻到达。
+        // - 与逐个 processEvent 的最终状态一致；批内的 ScreensaverStopped 同时记录“屏保刚恢复”
+        //   （等价于 markScreensaverResumedNow() + processEvent()，与 PomodoroTimer 的用法一致）
+        // - 在当前状态下已确认“状态不变且无动作”的事件直接跳过，不再查表（重复的用户活动、
+        //   无效的锁屏/解锁等）
+        // - 动作按顺序追加到 actions（不含 None）；紧邻且回到原状态的 PauseTimer/ResumeTimer 互相抵消
+        void processEvents(const AutoRestartEvent* events, std::size_t count, std::vector<AutoRestartAction>& actions);
 
         // 熬夜时间槽记录仅保留接口，具体持久化/统计由上层实现
         void markScreensaverResumedNow();
+        void markScreensaverResumedAt(MonotonicClock::time_point at);
         void setStayUpTime(bool isStayUp);
 
-    private:
-        AutoRestartAction determineAction(AutoRestartEvent event, AutoRestartState state) const;
-        AutoRestartState determineNewState(AutoRestartEvent event, AutoRestartState state) const;
+        // 崩溃/重启恢复：直接设置当前状态，不产生动作（见 PomodoroTimer::restoreSnapshot）
+        void restoreState(AutoRestartState state) noexcept;
 
-        bool wasRecentlyResumedByScreensaver() const;
+        // 记录每一次经过查表的事件（nullptr 关闭）；sink 的生命周期必须长于状态机。
+        // 批量入口中被跳过的已知空转事件不会经过查表，因此也不会被记录。
+        void setTransitionSink(AutoRestartTransitionSink* sink) noexcept { sink_ = sink; }
+
+    private:
+        bool wasRecentlyResumedByScreensaver(MonotonicClock::time_point at) const;
 
     private:
         AutoRestartState currentState_{ AutoRestartState::Idle };
@@ -115,8 +162,12 @@ namespace pomodoro {
         TimerType currentTimerType_{ TimerType::Pomodoro };
 
         bool isStayUpTime_{ false };
+        std::uint32_t tableKey_{ 0 }; // 由 settings_ + isStayUpTime_ 折叠出的转换表索引
         Clock::time_point lastScreensaverResumeTime_{};
         bool hasScreensaverResumeTime_{ false };
+
+        const MonotonicClock* clock_; // “屏保刚恢复”判断所用的时钟（测试/模拟时为虚拟时钟）
+        AutoRestartTransitionSink* sink_{ nullptr };
     };
 
 } // namespace pomodoro
@@ -0,0 +1,236 @@
+#pragma once
+
+// Compile-time transition table for AutoRestartStateMachine.
+//
+// Every (state, event) outcome of the state machine depends only on:
+// - the AutoRestartSettings flags (idle / lock / screensaver enable + restart-vs-resume, stay-up limit)
+// - whether the stay-up window is currently active (`setStayUpTime`)
+// - whether the screensaver was dismissed within the last second (only consulted for ScreenUnlocked)
+//
+// All of these are folded into a small integer key, and the full table of
+// (key, recentlyResumed, state, event) -> (newState, action) is generated by constexpr evaluation.
+// `updateSettings` / `setStayUpTime` select one precomputed table, so `processEvent` is a single
+// indexed load instead of two nested switches that re-check the settings on every event.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "AutoRestartStateMachine.h"
+
+namespace pomodoro {
+
+    constexpr std::size_t kAutoRestartStateCount = static_cast<std::size_t>(AutoRestartState::ForcedSleep) + 1;
+    constexpr std::size_t kAutoRestartEventCount = static_cast<std::size_t>(AutoRestartEvent::ForcedSleepEnded) + 1;
+
+    // Bit layout of the table key.
+    enum AutoRestartKeyBits : std::uint32_t {
+        kKeyIdleEnabled = 1u << 0,
+        kKeyIdleActionIsRestart = 1u << 1,
+        kKeyScreenLockEnabled = 1u << 2,
+        kKeyScreenLockActionIsRestart = 1u << 3,
+        kKeyScreensaverEnabled = 1u << 4,
+        kKeyScreensaverActionIsRestart = 1u << 5,
+        kKeyStayUpLimitEnabled = 1u << 6,
+        kKeyStayUpTime = 1u << 7,   // 运行时状态：当前处于熬夜时间
+    };
+
+    constexpr std::size_t kAutoRestartKeyCount = 1u << 8;
+
+    struct AutoRestartTransition {
+        AutoRestartState newState;
+        AutoRestartAction action;
+    };
+
+    // [recentlyResumedByScreensaver][state][event]
+    using AutoRestartTransitionTable =
+        std::array<std::array<std::array<AutoRestartTransition, kAutoRestartEventCount>, kAutoRestartStateCount>, 2>;
+
+    using AutoRestartTransitionTables = std::array<AutoRestartTransitionTable, kAutoRestartKeyCount>;
+
+    constexpr std::uint32_t makeAutoRestartKey(const AutoRestartSettings& s, bool isStayUpTime) noexcept {
+        return (s.idleEnabled ? kKeyIdleEnabled : 0u)
+            | (s.idleActionIsRestart ? kKeyIdleActionIsRestart : 0u)
+            | (s.screenLockEnabled ? kKeyScreenLockEnabled : 0u)
+            | (s.screenLockActionIsRestart ? kKeyScreenLockActionIsRestart : 0u)
+            | (s.screensaverEnabled ? kKeyScreensaverEnabled : 0u)
+            | (s.screensaverActionIsRestart ? kKeyScreensaverActionIsRestart : 0u)
+            | (s.stayUpLimitEnabled ? kKeyStayUpLimitEnabled : 0u)
+            | (isStayUpTime ? kKeyStayUpTime : 0u);
+    }
+
+    namespace detail {
+
+        constexpr bool has(std::uint32_t key, std::uint32_t bit) noexcept { return (key & bit) != 0; }
+
+        // Same rules as the original `determineAction`, expressed over the table key.
+        constexpr AutoRestartAction determineAction(std::uint32_t key, bool recentlyResumed,
+            AutoRestartState state, AutoRestartEvent event) noexcept {
+            using S = AutoRestartState;
+            using E = AutoRestartEvent;
+            using A = AutoRestartAction;
+
+            switch (event) {
+            case E::TimerStarted:
+            case E::TimerStopped:
+            case E::TimerPaused:
+                return A::None;
+
+            case E::IdleTimeExceeded:
+                return (state == S::TimerRunning && has(key, kKeyIdleEnabled)) ? A::PauseTimer : A::None;
+
+            case E::UserActivityDetected:
+                if (!has(key, kKeyIdleEnabled)) return A::None;
+                if (state == S::TimerPausedByIdle) {
+                    return has(key, kKeyIdleActionIsRestart) ? A::RestartTimer : A::ResumeTimer;
+                }
+                // 系统事件暂停或强制睡眠时，用户活动不触发动作
+                return A::None;
+
+            case E::ScreenLocked:
+                if (!has(key, kKeyScreenLockEnabled)) return A::None;
+                if (state == S::TimerRunning || state == S::RestTimerRunning) {
+                    return has(key, kKeyScreenLockActionIsRestart) ? A::None : A::PauseTimer;
+                }
+                return A::None;
+
+            case E::ScreenUnlocked:
+                if (!has(key, kKeyScreenLockEnabled)) return A::None;
+                if (state == S::TimerPausedBySystem) {
+                    if (recentlyResumed) return A::None;
+                    return has(key, kKeyScreenLockActionIsRestart) ? A::RestartTimer : A::ResumeTimer;
+                }
+                if (state == S::RestTimerPausedBySystem) {
+                    return recentlyResumed ? A::None : A::ResumeTimer;
+                }
+                if (state == S::TimerRunning) {
+                    if (recentlyResumed) return A::None;
+                    return has(key, kKeyScreenLockActionIsRestart) ? A::RestartTimer : A::None;
+                }
+                if (state == S::ForcedSleep) {
+                    return has(key, kKeyStayUpTime) ? A::None : A::ExitForcedSleep;
+                }
+                return A::None;
+
+            case E::ScreensaverStarted:
+                if (!has(key, kKeyScreensaverEnabled)) return A::None;
+                if (state == S::TimerRunning || state == S::RestTimerRunning) {
+                    return has(key, kKeyScreensaverActionIsRestart) ? A::None : A::PauseTimer;
+                }
+                return A::None;
+
+            case E::ScreensaverStopped:
+                if (!has(key, kKeyScreensaverEnabled)) return A::None;
+                if (state == S::RestTimerPausedBySystem) {
+                    // 休息期间解屏，一律恢复休息计时
+                    return A::ResumeTimer;
+                }
+                if (state == S::TimerPausedBySystem) {
+                    return has(key, kKeyScreensaverActionIsRestart) ? A::RestartTimer : A::ResumeTimer;
+                }
+                return A::None;
+
+            case E::PomodoroFinished:
+                return A::ShowRestOverlay;
+
+            case E::RestStarted:
+            case E::RestCancelled:
+                return A::None;
+
+            case E::RestFinished:
+                return A::StartNextPomodoro;
+
+            case E::ForcedSleepTriggered:
+                return has(key, kKeyStayUpLimitEnabled) ? A::EnterForcedSleep : A::None;
+
+            case E::ForcedSleepEnded:
+                return (state == S::ForcedSleep) ? A::ExitForcedSleep : A::None;
+            }
+            return A::None;
+        }
+
+        // Same rules as the original `determineNewState`, expressed over the table key.
+        constexpr AutoRestartState determineNewState(std::uint32_t key, AutoRestartState state,
+            AutoRestartEvent event) noexcept {
+            using S = AutoRestartState;
+            using E = AutoRestartEvent;
+
+            switch (event) {
+            case E::TimerStarted:
+                return S::TimerRunning;
+            case E::TimerStopped:
+                return S::Idle;
+            case E::TimerPaused:
+                return S::TimerPausedByUser;
+
+            case E::IdleTimeExceeded:
+                return (state == S::TimerRunning && has(key, kKeyIdleEnabled)) ? S::TimerPausedByIdle : state;
+
+            case E::UserActivityDetected:
+                if (!has(key, kKeyIdleEnabled)) return state;
+                return (state == S::TimerPausedByIdle) ? S::TimerRunning : state;
+
+            case E::ScreenLocked:
+                if (!has(key, kKeyScreenLockEnabled)) return state;
+                return (state == S::TimerRunning || state == S::RestTimerRunning) ? S::TimerPausedBySystem : state;
+
+            case E::ScreenUnlocked:
+                if (!has(key, kKeyScreenLockEnabled)) return state;
+                if (state == S::TimerPausedBySystem) return S::TimerRunning;
+                if (state == S::RestTimerPausedBySystem) return S::RestTimerRunning;
+                if (state == S::ForcedSleep && !has(key, kKeyStayUpTime)) return S::Idle;
+                return state;
+
+            case E::ScreensaverStarted:
+                if (!has(key, kKeyScreensaverEnabled)) return state;
+                return (state == S::TimerRunning || state == S::RestTimerRunning) ? S::TimerPausedBySystem : state;
+
+            case E::ScreensaverStopped:
+                if (!has(key, kKeyScreensaverEnabled)) return state;
+                if (state == S::TimerPausedBySystem) return S::TimerRunning;
+                if (state == S::RestTimerPausedBySystem) return S::RestTimerRunning;
+                return state;
+
+            case E::PomodoroFinished:
+                return S::RestPeriod;
+            case E::RestStarted:
+                return S::RestTimerRunning;
+            case E::RestFinished:
+            case E::RestCancelled:
+                return S::Idle;
+
+            case E::ForcedSleepTriggered:
+                return has(key, kKeyStayUpLimitEnabled) ? S::ForcedSleep : state;
+
+            case E::ForcedSleepEnded:
+                return (state == S::ForcedSleep) ? S::Idle : state;
+            }
+            return state;
+        }
+
+        constexpr AutoRestartTransitionTables buildAutoRestartTransitionTables() noexcept {
+            AutoRestartTransitionTables tables{};
+            for (std::size_t key = 0; key < kAutoRestartKeyCount; ++key) {
+                for (std::size_t recent = 0; recent < 2; ++recent) {
+                    for (std::size_t s = 0; s < kAutoRestartStateCount; ++s) {
+                        for (std::size_t e = 0; e < kAutoRestartEventCount; ++e) {
+                            const auto state = static_cast<AutoRestartState>(s);
+                            const auto event = static_cast<AutoRestartEvent>(e);
+                            const auto k = static_cast<std::uint32_t>(key);
+                            tables[key][recent][s][e] = AutoRestartTransition{
+                                determineNewState(k, state, event),
+                                determineAction(k, recent != 0, state, event)
+                            };
+                        }
+                    }
+                }
+            }
+            return tables;
+        }
+
+    } // namespace detail
+
+    // Defined (and constant-initialized) in AutoRestartStateMachine.cpp.
+    extern const AutoRestartTransitionTables kAutoRestartTransitionTables;
+
+} // namespace pomodoro
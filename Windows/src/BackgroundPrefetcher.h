@@ -0,0 +1,195 @@
+#pragma once
+
+// Ahead-of-time selection and decoding of the next rest background.
+//
+// The overlay rotates through the configured backgrounds: starting at a cursor, entries with an empty
+// path are skipped, and an entry whose decode fails (an unreadable image) is skipped as well. The first
+// usable entry is shown, and the cursor moves past it. Decoding an image or a video poster frame takes
+// tens to hundreds of milliseconds. Doing it when the pomodoro ends delays the overlay, so the owner
+// calls prefetch() shortly before (for example in the last minute of a pomodoro). A worker thread then
+// runs the same rotation and keeps the decoded result.
+//
+// At rest start take() returns the prepared result when it was computed for the same entry list and
+// cursor. If that decode is still running, take() waits for it. Without a matching prefetch (settings
+// changed, or no prefetch was requested), it decodes now. A newer request makes the worker abandon a
+// stale one between candidates. A decode call itself is never interrupted.
+//
+// Portable C++17; Decoded is the platform's decoded payload (GDI+ bitmaps on Windows) and must be
+// default-constructible and movable.
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pomodoro {
+
+    struct BackgroundEntry {
+        std::wstring path;
+        bool video{ false };
+        double playbackRate{ 1.0 };
+
+        friend bool operator==(const BackgroundEntry& a, const BackgroundEntry& b) noexcept {
+            return a.video == b.video && a.playbackRate == b.playbackRate && a.path == b.path;
+        }
+        friend bool operator!=(const BackgroundEntry& a, const BackgroundEntry& b) noexcept { return !(a == b); }
+    };
+
+    template <typename Decoded>
+    class BackgroundPrefetcher {
+    public:
+        // 解码一个条目（在后台线程上调用）；返回 false 表示该条目不可用，轮换继续尝试下一个
+        using Decoder = std::function<bool(const BackgroundEntry& entry, Decoded& out)>;
+
+        struct Prepared {
+            std::size_t index{ 0 };       // 选中的条目
+            std::size_t nextCursor{ 0 };  // 下一次轮换的起点
+            BackgroundEntry entry;
+            Decoded decoded{};
+        };
+
+        explicit BackgroundPrefetcher(Decoder decoder)
+            : decoder_(std::move(decoder)), worker_([this] { run(); }) {
+        }
+
+        ~BackgroundPrefetcher() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_one();
+            worker_.join();
+        }
+
+        BackgroundPrefetcher(const BackgroundPrefetcher&) = delete;
+        BackgroundPrefetcher& operator=(const BackgroundPrefetcher&) = delete;
+
+        // 请求在后台准备从 cursor 开始的下一个可用背景；与排队、进行中或已完成的请求相同时什么都不做
+        void prefetch(std::vector<BackgroundEntry> entries, std::size_t cursor) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (knownLocked(entries, cursor)) return;
+                pending_ = Request{ std::move(entries), cursor };
+            }
+            wake_.notify_one();
+        }
+
+        // 取出与 (entries, cursor) 对应的结果并清空；没有可用条目时返回 nullopt
+        std::optional<Prepared> take(const std::vector<BackgroundEntry>& entries, std::size_t cursor) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // 进行中的请求在有新请求排队时会被放弃，此时需要重新排队
+            const bool coming = (done_ && matches(done_->request, entries, cursor)) ||
+                (pending_ && matches(*pending_, entries, cursor)) ||
+                (active_ && matches(*active_, entries, cursor) && !pending_);
+            if (!coming) {
+                pending_ = Request{ entries, cursor };
+                wake_.notify_one();
+            }
+            finished_.wait(lock, [&] { return done_ && matches(done_->request, entries, cursor); });
+            std::optional<Prepared> result = std::move(done_->prepared);
+            done_.reset();
+            return result;
+        }
+
+        // 与 (entries, cursor) 对应的结果已经就绪（take 不会等待）
+        bool ready(const std::vector<BackgroundEntry>& entries, std::size_t cursor) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return done_ && matches(done_->request, entries, cursor);
+        }
+
+        // 调用解码器的累计次数
+        std::size_t decodeCount() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return decodes_;
+        }
+
+    private:
+        struct Request {
+            std::vector<BackgroundEntry> entries;
+            std::size_t cursor{ 0 };
+        };
+
+        struct Done {
+            Request request;
+            std::optional<Prepared> prepared;
+        };
+
+        static bool matches(const Request& r, const std::vector<BackgroundEntry>& entries, std::size_t cursor) {
+            return r.cursor == cursor && r.entries == entries;
+        }
+
+        bool knownLocked(const std::vector<BackgroundEntry>& entries, std::size_t cursor) const {
+            return (pending_ && matches(*pending_, entries, cursor)) ||
+                (active_ && matches(*active_, entries, cursor)) ||
+                (done_ && matches(done_->request, entries, cursor));
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                wake_.wait(lock, [this] { return stop_ || pending_.has_value(); });
+                if (stop_) break;
+
+                active_ = std::move(pending_);
+                pending_.reset();
+                lock.unlock();
+
+                bool abandoned = false;
+                std::optional<Prepared> prepared = select(*active_, abandoned);
+
+                lock.lock();
+                if (!abandoned) {
+                    done_ = Done{ std::move(*active_), std::move(prepared) };
+                }
+                active_.reset();
+                finished_.notify_all();
+            }
+        }
+
+        // 与同步轮换相同的规则：游标越界时从头开始，跳过空路径与解码失败的条目，最多尝试一轮
+        std::optional<Prepared> select(const Request& request, bool& abandoned) {
+            const std::size_t n = request.entries.size();
+            const std::size_t start = request.cursor >= n ? 0 : request.cursor;
+            for (std::size_t attempt = 0; attempt < n; ++attempt) {
+                const std::size_t index = (start + attempt) % n;
+                const BackgroundEntry& entry = request.entries[index];
+                if (entry.path.empty()) continue;
+                {
+                    // 有更新的请求（设置变化）或正在退出时放弃剩余候选
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (stop_ || pending_) {
+                        abandoned = true;
+                        return std::nullopt;
+                    }
+                    ++decodes_;
+                }
+
+                Prepared prepared;
+                prepared.index = index;
+                prepared.nextCursor = (index + 1) % n;
+                prepared.entry = entry;
+                if (decoder_(entry, prepared.decoded)) return prepared;
+            }
+            return std::nullopt;
+        }
+
+        const Decoder decoder_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;      // 新请求或停止
+        std::condition_variable finished_;  // 一个请求处理完（或被放弃）
+        std::optional<Request> pending_;
+        std::optional<Request> active_;
+        std::optional<Done> done_;
+        std::size_t decodes_{ 0 };
+        bool stop_{ false };
+
+        std::thread worker_;  // 最后声明：其余成员初始化完成后才启动
+    };
+
+} // namespace pomodoro
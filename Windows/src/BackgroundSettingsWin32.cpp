@@ -2,9 +2,13 @@
 
 #include <windows.h>
 #include <shlobj.h>
+#include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
+#include "BackgroundsJson.h"
+
 #pragma comment(lib, "Shell32.lib")
 
 namespace {
@@ -15,166 +19,32 @@ namespace {
         return path.substr(pos + 1);
     }
 
-    // 非严格 JSON 转义，仅处理我们会用到的几个字符
-    std::wstring EscapeJsonString(const std::wstring& input) {
-        std::wstring out;
-        out.reserve(input.size());
-        for (wchar_t ch : input) {
-            switch (ch) {
-            case L'\\': out += L"\\\\"; break;
-            case L'"':  out += L"\\\""; break;
-            case L'\n': out += L"\\n";  break;
-            case L'\r': out += L"\\r";  break;
-            case L'\t': out += L"\\t";  break;
-            default:
-                out.push_back(ch);
-                break;
-            }
-        }
-        return out;
-    }
-
-    std::wstring UnescapeJsonString(const std::wstring& input) {
-        std::wstring out;
-        out.reserve(input.size());
-        for (std::size_t i = 0; i < input.size(); ++i) {
-            wchar_t ch = input[i];
-            if (ch == L'\\' && i + 1 < input.size()) {
-                wchar_t next = input[++i];
-                switch (next) {
-                case L'\\': out.push_back(L'\\'); break;
-                case L'"':  out.push_back(L'"');  break;
-                case L'n':  out.push_back(L'\n'); break;
-                case L'r':  out.push_back(L'\r'); break;
-                case L't':  out.push_back(L'\t'); break;
-                default:
-                    out.push_back(next);
-                    break;
-                }
-            } else {
-                out.push_back(ch);
-            }
-        }
-        return out;
-    }
-
-    // 在 JSON 对象字符串中提取形如 "key": "value" 的字符串值
-    bool ExtractJsonStringField(const std::wstring& obj, const std::wstring& key, std::wstring& outValue) {
-        std::wstring pattern = L"\"" + key + L"\"";
-        auto keyPos = obj.find(pattern);
-        if (keyPos == std::wstring::npos) return false;
-
-        auto colonPos = obj.find(L':', keyPos + pattern.size());
-        if (colonPos == std::wstring::npos) return false;
-
-        auto quoteStart = obj.find(L'"', colonPos);
-        if (quoteStart == std::wstring::npos) return false;
-
-        std::wstring raw;
-        for (std::size_t i = quoteStart + 1; i < obj.size(); ++i) {
-            wchar_t ch = obj[i];
-            if (ch == L'\\' && i + 1 < obj.size()) {
-                raw.push_back(ch);
-                raw.push_back(obj[i + 1]);
-                ++i;
-            } else if (ch == L'"') {
-                break;
-            } else {
-                raw.push_back(ch);
-            }
-        }
-
-        outValue = UnescapeJsonString(raw);
-        return true;
+    // 数字固定使用 C 区域格式（小数点、无千位分隔），保证写出的是合法 JSON
+    void AppendNumber(std::wstring& out, double value) {
+        std::wostringstream text;
+        text.imbue(std::locale::classic());
+        text << value;
+        out += text.str();
     }
 
-    // 在 JSON 对象字符串中提取形如 "key": 1.23 的数字值
-    bool ExtractJsonDoubleField(const std::wstring& obj, const std::wstring& key, double& outValue) {
-        std::wstring pattern = L"\"" + key + L"\"";
-        auto keyPos = obj.find(pattern);
-        if (keyPos == std::wstring::npos) return false;
-
-        auto colonPos = obj.find(L':', keyPos + pattern.size());
-        if (colonPos == std::wstring::npos) return false;
-
-        auto start = obj.find_first_of(L"-0123456789", colonPos + 1);
-        if (start == std::wstring::npos) return false;
-
-        auto end = start;
-        while (end < obj.size() && (iswdigit(obj[end]) || obj[end] == L'.')) {
-            ++end;
-        }
-
-        std::wstring numStr = obj.substr(start, end - start);
-        wchar_t* endPtr = nullptr;
-        double value = std::wcstod(numStr.c_str(), &endPtr);
-        if (endPtr == numStr.c_str()) {
+    // 文本编码跟随系统区域设置（与读取时一致），支持中文路径
+    bool WriteJsonText(const std::filesystem::path& path, const std::wstring& json) {
+        std::wofstream out(path, std::ios::trunc);
+        if (!out.is_open()) {
             return false;
         }
-        outValue = value;
-        return true;
-    }
-
-    // 在 JSON 文本中提取形如 "key": 123 的整数值（非严格解析，满足本项目配置文件结构即可）
-    bool ExtractJsonIntFieldFromRoot(const std::wstring& json, const std::wstring& key, int& outValue) {
-        std::wstring pattern = L"\"" + key + L"\"";
-        auto keyPos = json.find(pattern);
-        if (keyPos == std::wstring::npos) return false;
-
-        auto colonPos = json.find(L':', keyPos + pattern.size());
-        if (colonPos == std::wstring::npos) return false;
-
-        auto start = json.find_first_of(L"-0123456789", colonPos + 1);
-        if (start == std::wstring::npos) return false;
-
-        auto end = start;
-        while (end < json.size() && iswdigit(json[end])) {
-            ++end;
-        }
-
-        std::wstring numStr = json.substr(start, end - start);
-        wchar_t* endPtr = nullptr;
-        long value = std::wcstol(numStr.c_str(), &endPtr, 10);
-        if (endPtr == numStr.c_str()) return false;
-
-        outValue = static_cast<int>(value);
-        return true;
-    }
-
-    // 在 JSON 文本中提取形如 "key": "value" 的字符串值（root 层）。
-    bool ExtractJsonStringFieldFromRoot(const std::wstring& json, const std::wstring& key, std::wstring& outValue) {
-        std::wstring pattern = L"\"" + key + L"\"";
-        auto keyPos = json.find(pattern);
-        if (keyPos == std::wstring::npos) return false;
-
-        auto colonPos = json.find(L':', keyPos + pattern.size());
-        if (colonPos == std::wstring::npos) return false;
-
-        auto quoteStart = json.find(L'"', colonPos);
-        if (quoteStart == std::wstring::npos) return false;
-
-        std::wstring raw;
-        for (std::size_t i = quoteStart + 1; i < json.size(); ++i) {
-            wchar_t ch = json[i];
-            if (ch == L'\\' && i + 1 < json.size()) {
-                raw.push_back(ch);
-                raw.push_back(json[i + 1]);
-                ++i;
-            } else if (ch == L'"') {
-                break;
-            } else {
-                raw.push_back(ch);
-            }
-        }
-
-        outValue = UnescapeJsonString(raw);
-        return true;
+        out.imbue(std::locale("", std::locale::all));
+        out << json;
+        out.flush();
+        return static_cast<bool>(out);
     }
 
 } // namespace
 
 namespace pomodoro {
 
+    BackgroundSettingsWin32::~BackgroundSettingsWin32() = default;
+
     std::wstring BackgroundSettingsWin32::DefaultConfigPath() {
         wchar_t appDataPath[MAX_PATH] = { 0 };
         if (SUCCEEDED(SHGetFolderPathW(nullptr, CSIDL_APPDATA, nullptr, SHGFP_TYPE_CURRENT, appDataPath))) {
@@ -189,6 +59,8 @@ namespace pomodoro {
     bool BackgroundSettingsWin32::loadFromFile(const std::wstring& filePath) {
         files_.clear();
         overlayMessage_.clear();
+        // 先取元数据再读内容：读取期间文件被改写时，记录的是旧版本，下次检查会再加载一次
+        fileStamp_ = readFileStamp(filePath);
 
         std::wifstream in(filePath);
         if (!in.is_open()) {
@@ -197,134 +69,133 @@ namespace pomodoro {
         }
         in.imbue(std::locale("", std::locale::all)); // 使用系统本地编码，支持中文路径
 
-        std::wstringstream buffer;
-        buffer << in.rdbuf();
-        const std::wstring json = buffer.str();
-
-        // 查找 "backgrounds": [ ... ] 段
-        const std::wstring key = L"\"backgrounds\"";
-        auto keyPos = json.find(key);
-        if (keyPos == std::wstring::npos) {
+        // 整个文件读入一个缓冲区，单遍解析；条目中的字符串以视图形式交给回调，只在构造 files_ 时复制一次
+        const std::wstring json((std::istreambuf_iterator<wchar_t>(in)), std::istreambuf_iterator<wchar_t>());
+
+        std::vector<BackgroundFileWin32> files;
+        BackgroundsJsonSettings parsed;
+        const bool valid = parseBackgroundsJson(json, parsed, [&files](const BackgroundJsonEntry& entry) {
+            std::wstring path(entry.path);
+            std::wstring name = entry.hasName ? std::wstring(entry.name) : ExtractFileName(path);
+            const BackgroundType type = entry.type == L"video" ? BackgroundType::Video : BackgroundType::Image;
+            const double rate = entry.playbackRate > 0.0 ? entry.playbackRate : 1.0;
+            files.push_back(BackgroundFileWin32{ std::move(path), type, std::move(name), rate });
+        });
+        if (!valid || !parsed.hasBackgrounds) {
             return false;
         }
+        files_ = std::move(files);
 
-        auto arrayStart = json.find(L'[', keyPos);
-        if (arrayStart == std::wstring::npos) {
-            return false;
-        }
-        auto arrayEnd = json.find(L']', arrayStart);
-        if (arrayEnd == std::wstring::npos || arrayEnd <= arrayStart) {
-            return false;
+        if (parsed.autoStartNextPomodoroAfterRest) {
+            autoStartNextPomodoroAfterRest_ = *parsed.autoStartNextPomodoroAfterRest;
         }
 
-        std::wstring arrayBody = json.substr(arrayStart + 1, arrayEnd - arrayStart - 1);
-
-        std::size_t pos = 0;
-        while (true) {
-            auto objStart = arrayBody.find(L'{', pos);
-            if (objStart == std::wstring::npos) break;
-            auto objEnd = arrayBody.find(L'}', objStart);
-            if (objEnd == std::wstring::npos) break;
-
-            std::wstring obj = arrayBody.substr(objStart, objEnd - objStart + 1);
-            pos = objEnd + 1;
-
-            std::wstring path, typeStr, name;
-            double rate = 1.0;
-
-            if (!ExtractJsonStringField(obj, L"path", path)) continue;
-            if (!ExtractJsonStringField(obj, L"type", typeStr)) continue;
-            if (!ExtractJsonStringField(obj, L"name", name)) {
-                name = ExtractFileName(path);
-            }
-            ExtractJsonDoubleField(obj, L"playbackRate", rate);
-            if (rate <= 0.0) rate = 1.0;
-
-            BackgroundType type = BackgroundType::Image;
-            if (typeStr == L"video") {
-                type = BackgroundType::Video;
-            }
-
-            files_.push_back(BackgroundFileWin32{ path, type, name, rate });
+        // 分钟数按整数截断后限制在允许范围内
+        if (parsed.pomodoroMinutes) {
+            const double minutes = *parsed.pomodoroMinutes;
+            pomodoroMinutes_ = minutes < 5 ? 5 : minutes > 120 ? 120 : static_cast<int>(minutes);
         }
-
-        // 解析可选的 autoStartNextPomodoroAfterRest 字段
-        auto parseBoolField = [&](const std::wstring& key, bool& outValue) {
-            std::wstring boolKey = L"\"" + key + L"\"";
-            auto boolPos = json.find(boolKey);
-            if (boolPos == std::wstring::npos) return false;
-            auto colonPos = json.find(L':', boolPos + boolKey.size());
-            if (colonPos == std::wstring::npos) return false;
-            auto valueStart = json.find_first_not_of(L" \t\r\n", colonPos + 1);
-            if (valueStart == std::wstring::npos) return false;
-            if (json.compare(valueStart, 4, L"true") == 0) {
-                outValue = true;
-                return true;
-            }
-            if (json.compare(valueStart, 5, L"false") == 0) {
-                outValue = false;
-                return true;
-            }
-            return false;
-        };
-
-        parseBoolField(L"autoStartNextPomodoroAfterRest", autoStartNextPomodoroAfterRest_);
-
-        // 解析可选的 pomodoroMinutes 字段
-        int pomodoroMinutes = pomodoroMinutes_;
-        if (ExtractJsonIntFieldFromRoot(json, L"pomodoroMinutes", pomodoroMinutes)) {
-            if (pomodoroMinutes < 5) pomodoroMinutes = 5;
-            if (pomodoroMinutes > 120) pomodoroMinutes = 120;
-            pomodoroMinutes_ = pomodoroMinutes;
+        if (parsed.breakMinutes) {
+            const double minutes = *parsed.breakMinutes;
+            breakMinutes_ = minutes < 1 ? 1 : minutes > 30 ? 30 : static_cast<int>(minutes);
         }
 
-        // 解析可选的 breakMinutes 字段（短休息分钟）
-        int breakMinutes = breakMinutes_;
-        if (ExtractJsonIntFieldFromRoot(json, L"breakMinutes", breakMinutes)) {
-            if (breakMinutes < 1) breakMinutes = 1;
-            if (breakMinutes > 30) breakMinutes = 30;
-            breakMinutes_ = breakMinutes;
+        if (parsed.overlayMessage) {
+            overlayMessage_ = std::move(*parsed.overlayMessage);
         }
 
-        // 解析可选的 overlayMessage 字段
-        ExtractJsonStringFieldFromRoot(json, L"overlayMessage", overlayMessage_);
-
         return true;
     }
 
     bool BackgroundSettingsWin32::saveToFile(const std::wstring& filePath) const {
-        std::wofstream out(filePath, std::ios::trunc);
-        if (!out.is_open()) {
+        // 后台写入与这里使用同一个临时文件，先等它完成
+        if (writer_) {
+            writer_->flush();
+        }
+        const std::wstring json = toJson();
+        if (!writeFileAtomically(filePath, [&json](const std::filesystem::path& temp) { return WriteJsonText(temp, json); })) {
             return false;
         }
-        out.imbue(std::locale("", std::locale::all));
 
-        out << L"{\n  \"backgrounds\": [\n";
+        fileStamp_ = readFileStamp(filePath);
+        return true;
+    }
+
+    void BackgroundSettingsWin32::scheduleSave(const std::wstring& filePath) {
+        if (!writer_ || writer_->path() != std::filesystem::path(filePath)) {
+            writer_.reset(); // 析构时写出旧路径上尚未落盘的内容
+            writer_ = std::make_unique<DebouncedFileWriter>(filePath);
+        }
+        writer_->submit([json = toJson()](const std::filesystem::path& temp) { return WriteJsonText(temp, json); });
+    }
+
+    void BackgroundSettingsWin32::flushPendingSave() {
+        if (writer_) {
+            writer_->flush();
+        }
+    }
+
+    std::wstring BackgroundSettingsWin32::toJson() const {
+        std::wstring out = L"{\n  \"backgrounds\": [\n";
 
         for (std::size_t i = 0; i < files_.size(); ++i) {
             const auto& file = files_[i];
-            std::wstring typeStr = (file.type == BackgroundType::Image) ? L"image" : L"video";
-
-            out << L"    { "
-                << L"\"path\": \"" << EscapeJsonString(file.path) << L"\", "
-                << L"\"type\": \"" << typeStr << L"\", "
-                << L"\"name\": \"" << EscapeJsonString(file.name) << L"\", "
-                << L"\"playbackRate\": " << file.playbackRate
-                << L" }";
+            out += L"    { \"path\": \"";
+            appendJsonEscaped(out, file.path);
+            out += L"\", \"type\": \"";
+            out += (file.type == BackgroundType::Image) ? L"image" : L"video";
+            out += L"\", \"name\": \"";
+            appendJsonEscaped(out, file.name);
+            out += L"\", \"playbackRate\": ";
+            AppendNumber(out, file.playbackRate);
+            out += L" }";
 
             if (i + 1 < files_.size()) {
-                out << L",";
+                out += L",";
+            }
+            out += L"\n";
+        }
+
+        out += L"  ],\n";
+        out += L"  \"pomodoroMinutes\": " + std::to_wstring(pomodoroMinutes_) + L",\n";
+        out += L"  \"breakMinutes\": " + std::to_wstring(breakMinutes_) + L",\n";
+        out += L"  \"autoStartNextPomodoroAfterRest\": ";
+        out += autoStartNextPomodoroAfterRest_ ? L"true" : L"false";
+        out += L",\n";
+        out += L"  \"overlayMessage\": \"";
+        appendJsonEscaped(out, overlayMessage_);
+        out += L"\"\n}\n";
+        return out;
+    }
+
+    bool BackgroundSettingsWin32::reloadIfChanged(const std::wstring& filePath) {
+        if (writer_) {
+            // 自己还有未写出的修改时内存中的版本最新；写完后记录自己写出的版本，不把它当成外部修改
+            if (writer_->busy()) {
+                return false;
+            }
+            if (const auto written = writer_->takeWrittenStamp()) {
+                fileStamp_ = *written;
             }
-            out << L"\n";
         }
 
-        out << L"  ],\n";
-        out << L"  \"pomodoroMinutes\": " << pomodoroMinutes_ << L",\n";
-        out << L"  \"breakMinutes\": " << breakMinutes_ << L",\n";
-        out << L"  \"autoStartNextPomodoroAfterRest\": " << (autoStartNextPomodoroAfterRest_ ? L"true" : L"false") << L",\n";
-        out << L"  \"overlayMessage\": \"" << EscapeJsonString(overlayMessage_) << L"\"\n";
-        out << L"}\n";
+        const FileStamp stamp = readFileStamp(filePath);
+        if (stamp == fileStamp_) {
+            return false;
+        }
 
+        BackgroundSettingsWin32 fresh;
+        if (!fresh.loadFromFile(filePath)) {
+            // 同一版本不再重复解析，直到文件再次变化
+            fileStamp_ = stamp;
+            return false;
+        }
+        files_ = std::move(fresh.files_);
+        autoStartNextPomodoroAfterRest_ = fresh.autoStartNextPomodoroAfterRest_;
+        pomodoroMinutes_ = fresh.pomodoroMinutes_;
+        breakMinutes_ = fresh.breakMinutes_;
+        overlayMessage_ = std::move(fresh.overlayMessage_);
+        fileStamp_ = fresh.fileStamp_;
         return true;
     }
 
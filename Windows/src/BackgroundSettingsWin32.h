@@ -1,8 +1,12 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "DebouncedFileWriter.h"
+#include "FileStamp.h"
+
 namespace pomodoro {
 
     // 与 macOS 端 BackgroundFile 结构对应的简化版本
@@ -22,6 +26,10 @@ namespace pomodoro {
     class BackgroundSettingsWin32 {
     public:
         BackgroundSettingsWin32() = default;
+        ~BackgroundSettingsWin32();
+
+        BackgroundSettingsWin32(const BackgroundSettingsWin32&) = delete;
+        BackgroundSettingsWin32& operator=(const BackgroundSettingsWin32&) = delete;
 
         // 返回默认配置文件路径（用户空间），例如：%APPDATA%\PomodoroScreen\backgrounds.json
         static std::wstring DefaultConfigPath();
@@ -29,9 +37,20 @@ namespace pomodoro {
         // 从给定路径加载配置（如果文件不存在则返回 false，但不会视为错误）
         bool loadFromFile(const std::wstring& filePath);
 
-        // 将当前配置保存到给定路径
+        // 将当前配置保存到给定路径（同步；写临时文件后重命名覆盖，中途崩溃不会留下半个文件）
         bool saveToFile(const std::wstring& filePath) const;
 
+        // 设置面板每次修改后调用：在当前线程序列化，由后台线程在修改停止一段时间后写出（同样是临时文件 + 重命名），
+        // 连续的修改（如拖动滑块）只写最后一次
+        void scheduleSave(const std::wstring& filePath);
+
+        // 等待尚未写出的保存完成
+        void flushPendingSave();
+
+        // 文件自上次加载 / 保存以来被外部修改过时重新加载，返回 true；未变化（只读取一次文件元数据）、
+        // 被删除或内容不合法时保留内存中的配置并返回 false
+        bool reloadIfChanged(const std::wstring& filePath);
+
         const std::vector<BackgroundFileWin32>& files() const { return files_; }
         std::vector<BackgroundFileWin32>& files() { return files_; }
 
@@ -53,11 +72,17 @@ namespace pomodoro {
         void setOverlayMessage(std::wstring value) { overlayMessage_ = std::move(value); }
 
     private:
+        std::wstring toJson() const;
+
         std::vector<BackgroundFileWin32> files_{};
         bool autoStartNextPomodoroAfterRest_{ true };
         int pomodoroMinutes_{ 25 };
         int breakMinutes_{ 1 };
         std::wstring overlayMessage_{};
+        // 最近一次加载或保存时配置文件的大小与修改时间；保存是 const 操作，但需要记录自己写出的版本
+        mutable FileStamp fileStamp_{};
+        // 第一次 scheduleSave 时创建（不修改设置就没有后台线程）
+        std::unique_ptr<DebouncedFileWriter> writer_{};
     };
 
 } // namespace pomodoro
@@ -0,0 +1,350 @@
+#include "BackgroundsJson.h"
+
+#include <charconv>
+
+namespace pomodoro {
+
+    namespace {
+
+        constexpr int kMaxDepth = 64;
+
+        int HexValue(wchar_t c) noexcept {
+            if (c >= L'0' && c <= L'9') return c - L'0';
+            if (c >= L'a' && c <= L'f') return c - L'a' + 10;
+            if (c >= L'A' && c <= L'F') return c - L'A' + 10;
+            return -1;
+        }
+
+        class Parser {
+        public:
+            Parser(std::wstring_view text, BackgroundsJsonSettings& settings,
+                const std::function<void(const BackgroundJsonEntry&)>& onEntry)
+                : text_(text), settings_(settings), onEntry_(onEntry) {
+            }
+
+            bool parseDocument() {
+                skipSpace();
+                if (!parseRoot()) return false;
+                skipSpace();
+                return pos_ == text_.size();
+            }
+
+        private:
+            // MARK: 词法
+
+            void skipSpace() noexcept {
+                while (pos_ < text_.size()) {
+                    const wchar_t c = text_[pos_];
+                    if (c != L' ' && c != L'\t' && c != L'\n' && c != L'\r' && c != 0xFEFF) break; // 兼容 BOM
+                    ++pos_;
+                }
+            }
+
+            bool consume(wchar_t c) noexcept {
+                skipSpace();
+                if (pos_ < text_.size() && text_[pos_] == c) {
+                    ++pos_;
+                    return true;
+                }
+                return false;
+            }
+
+            bool peek(wchar_t c) noexcept {
+                skipSpace();
+                return pos_ < text_.size() && text_[pos_] == c;
+            }
+
+            bool literal(std::wstring_view word) noexcept {
+                if (text_.substr(pos_, word.size()) != word) return false;
+                pos_ += word.size();
+                return true;
+            }
+
+            // 读取字符串：没有转义时返回输入的视图；有转义时解码到 scratch 并返回其视图
+            bool parseString(std::wstring_view& out, std::wstring& scratch) {
+                if (!consume(L'"')) return false;
+                const std::size_t start = pos_;
+                while (pos_ < text_.size()) {
+                    const wchar_t c = text_[pos_];
+                    if (c == L'"') {
+                        out = text_.substr(start, pos_ - start);
+                        ++pos_;
+                        return true;
+                    }
+                    if (c == L'\\') return decodeEscaped(start, out, scratch);
+                    if (static_cast<std::uint32_t>(c) < 0x20) return false;
+                    ++pos_;
+                }
+                return false;
+            }
+
+            bool decodeEscaped(std::size_t start, std::wstring_view& out, std::wstring& scratch) {
+                scratch.assign(text_.data() + start, pos_ - start);
+                while (pos_ < text_.size()) {
+                    const wchar_t c = text_[pos_++];
+                    if (c == L'"') {
+                        out = scratch;
+                        return true;
+                    }
+                    if (static_cast<std::uint32_t>(c) < 0x20) return false;
+                    if (c != L'\\') {
+                        scratch.push_back(c);
+                        continue;
+                    }
+                    if (pos_ >= text_.size()) return false;
+                    switch (text_[pos_++]) {
+                    case L'"': scratch.push_back(L'"'); break;
+                    case L'\\': scratch.push_back(L'\\'); break;
+                    case L'/': scratch.push_back(L'/'); break;
+                    case L'b': scratch.push_back(L'\b'); break;
+                    case L'f': scratch.push_back(L'\f'); break;
+                    case L'n': scratch.push_back(L'\n'); break;
+                    case L'r': scratch.push_back(L'\r'); break;
+                    case L't': scratch.push_back(L'\t'); break;
+                    case L'u': {
+                        std::uint32_t unit = 0;
+                        if (!parseHex4(unit)) return false;
+                        appendCodeUnit(scratch, unit);
+                        break;
+                    }
+                    default:
+                        return false;
+                    }
+                }
+                return false;
+            }
+
+            bool parseHex4(std::uint32_t& unit) noexcept {
+                if (text_.size() - pos_ < 4) return false;
+                unit = 0;
+                for (int i = 0; i < 4; ++i) {
+                    const int v = HexValue(text_[pos_++]);
+                    if (v < 0) return false;
+                    unit = unit * 16 + static_cast<std::uint32_t>(v);
+                }
+                return true;
+            }
+
+            void appendCodeUnit(std::wstring& out, std::uint32_t unit) {
+                if constexpr (sizeof(wchar_t) == 2) {
+                    out.push_back(static_cast<wchar_t>(unit));
+                } else {
+                    // 32 位 wchar_t：把代理对合成为一个码点
+                    if (unit >= 0xDC00 && unit <= 0xDFFF && !out.empty()) {
+                        const auto high = static_cast<std::uint32_t>(out.back());
+                        if (high >= 0xD800 && high <= 0xDBFF) {
+                            out.back() = static_cast<wchar_t>(0x10000 + ((high - 0xD800) << 10) + (unit - 0xDC00));
+                            return;
+                        }
+                    }
+                    out.push_back(static_cast<wchar_t>(unit));
+                }
+            }
+
+            bool parseNumber(double& value) {
+                skipSpace();
+                // JSON 数字只含 ASCII：先收窄再用 from_chars（与区域设置无关）
+                char digits[64];
+                std::size_t n = 0;
+                const std::size_t start = pos_;
+                if (pos_ < text_.size() && text_[pos_] == L'-') ++pos_;
+                const std::size_t intStart = pos_;
+                while (pos_ < text_.size() && text_[pos_] >= L'0' && text_[pos_] <= L'9') ++pos_;
+                if (pos_ == intStart || (text_[intStart] == L'0' && pos_ - intStart > 1)) return false;
+                if (pos_ < text_.size() && text_[pos_] == L'.') {
+                    const std::size_t fracStart = ++pos_;
+                    while (pos_ < text_.size() && text_[pos_] >= L'0' && text_[pos_] <= L'9') ++pos_;
+                    if (pos_ == fracStart) return false;
+                }
+                if (pos_ < text_.size() && (text_[pos_] == L'e' || text_[pos_] == L'E')) {
+                    ++pos_;
+                    if (pos_ < text_.size() && (text_[pos_] == L'+' || text_[pos_] == L'-')) ++pos_;
+                    const std::size_t expStart = pos_;
+                    while (pos_ < text_.size() && text_[pos_] >= L'0' && text_[pos_] <= L'9') ++pos_;
+                    if (pos_ == expStart) return false;
+                }
+                if (pos_ - start > sizeof(digits)) return false;
+                for (std::size_t i = start; i < pos_; ++i) digits[n++] = static_cast<char>(text_[i]);
+                const auto r = std::from_chars(digits, digits + n, value);
+                return r.ec == std::errc() || r.ec == std::errc::result_out_of_range;
+            }
+
+            // MARK: 结构
+
+            // 跳过任意值（未知字段）
+            bool skipValue(int depth) {
+                if (depth > kMaxDepth) return false;
+                skipSpace();
+                if (pos_ >= text_.size()) return false;
+                std::wstring_view ignored;
+                switch (text_[pos_]) {
+                case L'"':
+                    return parseString(ignored, scratch_[kScratchOther]);
+                case L'{':
+                    ++pos_;
+                    if (consume(L'}')) return true;
+                    do {
+                        if (!parseString(ignored, scratch_[kScratchOther]) || !consume(L':') || !skipValue(depth + 1)) return false;
+                    } while (consume(L','));
+                    return consume(L'}');
+                case L'[':
+                    ++pos_;
+                    if (consume(L']')) return true;
+                    do {
+                        if (!skipValue(depth + 1)) return false;
+                    } while (consume(L','));
+                    return consume(L']');
+                case L't':
+                    return literal(L"true");
+                case L'f':
+                    return literal(L"false");
+                case L'n':
+                    return literal(L"null");
+                default: {
+                    double number = 0;
+                    return parseNumber(number);
+                }
+                }
+            }
+
+            bool parseBool(std::optional<bool>& out) {
+                skipSpace();
+                if (literal(L"true")) {
+                    out = true;
+                    return true;
+                }
+                if (literal(L"false")) {
+                    out = false;
+                    return true;
+                }
+                return skipValue(1); // 类型不符：忽略该字段
+            }
+
+            bool parseOptionalNumber(std::optional<double>& out) {
+                skipSpace();
+                if (pos_ < text_.size() && (text_[pos_] == L'-' || (text_[pos_] >= L'0' && text_[pos_] <= L'9'))) {
+                    double v = 0;
+                    if (!parseNumber(v)) return false;
+                    out = v;
+                    return true;
+                }
+                return skipValue(1);
+            }
+
+            bool parseRoot() {
+                if (!consume(L'{')) return false;
+                if (consume(L'}')) return true;
+                do {
+                    std::wstring_view key;
+                    if (!parseString(key, scratch_[kScratchKey]) || !consume(L':')) return false;
+                    bool ok = true;
+                    if (key == L"backgrounds" && peek(L'[')) {
+                        settings_.hasBackgrounds = true;
+                        ok = parseBackgrounds();
+                    } else if (key == L"autoStartNextPomodoroAfterRest") {
+                        ok = parseBool(settings_.autoStartNextPomodoroAfterRest);
+                    } else if (key == L"pomodoroMinutes") {
+                        ok = parseOptionalNumber(settings_.pomodoroMinutes);
+                    } else if (key == L"breakMinutes") {
+                        ok = parseOptionalNumber(settings_.breakMinutes);
+                    } else if (key == L"overlayMessage" && peek(L'"')) {
+                        std::wstring_view message;
+                        ok = parseString(message, scratch_[kScratchOther]);
+                        if (ok) settings_.overlayMessage = std::wstring(message);
+                    } else {
+                        ok = skipValue(1);
+                    }
+                    if (!ok) return false;
+                } while (consume(L','));
+                return consume(L'}');
+            }
+
+            bool parseBackgrounds() {
+                if (!consume(L'[')) return false;
+                if (consume(L']')) return true;
+                do {
+                    if (peek(L'{')) {
+                        if (!parseEntry()) return false;
+                    } else if (!skipValue(2)) {
+                        return false;
+                    }
+                } while (consume(L','));
+                return consume(L']');
+            }
+
+            bool parseEntry() {
+                if (!consume(L'{')) return false;
+                BackgroundJsonEntry entry;
+                bool hasPath = false;
+                bool hasType = false;
+                if (!consume(L'}')) {
+                    do {
+                        std::wstring_view key;
+                        if (!parseString(key, scratch_[kScratchKey]) || !consume(L':')) return false;
+                        bool ok = true;
+                        if (key == L"path" && peek(L'"')) {
+                            ok = parseString(entry.path, scratch_[kScratchPath]);
+                            hasPath = true;
+                        } else if (key == L"type" && peek(L'"')) {
+                            ok = parseString(entry.type, scratch_[kScratchType]);
+                            hasType = true;
+                        } else if (key == L"name" && peek(L'"')) {
+                            ok = parseString(entry.name, scratch_[kScratchName]);
+                            entry.hasName = true;
+                        } else if (key == L"playbackRate") {
+                            std::optional<double> rate;
+                            ok = parseOptionalNumber(rate);
+                            if (rate) entry.playbackRate = *rate;
+                        } else {
+                            ok = skipValue(3);
+                        }
+                        if (!ok) return false;
+                    } while (consume(L','));
+                    if (!consume(L'}')) return false;
+                }
+                // 与旧实现一致：缺少 path 或 type 的条目忽略
+                if (hasPath && hasType) onEntry_(entry);
+                return true;
+            }
+
+            enum Scratch { kScratchKey, kScratchPath, kScratchType, kScratchName, kScratchOther, kScratchCount };
+
+            std::wstring_view text_;
+            std::size_t pos_{ 0 };
+            BackgroundsJsonSettings& settings_;
+            const std::function<void(const BackgroundJsonEntry&)>& onEntry_;
+            std::wstring scratch_[kScratchCount];
+        };
+
+    } // namespace
+
+    bool parseBackgroundsJson(std::wstring_view json, BackgroundsJsonSettings& settings,
+        const std::function<void(const BackgroundJsonEntry&)>& onEntry) {
+        settings = BackgroundsJsonSettings{};
+        Parser parser(json, settings, onEntry);
+        return parser.parseDocument();
+    }
+
+    void appendJsonEscaped(std::wstring& out, std::wstring_view text) {
+        static constexpr wchar_t kHex[] = L"0123456789abcdef";
+        for (const wchar_t c : text) {
+            switch (c) {
+            case L'"': out += L"\\\""; break;
+            case L'\\': out += L"\\\\"; break;
+            case L'\n': out += L"\\n"; break;
+            case L'\r': out += L"\\r"; break;
+            case L'\t': out += L"\\t"; break;
+            default:
+                if (static_cast<std::uint32_t>(c) < 0x20) {
+                    out += L"\\u00";
+                    out.push_back(kHex[(c >> 4) & 0xF]);
+                    out.push_back(kHex[c & 0xF]);
+                } else {
+                    out.push_back(c);
+                }
+                break;
+            }
+        }
+    }
+
+} // namespace pomodoro
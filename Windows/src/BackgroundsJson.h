@@ -0,0 +1,51 @@
+#pragma once
+
+// Single-pass reader / escaping helper for the backgrounds.json settings file written by
+// BackgroundSettingsWin32::saveToFile.
+//
+// The previous loader searched the whole text once per key, copied every object with substr and took
+// an object to end at the next `}` (a `}` or `]` inside a path broke it). This tokenizer walks the
+// decoded text once and only looks at keys where they belong: root keys at the root, entry keys
+// inside the objects of the root "backgrounds" array. Unknown keys and values of any shape are
+// skipped. Strings are returned as views into the input; only a string that contains escapes is
+// decoded, into a scratch buffer the parser reuses.
+//
+// The text is the file decoded to wide characters (UTF-16 on Windows), so \uXXXX escapes are emitted
+// as UTF-16 code units where wchar_t is 16 bits and as code points (surrogate pairs combined)
+// elsewhere.
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace pomodoro {
+
+    // 一个背景条目；视图只在 onEntry 回调期间有效
+    struct BackgroundJsonEntry {
+        std::wstring_view path;
+        std::wstring_view type;   // "image" / "video"
+        std::wstring_view name;
+        bool hasName{ false };
+        double playbackRate{ 1.0 };
+    };
+
+    // 根对象上的可选设置；文件中没有的字段保持为空
+    struct BackgroundsJsonSettings {
+        bool hasBackgrounds{ false };  // 是否有 "backgrounds" 数组
+        std::optional<bool> autoStartNextPomodoroAfterRest;
+        std::optional<double> pomodoroMinutes;
+        std::optional<double> breakMinutes;
+        std::optional<std::wstring> overlayMessage;
+    };
+
+    // 单遍解析。"backgrounds" 中每个同时有 path 与 type 的对象调用一次 onEntry（按文件顺序）。
+    // 文本不是合法 JSON（或嵌套超过 64 层）时返回 false；此前已回调的条目由调用方决定是否保留。
+    bool parseBackgroundsJson(std::wstring_view json, BackgroundsJsonSettings& settings,
+        const std::function<void(const BackgroundJsonEntry&)>& onEntry);
+
+    // 追加 JSON 字符串内容（不含两侧引号）：转义引号、反斜杠与全部控制字符
+    void appendJsonEscaped(std::wstring& out, std::wstring_view text);
+
+} // namespace pomodoro
@@ -0,0 +1,97 @@
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define POMODORO_SIMD_X86 1
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define POMODORO_SIMD_NEON 1
+#endif
+
+namespace pomodoro {
+
+    namespace {
+
+#if defined(POMODORO_SIMD_X86)
+        struct X86Features {
+            bool sse41{ false };
+            bool avx2{ false };
+        };
+
+        X86Features DetectX86() noexcept {
+            X86Features f;
+#if defined(_MSC_VER)
+            int regs[4] = { 0, 0, 0, 0 };
+            __cpuid(regs, 0);
+            const int maxLeaf = regs[0];
+            __cpuid(regs, 1);
+            f.sse41 = (regs[2] & (1 << 19)) != 0;
+            const bool osxsave = (regs[2] & (1 << 27)) != 0;
+            const bool avx = (regs[2] & (1 << 28)) != 0;
+            if (maxLeaf >= 7 && osxsave && avx) {
+                // 操作系统必须在上下文切换时保存 YMM 寄存器（XCR0 的 bit 1、2）
+                const unsigned long long xcr0 = _xgetbv(0);
+                __cpuidex(regs, 7, 0);
+                f.avx2 = (xcr0 & 0x6) == 0x6 && (regs[1] & (1 << 5)) != 0;
+            }
+#else
+            // libgcc 的检测已包含操作系统对 YMM 状态的支持
+            __builtin_cpu_init();
+            f.sse41 = __builtin_cpu_supports("sse4.1") != 0;
+            f.avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+            return f;
+        }
+
+        const X86Features& CachedX86() noexcept {
+            static const X86Features features = DetectX86();
+            return features;
+        }
+#endif
+
+    } // namespace
+
+    bool simdLevelSupported(SimdLevel level) noexcept {
+        switch (level) {
+        case SimdLevel::Scalar:
+            return true;
+#if defined(POMODORO_SIMD_X86)
+        case SimdLevel::Sse41:
+            return CachedX86().sse41;
+        case SimdLevel::Avx2:
+            return CachedX86().avx2;
+#endif
+#if defined(POMODORO_SIMD_NEON)
+        case SimdLevel::Neon:
+            return true; // ARM64 的基线指令集
+#endif
+        default:
+            return false;
+        }
+    }
+
+    SimdLevel bestSimdLevel() noexcept {
+        static const SimdLevel best = [] {
+            const SimdLevel preferred[] = { SimdLevel::Avx2, SimdLevel::Neon, SimdLevel::Sse41 };
+            for (SimdLevel level : preferred) {
+                if (simdLevelSupported(level)) return level;
+            }
+            return SimdLevel::Scalar;
+        }();
+        return best;
+    }
+
+    const char* simdLevelName(SimdLevel level) noexcept {
+        switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::Sse41: return "sse4.1";
+        case SimdLevel::Avx2: return "avx2";
+        case SimdLevel::Neon: return "neon";
+        }
+        return "unknown";
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,28 @@
+#pragma once
+
+// Runtime selection of the vector instruction set for the pixel kernels.
+//
+// Kernels for each instruction set live in their own translation units. Only those units are compiled
+// with the matching flags (-mavx2, /arch:AVX2 ...), so the rest of the program still runs on any CPU of
+// the target architecture. A kernel set is used only when it was compiled in (x86 builds get SSE4.1
+// and AVX2, ARM64 builds get NEON) and the running CPU supports it. Every level produces the same
+// results as the scalar reference, bit for bit.
+
+namespace pomodoro {
+
+    enum class SimdLevel {
+        Scalar,
+        Sse41,
+        Avx2,
+        Neon,
+    };
+
+    // 本构建包含该指令集的内核，且当前 CPU（与操作系统）支持它；Scalar 总是可用
+    bool simdLevelSupported(SimdLevel level) noexcept;
+
+    // 可用的最快指令集（首次调用时检测并缓存）
+    SimdLevel bestSimdLevel() noexcept;
+
+    const char* simdLevelName(SimdLevel level) noexcept;
+
+} // namespace pomodoro
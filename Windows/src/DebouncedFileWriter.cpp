@@ -0,0 +1,155 @@
+#include "DebouncedFileWriter.h"
+
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace pomodoro {
+
+    namespace {
+
+        // 把文件内容（以及元数据）写到磁盘，而不只是交给系统缓存
+        bool FlushToDisk(const std::filesystem::path& path) noexcept {
+#if defined(_WIN32)
+            HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return false;
+            const bool ok = FlushFileBuffers(file) != 0;
+            CloseHandle(file);
+            return ok;
+#else
+            const int fd = ::open(path.c_str(), O_WRONLY);
+            if (fd < 0) return false;
+            const bool ok = ::fsync(fd) == 0;
+            ::close(fd);
+            return ok;
+#endif
+        }
+
+        // POSIX 上重命名本身要等所在目录落盘才持久；NTFS 的元数据日志不需要这一步
+        void FlushDirectory(const std::filesystem::path& path) noexcept {
+#if !defined(_WIN32)
+            const auto dir = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+            const int fd = ::open(dir.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            ::fsync(fd);
+            ::close(fd);
+#else
+            (void)path;
+#endif
+        }
+
+    } // namespace
+
+    bool writeFileAtomically(const std::filesystem::path& path, const FileWriteFunction& write) {
+        auto temp = path;
+        temp += ".tmp";
+        std::error_code ec;
+        // 先让临时文件的内容落盘再重命名：否则断电后可能出现重命名已生效、内容却是空的或截断的文件
+        if (!write(temp) || !FlushToDisk(temp)) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        std::filesystem::rename(temp, path, ec);
+        if (ec) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        FlushDirectory(path);
+        return true;
+    }
+
+    DebouncedFileWriter::DebouncedFileWriter(std::filesystem::path path, Clock::duration quietPeriod, Clock::duration maxDelay)
+        : path_(std::move(path)), quietPeriod_(quietPeriod), maxDelay_(maxDelay) {
+        worker_ = std::thread([this] { run(); });
+    }
+
+    DebouncedFileWriter::~DebouncedFileWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        worker_.join();
+    }
+
+    void DebouncedFileWriter::submit(FileWriteFunction write) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto now = Clock::now();
+            if (!pending_) firstSubmit_ = now;
+            lastSubmit_ = now;
+            pending_ = std::move(write);
+        }
+        wake_.notify_one();
+    }
+
+    bool DebouncedFileWriter::flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!pending_ && !writing_) return lastOk_;
+        flushRequested_ = true;
+        wake_.notify_one();
+        idle_.wait(lock, [this] { return !pending_ && !writing_; });
+        return lastOk_;
+    }
+
+    bool DebouncedFileWriter::busy() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_ || writing_;
+    }
+
+    std::optional<FileStamp> DebouncedFileWriter::takeWrittenStamp() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::exchange(writtenStamp_, std::nullopt);
+    }
+
+    std::size_t DebouncedFileWriter::writeCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return writes_;
+    }
+
+    void DebouncedFileWriter::run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            if (!pending_) {
+                if (stop_) break;
+                wake_.wait(lock);
+                continue;
+            }
+            if (!flushRequested_ && !stop_) {
+                // 静默期结束或距本轮第一次提交已满 maxDelay 才写
+                const auto due = (std::min)(lastSubmit_ + quietPeriod_, firstSubmit_ + maxDelay_);
+                if (Clock::now() < due) {
+                    wake_.wait_until(lock, due);
+                    continue;
+                }
+            }
+
+            FileWriteFunction write = std::move(pending_);
+            pending_ = nullptr;
+            writing_ = true;
+            lock.unlock();
+
+            const bool ok = writeFileAtomically(path_, write);
+            const FileStamp stamp = ok ? readFileStamp(path_) : FileStamp{};
+
+            lock.lock();
+            writing_ = false;
+            lastOk_ = ok;
+            ++writes_;
+            if (ok) writtenStamp_ = stamp;
+            if (!pending_) {
+                flushRequested_ = false;
+                idle_.notify_all();
+            }
+        }
+    }
+
+} // namespace pomodoro
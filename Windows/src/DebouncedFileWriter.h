@@ -0,0 +1,85 @@
+#pragma once
+
+// Crash-safe, coalescing writer for small files that change in bursts (settings edited from sliders,
+// text boxes and list buttons).
+//
+// Every write goes to `<path>.tmp` first, is flushed to disk and is renamed over the target only if both
+// succeeded. A crash or power loss therefore leaves either the old file or the complete new one, never an
+// empty or truncated file. submit() only replaces the
+// pending content and returns. A worker thread writes the newest content once no new submission has
+// arrived for `quietPeriod`. If submissions keep coming, it writes after `maxDelay` at the latest, so a
+// long drag still reaches the disk. Serialization happens on the caller's thread; the worker only runs
+// the write function and the rename.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "FileStamp.h"
+
+namespace pomodoro {
+
+    // 把完整内容写到给定的临时文件，返回是否成功
+    using FileWriteFunction = std::function<bool(const std::filesystem::path& tempPath)>;
+
+    // 同步版本：写临时文件、落盘（FlushFileBuffers / fsync）后重命名覆盖 path。保证的是持久性而不只是原子性：
+    // 返回 true 时新内容已在磁盘上，断电后不会回退成空文件。失败时删除临时文件，原文件保持不变
+    bool writeFileAtomically(const std::filesystem::path& path, const FileWriteFunction& write);
+
+    class DebouncedFileWriter {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit DebouncedFileWriter(std::filesystem::path path,
+            Clock::duration quietPeriod = std::chrono::milliseconds(500),
+            Clock::duration maxDelay = std::chrono::seconds(3));
+        // 写出尚未落盘的内容后停止后台线程
+        ~DebouncedFileWriter();
+
+        DebouncedFileWriter(const DebouncedFileWriter&) = delete;
+        DebouncedFileWriter& operator=(const DebouncedFileWriter&) = delete;
+
+        const std::filesystem::path& path() const noexcept { return path_; }
+
+        // 替换待写内容（之前未写出的版本直接丢弃），不等待
+        void submit(FileWriteFunction write);
+
+        // 立即写出待写内容并等待完成；返回最近一次写入是否成功（从未写过时为 true）
+        bool flush();
+
+        // 有待写或正在写的内容
+        bool busy() const;
+
+        // 最近一次成功写入后目标文件的大小与修改时间（取走后清空），用于区分自己的写入和外部修改
+        std::optional<FileStamp> takeWrittenStamp();
+
+        std::size_t writeCount() const;
+
+    private:
+        void run();
+
+        const std::filesystem::path path_;
+        const Clock::duration quietPeriod_;
+        const Clock::duration maxDelay_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;   // 新内容、flush 或停止
+        std::condition_variable idle_;   // 没有待写内容
+        FileWriteFunction pending_;
+        Clock::time_point firstSubmit_{};  // 本轮第一次提交（maxDelay 从这里算起）
+        Clock::time_point lastSubmit_{};
+        bool writing_{ false };
+        bool flushRequested_{ false };
+        bool stop_{ false };
+        bool lastOk_{ true };
+        std::size_t writes_{ 0 };
+        std::optional<FileStamp> writtenStamp_;
+        std::thread worker_;
+    };
+
+} // namespace pomodoro
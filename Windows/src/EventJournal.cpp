@@ -0,0 +1,220 @@
+#include "EventJournal.h"
+
+#include "AutoRestartTransitionTable.h"
+#include "TimerSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace pomodoro {
+
+    struct EventJournal::Header {
+        static constexpr std::uint32_t kMagic = 0x4C4A4D50u; // "PMJL"
+        static constexpr std::uint16_t kVersion = 1;
+
+        std::uint32_t magic{ kMagic };
+        std::uint16_t version{ kVersion };
+        std::uint16_t recordSize{ static_cast<std::uint16_t>(sizeof(JournalRecord)) };
+        std::uint64_t committedRecords{ 0 };  // 最近一次组提交时的记录数
+        std::int64_t createdUnixMs{ 0 };
+        std::uint8_t reserved[40]{};
+    };
+
+    namespace {
+
+        constexpr std::size_t kHeaderSize = 64;
+
+        bool IsValidRecord(const JournalRecord& r) noexcept {
+            return (r.flags & JournalRecord::kFlagValid) != 0;
+        }
+
+        // Header 是私有类型，这里按模板参数推导，不直接点名
+        template <typename HeaderT>
+        bool IsCompatibleHeader(const HeaderT& h) noexcept {
+            return h.magic == HeaderT::kMagic && h.version == HeaderT::kVersion && h.recordSize == sizeof(JournalRecord);
+        }
+
+    } // namespace
+
+    EventJournal::~EventJournal() {
+        close();
+    }
+
+    bool EventJournal::open(const std::filesystem::path& path) {
+        return open(path, Options{});
+    }
+
+    bool EventJournal::open(const std::filesystem::path& path, const Options& options) {
+        close();
+        options_ = options;
+        if (options_.groupCommitRecords == 0) options_.groupCommitRecords = 1;
+        if (options_.initialCapacity == 0) options_.initialCapacity = 1;
+
+        std::error_code ec;
+        const auto existingSize = std::filesystem::exists(path, ec) ? std::filesystem::file_size(path, ec) : 0;
+        if (ec) return false;
+
+        // 先只读校验已有文件，避免映射（并扩展）一个不认识的文件
+        if (existingSize > 0) {
+            Header h;
+            std::ifstream in(path, std::ios::binary);
+            if (existingSize < kHeaderSize || !in.read(reinterpret_cast<char*>(&h), sizeof(h)) || !IsCompatibleHeader(h)) {
+                return false;
+            }
+        }
+
+        path_ = path;
+        const std::size_t existingRecords = existingSize > kHeaderSize
+            ? static_cast<std::size_t>((existingSize - kHeaderSize) / sizeof(JournalRecord)) : 0;
+        if (!mapCapacity((std::max)(existingRecords, options_.initialCapacity))) return false;
+
+        Header* h = header();
+        if (existingSize == 0) {
+            *h = Header{};
+            h->createdUnixMs = currentUnixMillis();
+        }
+
+        // 已提交的部分直接信任；之后的尾部（进程崩溃前写入但未提交）逐条扫描到第一个空位为止
+        committed_ = static_cast<std::size_t>((std::min<std::uint64_t>)(h->committedRecords, capacity_));
+        count_ = committed_;
+        const JournalRecord* all = records();
+        while (count_ < capacity_ && IsValidRecord(all[count_])) ++count_;
+        commit();
+
+        sessionStartPending_ = true;
+        anchorTime(SteadyClock::instance().now(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        lastCommit_ = {}; // 由第一次 commitIfDue 按调用方的时钟建立
+        return true;
+    }
+
+    void EventJournal::close() {
+        if (!file_.isOpen()) return;
+        commit();
+        file_.close();
+        capacity_ = 0;
+        count_ = 0;
+        committed_ = 0;
+    }
+
+    void EventJournal::anchorTime(MonotonicClock::time_point monotonic, std::int64_t unixNs) noexcept {
+        monotonicAnchor_ = monotonic;
+        unixNsAnchor_ = unixNs;
+    }
+
+    void EventJournal::append(const AutoRestartTransitionRecord& transition) noexcept {
+        if (!file_.isOpen()) return;
+        if (count_ == capacity_ && !grow()) {
+            ++dropped_;
+            return;
+        }
+
+        JournalRecord r;
+        r.unixNs = unixNsAnchor_ +
+            std::chrono::duration_cast<std::chrono::nanoseconds>(transition.at - monotonicAnchor_).count();
+        r.event = static_cast<std::uint8_t>(transition.event);
+        r.oldState = static_cast<std::uint8_t>(transition.oldState);
+        r.newState = static_cast<std::uint8_t>(transition.newState);
+        r.action = static_cast<std::uint8_t>(transition.action);
+        r.tableKey = transition.tableKey;
+        r.flags = JournalRecord::kFlagValid
+            | (transition.recentlyResumedByScreensaver ? JournalRecord::kFlagRecentResume : 0)
+            | (sessionStartPending_ ? JournalRecord::kFlagSessionStart : 0);
+        sessionStartPending_ = false;
+
+        std::memcpy(file_.data() + kHeaderSize + count_ * sizeof(JournalRecord), &r, sizeof(r));
+        ++count_;
+        if (count_ - committed_ >= options_.groupCommitRecords) commit();
+    }
+
+    void EventJournal::commit() noexcept {
+        if (!file_.isOpen() || committed_ == count_) return;
+
+        const std::size_t firstDirty = kHeaderSize + committed_ * sizeof(JournalRecord);
+        header()->committedRecords = count_;
+        file_.flushAsync(firstDirty, (count_ - committed_) * sizeof(JournalRecord));
+        file_.flushAsync(0, kHeaderSize);
+        committed_ = count_;
+    }
+
+    void EventJournal::commitIfDue(MonotonicClock::time_point now) noexcept {
+        if (committed_ == count_) {
+            lastCommit_ = now; // 没有待提交记录时间隔从下一条记录开始算
+            return;
+        }
+        if (now - lastCommit_ < options_.groupCommitInterval) return;
+        commit();
+        lastCommit_ = now;
+    }
+
+    const JournalRecord* EventJournal::records() const noexcept {
+        return file_.isOpen() ? reinterpret_cast<const JournalRecord*>(file_.data() + kHeaderSize) : nullptr;
+    }
+
+    bool EventJournal::mapCapacity(std::size_t capacity) {
+        if (!file_.open(path_, kHeaderSize + capacity * sizeof(JournalRecord))) return false;
+        capacity_ = capacity;
+        return true;
+    }
+
+    bool EventJournal::grow() noexcept {
+        // 重新映射前先提交：扩展失败时已写入的记录仍然完整
+        commit();
+        if (mapCapacity(capacity_ * 2)) return true;
+        // 扩展失败时尽量恢复原映射，后续记录计入 dropped_
+        const std::size_t previous = capacity_;
+        if (!mapCapacity(previous)) {
+            capacity_ = 0;
+            count_ = 0;
+            committed_ = 0;
+        }
+        return false;
+    }
+
+    EventJournal::Header* EventJournal::header() noexcept {
+        static_assert(sizeof(Header) == kHeaderSize, "journal header layout is part of the file format");
+        return reinterpret_cast<Header*>(file_.data());
+    }
+
+    std::vector<JournalRecord> EventJournal::readAll(const std::filesystem::path& path) {
+        std::vector<JournalRecord> out;
+        std::ifstream in(path, std::ios::binary);
+        Header h;
+        if (!in.read(reinterpret_cast<char*>(&h), sizeof(h)) || !IsCompatibleHeader(h)) return out;
+        in.seekg(static_cast<std::streamoff>(kHeaderSize));
+
+        JournalRecord r;
+        std::uint64_t index = 0;
+        while (in.read(reinterpret_cast<char*>(&r), sizeof(r))) {
+            // 已提交部分之后以第一个空位为尾
+            if (index >= h.committedRecords && !IsValidRecord(r)) break;
+            out.push_back(r);
+            ++index;
+        }
+        return out;
+    }
+
+    std::size_t findJournalDivergence(const JournalRecord* records, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            const JournalRecord& r = records[i];
+            if (!IsValidRecord(r) || r.oldState >= kAutoRestartStateCount || r.newState >= kAutoRestartStateCount ||
+                r.event >= kAutoRestartEventCount) {
+                return i;
+            }
+            const std::size_t recent = (r.flags & JournalRecord::kFlagRecentResume) ? 1 : 0;
+            const auto& t = kAutoRestartTransitionTables[r.tableKey][recent][r.oldState][r.event];
+            if (static_cast<std::uint8_t>(t.newState) != r.newState || static_cast<std::uint8_t>(t.action) != r.action) {
+                return i;
+            }
+            // 新会话（进程重启、快照恢复）的起点不要求与上一条衔接
+            if (i > 0 && !(r.flags & JournalRecord::kFlagSessionStart) && records[i - 1].newState != r.oldState) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,115 @@
+#pragma once
+
+// Append-only, memory-mapped journal of every AutoRestartStateMachine transition.
+//
+// Each processEvent call becomes one fixed 16-byte JournalRecord (timestamp, event, old/new state,
+// action, table key) written straight into a mapped file, so the hot path is a memcpy plus a counter
+// increment. Durability is group-committed: the header's committed count is published and the dirty
+// pages are handed to the OS every `groupCommitRecords` records, on close, or when the host calls
+// commitIfDue(). Records written after the last commit still sit in the page cache, so a process crash
+// loses nothing; open() recovers that tail by scanning for valid records.
+//
+// The journal is the raw input for statistics, debugging and replay: findJournalDivergence() re-runs
+// every record against the compiled transition tables and reports the first one that does not match.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <type_traits>
+#include <vector>
+
+#include "AutoRestartStateMachine.h"
+#include "MappedFile.h"
+#include "MonotonicClock.h"
+
+namespace pomodoro {
+
+    struct JournalRecord {
+        static constexpr std::uint8_t kFlagValid = 1u << 0;         // 已写入的记录（文件中未写区域全为 0）
+        static constexpr std::uint8_t kFlagRecentResume = 1u << 1;  // 查表时“屏保刚恢复”为真
+        static constexpr std::uint8_t kFlagSessionStart = 1u << 2;  // 进程打开日志后的第一条记录
+
+        std::int64_t unixNs{ 0 };     // 单调时钟换算到墙钟的时间（同一会话内单调递增）
+        std::uint8_t event{ 0 };      // AutoRestartEvent
+        std::uint8_t oldState{ 0 };   // AutoRestartState
+        std::uint8_t newState{ 0 };   // AutoRestartState
+        std::uint8_t action{ 0 };     // AutoRestartAction
+        std::uint8_t tableKey{ 0 };
+        std::uint8_t flags{ 0 };
+        std::uint16_t reserved{ 0 };
+    };
+
+    static_assert(std::is_trivially_copyable_v<JournalRecord>, "JournalRecord is copied byte-for-byte");
+    static_assert(sizeof(JournalRecord) == 16, "JournalRecord layout is part of the file format");
+
+    class EventJournal final : public AutoRestartTransitionSink {
+    public:
+        struct Options {
+            std::size_t groupCommitRecords{ 256 };                    // 每累计这么多条提交一次
+            std::chrono::milliseconds groupCommitInterval{ 2000 };    // commitIfDue 的最长提交间隔
+            std::size_t initialCapacity{ 4096 };                      // 新文件预留的记录数，写满后按倍数扩展
+        };
+
+        EventJournal() = default;
+        ~EventJournal() override;
+
+        EventJournal(const EventJournal&) = delete;
+        EventJournal& operator=(const EventJournal&) = delete;
+
+        // 打开（不存在则创建）日志文件并定位到末尾；格式不符时返回 false 且不修改文件
+        bool open(const std::filesystem::path& path);
+        bool open(const std::filesystem::path& path, const Options& options);
+        // 提交并关闭
+        void close();
+        bool isOpen() const noexcept { return file_.isOpen(); }
+
+        // 单调时钟与墙钟的对应关系；open() 以 SteadyClock 与 system_clock 的当前时刻建立，
+        // 使用 VirtualClock 的测试/模拟器可以重新指定
+        void anchorTime(MonotonicClock::time_point monotonic, std::int64_t unixNs) noexcept;
+
+        // 热路径：一次 16 字节写入；满 groupCommitRecords 条时顺带提交
+        void append(const AutoRestartTransitionRecord& transition) noexcept;
+        void onTransition(const AutoRestartTransitionRecord& transition) override { append(transition); }
+
+        // 发布已写入的记录数并请求异步写回
+        void commit() noexcept;
+        // 主循环每次醒来时调用：有未提交记录且距上次提交超过 groupCommitInterval 时提交
+        void commitIfDue(MonotonicClock::time_point now) noexcept;
+
+        std::size_t size() const noexcept { return count_; }
+        std::size_t committedSize() const noexcept { return committed_; }
+        const JournalRecord* records() const noexcept;
+        // 扩展文件失败而丢弃的记录数
+        std::uint64_t droppedRecords() const noexcept { return dropped_; }
+
+        // 读取现有日志（包含最后一次提交之后仍然完整的尾部），供统计、调试与回放使用
+        static std::vector<JournalRecord> readAll(const std::filesystem::path& path);
+
+    private:
+        struct Header;
+
+        bool mapCapacity(std::size_t capacity);
+        bool grow() noexcept;
+        Header* header() noexcept;
+
+        MappedFile file_;
+        std::filesystem::path path_;
+        Options options_{};
+
+        std::size_t capacity_{ 0 };
+        std::size_t count_{ 0 };
+        std::size_t committed_{ 0 };
+        std::uint64_t dropped_{ 0 };
+        bool sessionStartPending_{ false };
+
+        MonotonicClock::time_point monotonicAnchor_{};
+        std::int64_t unixNsAnchor_{ 0 };
+        MonotonicClock::time_point lastCommit_{};
+    };
+
+    // 回放校验：逐条用编译期转换表重新计算（状态, 事件, 键, 屏保刚恢复）→（新状态, 动作），并检查同一会话内
+    // 每条记录的旧状态等于上一条的新状态。全部一致时返回 count，否则返回第一条不一致记录的下标。
+    std::size_t findJournalDivergence(const JournalRecord* records, std::size_t count) noexcept;
+
+} // namespace pomodoro
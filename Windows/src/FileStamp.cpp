@@ -0,0 +1,38 @@
+#include "FileStamp.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace pomodoro {
+
+    FileStamp readFileStamp(const std::filesystem::path& path) noexcept {
+        FileStamp stamp;
+#if defined(_WIN32)
+        // 一次 GetFileAttributesExW 同时取得类型、大小与修改时间
+        WIN32_FILE_ATTRIBUTE_DATA data{};
+        if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data)) return stamp;
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) return stamp;
+
+        stamp.exists = true;
+        stamp.size = (static_cast<std::uintmax_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        stamp.writeTime = static_cast<std::int64_t>(
+            (static_cast<std::uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime);
+#else
+        struct stat st {};
+        if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return stamp;
+
+        stamp.exists = true;
+        stamp.size = static_cast<std::uintmax_t>(st.st_size);
+#if defined(__APPLE__)
+        stamp.writeTime = static_cast<std::int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+        stamp.writeTime = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+#endif
+        return stamp;
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,27 @@
+#pragma once
+
+// Cheap change detection for small configuration files: size plus last-write time, read with a single
+// metadata query (GetFileAttributesExW on Windows, stat elsewhere). Two stamps compare equal when the
+// file has not been rewritten since the first one was taken, so a caller can keep the parsed contents
+// in memory and only re-read the file when its stamp moves.
+
+#include <cstdint>
+#include <filesystem>
+
+namespace pomodoro {
+
+    struct FileStamp {
+        bool exists{ false };
+        std::uintmax_t size{ 0 };
+        std::int64_t writeTime{ 0 };  // 平台原生的修改时间计数（FILETIME / 纳秒），只用于比较，不换算成日历时间
+
+        friend bool operator==(const FileStamp& a, const FileStamp& b) noexcept {
+            return a.exists == b.exists && a.size == b.size && a.writeTime == b.writeTime;
+        }
+        friend bool operator!=(const FileStamp& a, const FileStamp& b) noexcept { return !(a == b); }
+    };
+
+    // 文件不存在或无法访问时返回 exists = false
+    FileStamp readFileStamp(const std::filesystem::path& path) noexcept;
+
+} // namespace pomodoro
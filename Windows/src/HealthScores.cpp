@@ -0,0 +1,81 @@
+#include "HealthScores.h"
+
+#include <algorithm>
+
+namespace pomodoro {
+
+    namespace {
+
+        constexpr double kIdealPomodoros = 8.0;         // 理想的番茄钟数量
+        constexpr double kIdealBreakRatio = 0.25;       // 理想的休息/工作比例
+        constexpr std::int64_t kLongWorkMs = 8LL * 60 * 60 * 1000; // 超过 8 小时扣分
+
+    } // namespace
+
+    HealthScores computeHealthScores(const DailyStatistics& day, int breakMinutes) noexcept {
+        const double pomodoros = day.completedPomodoros;
+        const double cancelled = day.cancelledBreakCount;
+        const double workMs = static_cast<double>(day.totalWorkMs);
+        const double breakMs = static_cast<double>(day.totalBreakMs);
+
+        HealthScores s;
+
+        const double pomodoroScore = (std::min)(pomodoros / kIdealPomodoros, 1.0) * 50;
+        const double workBreakRatio = day.totalWorkMs > 0 ? breakMs / workMs : 0;
+        const double breakScore = (std::min)(workBreakRatio / kIdealBreakRatio, 1.0) * 30;
+        const double consistencyScore = day.cancelledBreakCount == 0 ? 20.0 : (std::max)(0.0, 20 - cancelled * 5);
+        s.workIntensity = pomodoroScore + breakScore + consistencyScore;
+
+        if (day.completedPomodoros > 0) {
+            // 休息时长设为 0 时 Swift 会除以 0；这里视为休息总是充足
+            const double expectedBreakMs = pomodoros * breakMinutes * 60'000.0;
+            s.restAdequacy = expectedBreakMs > 0 ? (std::min)(breakMs / expectedBreakMs, 1.0) * 100 : 100;
+
+            const double interruptionPenalty = (cancelled + day.screenLockCount) * 5;
+            s.focus = (std::max)(0.0, (std::min)(100.0, pomodoros * 10 - interruptionPenalty));
+        }
+
+        if (day.completedPomodoros > 0 || day.totalWorkMs > 0) {
+            double health = 100.0;
+            health -= day.stayUpLateCount * 20.0;  // 熬夜扣分
+            health -= cancelled * 5;               // 取消休息扣分
+            if (day.totalWorkMs > kLongWorkMs) health -= 20;
+            s.health = (std::max)(0.0, health);
+        } else {
+            s.health = 20; // 没有任何活动时返回较低的基础分数
+        }
+        return s;
+    }
+
+    HealthScoreTracker::HealthScoreTracker(int breakMinutes)
+        : breakMinutes_(breakMinutes) {
+        recompute();
+    }
+
+    void HealthScoreTracker::setBreakMinutes(int minutes) noexcept {
+        if (minutes == breakMinutes_) return;
+        breakMinutes_ = minutes;
+        recompute();
+    }
+
+    void HealthScoreTracker::update(const DailyStatistics& day) noexcept {
+        if (hasDay_ && day.dayIndex < day_.dayIndex) return;
+        day_ = day;
+        hasDay_ = true;
+        recompute();
+    }
+
+    HealthScores HealthScoreTracker::scoresFor(std::int32_t dayIndex) const noexcept {
+        if (hasDay_ && dayIndex == day_.dayIndex) return snapshot_.scores;
+        DailyStatistics empty;
+        empty.dayIndex = dayIndex;
+        return computeHealthScores(empty, breakMinutes_);
+    }
+
+    void HealthScoreTracker::recompute() noexcept {
+        snapshot_.dayIndex = day_.dayIndex;
+        snapshot_.scores = computeHealthScores(day_, breakMinutes_);
+        ++snapshot_.version;
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,61 @@
+#pragma once
+
+// Daily work-intensity / rest-adequacy / focus / health scores, the Windows counterpart of the computed
+// properties on the Swift DailyStatistics (StatisticsModels.swift).
+//
+// The Swift properties are re-evaluated from the stored row every time the report reads them. Here
+// HealthScoreTracker keeps today's counters and recomputes the four scores once per statistics event
+// (each score is a closed-form function of a handful of counters, so an update is O(1)); readers such
+// as the tray popup only copy the cached snapshot.
+//
+// Feed it with the day returned by StatisticsEngine::record() (null for rejected events):
+//     if (const auto* day = statistics.record(event)) healthScores.update(*day);
+
+#include <cstdint>
+
+#include "StatisticsModels.h"
+
+namespace pomodoro {
+
+    struct HealthScores {
+        double workIntensity{ 0 };  // 工作强度 (0-100)
+        double restAdequacy{ 0 };   // 休息充足度 (0-100)
+        double focus{ 0 };          // 专注度 (0-100)
+        double health{ 0 };         // 健康度 (0-100)
+    };
+
+    // 与 Swift 公式一致；breakMinutes 对应 SettingsStore.breakTimeMinutes
+    HealthScores computeHealthScores(const DailyStatistics& day, int breakMinutes) noexcept;
+
+    struct HealthScoreSnapshot {
+        std::int32_t dayIndex{ 0 };
+        HealthScores scores;
+        std::uint64_t version{ 0 };  // 每次分数重新计算后递增，读取方可据此跳过重绘
+    };
+
+    class HealthScoreTracker {
+    public:
+        explicit HealthScoreTracker(int breakMinutes = 5);
+
+        // 休息时长设置变化时重新计算当天的休息充足度
+        void setBreakMinutes(int minutes) noexcept;
+        int breakMinutes() const noexcept { return breakMinutes_; }
+
+        // 某天的汇总刚被更新（通常是 StatisticsEngine::record 的返回值）；早于当前跟踪日期的补录事件忽略
+        void update(const DailyStatistics& day) noexcept;
+
+        const HealthScoreSnapshot& snapshot() const noexcept { return snapshot_; }
+
+        // 指定日期的分数：跨日后当天还没有事件时返回空白日期的分数
+        HealthScores scoresFor(std::int32_t dayIndex) const noexcept;
+
+    private:
+        void recompute() noexcept;
+
+        DailyStatistics day_;
+        HealthScoreSnapshot snapshot_;
+        int breakMinutes_{ 5 };
+        bool hasDay_{ false };
+    };
+
+} // namespace pomodoro
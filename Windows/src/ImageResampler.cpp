@@ -0,0 +1,249 @@
+#include "ImageResampler.h"
+
+#include "ImageResamplerKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pomodoro {
+
+    namespace {
+
+        constexpr int kWeightBits = detail::kResampleWeightBits;
+        constexpr int kWeightOne = 1 << kWeightBits;
+        constexpr int kRound = 1 << (kWeightBits - 1);
+
+        double CubicWeight(double x) noexcept {
+            // Catmull-Rom: Keys 三次卷积，a = -0.5
+            constexpr double a = -0.5;
+            x = std::fabs(x);
+            if (x < 1.0) return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+            if (x < 2.0) return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+            return 0.0;
+        }
+
+        double Sinc(double x) noexcept {
+            if (x == 0.0) return 1.0;
+            x *= 3.14159265358979323846;
+            return std::sin(x) / x;
+        }
+
+        double Lanczos3Weight(double x) noexcept {
+            x = std::fabs(x);
+            return x < 3.0 ? Sinc(x) * Sinc(x / 3.0) : 0.0;
+        }
+
+        double FilterSupport(ResampleFilter filter) noexcept {
+            return filter == ResampleFilter::Lanczos3 ? 3.0 : 2.0;
+        }
+
+        double FilterWeight(ResampleFilter filter, double x) noexcept {
+            return filter == ResampleFilter::Lanczos3 ? Lanczos3Weight(x) : CubicWeight(x);
+        }
+
+        // 一个方向上每个输出位置的起始源下标与 taps 个定点权重（不足 taps 的补 0）
+        struct Coefficients {
+            int taps{ 0 };
+            std::vector<int> first;
+            std::vector<std::int16_t> weights;  // size = outSize * taps
+        };
+
+        Coefficients ComputeCoefficients(double srcStart, double srcLength, int srcLimit, int outSize, ResampleFilter filter) {
+            const double scale = srcLength / outSize;
+            const double filterScale = (std::max)(scale, 1.0);  // 缩小时按比例放宽滤波器
+            const double support = FilterSupport(filter) * filterScale;
+
+            Coefficients c;
+            c.taps = (std::min)(static_cast<int>(std::ceil(support)) * 2 + 1, srcLimit);
+            c.first.resize(static_cast<std::size_t>(outSize));
+            c.weights.assign(static_cast<std::size_t>(outSize) * static_cast<std::size_t>(c.taps), 0);
+
+            std::vector<double> w(static_cast<std::size_t>(c.taps) + 1);
+            for (int i = 0; i < outSize; ++i) {
+                const double center = srcStart + (i + 0.5) * scale;
+                const int lo = (std::max)(static_cast<int>(std::floor(center - support + 0.5)), 0);
+                const int hi = (std::min)(static_cast<int>(std::floor(center + support + 0.5)), srcLimit);
+                const int count = (std::min)(hi - lo, c.taps);
+
+                double sum = 0.0;
+                for (int k = 0; k < count; ++k) {
+                    w[static_cast<std::size_t>(k)] = FilterWeight(filter, (lo + k - center + 0.5) / filterScale);
+                    sum += w[static_cast<std::size_t>(k)];
+                }
+                if (sum == 0.0) {
+                    // 所有候选都落在零点上（极端裁剪）：取最近的源像素
+                    for (int k = 0; k < count; ++k) w[static_cast<std::size_t>(k)] = 0.0;
+                    w[0] = 1.0;
+                    sum = 1.0;
+                }
+
+                // 贴近边界时整体右移，保证 first + taps 不越界；多出来的位置权重为 0
+                int first = lo;
+                int shift = 0;
+                if (first + c.taps > srcLimit) {
+                    shift = first + c.taps - srcLimit;
+                    first -= shift;
+                }
+                c.first[static_cast<std::size_t>(i)] = first;
+
+                std::int16_t* out = &c.weights[static_cast<std::size_t>(i) * static_cast<std::size_t>(c.taps)];
+                int total = 0;
+                int largest = shift;
+                for (int k = 0; k < count; ++k) {
+                    const int q = static_cast<int>(std::lround(w[static_cast<std::size_t>(k)] / sum * kWeightOne));
+                    out[shift + k] = static_cast<std::int16_t>(q);
+                    total += q;
+                    if (q > out[largest]) largest = shift + k;
+                }
+                // 舍入误差补到最大的权重上，使权重和恰好为 1.0（纯色区域保持不变）
+                out[largest] = static_cast<std::int16_t>(out[largest] + (kWeightOne - total));
+            }
+            return c;
+        }
+
+        const detail::ResampleKernels kScalarKernels{ detail::resampleHorizontalScalar, detail::resampleVerticalScalar };
+
+        const detail::ResampleKernels* KernelsFor(SimdLevel level) noexcept {
+            if (!simdLevelSupported(level)) return nullptr;
+            switch (level) {
+            case SimdLevel::Scalar: return &kScalarKernels;
+            case SimdLevel::Sse41: return detail::sse41ResampleKernels();
+            case SimdLevel::Avx2: return detail::avx2ResampleKernels();
+            case SimdLevel::Neon: return detail::neonResampleKernels();
+            }
+            return nullptr;
+        }
+
+        inline std::uint8_t ClampToByte(int acc) noexcept {
+            const int v = (acc + kRound) >> kWeightBits;
+            return static_cast<std::uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+
+    } // namespace
+
+    namespace detail {
+
+        void resampleHorizontalScalar(const std::uint8_t* src, std::uint8_t* out, const int* first,
+            const std::int16_t* weights, int taps, int outWidth) {
+            for (int x = 0; x < outWidth; ++x) {
+                const std::uint8_t* p = src + static_cast<std::ptrdiff_t>(first[x]) * 4;
+                const std::int16_t* w = weights + static_cast<std::ptrdiff_t>(x) * taps;
+                int b = 0, g = 0, r = 0, a = 0;
+                for (int k = 0; k < taps; ++k, p += 4) {
+                    b += p[0] * w[k];
+                    g += p[1] * w[k];
+                    r += p[2] * w[k];
+                    a += p[3] * w[k];
+                }
+                out[x * 4 + 0] = ClampToByte(b);
+                out[x * 4 + 1] = ClampToByte(g);
+                out[x * 4 + 2] = ClampToByte(r);
+                out[x * 4 + 3] = ClampToByte(a);
+            }
+        }
+
+        void resampleVerticalScalar(const std::uint8_t* const* rows, const std::int16_t* weights, int taps,
+            std::uint8_t* out, int xBegin, int xEnd) {
+            for (int i = xBegin * 4; i < xEnd * 4; i += 4) {
+                int b = 0, g = 0, r = 0, a = 0;
+                for (int k = 0; k < taps; ++k) {
+                    const std::uint8_t* p = rows[k] + i;
+                    b += p[0] * weights[k];
+                    g += p[1] * weights[k];
+                    r += p[2] * weights[k];
+                    a += p[3] * weights[k];
+                }
+                const std::uint8_t alpha = ClampToByte(a);
+                // 预乘 alpha：振铃不能让颜色分量超过 alpha
+                out[i + 0] = (std::min)(ClampToByte(b), alpha);
+                out[i + 1] = (std::min)(ClampToByte(g), alpha);
+                out[i + 2] = (std::min)(ClampToByte(r), alpha);
+                out[i + 3] = alpha;
+            }
+        }
+
+    } // namespace detail
+
+    FitGeometry computeFit(FitMode mode, int srcWidth, int srcHeight, int dstWidth, int dstHeight) noexcept {
+        FitGeometry g;
+        if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0) return g;
+
+        switch (mode) {
+        case FitMode::Cover: {
+            // 缩放比取 max(dstW / srcW, dstH / srcH)，等价于从源中居中裁出与目标同宽高比的区域
+            const double scale = (std::max)(static_cast<double>(dstWidth) / srcWidth, static_cast<double>(dstHeight) / srcHeight);
+            g.dstWidth = dstWidth;
+            g.dstHeight = dstHeight;
+            g.srcWidth = (std::min)(dstWidth / scale, static_cast<double>(srcWidth));
+            g.srcHeight = (std::min)(dstHeight / scale, static_cast<double>(srcHeight));
+            g.srcX = (srcWidth - g.srcWidth) * 0.5;
+            g.srcY = (srcHeight - g.srcHeight) * 0.5;
+            break;
+        }
+        case FitMode::Contain: {
+            // 缩放比取 min(...)：整张源图放进目标，目标矩形居中，两侧留边
+            const double scale = (std::min)(static_cast<double>(dstWidth) / srcWidth, static_cast<double>(dstHeight) / srcHeight);
+            g.dstWidth = std::clamp(static_cast<int>(std::lround(srcWidth * scale)), 1, dstWidth);
+            g.dstHeight = std::clamp(static_cast<int>(std::lround(srcHeight * scale)), 1, dstHeight);
+            g.dstX = (dstWidth - g.dstWidth) / 2;
+            g.dstY = (dstHeight - g.dstHeight) / 2;
+            g.srcWidth = srcWidth;
+            g.srcHeight = srcHeight;
+            break;
+        }
+        }
+        return g;
+    }
+
+    bool resampleBgra(const ImageView& src, const MutableImageView& dst, const FitGeometry& geometry, ResampleFilter filter) {
+        return resampleBgra(src, dst, geometry, filter, bestSimdLevel());
+    }
+
+    bool resampleBgra(const ImageView& src, const MutableImageView& dst, const FitGeometry& geometry, ResampleFilter filter,
+        SimdLevel level) {
+        const detail::ResampleKernels* kernels = KernelsFor(level);
+        if (!kernels) return false;
+        if (!src.pixels || !dst.pixels || src.width <= 0 || src.height <= 0 || dst.width <= 0 || dst.height <= 0) return false;
+        const FitGeometry& g = geometry;
+        if (g.dstWidth <= 0 || g.dstHeight <= 0 || g.dstX < 0 || g.dstY < 0 ||
+            g.dstX + g.dstWidth > dst.width || g.dstY + g.dstHeight > dst.height) {
+            return false;
+        }
+        if (!(g.srcWidth > 0.0) || !(g.srcHeight > 0.0) || g.srcX < 0.0 || g.srcY < 0.0 ||
+            g.srcX + g.srcWidth > src.width + 1e-6 || g.srcY + g.srcHeight > src.height + 1e-6) {
+            return false;
+        }
+
+        const Coefficients h = ComputeCoefficients(g.srcX, g.srcWidth, src.width, g.dstWidth, filter);
+        const Coefficients v = ComputeCoefficients(g.srcY, g.srcHeight, src.height, g.dstHeight, filter);
+
+        // 水平滤波后的源行放在环形缓冲里：第 r 行存在 r % taps 槽位。输出行对应的源行窗口单调不减，
+        // 新算的行只会覆盖已经用不到的行
+        const int ringRows = v.taps;
+        const std::size_t rowBytes = static_cast<std::size_t>(g.dstWidth) * 4;
+        std::vector<std::uint8_t> ring(rowBytes * static_cast<std::size_t>(ringRows));
+        std::vector<const std::uint8_t*> rows(static_cast<std::size_t>(ringRows));
+        int nextRow = 0;
+
+        for (int y = 0; y < g.dstHeight; ++y) {
+            const int first = v.first[static_cast<std::size_t>(y)];
+            for (int r = (std::max)(nextRow, first); r < first + ringRows; ++r) {
+                const std::uint8_t* srcRow = src.pixels + static_cast<std::ptrdiff_t>(r) * src.stride;
+                kernels->horizontal(srcRow, &ring[rowBytes * static_cast<std::size_t>(r % ringRows)], h.first.data(), h.weights.data(), h.taps, g.dstWidth);
+            }
+            nextRow = (std::max)(nextRow, first + ringRows);
+
+            for (int k = 0; k < ringRows; ++k) {
+                rows[static_cast<std::size_t>(k)] = &ring[rowBytes * static_cast<std::size_t>((first + k) % ringRows)];
+            }
+            std::uint8_t* out = dst.pixels + static_cast<std::ptrdiff_t>(g.dstY + y) * dst.stride + static_cast<std::ptrdiff_t>(g.dstX) * 4;
+            kernels->vertical(rows.data(), &v.weights[static_cast<std::size_t>(y) * static_cast<std::size_t>(ringRows)], ringRows, out, 0, g.dstWidth);
+        }
+        return true;
+    }
+
+    bool resampleBgraToFit(const ImageView& src, const MutableImageView& dst, FitMode mode, ResampleFilter filter) {
+        return resampleBgra(src, dst, computeFit(mode, src.width, src.height, dst.width, dst.height), filter);
+    }
+
+} // namespace pomodoro
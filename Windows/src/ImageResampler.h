@@ -0,0 +1,92 @@
+#pragma once
+
+// Background scaling for the rest overlay: fit geometry plus a separable resampler over 32-bpp BGRA
+// buffers (premultiplied alpha, the layout of GDI+ PixelFormat32bppPARGB and of a top-down 32-bpp DIB).
+//
+// The overlay used to hand the full-resolution image to GDI+ DrawImage with bicubic interpolation on
+// every WM_PAINT of every monitor. Here an image is resampled once per distinct target size, and the
+// result is blitted. Both filters (Catmull-Rom cubic and Lanczos-3) widen with the downscale factor, so
+// large reductions average every source pixel instead of skipping them. Weights are 14-bit fixed point,
+// and each output's weights sum to exactly 1.0, so flat regions stay flat. Rows are filtered
+// horizontally once into a small ring buffer and then vertically. Memory is O(taps x output width),
+// whatever the source size.
+//
+// The row kernels have SSE4.1, AVX2 and NEON versions, picked at run time (see CpuFeatures.h). They use
+// integer arithmetic only, so every path produces the same bytes as the scalar reference.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CpuFeatures.h"
+
+namespace pomodoro {
+
+    struct ImageView {
+        const std::uint8_t* pixels{ nullptr };
+        int width{ 0 };
+        int height{ 0 };
+        std::ptrdiff_t stride{ 0 };  // 每行字节数（可大于 width * 4）
+    };
+
+    struct MutableImageView {
+        std::uint8_t* pixels{ nullptr };
+        int width{ 0 };
+        int height{ 0 };
+        std::ptrdiff_t stride{ 0 };
+    };
+
+    // 自带存储的 BGRA 图像（行紧密排列）
+    struct BgraImage {
+        int width{ 0 };
+        int height{ 0 };
+        std::vector<std::uint8_t> pixels;
+
+        BgraImage() = default;
+        BgraImage(int w, int h) : width(w), height(h), pixels(static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4) {}
+
+        bool empty() const noexcept { return width <= 0 || height <= 0; }
+        std::ptrdiff_t stride() const noexcept { return static_cast<std::ptrdiff_t>(width) * 4; }
+        ImageView view() const noexcept { return ImageView{ pixels.data(), width, height, stride() }; }
+        MutableImageView mutableView() noexcept { return MutableImageView{ pixels.data(), width, height, stride() }; }
+    };
+
+    enum class FitMode {
+        Cover,    // 保持宽高比填满目标，超出部分居中裁掉（遮罩背景）
+        Contain,  // 保持宽高比完整放入目标并居中，留边部分不写入，由调用方填充
+    };
+
+    enum class ResampleFilter {
+        Bicubic,   // Catmull-Rom（a = -0.5）
+        Lanczos3,  // 更锐利，大幅缩小时细节保留更好，代价是更多抽头
+    };
+
+    // 源区域（浮点，允许非整数裁剪）映射到目标矩形
+    struct FitGeometry {
+        int dstX{ 0 };
+        int dstY{ 0 };
+        int dstWidth{ 0 };
+        int dstHeight{ 0 };
+        double srcX{ 0.0 };
+        double srcY{ 0.0 };
+        double srcWidth{ 0.0 };
+        double srcHeight{ 0.0 };
+    };
+
+    // 尺寸不合法（<= 0）时返回全零
+    FitGeometry computeFit(FitMode mode, int srcWidth, int srcHeight, int dstWidth, int dstHeight) noexcept;
+
+    // 把 src 中 geometry 指定的源区域重采样到 dst 的目标矩形；目标矩形以外的像素不修改。
+    // 参数不合法（空图像、矩形越界）时返回 false
+    bool resampleBgra(const ImageView& src, const MutableImageView& dst, const FitGeometry& geometry,
+        ResampleFilter filter = ResampleFilter::Bicubic);
+
+    // 指定指令集（测试与基准用）；本机不支持该指令集时返回 false
+    bool resampleBgra(const ImageView& src, const MutableImageView& dst, const FitGeometry& geometry,
+        ResampleFilter filter, SimdLevel level);
+
+    // computeFit + resampleBgra，目标为整个 dst
+    bool resampleBgraToFit(const ImageView& src, const MutableImageView& dst, FitMode mode,
+        ResampleFilter filter = ResampleFilter::Bicubic);
+
+} // namespace pomodoro
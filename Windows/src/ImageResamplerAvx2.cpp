@@ -0,0 +1,121 @@
+// AVX2 row kernels for ImageResampler (compiled with -mavx2 or /arch:AVX2; see CMakeLists.txt).
+
+#include "ImageResamplerKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        namespace {
+
+            constexpr int kRound = 1 << (kResampleWeightBits - 1);
+
+            inline std::int32_t WeightPairBits(std::int16_t first, std::int16_t second) noexcept {
+                const std::uint32_t packed = static_cast<std::uint32_t>(static_cast<std::uint16_t>(first)) |
+                    (static_cast<std::uint32_t>(static_cast<std::uint16_t>(second)) << 16);
+                return static_cast<std::int32_t>(packed);
+            }
+
+            inline __m128i RoundShift(__m128i acc) noexcept {
+                return _mm_srai_epi32(_mm_add_epi32(acc, _mm_set1_epi32(kRound)), kResampleWeightBits);
+            }
+
+            inline __m256i RoundShift(__m256i acc) noexcept {
+                return _mm256_srai_epi32(_mm256_add_epi32(acc, _mm256_set1_epi32(kRound)), kResampleWeightBits);
+            }
+
+            void Horizontal(const std::uint8_t* src, std::uint8_t* out, const int* first,
+                const std::int16_t* weights, int taps, int outWidth) {
+                // 每对相邻像素的同一通道排在一起：b0 b1 g0 g1 r0 r1 a0 a1 | b2 b3 g2 g3 ...
+                const __m128i interleave4 = _mm_setr_epi8(0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15);
+                // 4 个权重（两个 32 位权重对）广播到各自的 128 位半边
+                const __m256i spreadPairs = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+                for (int x = 0; x < outWidth; ++x) {
+                    const std::uint8_t* p = src + static_cast<std::ptrdiff_t>(first[x]) * 4;
+                    const std::int16_t* w = weights + static_cast<std::ptrdiff_t>(x) * taps;
+                    __m256i wide = _mm256_setzero_si256();
+                    int k = 0;
+                    for (; k + 3 < taps; k += 4) {
+                        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k * 4));
+                        const __m256i values = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(px, interleave4));
+                        const __m128i w4 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(w + k));
+                        const __m256i wk = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(w4), spreadPairs);
+                        wide = _mm256_add_epi32(wide, _mm256_madd_epi16(values, wk));
+                    }
+                    __m128i acc = _mm_add_epi32(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+                    if (k + 1 < taps) {
+                        __m128i px = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + k * 4));
+                        px = _mm_cvtepu8_epi16(_mm_shuffle_epi8(px, interleave4));
+                        acc = _mm_add_epi32(acc, _mm_madd_epi16(px, _mm_set1_epi32(WeightPairBits(w[k], w[k + 1]))));
+                        k += 2;
+                    }
+                    if (k < taps) {
+                        std::int32_t last;
+                        std::memcpy(&last, p + k * 4, 4);
+                        const __m128i px = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(last));
+                        acc = _mm_add_epi32(acc, _mm_mullo_epi32(px, _mm_set1_epi32(w[k])));
+                    }
+                    __m128i v = RoundShift(acc);
+                    v = _mm_packs_epi32(v, v);
+                    v = _mm_packus_epi16(v, v);
+                    const std::int32_t pixel = _mm_cvtsi128_si32(v);
+                    std::memcpy(out + x * 4, &pixel, 4);
+                }
+            }
+
+            void Vertical(const std::uint8_t* const* rows, const std::int16_t* weights, int taps,
+                std::uint8_t* out, int xBegin, int xEnd) {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i alphaMask = _mm256_setr_epi8(
+                    3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15,
+                    3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15);
+                int x = xBegin;
+                // 每次 8 个像素（32 字节）。解包只在 128 位半边内进行，打包时顺序会还原
+                for (; x + 8 <= xEnd; x += 8) {
+                    const std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(x) * 4;
+                    __m256i a0 = zero, a1 = zero, a2 = zero, a3 = zero;
+                    for (int k = 0; k < taps; k += 2) {
+                        const __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k] + offset));
+                        const bool pair = k + 1 < taps;
+                        const __m256i r1 = pair ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k + 1] + offset)) : zero;
+                        const __m256i wk = _mm256_set1_epi32(WeightPairBits(weights[k], pair ? weights[k + 1] : 0));
+                        const __m256i lo = _mm256_unpacklo_epi8(r0, r1);
+                        const __m256i hi = _mm256_unpackhi_epi8(r0, r1);
+                        a0 = _mm256_add_epi32(a0, _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, zero), wk));
+                        a1 = _mm256_add_epi32(a1, _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, zero), wk));
+                        a2 = _mm256_add_epi32(a2, _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, zero), wk));
+                        a3 = _mm256_add_epi32(a3, _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, zero), wk));
+                    }
+                    const __m256i p01 = _mm256_packs_epi32(RoundShift(a0), RoundShift(a1));
+                    const __m256i p23 = _mm256_packs_epi32(RoundShift(a2), RoundShift(a3));
+                    __m256i bytes = _mm256_packus_epi16(p01, p23);
+                    bytes = _mm256_min_epu8(bytes, _mm256_shuffle_epi8(bytes, alphaMask));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset), bytes);
+                }
+                resampleVerticalScalar(rows, weights, taps, out, x, xEnd);
+            }
+
+            const ResampleKernels kKernels{ Horizontal, Vertical };
+
+        } // namespace
+
+        const ResampleKernels* avx2ResampleKernels() noexcept { return &kKernels; }
+
+    } // namespace detail
+
+} // namespace pomodoro
+
+#else
+
+namespace pomodoro {
+    namespace detail {
+        const ResampleKernels* avx2ResampleKernels() noexcept { return nullptr; }
+    } // namespace detail
+} // namespace pomodoro
+
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+
+// Internal to ImageResampler: the per-instruction-set row kernels. Each set is implemented in its own
+// translation unit, which is compiled with that instruction set enabled. These units include nothing
+// beyond intrinsics and this header, so no inline library code built with wider instructions can be
+// picked by the linker for the rest of the program.
+//
+// Fixed-point contract, shared by every implementation: weights are int16 in units of 1 / 2^14. Each
+// channel accumulates sum(pixel * weight) in int32, then rounds with (acc + 2^13) >> 14 (arithmetic
+// shift) and saturates to 0..255. The vertical pass also clamps B, G and R to A to keep the output
+// premultiplied. Given the same coefficients, all implementations give the same bytes.
+
+#include <cstdint>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        constexpr int kResampleWeightBits = 14;
+
+        struct ResampleKernels {
+            // 一行水平滤波：第 x 个输出像素读取 src[first[x] ..)，使用 weights[x * taps ..) 这 taps 个权重
+            void (*horizontal)(const std::uint8_t* src, std::uint8_t* out, const int* first,
+                const std::int16_t* weights, int taps, int outWidth);
+
+            // 一行垂直滤波：输出像素 [xBegin, xEnd) 由 rows[0..taps) 的同一列按 weights 加权
+            void (*vertical)(const std::uint8_t* const* rows, const std::int16_t* weights, int taps,
+                std::uint8_t* out, int xBegin, int xEnd);
+        };
+
+        // 标量参考实现；各向量实现用它处理行尾不足一个向量宽度的像素
+        void resampleHorizontalScalar(const std::uint8_t* src, std::uint8_t* out, const int* first,
+            const std::int16_t* weights, int taps, int outWidth);
+        void resampleVerticalScalar(const std::uint8_t* const* rows, const std::int16_t* weights, int taps,
+            std::uint8_t* out, int xBegin, int xEnd);
+
+        // 本构建未包含对应指令集时返回 nullptr
+        const ResampleKernels* sse41ResampleKernels() noexcept;
+        const ResampleKernels* avx2ResampleKernels() noexcept;
+        const ResampleKernels* neonResampleKernels() noexcept;
+
+    } // namespace detail
+
+} // namespace pomodoro
@@ -0,0 +1,92 @@
+// NEON row kernels for ImageResampler (ARM64, where NEON is part of the base instruction set).
+
+#include "ImageResamplerKernels.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+#include <cstring>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        namespace {
+
+            // vqrshrn 先加 2^13 再算术右移 14 位并饱和到 int16，与标量实现的舍入一致；vqmovun 再饱和到 0..255
+            inline uint8x8_t Narrow(int32x4_t lo, int32x4_t hi) noexcept {
+                return vqmovun_s16(vcombine_s16(vqrshrn_n_s32(lo, kResampleWeightBits), vqrshrn_n_s32(hi, kResampleWeightBits)));
+            }
+
+            inline int16x8_t Widen(uint8x8_t bytes) noexcept {
+                return vreinterpretq_s16_u16(vmovl_u8(bytes));
+            }
+
+            void Horizontal(const std::uint8_t* src, std::uint8_t* out, const int* first,
+                const std::int16_t* weights, int taps, int outWidth) {
+                for (int x = 0; x < outWidth; ++x) {
+                    const std::uint8_t* p = src + static_cast<std::ptrdiff_t>(first[x]) * 4;
+                    const std::int16_t* w = weights + static_cast<std::ptrdiff_t>(x) * taps;
+                    int32x4_t acc = vdupq_n_s32(0);
+                    int k = 0;
+                    for (; k + 1 < taps; k += 2) {
+                        const int16x8_t px = Widen(vld1_u8(p + k * 4));
+                        acc = vmlal_n_s16(acc, vget_low_s16(px), w[k]);
+                        acc = vmlal_n_s16(acc, vget_high_s16(px), w[k + 1]);
+                    }
+                    if (k < taps) {
+                        std::uint32_t last;
+                        std::memcpy(&last, p + k * 4, 4);
+                        const int16x8_t px = Widen(vreinterpret_u8_u32(vdup_n_u32(last)));
+                        acc = vmlal_n_s16(acc, vget_low_s16(px), w[k]);
+                    }
+                    const std::uint32_t pixel = vget_lane_u32(vreinterpret_u32_u8(Narrow(acc, acc)), 0);
+                    std::memcpy(out + x * 4, &pixel, 4);
+                }
+            }
+
+            void Vertical(const std::uint8_t* const* rows, const std::int16_t* weights, int taps,
+                std::uint8_t* out, int xBegin, int xEnd) {
+                static const std::uint8_t kAlphaIndex[16] = { 3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15 };
+                const uint8x16_t alphaIndex = vld1q_u8(kAlphaIndex);
+                int x = xBegin;
+                // 每次 4 个像素（16 字节）
+                for (; x + 4 <= xEnd; x += 4) {
+                    const std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(x) * 4;
+                    int32x4_t a0 = vdupq_n_s32(0), a1 = a0, a2 = a0, a3 = a0;
+                    for (int k = 0; k < taps; ++k) {
+                        const uint8x16_t r = vld1q_u8(rows[k] + offset);
+                        const int16x8_t lo = Widen(vget_low_u8(r));
+                        const int16x8_t hi = Widen(vget_high_u8(r));
+                        a0 = vmlal_n_s16(a0, vget_low_s16(lo), weights[k]);
+                        a1 = vmlal_n_s16(a1, vget_high_s16(lo), weights[k]);
+                        a2 = vmlal_n_s16(a2, vget_low_s16(hi), weights[k]);
+                        a3 = vmlal_n_s16(a3, vget_high_s16(hi), weights[k]);
+                    }
+                    uint8x16_t bytes = vcombine_u8(Narrow(a0, a1), Narrow(a2, a3));
+                    // 预乘 alpha：颜色分量不超过本像素的 alpha
+                    bytes = vminq_u8(bytes, vqtbl1q_u8(bytes, alphaIndex));
+                    vst1q_u8(out + offset, bytes);
+                }
+                resampleVerticalScalar(rows, weights, taps, out, x, xEnd);
+            }
+
+            const ResampleKernels kKernels{ Horizontal, Vertical };
+
+        } // namespace
+
+        const ResampleKernels* neonResampleKernels() noexcept { return &kKernels; }
+
+    } // namespace detail
+
+} // namespace pomodoro
+
+#else
+
+namespace pomodoro {
+    namespace detail {
+        const ResampleKernels* neonResampleKernels() noexcept { return nullptr; }
+    } // namespace detail
+} // namespace pomodoro
+
+#endif
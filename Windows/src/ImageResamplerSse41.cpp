@@ -0,0 +1,106 @@
+// SSE4.1 row kernels for ImageResampler (compiled with -msse4.1 on GCC/Clang; see CMakeLists.txt).
+
+#include "ImageResamplerKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <cstring>
+#include <smmintrin.h>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        namespace {
+
+            constexpr int kRound = 1 << (kResampleWeightBits - 1);
+
+            // 两个相邻权重打包成一个 32 位整数：低 16 位乘第一个样本，高 16 位乘第二个（pmaddwd）
+            inline __m128i WeightPair(std::int16_t first, std::int16_t second) noexcept {
+                const std::uint32_t packed = static_cast<std::uint32_t>(static_cast<std::uint16_t>(first)) |
+                    (static_cast<std::uint32_t>(static_cast<std::uint16_t>(second)) << 16);
+                return _mm_set1_epi32(static_cast<int>(packed));
+            }
+
+            inline __m128i RoundShift(__m128i acc) noexcept {
+                return _mm_srai_epi32(_mm_add_epi32(acc, _mm_set1_epi32(kRound)), kResampleWeightBits);
+            }
+
+            void Horizontal(const std::uint8_t* src, std::uint8_t* out, const int* first,
+                const std::int16_t* weights, int taps, int outWidth) {
+                // 相邻两个像素的同一通道排在一起：b0 b1 g0 g1 r0 r1 a0 a1
+                const __m128i interleave = _mm_setr_epi8(0, 4, 1, 5, 2, 6, 3, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+                for (int x = 0; x < outWidth; ++x) {
+                    const std::uint8_t* p = src + static_cast<std::ptrdiff_t>(first[x]) * 4;
+                    const std::int16_t* w = weights + static_cast<std::ptrdiff_t>(x) * taps;
+                    __m128i acc = _mm_setzero_si128();
+                    int k = 0;
+                    for (; k + 1 < taps; k += 2) {
+                        __m128i px = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + k * 4));
+                        px = _mm_cvtepu8_epi16(_mm_shuffle_epi8(px, interleave));
+                        acc = _mm_add_epi32(acc, _mm_madd_epi16(px, WeightPair(w[k], w[k + 1])));
+                    }
+                    if (k < taps) {
+                        std::int32_t last;
+                        std::memcpy(&last, p + k * 4, 4);
+                        const __m128i px = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(last));
+                        acc = _mm_add_epi32(acc, _mm_mullo_epi32(px, _mm_set1_epi32(w[k])));
+                    }
+                    __m128i v = RoundShift(acc);
+                    v = _mm_packs_epi32(v, v);
+                    v = _mm_packus_epi16(v, v);
+                    const std::int32_t pixel = _mm_cvtsi128_si32(v);
+                    std::memcpy(out + x * 4, &pixel, 4);
+                }
+            }
+
+            void Vertical(const std::uint8_t* const* rows, const std::int16_t* weights, int taps,
+                std::uint8_t* out, int xBegin, int xEnd) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i alphaMask = _mm_setr_epi8(3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15);
+                int x = xBegin;
+                // 每次 4 个像素（16 字节）；两行交错后用 pmaddwd 一次完成两个抽头的乘加
+                for (; x + 4 <= xEnd; x += 4) {
+                    const std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(x) * 4;
+                    __m128i a0 = zero, a1 = zero, a2 = zero, a3 = zero;
+                    for (int k = 0; k < taps; k += 2) {
+                        const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + offset));
+                        const bool pair = k + 1 < taps;
+                        const __m128i r1 = pair ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k + 1] + offset)) : zero;
+                        const __m128i wk = WeightPair(weights[k], pair ? weights[k + 1] : 0);
+                        const __m128i lo = _mm_unpacklo_epi8(r0, r1);
+                        const __m128i hi = _mm_unpackhi_epi8(r0, r1);
+                        a0 = _mm_add_epi32(a0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), wk));
+                        a1 = _mm_add_epi32(a1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), wk));
+                        a2 = _mm_add_epi32(a2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), wk));
+                        a3 = _mm_add_epi32(a3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), wk));
+                    }
+                    const __m128i p01 = _mm_packs_epi32(RoundShift(a0), RoundShift(a1));
+                    const __m128i p23 = _mm_packs_epi32(RoundShift(a2), RoundShift(a3));
+                    __m128i bytes = _mm_packus_epi16(p01, p23);
+                    // 预乘 alpha：颜色分量不超过本像素的 alpha（alpha 与自身取 min 不变）
+                    bytes = _mm_min_epu8(bytes, _mm_shuffle_epi8(bytes, alphaMask));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset), bytes);
+                }
+                resampleVerticalScalar(rows, weights, taps, out, x, xEnd);
+            }
+
+            const ResampleKernels kKernels{ Horizontal, Vertical };
+
+        } // namespace
+
+        const ResampleKernels* sse41ResampleKernels() noexcept { return &kKernels; }
+
+    } // namespace detail
+
+} // namespace pomodoro
+
+#else
+
+namespace pomodoro {
+    namespace detail {
+        const ResampleKernels* sse41ResampleKernels() noexcept { return nullptr; }
+    } // namespace detail
+} // namespace pomodoro
+
+#endif
@@ -0,0 +1,120 @@
+#include "JsonWriter.h"
+
+#include <charconv>
+#include <cmath>
+
+namespace pomodoro {
+
+    void JsonWriter::reset() noexcept {
+        buffer_.clear();
+        hasElements_ = 0;
+        depth_ = 0;
+        afterKey_ = false;
+    }
+
+    void JsonWriter::beforeValue() {
+        if (afterKey_) {
+            afterKey_ = false;
+            return;
+        }
+        const std::uint64_t bit = std::uint64_t(1) << depth_;
+        if (hasElements_ & bit) buffer_.push_back(',');
+        hasElements_ |= bit;
+    }
+
+    void JsonWriter::open(char bracket) {
+        beforeValue();
+        buffer_.push_back(bracket);
+        ++depth_;
+        hasElements_ &= ~(std::uint64_t(1) << depth_);
+    }
+
+    void JsonWriter::close(char bracket) {
+        --depth_;
+        buffer_.push_back(bracket);
+    }
+
+    JsonWriter& JsonWriter::beginObject() { open('{'); return *this; }
+    JsonWriter& JsonWriter::endObject() { close('}'); return *this; }
+    JsonWriter& JsonWriter::beginArray() { open('['); return *this; }
+    JsonWriter& JsonWriter::endArray() { close(']'); return *this; }
+
+    JsonWriter& JsonWriter::key(std::string_view name) {
+        beforeValue();
+        appendEscaped(name);
+        buffer_.push_back(':');
+        afterKey_ = true;
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value(std::string_view text) {
+        beforeValue();
+        appendEscaped(text);
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::rawString(std::string_view text) {
+        beforeValue();
+        buffer_.push_back('"');
+        buffer_.append(text);
+        buffer_.push_back('"');
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value(bool b) {
+        beforeValue();
+        buffer_.append(b ? "true" : "false");
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value(std::int64_t v) {
+        beforeValue();
+        char digits[24];
+        const auto r = std::to_chars(digits, digits + sizeof(digits), v);
+        buffer_.append(digits, r.ptr);
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value(double v) {
+        if (!std::isfinite(v)) return null();
+        beforeValue();
+        char digits[32];
+        const auto r = std::to_chars(digits, digits + sizeof(digits), v);
+        buffer_.append(digits, r.ptr);
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::null() {
+        beforeValue();
+        buffer_.append("null");
+        return *this;
+    }
+
+    void JsonWriter::appendEscaped(std::string_view text) {
+        static constexpr char kHex[] = "0123456789abcdef";
+        buffer_.push_back('"');
+        // 没有需要转义的字符时整段追加
+        std::size_t run = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const auto c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            buffer_.append(text.data() + run, i - run);
+            run = i + 1;
+            switch (c) {
+            case '"': buffer_.append("\\\""); break;
+            case '\\': buffer_.append("\\\\"); break;
+            case '\n': buffer_.append("\\n"); break;
+            case '\r': buffer_.append("\\r"); break;
+            case '\t': buffer_.append("\\t"); break;
+            default: {
+                const char escape[] = { '\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF] };
+                buffer_.append(escape, sizeof(escape));
+                break;
+            }
+            }
+        }
+        buffer_.append(text.data() + run, text.size() - run);
+        buffer_.push_back('"');
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,61 @@
+#pragma once
+
+// Minimal streaming JSON writer. Values are appended straight into one growable buffer that is kept
+// across reset() calls, so writing a report does not build any intermediate tree and, once the buffer
+// has grown to the report's size, does not allocate at all.
+//
+// Commas and nesting are tracked with a per-depth "first element" bit (up to 64 levels). Numbers use
+// std::to_chars (shortest round-trip form for doubles); NaN / infinity are written as null.
+// The writer trusts its caller for structure: key() must precede every value inside an object.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace pomodoro {
+
+    class JsonWriter {
+    public:
+        // 清空内容，保留已分配的容量
+        void reset() noexcept;
+        void reserve(std::size_t bytes) { buffer_.reserve(bytes); }
+
+        JsonWriter& beginObject();
+        JsonWriter& endObject();
+        JsonWriter& beginArray();
+        JsonWriter& endArray();
+
+        JsonWriter& key(std::string_view name);
+
+        JsonWriter& value(std::string_view text);
+        JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+        JsonWriter& value(bool b);
+        JsonWriter& value(int v) { return value(static_cast<std::int64_t>(v)); }
+        JsonWriter& value(std::int64_t v);
+        JsonWriter& value(double v);
+        JsonWriter& null();
+
+        // key + value 的简写
+        template <typename T>
+        JsonWriter& field(std::string_view name, const T& v) { return key(name).value(v); }
+
+        std::string_view view() const noexcept { return buffer_; }
+        std::size_t size() const noexcept { return buffer_.size(); }
+        std::size_t capacity() const noexcept { return buffer_.capacity(); }
+
+        // 直接追加已经是合法 JSON 字符串内容的文本（不转义），供日期等格式化路径使用
+        JsonWriter& rawString(std::string_view text);
+
+    private:
+        void beforeValue();
+        void open(char bracket);
+        void close(char bracket);
+        void appendEscaped(std::string_view text);
+
+        std::string buffer_;
+        std::uint64_t hasElements_{ 0 };  // 第 depth 位：该层已写过元素，下一个元素前需要逗号
+        int depth_{ 0 };
+        bool afterKey_{ false };
+    };
+
+} // namespace pomodoro
@@ -0,0 +1,258 @@
+#include "LocalCalendar.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace pomodoro {
+
+    namespace {
+
+        constexpr std::int64_t kMsPerMinute = 60'000;
+        constexpr std::int64_t kMsPerHour = 60 * kMsPerMinute;
+        constexpr std::int64_t kMsPerDay = 24 * kMsPerHour;
+
+        std::int64_t FloorDiv(std::int64_t a, std::int64_t b) noexcept {
+            const std::int64_t q = a / b;
+            return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+        }
+
+        // 0 = 周日；1970-01-01 是周四
+        int Weekday(std::int64_t days) noexcept {
+            return static_cast<int>(days - FloorDiv(days + 4, 7) * 7 + 4);
+        }
+
+        // 规则在某一年对应的本地时刻（毫秒）
+        std::int64_t RuleLocalMs(int year, const DstTransitionRule& rule) noexcept {
+            std::int64_t day = 0;
+            if (rule.week == 0) {
+                day = daysFromCivil(year, rule.month, rule.dayOfMonth);
+            } else {
+                const std::int64_t first = daysFromCivil(year, rule.month, 1);
+                const std::int64_t next = rule.month == 12 ? daysFromCivil(year + 1, 1, 1) : daysFromCivil(year, rule.month + 1, 1);
+                day = first + (rule.dayOfWeek - Weekday(first) + 7) % 7 + (rule.week - 1) * 7;
+                while (day >= next) day -= 7; // week = 5：当月最后一个
+            }
+            return day * kMsPerDay + rule.hour * kMsPerHour + rule.minute * kMsPerMinute;
+        }
+
+        void WriteDigits(char* out, int value, int width) noexcept {
+            for (int i = width - 1; i >= 0; --i) {
+                out[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+        }
+
+        void WriteDate(const CivilDate& date, char* out) noexcept {
+            WriteDigits(out, date.year, 4);
+            out[4] = '-';
+            WriteDigits(out + 5, date.month, 2);
+            out[7] = '-';
+            WriteDigits(out + 8, date.day, 2);
+        }
+
+    } // namespace
+
+    // Howard Hinnant 的 days_from_civil / civil_from_days
+    std::int64_t daysFromCivil(int year, int month, int day) noexcept {
+        const std::int64_t y = static_cast<std::int64_t>(year) - (month <= 2 ? 1 : 0);
+        const std::int64_t era = FloorDiv(y, 400);
+        const std::int64_t yoe = y - era * 400;
+        const std::int64_t mp = (month + 9) % 12;
+        const std::int64_t doy = (153 * mp + 2) / 5 + day - 1;
+        const std::int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    CivilDate civilFromDays(std::int64_t days) noexcept {
+        const std::int64_t z = days + 719468;
+        const std::int64_t era = FloorDiv(z, 146097);
+        const std::int64_t doe = z - era * 146097;
+        const std::int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const std::int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const std::int64_t mp = (5 * doy + 2) / 153;
+        CivilDate date;
+        date.day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+        date.month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        date.year = static_cast<int>(yoe + era * 400 + (date.month <= 2 ? 1 : 0));
+        return date;
+    }
+
+    void formatIsoTimestamp(std::int64_t unixMs, char* out) noexcept {
+        const std::int64_t seconds = FloorDiv(unixMs, 1000);
+        const std::int64_t days = FloorDiv(seconds, 86400);
+        const int secondOfDay = static_cast<int>(seconds - days * 86400);
+        WriteDate(civilFromDays(days), out);
+        out[10] = 'T';
+        WriteDigits(out + 11, secondOfDay / 3600, 2);
+        out[13] = ':';
+        WriteDigits(out + 14, secondOfDay / 60 % 60, 2);
+        out[16] = ':';
+        WriteDigits(out + 17, secondOfDay % 60, 2);
+        out[19] = 'Z';
+    }
+
+    void formatDateKey(std::int32_t dayIndex, char* out) noexcept {
+        WriteDate(civilFromDays(dayIndex), out);
+    }
+
+    LocalCalendar::LocalCalendar(int utcOffsetMinutes)
+        : initialOffsetMs_(static_cast<std::int64_t>(utcOffsetMinutes) * kMsPerMinute) {
+    }
+
+    LocalCalendar LocalCalendar::fromYearRules(const std::vector<TimeZoneYearRules>& years) {
+        LocalCalendar calendar;
+        if (years.empty()) return calendar;
+
+        std::int64_t current = 0;
+        bool first = true;
+        for (const auto& rules : years) {
+            const std::int64_t standard = static_cast<std::int64_t>(rules.standardOffsetMinutes) * kMsPerMinute;
+            const std::int64_t daylight = static_cast<std::int64_t>(rules.daylightOffsetMinutes) * kMsPerMinute;
+
+            std::int64_t atYearStart = standard;
+            std::int64_t changeAt[2]{};
+            std::int64_t changeTo[2]{};
+            int changes = 0;
+            if (rules.daylightStart.month != 0 && rules.standardStart.month != 0 && standard != daylight) {
+                // 进入夏令时按标准时间表述，回到标准时间按夏令时表述
+                const std::int64_t toDaylight = RuleLocalMs(rules.year, rules.daylightStart) - standard;
+                const std::int64_t toStandard = RuleLocalMs(rules.year, rules.standardStart) - daylight;
+                // 南半球：年初处于夏令时，先回到标准时间
+                const bool northern = toDaylight < toStandard;
+                atYearStart = northern ? standard : daylight;
+                changeAt[0] = northern ? toDaylight : toStandard;
+                changeTo[0] = northern ? daylight : standard;
+                changeAt[1] = northern ? toStandard : toDaylight;
+                changeTo[1] = northern ? standard : daylight;
+                changes = 2;
+            }
+
+            if (first) {
+                calendar.initialOffsetMs_ = atYearStart;
+                current = atYearStart;
+                first = false;
+            } else if (atYearStart != current) {
+                // 相邻年份的基准偏移不同（时区调整）：在新年零点切换
+                calendar.transitionAt_.push_back(daysFromCivil(rules.year, 1, 1) * kMsPerDay - current);
+                calendar.offsetAfterMs_.push_back(atYearStart);
+                current = atYearStart;
+            }
+            for (int i = 0; i < changes; ++i) {
+                if (changeTo[i] == current) continue;
+                calendar.transitionAt_.push_back(changeAt[i]);
+                calendar.offsetAfterMs_.push_back(changeTo[i]);
+                current = changeTo[i];
+            }
+        }
+
+        if (!calendar.transitionAt_.empty()) {
+            calendar.firstTableDay_ = static_cast<std::int32_t>(daysFromCivil(years.front().year, 1, 1));
+            const auto endDay = static_cast<std::int32_t>(daysFromCivil(years.back().year + 1, 1, 1));
+            calendar.dayStart_.resize(static_cast<std::size_t>(endDay - calendar.firstTableDay_) + 1);
+            calendar.buildDayTable();
+        }
+        return calendar;
+    }
+
+    void LocalCalendar::buildDayTable() {
+        for (std::size_t i = 0; i < dayStart_.size(); ++i) {
+            dayStart_[i] = firstInstantAtOrAfterLocal((firstTableDay_ + static_cast<std::int64_t>(i)) * kMsPerDay);
+        }
+    }
+
+    std::size_t LocalCalendar::segmentOf(std::int64_t unixMs) const noexcept {
+        return static_cast<std::size_t>(std::upper_bound(transitionAt_.begin(), transitionAt_.end(), unixMs) - transitionAt_.begin());
+    }
+
+    std::int64_t LocalCalendar::offsetMsAt(std::int64_t unixMs) const noexcept {
+        return transitionAt_.empty() ? initialOffsetMs_ : segmentOffsetMs(segmentOf(unixMs));
+    }
+
+    std::int64_t LocalCalendar::firstInstantAtOrAfterLocal(std::int64_t localMs) const noexcept {
+        if (transitionAt_.empty()) return localMs - initialOffsetMs_;
+
+        // 候选：某个偏移段内恰好是 localMs 的时刻，或开始时本地时间已越过 localMs 的段起点（跳过的时间）。
+        // 相邻切换相隔数月，检查估计位置附近的几个段即可；取最早的候选。
+        constexpr std::int64_t kNone = (std::numeric_limits<std::int64_t>::max)();
+        const std::size_t segments = transitionAt_.size() + 1;
+        const std::size_t guess = segmentOf(localMs - initialOffsetMs_);
+        const std::size_t lo = guess >= 2 ? guess - 2 : 0;
+        const std::size_t hi = (std::min)(guess + 2, segments - 1);
+
+        std::int64_t best = kNone;
+        for (std::size_t s = lo; s <= hi; ++s) {
+            const std::int64_t offset = segmentOffsetMs(s);
+            const std::int64_t begin = s == 0 ? (std::numeric_limits<std::int64_t>::min)() : transitionAt_[s - 1];
+            const std::int64_t end = s + 1 == segments ? kNone : transitionAt_[s];
+            const std::int64_t exact = localMs - offset;
+            if (exact >= begin && exact < end) {
+                best = (std::min)(best, exact);
+            } else if (s > 0 && begin + offset >= localMs) {
+                best = (std::min)(best, begin);
+            }
+        }
+        return best;
+    }
+
+    std::int32_t LocalCalendar::dayIndexFor(std::int64_t unixMs) const noexcept {
+        if (!dayStart_.empty()) {
+            // 以年初偏移估计日期，真实日期最多相差一天
+            const std::int64_t days = static_cast<std::int64_t>(dayStart_.size()) - 1;
+            std::int64_t i = FloorDiv(unixMs + initialOffsetMs_, kMsPerDay) - firstTableDay_;
+            if (i >= 0 && i < days) {
+                if (i > 0 && unixMs < dayStart_[static_cast<std::size_t>(i)]) --i;
+                if (i + 1 < days && unixMs >= dayStart_[static_cast<std::size_t>(i + 1)]) ++i;
+                if (unixMs >= dayStart_[static_cast<std::size_t>(i)] && unixMs < dayStart_[static_cast<std::size_t>(i + 1)]) {
+                    return static_cast<std::int32_t>(firstTableDay_ + i);
+                }
+            }
+        }
+        return static_cast<std::int32_t>(FloorDiv(unixMs + offsetMsAt(unixMs), kMsPerDay));
+    }
+
+    LocalCalendar::Position LocalCalendar::locate(std::int64_t unixMs) const noexcept {
+        Position p;
+        p.dayIndex = dayIndexFor(unixMs);
+
+        const std::int64_t i = static_cast<std::int64_t>(p.dayIndex) - firstTableDay_;
+        if (i >= 0 && i + 1 < static_cast<std::int64_t>(dayStart_.size())) {
+            const std::int64_t start = dayStart_[static_cast<std::size_t>(i)];
+            if (dayStart_[static_cast<std::size_t>(i + 1)] - start == kMsPerDay) {
+                // 当天没有切换：从零点起按等长小时计算
+                p.hour = static_cast<int>((unixMs - start) / kMsPerHour);
+                return p;
+            }
+        }
+        const std::int64_t local = unixMs + offsetMsAt(unixMs) - static_cast<std::int64_t>(p.dayIndex) * kMsPerDay;
+        p.hour = static_cast<int>((std::max)(std::int64_t(0), (std::min)(std::int64_t(23), FloorDiv(local, kMsPerHour))));
+        return p;
+    }
+
+    std::int64_t LocalCalendar::dayStartUtcMs(std::int32_t dayIndex) const noexcept {
+        return hourStartUtcMs(dayIndex, 0);
+    }
+
+    std::int64_t LocalCalendar::hourStartUtcMs(std::int32_t dayIndex, int hour) const noexcept {
+        const std::int64_t i = static_cast<std::int64_t>(dayIndex) - firstTableDay_;
+        if (i >= 0 && i + 1 < static_cast<std::int64_t>(dayStart_.size())) {
+            const std::int64_t start = dayStart_[static_cast<std::size_t>(i)];
+            const std::int64_t next = dayStart_[static_cast<std::size_t>(i + 1)];
+            if (hour == 0) return start;
+            if (hour == 24) return next;
+            if (next - start == kMsPerDay) return start + hour * kMsPerHour;
+        }
+        return firstInstantAtOrAfterLocal(static_cast<std::int64_t>(dayIndex) * kMsPerDay + hour * kMsPerHour);
+    }
+
+    std::array<std::int64_t, 7 * 24 + 1> LocalCalendar::weekHourStarts(std::int32_t firstDay) const noexcept {
+        std::array<std::int64_t, 7 * 24 + 1> starts{};
+        for (int day = 0; day < 7; ++day) {
+            for (int hour = 0; hour < 24; ++hour) {
+                starts[static_cast<std::size_t>(day * 24 + hour)] = hourStartUtcMs(firstDay + day, hour);
+            }
+        }
+        starts.back() = hourStartUtcMs(firstDay + 7, 0);
+        return starts;
+    }
+
+} // namespace pomodoro
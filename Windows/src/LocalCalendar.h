@@ -0,0 +1,108 @@
+#pragma once
+
+// UTC -> local day / hour mapping shared by every statistics path (daily aggregates, heatmap windows,
+// reports). The Swift side asks Calendar.current for every event; here the time zone is resolved once.
+//
+// A LocalCalendar is either a fixed UTC offset (pure arithmetic) or a sorted list of offset transitions
+// generated from annual DST rules, written the same way as the Windows TIME_ZONE_INFORMATION
+// StandardDate / DaylightDate fields. For a transition-based calendar, a table with the UTC start of
+// every local day is precomputed over the years the rules cover. Inside that range, finding the day of
+// an instant is a direct index plus at most one step in each direction. Outside it, lookups
+// binary-search the transitions.
+//
+// Local hours follow wall-clock semantics: on a spring-forward day the skipped hour has zero length
+// (its start equals the next hour's start), and on a fall-back day the repeated hour is two hours long.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pomodoro {
+
+    // 年度切换规则：month/week/dayOfWeek 同 Windows SYSTEMTIME 的“第 N 个星期 X”写法，
+    // week = 5 表示当月最后一个；week = 0 时改用 dayOfMonth（绝对日期）。时间为切换前的本地时间。
+    struct DstTransitionRule {
+        int month{ 0 };       // 1-12；0 表示当年没有夏令时
+        int week{ 1 };
+        int dayOfWeek{ 0 };   // 0 = 周日
+        int dayOfMonth{ 1 };
+        int hour{ 0 };
+        int minute{ 0 };
+    };
+
+    struct TimeZoneYearRules {
+        int year{ 1970 };
+        int standardOffsetMinutes{ 0 };   // 相对 UTC 的偏移，东为正
+        int daylightOffsetMinutes{ 0 };
+        DstTransitionRule daylightStart;  // 进入夏令时
+        DstTransitionRule standardStart;  // 回到标准时间
+    };
+
+    struct CivilDate {
+        int year{ 1970 };
+        int month{ 1 };   // 1-12
+        int day{ 1 };     // 1-31
+    };
+
+    // 公历日期 <-> 距 1970-01-01 的天数（支持负数）
+    std::int64_t daysFromCivil(int year, int month, int day) noexcept;
+    CivilDate civilFromDays(std::int64_t days) noexcept;
+
+    // "2024-03-10T05:00:00Z"：UTC、秒精度（与 ISO8601DateFormatter 的默认格式一致），写入 out[0, 20)
+    constexpr std::size_t kIsoTimestampLength = 20;
+    void formatIsoTimestamp(std::int64_t unixMs, char* out) noexcept;
+
+    // 本地日期键 "yyyy-MM-dd"（Swift DateFormatter.dateKey），写入 out[0, 10)
+    constexpr std::size_t kDateKeyLength = 10;
+    void formatDateKey(std::int32_t dayIndex, char* out) noexcept;
+
+    class LocalCalendar {
+    public:
+        struct Position {
+            std::int32_t dayIndex{ 0 };  // 本地日期距 1970-01-01 的天数
+            int hour{ 0 };               // 本地小时（0-23）
+        };
+
+        // 固定偏移（不考虑夏令时）
+        explicit LocalCalendar(int utcOffsetMinutes = 0);
+
+        // 按年份给出的规则（年份升序）。第一年之前沿用第一年的规则开始时的偏移，最后一年之后保持最后的偏移。
+        static LocalCalendar fromYearRules(const std::vector<TimeZoneYearRules>& years);
+
+        // 某一时刻的 UTC 偏移（毫秒）
+        std::int64_t offsetMsAt(std::int64_t unixMs) const noexcept;
+
+        std::int32_t dayIndexFor(std::int64_t unixMs) const noexcept;
+        Position locate(std::int64_t unixMs) const noexcept;
+
+        // 本地日期 dayIndex 的零点（UTC 毫秒）；零点被夏令时跳过时为跳变时刻
+        std::int64_t dayStartUtcMs(std::int32_t dayIndex) const noexcept;
+
+        // 本地 hour:00 的起点；hour = 24 即次日零点。被跳过的小时返回跳变时刻（长度为 0）
+        std::int64_t hourStartUtcMs(std::int32_t dayIndex, int hour) const noexcept;
+
+        // 从 firstDay 开始连续 7 天每个本地小时的起点，外加窗口结束时间（HeatmapBinner 的输入）
+        std::array<std::int64_t, 7 * 24 + 1> weekHourStarts(std::int32_t firstDay) const noexcept;
+
+        bool hasTransitions() const noexcept { return !transitionAt_.empty(); }
+
+    private:
+        // 第一个本地时间 >= localMs 的 UTC 时刻
+        std::int64_t firstInstantAtOrAfterLocal(std::int64_t localMs) const noexcept;
+        std::size_t segmentOf(std::int64_t unixMs) const noexcept;
+        std::int64_t segmentOffsetMs(std::size_t segment) const noexcept {
+            return segment == 0 ? initialOffsetMs_ : offsetAfterMs_[segment - 1];
+        }
+        void buildDayTable();
+
+        std::int64_t initialOffsetMs_{ 0 };
+        std::vector<std::int64_t> transitionAt_;   // 切换时刻（UTC 毫秒，升序）
+        std::vector<std::int64_t> offsetAfterMs_;  // 切换后的偏移
+
+        // 规则覆盖范围内每个本地日期的零点：dayStart_[i] 为 firstTableDay_ + i，最后多一项作为哨兵
+        std::int32_t firstTableDay_{ 0 };
+        std::vector<std::int64_t> dayStart_;
+    };
+
+} // namespace pomodoro
@@ -0,0 +1,124 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pomodoro {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+#if defined(_WIN32)
+
+    bool MappedFile::open(const std::filesystem::path& path, std::size_t size) {
+        close();
+        if (size == 0) return false;
+
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        // 映射大小即文件最小长度：CreateFileMapping 会按需扩展文件（新增部分为 0）
+        const auto size64 = static_cast<unsigned long long>(size);
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFull), nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, size);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        file_ = file;
+        mapping_ = mapping;
+        data_ = view;
+        size_ = size;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+        if (file_) CloseHandle(static_cast<HANDLE>(file_));
+        data_ = nullptr;
+        mapping_ = nullptr;
+        file_ = nullptr;
+        size_ = 0;
+    }
+
+    void MappedFile::flushAsync() {
+        // FlushViewOfFile 只把脏页交给系统写回，不等待磁盘（等待需要 FlushFileBuffers）
+        if (data_) FlushViewOfFile(data_, size_);
+    }
+
+    void MappedFile::flushAsync(std::size_t offset, std::size_t length) {
+        // FlushViewOfFile 自行按页对齐
+        if (!data_ || offset >= size_ || length == 0) return;
+        if (length > size_ - offset) length = size_ - offset;
+        FlushViewOfFile(static_cast<unsigned char*>(data_) + offset, length);
+    }
+
+#else
+
+    bool MappedFile::open(const std::filesystem::path& path, std::size_t size) {
+        close();
+        if (size == 0) return false;
+
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) return false;
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 ||
+            (static_cast<std::size_t>(st.st_size) < size && ::ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (view == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+
+        fd_ = fd;
+        data_ = view;
+        size_ = size;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) ::munmap(data_, size_);
+        if (fd_ >= 0) ::close(fd_);
+        data_ = nullptr;
+        fd_ = -1;
+        size_ = 0;
+    }
+
+    void MappedFile::flushAsync() {
+        if (data_) ::msync(data_, size_, MS_ASYNC);
+    }
+
+    void MappedFile::flushAsync(std::size_t offset, std::size_t length) {
+        if (!data_ || offset >= size_ || length == 0) return;
+        if (length > size_ - offset) length = size_ - offset;
+        // msync 要求起始地址按页对齐（映射起点本身是页对齐的）
+        static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t begin = offset - offset % pageSize;
+        ::msync(static_cast<unsigned char*>(data_) + begin, offset + length - begin, MS_ASYNC);
+    }
+
+#endif
+
+} // namespace pomodoro
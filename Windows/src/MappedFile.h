@@ -0,0 +1,45 @@
+#pragma once
+
+// Minimal read/write memory-mapped file (Win32 file mapping / POSIX mmap).
+// Used for small state files that are rewritten very often: writes are plain memory stores into the
+// page cache, so they survive a process crash without a syscall per write.
+
+#include <cstddef>
+#include <filesystem>
+
+namespace pomodoro {
+
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // 打开（不存在则创建）文件并映射前 size 字节；文件不足 size 时扩展并以 0 填充
+        bool open(const std::filesystem::path& path, std::size_t size);
+        void close();
+
+        bool isOpen() const noexcept { return data_ != nullptr; }
+        unsigned char* data() noexcept { return static_cast<unsigned char*>(data_); }
+        const unsigned char* data() const noexcept { return static_cast<const unsigned char*>(data_); }
+        std::size_t size() const noexcept { return size_; }
+
+        // 请求把脏页写回磁盘（异步，不等待完成）
+        void flushAsync();
+        // 只写回 [offset, offset + length) 所在的页（追加写入的文件每次只需写回尾部）
+        void flushAsync(std::size_t offset, std::size_t length);
+
+    private:
+        void* data_{ nullptr };
+        std::size_t size_{ 0 };
+#if defined(_WIN32)
+        void* file_{ nullptr };    // HANDLE
+        void* mapping_{ nullptr }; // HANDLE
+#else
+        int fd_{ -1 };
+#endif
+    };
+
+} // namespace pomodoro
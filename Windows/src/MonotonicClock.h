@@ -0,0 +1,57 @@
+#pragma once
+
+// Injectable monotonic clock used by the portable core (PomodoroTimer / AutoRestartStateMachine).
+//
+// Production code uses `SteadyClock::instance()` (std::chrono::steady_clock). Tests and the headless
+// simulator (see Windows/sim) pass a `VirtualClock` instead, so months of synthetic sessions can be
+// replayed in milliseconds and time-dependent rules (deadlines, the 1 s screensaver grace window)
+// become deterministic.
+//
+// Time points keep the steady_clock representation so callers can keep using
+// `std::chrono::steady_clock::time_point` / `duration` arithmetic regardless of the clock source.
+
+#include <chrono>
+
+namespace pomodoro {
+
+    class MonotonicClock {
+    public:
+        using duration = std::chrono::steady_clock::duration;
+        using time_point = std::chrono::steady_clock::time_point;
+
+        virtual ~MonotonicClock() = default;
+        virtual time_point now() const = 0;
+    };
+
+    // Real time: thin wrapper over std::chrono::steady_clock.
+    class SteadyClock final : public MonotonicClock {
+    public:
+        time_point now() const override { return std::chrono::steady_clock::now(); }
+
+        static const SteadyClock& instance() {
+            static const SteadyClock clock;
+            return clock;
+        }
+    };
+
+    // Manually advanced clock for tests and simulation. Never goes backwards.
+    class VirtualClock final : public MonotonicClock {
+    public:
+        VirtualClock() = default;
+        explicit VirtualClock(time_point start) : now_(start) {}
+
+        time_point now() const override { return now_; }
+
+        void advance(duration d) {
+            if (d > duration::zero()) now_ += d;
+        }
+
+        void advanceTo(time_point t) {
+            if (t > now_) now_ = t;
+        }
+
+    private:
+        time_point now_{};
+    };
+
+} // namespace pomodoro
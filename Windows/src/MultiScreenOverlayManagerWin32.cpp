@@ -8,13 +8,22 @@ namespace pomodoro {
 
     MultiScreenOverlayManagerWin32::~MultiScreenOverlayManagerWin32() {
         hideAllOverlays();
+        OverlayWindowWin32::ShutdownBackgroundPrefetch();
+    }
+
+    void MultiScreenOverlayManagerWin32::prefetchNextBackground() {
+        if (backgroundSettings_) {
+            OverlayWindowWin32::PrefetchNextBackground(*backgroundSettings_);
+        }
     }
 
     void MultiScreenOverlayManagerWin32::showOverlaysOnAllScreens() {
         hideAllOverlays();
 
         // Prepare one background (image or video) for this rest cycle and reuse it across all screens.
-        OverlayWindowWin32::PrepareNextBackgroundForRest();
+        if (backgroundSettings_) {
+            OverlayWindowWin32::PrepareNextBackgroundForRest(*backgroundSettings_);
+        }
 
         // 枚举所有显示器，为每个显示器创建一个遮罩窗口
         EnumDisplayMonitors(nullptr, nullptr, MonitorEnumProc, reinterpret_cast<LPARAM>(this));
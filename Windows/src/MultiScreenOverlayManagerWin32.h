@@ -34,6 +34,12 @@ namespace pomodoro {
         // 当“取消休息”或 ESC 关闭任一遮罩时回调（用于进入下一轮番茄）
         void setOnDismissAllCallback(const std::function<void()>& cb) { onDismissAll_ = cb; }
 
+        // 进程内共享的背景设置（由主循环在文件变化时重新加载）；未设置时遮罩不显示背景
+        void setBackgroundSettings(const BackgroundSettingsWin32* settings) { backgroundSettings_ = settings; }
+
+        // 在后台线程上提前选出并解码下一次休息的背景（番茄钟最后一分钟调用，重复调用开销很小）
+        void prefetchNextBackground();
+
     private:
         static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdc, LPRECT lprcMonitor, LPARAM dwData);
         void createOverlayForRect(const RECT& rect);
@@ -42,6 +48,7 @@ namespace pomodoro {
         HINSTANCE hInstance_{ nullptr };
         std::vector<std::unique_ptr<OverlayWindowWin32>> overlays_;
         std::function<void()> onDismissAll_{};
+        const BackgroundSettingsWin32* backgroundSettings_{ nullptr };
     };
 
 } // namespace pomodoro
@@ -1,11 +1,18 @@
 #include "OverlayWindowWin32.h"
+#include "BackgroundPrefetcher.h"
 #include "BackgroundSettingsWin32.h"
 #include "DpiUtilsWin32.h"
+#include "ImageResampler.h"
+#include "PixelKernels.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <cstdarg>
 #include <cstdio>
 #include <string>
+#include <utility>
+#include <vector>
 #include <windows.h>
 #include <gdiplus.h>
 #include <mfapi.h>
@@ -27,6 +34,9 @@ namespace {
     constexpr UINT_PTR kTimerHidePoster = 2;
     constexpr UINT_PTR kTimerEnsureTopmost = 3;
     constexpr UINT_PTR kTimerRevealUiAfterPoster = 4;
+    constexpr UINT_PTR kTimerFadeTextStep = 5;
+    constexpr UINT kFadeTextStepMs = 16;
+    constexpr BYTE kFadeTextStepAlpha = 17;  // 15 步，约 250 ms
     constexpr int kIdCancelButton = 3001;
 
     // Posted from MFPlay callback thread to UI thread: show poster shield to cover loop gap.
@@ -170,30 +180,142 @@ namespace {
 
     // Prepared once per rest cycle; reused across monitors.
     PreparedKind g_preparedKind = PreparedKind::None;
-    std::unique_ptr<Gdiplus::Image> g_backgroundImage;
-    std::unique_ptr<Gdiplus::Bitmap> g_videoPoster;
+    pomodoro::BgraImage g_backgroundPixels;  // 预乘 alpha 的 BGRA，原始分辨率
+    pomodoro::BgraImage g_videoPoster;       // 视频海报帧（不透明），同时作为视频宽高比的参考
     std::wstring g_preparedVideoPath;
     double g_preparedVideoPlaybackRate = 1.0;
     // Round-robin cursor for mixed image/video rotation. In-memory only (resets on app restart).
     std::size_t g_backgroundRotateCursor = 0;
     std::wstring g_overlayMessage;
+    const wchar_t* kDefaultOverlayTitle = L"Rest Time - PomodoroScreen";
+
+    // 背景图与海报帧按显示器尺寸缩放后的位图（每个源、每种尺寸一份，换背景时清空）。当前各显示器
+    // 尺寸的位图在预取线程上随解码一起生成（见 DecodeBackground），绘制时只需查表后 BitBlt /
+    // UpdateLayeredWindow；只有显示器配置在预取之后变化时才会在界面线程上补做一次缩放
+    struct ScaledBackground {
+        const pomodoro::BgraImage* source{ nullptr };
+        int width{ 0 };
+        int height{ 0 };
+        HBITMAP bitmap{ nullptr };
+    };
+    std::vector<ScaledBackground> g_scaledBackgrounds;
+
+    void ClearScaledBackgrounds() {
+        for (auto& scaled : g_scaledBackgrounds) {
+            if (scaled.bitmap) DeleteObject(scaled.bitmap);
+        }
+        g_scaledBackgrounds.clear();
+    }
+
+    // 把 source 按 Cover 模式缩放进新建的 w x h DIB；不依赖 DC，可以在任意线程上调用
+    HBITMAP CreateScaledBitmap(const pomodoro::BgraImage& source, int w, int h) {
+        if (source.empty() || w <= 0 || h <= 0) return nullptr;
+
+        BITMAPINFO bi{};
+        bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        bi.bmiHeader.biWidth = w;
+        bi.bmiHeader.biHeight = -h; // top-down，与 BgraImage 的行顺序一致
+        bi.bmiHeader.biPlanes = 1;
+        bi.bmiHeader.biBitCount = 32;
+        bi.bmiHeader.biCompression = BI_RGB;
 
-    std::unique_ptr<Gdiplus::Image> TryLoadBackgroundImage(const std::wstring& path) {
-        if (path.empty()) return nullptr;
-        auto img = std::make_unique<Gdiplus::Image>(path.c_str());
-        if (!img || img->GetLastStatus() != Gdiplus::Ok) {
+        void* bits = nullptr;
+        HBITMAP dib = CreateDIBSection(nullptr, &bi, DIB_RGB_COLORS, &bits, nullptr, 0);
+        if (!dib || !bits) {
+            if (dib) DeleteObject(dib);
+            return nullptr;
+        }
+
+        // 预乘 alpha 的像素直接 BitBlt，相当于叠加在黑色背景上
+        const pomodoro::MutableImageView target{ static_cast<std::uint8_t*>(bits), w, h, static_cast<std::ptrdiff_t>(w) * 4 };
+        if (!pomodoro::resampleBgraToFit(source.view(), target, pomodoro::FitMode::Cover)) {
+            DeleteObject(dib);
             return nullptr;
         }
-        return img;
+        return dib;
     }
 
-    std::unique_ptr<Gdiplus::Bitmap> TryDecodeVideoPosterFrame(const std::wstring& path) {
-        if (path.empty()) return nullptr;
-        EnsureGdiplusStarted();
-        if (g_gdiplusToken == 0) return nullptr;
+    HBITMAP ScaledBackgroundFor(const pomodoro::BgraImage& source, int w, int h) {
+        if (source.empty() || w <= 0 || h <= 0) return nullptr;
+        for (const auto& scaled : g_scaledBackgrounds) {
+            if (scaled.source == &source && scaled.width == w && scaled.height == h) return scaled.bitmap;
+        }
+
+        HBITMAP dib = CreateScaledBitmap(source, w, h);
+        if (!dib) return nullptr;
+        g_scaledBackgrounds.push_back(ScaledBackground{ &source, w, h, dib });
+        return dib;
+    }
+
+    // 预取线程上生成的缩放位图。界面线程在 PrepareNextBackgroundForRest 中接管它；被放弃的预取结果
+    // 在析构时释放位图
+    struct PrescaledBackground {
+        int width{ 0 };
+        int height{ 0 };
+        HBITMAP bitmap{ nullptr };
+
+        PrescaledBackground() = default;
+        PrescaledBackground(int w, int h, HBITMAP b) : width(w), height(h), bitmap(b) {}
+        PrescaledBackground(PrescaledBackground&& other) noexcept
+            : width(other.width), height(other.height), bitmap(std::exchange(other.bitmap, nullptr)) {
+        }
+        PrescaledBackground& operator=(PrescaledBackground&& other) noexcept {
+            if (this != &other) {
+                if (bitmap) DeleteObject(bitmap);
+                width = other.width;
+                height = other.height;
+                bitmap = std::exchange(other.bitmap, nullptr);
+            }
+            return *this;
+        }
+        PrescaledBackground(const PrescaledBackground&) = delete;
+        PrescaledBackground& operator=(const PrescaledBackground&) = delete;
+        ~PrescaledBackground() {
+            if (bitmap) DeleteObject(bitmap);
+        }
+    };
+
+    BOOL CALLBACK CollectMonitorSize(HMONITOR /*monitor*/, HDC /*hdc*/, LPRECT rect, LPARAM data) {
+        auto* sizes = reinterpret_cast<std::vector<SIZE>*>(data);
+        if (!sizes || !rect) return TRUE;
+        const SIZE size{ rect->right - rect->left, rect->bottom - rect->top };
+        if (size.cx <= 0 || size.cy <= 0) return TRUE;
+        // 多块相同分辨率的显示器共用一份
+        const bool known = std::any_of(sizes->begin(), sizes->end(), [&](const SIZE& s) {
+            return s.cx == size.cx && s.cy == size.cy;
+        });
+        if (!known) sizes->push_back(size);
+        return TRUE;
+    }
+
+    // 遮罩窗口覆盖整个显示器矩形（与 MultiScreenOverlayManagerWin32 的枚举一致），按这些尺寸预先缩放
+    std::vector<PrescaledBackground> PrescaleForMonitors(const pomodoro::BgraImage& source) {
+        std::vector<PrescaledBackground> out;
+        if (source.empty()) return out;
+        std::vector<SIZE> sizes;
+        EnumDisplayMonitors(nullptr, nullptr, CollectMonitorSize, reinterpret_cast<LPARAM>(&sizes));
+        out.reserve(sizes.size());
+        for (const SIZE& size : sizes) {
+            HBITMAP dib = CreateScaledBitmap(source, size.cx, size.cy);
+            if (dib) out.emplace_back(size.cx, size.cy, dib);
+        }
+        return out;
+    }
+
+    // 在界面线程上调用：source 已经移动到它的最终位置（g_backgroundPixels / g_videoPoster）
+    void AdoptPrescaledBackgrounds(const pomodoro::BgraImage& source, std::vector<PrescaledBackground>& prescaled) {
+        for (auto& surface : prescaled) {
+            if (!surface.bitmap) continue;
+            g_scaledBackgrounds.push_back(ScaledBackground{ &source, surface.width, surface.height, std::exchange(surface.bitmap, nullptr) });
+        }
+        prescaled.clear();
+    }
+
+    bool TryDecodeVideoPosterFrame(const std::wstring& path, pomodoro::BgraImage& out) {
+        if (path.empty()) return false;
 
         if (FAILED(MFStartup(MF_VERSION))) {
-            return nullptr;
+            return false;
         }
 
         IMFAttributes* attrs = nullptr;
@@ -211,7 +333,7 @@ namespace {
         }
         if (FAILED(hr) || !reader) {
             MFShutdown();
-            return nullptr;
+            return false;
         }
 
         reader->SetStreamSelection(static_cast<DWORD>(MF_SOURCE_READER_ALL_STREAMS), FALSE);
@@ -250,7 +372,7 @@ namespace {
         if (!sample) {
             reader->Release();
             MFShutdown();
-            return nullptr;
+            return false;
         }
 
         IMFMediaBuffer* buffer = nullptr;
@@ -259,7 +381,7 @@ namespace {
             sample->Release();
             reader->Release();
             MFShutdown();
-            return nullptr;
+            return false;
         }
 
         IMFMediaType* curType = nullptr;
@@ -279,35 +401,97 @@ namespace {
             sample->Release();
             reader->Release();
             MFShutdown();
-            return nullptr;
+            return false;
         }
 
-        auto bmp = std::make_unique<Gdiplus::Bitmap>(w, h, PixelFormat32bppARGB);
-        if (bmp && bmp->GetLastStatus() == Gdiplus::Ok) {
-            Gdiplus::Rect r(0, 0, static_cast<INT>(w), static_cast<INT>(h));
-            Gdiplus::BitmapData bd{};
-            if (bmp->LockBits(&r, Gdiplus::ImageLockModeWrite, PixelFormat32bppARGB, &bd) == Gdiplus::Ok) {
-                const int srcStride = static_cast<int>(w) * 4;
-                const int dstStride = bd.Stride;
-                for (UINT32 y = 0; y < h; ++y) {
-                    BYTE* dstRow = static_cast<BYTE*>(bd.Scan0) + y * dstStride;
-                    const BYTE* srcRow = data + y * srcStride;
-                    memcpy(dstRow, srcRow, srcStride);
-                    // Ensure opaque alpha (RGB32 from MF is typically BGRX with undefined alpha).
-                    for (UINT32 x = 0; x < w; ++x) {
-                        dstRow[x * 4 + 3] = 0xFF;
-                    }
-                }
-                bmp->UnlockBits(&bd);
-            }
-        }
+        // Ensure opaque alpha (RGB32 from MF is typically BGRX with undefined alpha): copy and fix alpha in one pass.
+        pomodoro::BgraImage poster(static_cast<int>(w), static_cast<int>(h));
+        pomodoro::pixelKernels().bgrxToBgraOpaque(data, poster.pixels.data(), static_cast<std::size_t>(w) * h);
 
         buffer->Unlock();
         buffer->Release();
         sample->Release();
         reader->Release();
         MFShutdown();
-        return bmp;
+        out = std::move(poster);
+        return true;
+    }
+
+    // 预取结果（每次休息一份，所有屏幕共享）
+    struct DecodedBackground {
+        pomodoro::BgraImage image;
+        pomodoro::BgraImage poster;
+        std::vector<PrescaledBackground> prescaled;  // image（或视频的 poster）按当前各显示器尺寸缩放的结果
+    };
+
+    // 从文件构造的 GDI+ 位图只解析文件头，真正解码发生在第一次访问像素时。这里在预取线程上
+    // 直接把像素按 PARGB（与 32 位 DIB 相同的内存布局）解码进自己的缓冲区，随后释放文件
+    bool DecodeImagePixels(const std::wstring& path, pomodoro::BgraImage& out) {
+        if (path.empty()) return false;
+        Gdiplus::Bitmap bitmap(path.c_str());
+        if (bitmap.GetLastStatus() != Gdiplus::Ok) return false;
+        const INT w = static_cast<INT>(bitmap.GetWidth());
+        const INT h = static_cast<INT>(bitmap.GetHeight());
+        if (w <= 0 || h <= 0) return false;
+
+        pomodoro::BgraImage pixels(w, h);
+        Gdiplus::Rect rect(0, 0, w, h);
+        Gdiplus::BitmapData data{};
+        data.Width = static_cast<UINT>(w);
+        data.Height = static_cast<UINT>(h);
+        data.Stride = static_cast<INT>(pixels.stride());
+        data.PixelFormat = PixelFormat32bppPARGB;
+        data.Scan0 = pixels.pixels.data();
+        // UserInputBuf：GDI+ 把转换后的像素直接写进我们的缓冲区，省去一次整图拷贝
+        const UINT mode = Gdiplus::ImageLockModeRead | Gdiplus::ImageLockModeUserInputBuf;
+        if (bitmap.LockBits(&rect, mode, PixelFormat32bppPARGB, &data) != Gdiplus::Ok) return false;
+        bitmap.UnlockBits(&data);
+        out = std::move(pixels);
+        return true;
+    }
+
+    // 在预取线程上调用；图片无法加载时返回 false（轮换跳过它），视频即使没有海报帧也可以播放
+    bool DecodeBackground(const pomodoro::BackgroundEntry& entry, DecodedBackground& out) {
+        // Media Foundation 的源读取器要求调用线程已初始化 COM
+        const HRESULT co = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        bool usable = true;
+        if (entry.video) {
+            TryDecodeVideoPosterFrame(entry.path, out.poster);
+        } else {
+            usable = DecodeImagePixels(entry.path, out.image);
+        }
+        if (usable) {
+            // 全分辨率的双三次缩放也放在这里做，首次 WM_PAINT 只需查表
+            out.prescaled = PrescaleForMonitors(entry.video ? out.poster : out.image);
+        }
+        if (SUCCEEDED(co)) {
+            CoUninitialize();
+        }
+        return usable;
+    }
+
+    using BackgroundPrefetcherWin32 = pomodoro::BackgroundPrefetcher<DecodedBackground>;
+    std::unique_ptr<BackgroundPrefetcherWin32> g_backgroundPrefetcher;
+
+    BackgroundPrefetcherWin32& SharedBackgroundPrefetcher() {
+        // GDI+ 在界面线程上初始化；预取线程只读取令牌
+        EnsureGdiplusStarted();
+        if (!g_backgroundPrefetcher) {
+            g_backgroundPrefetcher = std::make_unique<BackgroundPrefetcherWin32>(DecodeBackground);
+        }
+        return *g_backgroundPrefetcher;
+    }
+
+    std::vector<pomodoro::BackgroundEntry> RotationEntries(const pomodoro::BackgroundSettingsWin32& settings) {
+        std::vector<pomodoro::BackgroundEntry> entries;
+        entries.reserve(settings.files().size());
+        for (const auto& f : settings.files()) {
+            entries.push_back(pomodoro::BackgroundEntry{
+                f.path,
+                f.type == pomodoro::BackgroundType::Video,
+                (f.playbackRate > 0.0) ? f.playbackRate : 1.0 });
+        }
+        return entries;
     }
 
     // 注册窗口类（进程内只需一次）
@@ -604,13 +788,13 @@ namespace pomodoro {
             // destination aspect ratio, while keeping MFPlay in PreservePicture mode (no distortion).
             //
             // We use the decoded poster's dimensions as the video's aspect ratio reference.
-            if ((rc.right - rc.left) > 0 && (rc.bottom - rc.top) > 0 && g_videoPoster) {
+            if ((rc.right - rc.left) > 0 && (rc.bottom - rc.top) > 0 && !g_videoPoster.empty()) {
                 const double dstW = static_cast<double>(rc.right - rc.left);
                 const double dstH = static_cast<double>(rc.bottom - rc.top);
                 const double dstAR = dstW / dstH;
 
-                const double srcW = static_cast<double>(g_videoPoster->GetWidth());
-                const double srcH = static_cast<double>(g_videoPoster->GetHeight());
+                const double srcW = static_cast<double>(g_videoPoster.width);
+                const double srcH = static_cast<double>(g_videoPoster.height);
                 const double srcAR = (srcH > 0.0) ? (srcW / srcH) : 0.0;
 
                 if (srcAR > 0.0) {
@@ -678,54 +862,293 @@ namespace pomodoro {
         bool mfStarted_{ false };
     };
 
-    void OverlayWindowWin32::PrepareNextBackgroundForRest() {
+    void OverlayWindowWin32::PrefetchNextBackground(const BackgroundSettingsWin32& settings) {
+        auto entries = RotationEntries(settings);
+        if (entries.empty()) return;
+        SharedBackgroundPrefetcher().prefetch(std::move(entries), g_backgroundRotateCursor);
+    }
+
+    void OverlayWindowWin32::PrepareNextBackgroundForRest(const BackgroundSettingsWin32& settings) {
         g_preparedKind = PreparedKind::None;
-        g_backgroundImage.reset();
-        g_videoPoster.reset();
+        g_backgroundPixels = pomodoro::BgraImage{};
+        ClearScaledBackgrounds();
+        g_videoPoster = pomodoro::BgraImage{};
         g_preparedVideoPath.clear();
         g_preparedVideoPlaybackRate = 1.0;
         g_overlayMessage.clear();
 
-        BackgroundSettingsWin32 settings;
-        const std::wstring settingsPath = BackgroundSettingsWin32::DefaultConfigPath();
-        if (!settings.loadFromFile(settingsPath)) {
-            return;
-        }
-
         g_overlayMessage = settings.overlayMessage();
 
-        const auto& files = settings.files();
-        if (files.empty()) return;
+        const auto entries = RotationEntries(settings);
+        if (entries.empty()) return;
 
         // Mixed rotation across image/video list.
         // Each rest cycle advances to the next entry; invalid entries are skipped.
-        const std::size_t n = files.size();
-        std::size_t start = (g_backgroundRotateCursor >= n) ? 0 : g_backgroundRotateCursor;
-
-        for (std::size_t attempt = 0; attempt < n; ++attempt) {
-            const std::size_t idx = (start + attempt) % n;
-            const auto& f = files[idx];
-            if (f.path.empty()) continue;
-
-            // Advance cursor so next rest cycle tries the following item first.
-            g_backgroundRotateCursor = (idx + 1) % n;
-
-            if (f.type == BackgroundType::Image) {
-                auto img = TryLoadBackgroundImage(f.path);
-                if (img) {
-                    g_backgroundImage = std::move(img);
-                    g_preparedKind = PreparedKind::Image;
-                    return;
+        // Normally the result was decoded ahead of time (PrefetchNextBackground); otherwise it is decoded now.
+        auto prepared = SharedBackgroundPrefetcher().take(entries, g_backgroundRotateCursor);
+        if (!prepared) return;
+
+        // Advance cursor so next rest cycle tries the following item first.
+        g_backgroundRotateCursor = prepared->nextCursor;
+
+        if (!prepared->entry.video) {
+            g_backgroundPixels = std::move(prepared->decoded.image);
+            AdoptPrescaledBackgrounds(g_backgroundPixels, prepared->decoded.prescaled);
+            g_preparedKind = PreparedKind::Image;
+        } else {
+            g_preparedKind = PreparedKind::Video;
+            g_preparedVideoPath = prepared->entry.path;
+            g_preparedVideoPlaybackRate = prepared->entry.playbackRate;
+            g_videoPoster = std::move(prepared->decoded.poster);
+            AdoptPrescaledBackgrounds(g_videoPoster, prepared->decoded.prescaled);
+        }
+    }
+
+    void OverlayWindowWin32::ShutdownBackgroundPrefetch() {
+        g_backgroundPrefetcher.reset();
+    }
+
+    // 界面层窗口的持久表面：与屏幕同尺寸的 DIB 和内存 DC，只在尺寸变化时重新分配。
+    // 标题以不透明度 255 栅格化一次并保存在 titleLayer 中，淡出的每一步只把这一块按 alpha 缩放后
+    // 写回；按钮按下 / 松开只重画按钮区域。两种情况都用脏矩形提交给 UpdateLayeredWindowIndirect。
+    // 按钮在标题淡出期间保持不透明，所以不能用整窗的 SourceConstantAlpha。
+    struct OverlayWindowWin32::UiSurface {
+        HDC dc{ nullptr };
+        HBITMAP bitmap{ nullptr };
+        HGDIOBJ oldBitmap{ nullptr };
+        std::uint8_t* bits{ nullptr };
+        int width{ 0 };
+        int height{ 0 };
+
+        // 上次栅格化时的内容
+        bool rasterized{ false };
+        UINT dpi{ 0 };
+        std::wstring title;
+        RECT button{};
+        bool pressed{ false };
+        BYTE titleAlpha{ 255 };
+
+        // 标题所占区域（不与按钮区域重叠）及其不透明时的像素（预乘 BGRA）
+        RECT titleRect{};
+        pomodoro::BgraImage titleLayer;
+
+        UiSurface() = default;
+        UiSurface(const UiSurface&) = delete;
+        UiSurface& operator=(const UiSurface&) = delete;
+        ~UiSurface() { release(); }
+
+        void release() {
+            if (dc) {
+                if (oldBitmap) SelectObject(dc, oldBitmap);
+                DeleteDC(dc);
+            }
+            if (bitmap) DeleteObject(bitmap);
+            dc = nullptr;
+            bitmap = nullptr;
+            oldBitmap = nullptr;
+            bits = nullptr;
+            width = 0;
+            height = 0;
+            rasterized = false;
+        }
+
+        bool ensure(int w, int h) {
+            if (dc && width == w && height == h) return true;
+            release();
+
+            BITMAPINFO bi{};
+            bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            bi.bmiHeader.biWidth = w;
+            bi.bmiHeader.biHeight = -h; // top-down
+            bi.bmiHeader.biPlanes = 1;
+            bi.bmiHeader.biBitCount = 32;
+            bi.bmiHeader.biCompression = BI_RGB;
+
+            dc = CreateCompatibleDC(nullptr);
+            if (!dc) return false;
+            void* p = nullptr;
+            bitmap = CreateDIBSection(dc, &bi, DIB_RGB_COLORS, &p, nullptr, 0);
+            if (!bitmap || !p) {
+                release();
+                return false;
+            }
+            oldBitmap = SelectObject(dc, bitmap);
+            bits = static_cast<std::uint8_t*>(p);
+            width = w;
+            height = h;
+            return true;
+        }
+
+        std::uint8_t* pixel(int x, int y) const {
+            return bits + (static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x)) * 4;
+        }
+
+        RECT clipped(const RECT& r) const {
+            const RECT all{ 0, 0, width, height };
+            RECT out{};
+            IntersectRect(&out, &r, &all);
+            return out;
+        }
+
+        // 按钮及其边框（含抗锯齿）实际覆盖的区域
+        RECT buttonArea(const RECT& r) const {
+            RECT area = r;
+            InflateRect(&area, 2, 2);
+            return clipped(area);
+        }
+
+        void clear(const RECT& r) {
+            for (int y = r.top; y < r.bottom; ++y) {
+                pomodoro::pixelKernels().fill(pixel(r.left, y), static_cast<std::size_t>(r.right - r.left), 0);
+            }
+        }
+
+        void rasterize(const std::wstring& text, UINT newDpi, const RECT& newButton, bool newPressed, BYTE alpha) {
+            clear(RECT{ 0, 0, width, height });
+            drawTitle(text, newDpi, newButton);
+            drawButton(newButton, newPressed, newDpi);
+            applyTitleAlpha(alpha);
+            dpi = newDpi;
+            title = text;
+            rasterized = true;
+        }
+
+        void drawTitle(const std::wstring& text, UINT newDpi, const RECT& newButton) {
+            {
+                Gdiplus::Graphics g(dc);
+                g.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+                g.SetTextRenderingHint(Gdiplus::TextRenderingHintClearTypeGridFit);
+
+                Gdiplus::FontFamily family(L"Segoe UI");
+                const float titlePx = static_cast<float>(pomodoro::win32::Scale(32, newDpi));
+                Gdiplus::Font titleFont(&family, titlePx, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
+
+                Gdiplus::StringFormat fmt;
+                fmt.SetAlignment(Gdiplus::StringAlignmentCenter);
+                fmt.SetLineAlignment(Gdiplus::StringAlignmentCenter);
+
+                const Gdiplus::RectF layout(
+                    0.0f,
+                    static_cast<Gdiplus::REAL>(-pomodoro::win32::Scale(80, newDpi)),
+                    static_cast<Gdiplus::REAL>(width),
+                    static_cast<Gdiplus::REAL>(height)
+                );
+                Gdiplus::RectF bounds;
+                g.MeasureString(text.c_str(), -1, &titleFont, layout, &fmt, &bounds);
+
+                // 文字外接矩形留出抗锯齿余量，并让出按钮区域，这样两块可以各自更新
+                const int pad = pomodoro::win32::Scale(4, newDpi);
+                RECT r{
+                    static_cast<LONG>(std::floor(bounds.X)) - pad,
+                    static_cast<LONG>(std::floor(bounds.Y)) - pad,
+                    static_cast<LONG>(std::ceil(bounds.X + bounds.Width)) + pad,
+                    static_cast<LONG>(std::ceil(bounds.Y + bounds.Height)) + pad
+                };
+                r = clipped(r);
+                const RECT area = buttonArea(newButton);
+                RECT overlap{};
+                if (IntersectRect(&overlap, &r, &area)) {
+                    r.bottom = (std::max)(r.top, area.top);
                 }
-            } else {
-                g_preparedKind = PreparedKind::Video;
-                g_preparedVideoPath = f.path;
-                g_preparedVideoPlaybackRate = (f.playbackRate > 0.0) ? f.playbackRate : 1.0;
-                g_videoPoster = TryDecodeVideoPosterFrame(f.path);
-                return;
+                titleRect = r;
+
+                g.SetClip(Gdiplus::Rect(r.left, r.top, r.right - r.left, r.bottom - r.top));
+                Gdiplus::SolidBrush titleBrush(Gdiplus::Color(255, 255, 255, 255));
+                g.DrawString(text.c_str(), -1, &titleFont, layout, &fmt, &titleBrush);
+            }
+            GdiFlush();
+
+            const int w = titleRect.right - titleRect.left;
+            const int h = titleRect.bottom - titleRect.top;
+            titleLayer = pomodoro::BgraImage((std::max)(w, 0), (std::max)(h, 0));
+            for (int y = 0; y < titleLayer.height; ++y) {
+                memcpy(titleLayer.pixels.data() + y * titleLayer.stride(), pixel(titleRect.left, titleRect.top + y), static_cast<size_t>(titleLayer.stride()));
             }
+            titleAlpha = 255;
+        }
+
+        // 返回需要提交的区域
+        RECT drawButton(const RECT& newButton, bool newPressed, UINT newDpi) {
+            const RECT area = buttonArea(newButton);
+            clear(area);
+            {
+                Gdiplus::Graphics g(dc);
+                g.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+                g.SetTextRenderingHint(Gdiplus::TextRenderingHintClearTypeGridFit);
+
+                const Gdiplus::Color border(255, 255, 255, 255);
+                const Gdiplus::Color fill(255, newPressed ? 255 : 0, newPressed ? 255 : 0, newPressed ? 255 : 0);
+                const Gdiplus::Color textC(255, newPressed ? 0 : 255, newPressed ? 0 : 255, newPressed ? 0 : 255);
+
+                Gdiplus::Rect btn(
+                    newButton.left,
+                    newButton.top,
+                    newButton.right - newButton.left,
+                    newButton.bottom - newButton.top
+                );
+                Gdiplus::SolidBrush fillBrush(fill);
+                Gdiplus::Pen borderPen(border, 1.0f);
+                g.FillRectangle(&fillBrush, btn);
+                g.DrawRectangle(&borderPen, btn);
+
+                Gdiplus::StringFormat fmt;
+                fmt.SetAlignment(Gdiplus::StringAlignmentCenter);
+                fmt.SetLineAlignment(Gdiplus::StringAlignmentCenter);
+
+                Gdiplus::FontFamily family(L"Segoe UI");
+                const float btnPx = static_cast<float>(pomodoro::win32::Scale(14, newDpi));
+                Gdiplus::Font btnFont(&family, btnPx, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
+                Gdiplus::SolidBrush btnTextBrush(textC);
+                Gdiplus::RectF btnRect(
+                    static_cast<Gdiplus::REAL>(btn.X),
+                    static_cast<Gdiplus::REAL>(btn.Y),
+                    static_cast<Gdiplus::REAL>(btn.Width),
+                    static_cast<Gdiplus::REAL>(btn.Height)
+                );
+                g.DrawString(L"\u53d6\u6d88\u4f11\u606f", -1, &btnFont, btnRect, &fmt, &btnTextBrush);
+            }
+            GdiFlush();
+            button = newButton;
+            pressed = newPressed;
+            return area;
+        }
+
+        // 预乘像素整体乘以 alpha，效果与只作用于标题区域的 SourceConstantAlpha 相同
+        RECT applyTitleAlpha(BYTE alpha) {
+            const auto& kernels = pomodoro::pixelKernels();
+            for (int y = 0; y < titleLayer.height; ++y) {
+                kernels.scaleAlpha(
+                    titleLayer.pixels.data() + y * titleLayer.stride(),
+                    pixel(titleRect.left, titleRect.top + y),
+                    static_cast<std::size_t>(titleLayer.width),
+                    alpha
+                );
+            }
+            titleAlpha = alpha;
+            return titleRect;
+        }
+
+        // dirty 为 nullptr 时提交整块表面
+        void present(HWND window, POINT position, const RECT* dirty) const {
+            SIZE size{ width, height };
+            POINT ptSrc{ 0, 0 };
+            BLENDFUNCTION bf{};
+            bf.BlendOp = AC_SRC_OVER;
+            bf.SourceConstantAlpha = 255;
+            bf.AlphaFormat = AC_SRC_ALPHA;
+
+            UPDATELAYEREDWINDOWINFO info{};
+            info.cbSize = sizeof(info);
+            info.pptDst = &position;
+            info.psize = &size;
+            info.hdcSrc = dc;
+            info.pptSrc = &ptSrc;
+            info.pblend = &bf;
+            info.dwFlags = ULW_ALPHA;
+            info.prcDirty = dirty;
+            UpdateLayeredWindowIndirect(window, &info);
         }
-    }
+    };
 
     OverlayWindowWin32::OverlayWindowWin32() = default;
 
@@ -866,7 +1289,7 @@ namespace pomodoro {
             return;
         }
         const bool isVideo = (g_preparedKind == PreparedKind::Video && !g_preparedVideoPath.empty());
-        const bool willShowPoster = isVideo && (g_videoPoster != nullptr);
+        const bool willShowPoster = isVideo && !g_videoPoster.empty();
         OverlayDbgLog("show enter isVideo=%d willShowPoster=%d", isVideo ? 1 : 0, willShowPoster ? 1 : 0);
 
         // For video + poster mode, avoid showing the main window until the poster shield is visible.
@@ -904,7 +1327,7 @@ namespace pomodoro {
             }
             videoPlayer_->start(hwnd_, g_preparedVideoPath, g_preparedVideoPlaybackRate);
 
-            posterVisible_ = (g_videoPoster != nullptr);
+            posterVisible_ = !g_videoPoster.empty();
             posterShownTick_ = GetTickCount64();
 
             if (posterShieldWindow_) {
@@ -998,6 +1421,10 @@ namespace pomodoro {
             KillTimer(hwnd_, posterTimerId_);
             posterTimerId_ = 0;
         }
+        if (fadeTimerId_ != 0) {
+            KillTimer(hwnd_, fadeTimerId_);
+            fadeTimerId_ = 0;
+        }
         posterVisible_ = false;
         posterShownTick_ = 0;
         if (videoPlayer_) {
@@ -1051,8 +1478,8 @@ namespace pomodoro {
         switch (msg) {
         case kMsgShowPosterForLoop: {
             // Re-show poster shield to mask any transient frame gap during loop restart.
-            OverlayDbgLog("msg kMsgShowPosterForLoop received posterShield=%p posterBmp=%p", posterShieldWindow_, g_videoPoster.get());
-            if (posterShieldWindow_ && g_videoPoster) {
+            OverlayDbgLog("msg kMsgShowPosterForLoop received posterShield=%p posterBmp=%d", posterShieldWindow_, g_videoPoster.empty() ? 0 : 1);
+            if (posterShieldWindow_ && !g_videoPoster.empty()) {
                 posterVisible_ = true;
                 posterShownTick_ = GetTickCount64();
 
@@ -1066,7 +1493,7 @@ namespace pomodoro {
                     SWP_NOACTIVATE | SWP_SHOWWINDOW
                 );
                 // IMPORTANT:
-                // Do NOT re-render the layered bitmap here. `renderPosterShield()` can be expensive (GDI+ scale),
+                // Do NOT re-render the layered bitmap here. `renderPosterShield()` can be expensive (full-frame scale),
                 // which delays returning to the message pump and delays composition. For loop masking we prefer
                 // to show the previously-rendered layered content immediately.
                 OverlayDbgLog("poster shown (loop) posterVisible=1 (no re-render)");
@@ -1253,9 +1680,19 @@ namespace pomodoro {
             if (wParam == kTimerStartFadeText) {
                 KillTimer(hwnd, kTimerStartFadeText);
                 startFadeTimerId_ = 0;
-                // 直接隐藏文本，避免频繁重绘导致的闪烁
-                textAlpha_ = 0;
+                // 每一步只缩放并提交标题区域（见 UiSurface），不再整屏重绘
+                if (fadeTimerId_ == 0) {
+                    fadeTimerId_ = SetTimer(hwnd, kTimerFadeTextStep, kFadeTextStepMs, nullptr);
+                }
+                return 0;
+            }
+            if (wParam == kTimerFadeTextStep) {
+                textAlpha_ = textAlpha_ > kFadeTextStepAlpha ? static_cast<BYTE>(textAlpha_ - kFadeTextStepAlpha) : 0;
                 renderUiOverlay();
+                if (textAlpha_ == 0) {
+                    KillTimer(hwnd, kTimerFadeTextStep);
+                    fadeTimerId_ = 0;
+                }
                 return 0;
             }
             if (wParam == kTimerEnsureTopmost) {
@@ -1353,38 +1790,16 @@ namespace pomodoro {
         RECT client{};
         GetClientRect(hwnd_, &client);
 
-        // 优先绘制用户配置的背景图片（填充模式，保持宽高比）
-        if (g_preparedKind == PreparedKind::Image && g_backgroundImage && g_gdiplusToken != 0) {
-            Gdiplus::Graphics graphics(hdc);
-            graphics.SetCompositingQuality(Gdiplus::CompositingQualityHighQuality);
-            graphics.SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic);
-            graphics.SetPixelOffsetMode(Gdiplus::PixelOffsetModeHighQuality);
-
-            const auto imgWidth = static_cast<float>(g_backgroundImage->GetWidth());
-            const auto imgHeight = static_cast<float>(g_backgroundImage->GetHeight());
-
-            if (imgWidth > 0.0f && imgHeight > 0.0f) {
-                const float clientWidth = static_cast<float>(client.right - client.left);
-                const float clientHeight = static_cast<float>(client.bottom - client.top);
-
-                const float scaleX = clientWidth / imgWidth;
-                const float scaleY = clientHeight / imgHeight;
-                const float scale = (scaleX > scaleY) ? scaleX : scaleY; // 等价于 max(scaleX, scaleY)
-
-                const float scaledWidth = imgWidth * scale;
-                const float scaledHeight = imgHeight * scale;
-
-                const float offsetX = (clientWidth - scaledWidth) * 0.5f;
-                const float offsetY = (clientHeight - scaledHeight) * 0.5f;
-
-                Gdiplus::RectF destRect(
-                    static_cast<Gdiplus::REAL>(client.left + offsetX),
-                    static_cast<Gdiplus::REAL>(client.top + offsetY),
-                    static_cast<Gdiplus::REAL>(scaledWidth),
-                    static_cast<Gdiplus::REAL>(scaledHeight));
-
-                graphics.DrawImage(g_backgroundImage.get(), destRect);
-            }
+        // 优先绘制用户配置的背景图片（填充模式，保持宽高比）：通常已在预取线程上按屏幕尺寸缩放好，这里直接 BitBlt
+        const int clientWidth = client.right - client.left;
+        const int clientHeight = client.bottom - client.top;
+        HBITMAP scaled = (g_preparedKind == PreparedKind::Image) ? ScaledBackgroundFor(g_backgroundPixels, clientWidth, clientHeight) : nullptr;
+        if (scaled) {
+            HDC mem = CreateCompatibleDC(hdc);
+            HGDIOBJ oldBmp = SelectObject(mem, scaled);
+            BitBlt(hdc, client.left, client.top, clientWidth, clientHeight, mem, 0, 0, SRCCOPY);
+            SelectObject(mem, oldBmp);
+            DeleteDC(mem);
         } else {
             // 没有背景图时，退回到纯黑背景
             HBRUSH brush = CreateSolidBrush(RGB(0, 0, 0));
@@ -1527,98 +1942,40 @@ namespace pomodoro {
         const int h = bounds_.bottom - bounds_.top;
         if (w <= 0 || h <= 0) return;
 
-        HDC screen = GetDC(nullptr);
-        HDC mem = CreateCompatibleDC(screen);
-
-        BITMAPINFO bi{};
-        bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-        bi.bmiHeader.biWidth = w;
-        bi.bmiHeader.biHeight = -h; // top-down
-        bi.bmiHeader.biPlanes = 1;
-        bi.bmiHeader.biBitCount = 32;
-        bi.bmiHeader.biCompression = BI_RGB;
-
-        void* bits = nullptr;
-        HBITMAP dib = CreateDIBSection(mem, &bi, DIB_RGB_COLORS, &bits, nullptr, 0);
-        HGDIOBJ oldBmp = SelectObject(mem, dib);
-
-        if (bits) {
-            memset(bits, 0, static_cast<size_t>(w) * static_cast<size_t>(h) * 4); // fully transparent
+        if (!uiSurface_) {
+            uiSurface_ = std::make_unique<UiSurface>();
         }
+        UiSurface& surface = *uiSurface_;
+        if (!surface.ensure(w, h)) return;
 
-        {
-            Gdiplus::Graphics g(mem);
-            g.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
-            g.SetTextRenderingHint(Gdiplus::TextRenderingHintClearTypeGridFit);
-
-            const UINT dpi = dpi_ ? dpi_ : 96;
-            Gdiplus::FontFamily family(L"Segoe UI");
-            const float titlePx = static_cast<float>(pomodoro::win32::Scale(32, dpi));
-            Gdiplus::Font titleFont(&family, titlePx, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
-
-            Gdiplus::StringFormat fmt;
-            fmt.SetAlignment(Gdiplus::StringAlignmentCenter);
-            fmt.SetLineAlignment(Gdiplus::StringAlignmentCenter);
-
-            const wchar_t* title = (!g_overlayMessage.empty()) ? g_overlayMessage.c_str() : L"Rest Time - PomodoroScreen";
-            Gdiplus::SolidBrush titleBrush(Gdiplus::Color(textAlpha_, 255, 255, 255));
-            Gdiplus::RectF titleRect(
-                0.0f,
-                static_cast<Gdiplus::REAL>(-pomodoro::win32::Scale(80, dpi)),
-                static_cast<Gdiplus::REAL>(w),
-                static_cast<Gdiplus::REAL>(h)
-            );
-            g.DrawString(title, -1, &titleFont, titleRect, &fmt, &titleBrush);
-
-            // Cancel button
-            const bool pressed = uiCancelPressed_;
-            const Gdiplus::Color border(255, 255, 255, 255);
-            const Gdiplus::Color fill(255, pressed ? 255 : 0, pressed ? 255 : 0, pressed ? 255 : 0);
-            const Gdiplus::Color textC(255, pressed ? 0 : 255, pressed ? 0 : 255, pressed ? 0 : 255);
-
-            Gdiplus::Rect btn(
-                uiCancelButtonRect_.left,
-                uiCancelButtonRect_.top,
-                uiCancelButtonRect_.right - uiCancelButtonRect_.left,
-                uiCancelButtonRect_.bottom - uiCancelButtonRect_.top
-            );
-            Gdiplus::SolidBrush fillBrush(fill);
-            Gdiplus::Pen borderPen(border, 1.0f);
-            g.FillRectangle(&fillBrush, btn);
-            g.DrawRectangle(&borderPen, btn);
-
-            const float btnPx = static_cast<float>(pomodoro::win32::Scale(14, dpi));
-            Gdiplus::Font btnFont(&family, btnPx, Gdiplus::FontStyleBold, Gdiplus::UnitPixel);
-            Gdiplus::SolidBrush btnTextBrush(textC);
-            Gdiplus::RectF btnRect(
-                static_cast<Gdiplus::REAL>(btn.X),
-                static_cast<Gdiplus::REAL>(btn.Y),
-                static_cast<Gdiplus::REAL>(btn.Width),
-                static_cast<Gdiplus::REAL>(btn.Height)
-            );
-            g.DrawString(L"\u53d6\u6d88\u4f11\u606f", -1, &btnFont, btnRect, &fmt, &btnTextBrush);
+        const UINT dpi = dpi_ ? dpi_ : 96;
+        const std::wstring title = (!g_overlayMessage.empty()) ? g_overlayMessage : std::wstring(kDefaultOverlayTitle);
+        const POINT position{ bounds_.left, bounds_.top };
+
+        // 尺寸、DPI、文字或按钮位置变化：整块重新栅格化
+        if (!surface.rasterized || surface.dpi != dpi || surface.title != title ||
+            !EqualRect(&surface.button, &uiCancelButtonRect_)) {
+            surface.rasterize(title, dpi, uiCancelButtonRect_, uiCancelPressed_, textAlpha_);
+            surface.present(uiOverlayWindow_, position, nullptr);
+            return;
         }
 
-        POINT ptPos{ bounds_.left, bounds_.top };
-        SIZE size{ w, h };
-        POINT ptSrc{ 0, 0 };
-        BLENDFUNCTION bf{};
-        bf.BlendOp = AC_SRC_OVER;
-        bf.SourceConstantAlpha = 255;
-        bf.AlphaFormat = AC_SRC_ALPHA;
-
-        UpdateLayeredWindow(uiOverlayWindow_, screen, &ptPos, &size, mem, &ptSrc, 0, &bf, ULW_ALPHA);
-
-        SelectObject(mem, oldBmp);
-        DeleteObject(dib);
-        DeleteDC(mem);
-        ReleaseDC(nullptr, screen);
+        RECT dirty{};
+        if (surface.pressed != uiCancelPressed_) {
+            const RECT area = surface.drawButton(uiCancelButtonRect_, uiCancelPressed_, dpi);
+            UnionRect(&dirty, &dirty, &area);
+        }
+        if (surface.titleAlpha != textAlpha_) {
+            const RECT area = surface.applyTitleAlpha(textAlpha_);
+            UnionRect(&dirty, &dirty, &area);
+        }
+        // 内容没有变化（例如 WM_PAINT）：分层窗口保留着上次提交的内容，无需再次提交
+        if (IsRectEmpty(&dirty)) return;
+        surface.present(uiOverlayWindow_, position, &dirty);
     }
 
     void OverlayWindowWin32::renderPosterShield() {
         if (!posterShieldWindow_) return;
-        EnsureGdiplusStarted();
-        if (g_gdiplusToken == 0) return;
 
         const int w = bounds_.right - bounds_.left;
         const int h = bounds_.bottom - bounds_.top;
@@ -1627,43 +1984,26 @@ namespace pomodoro {
         HDC screen = GetDC(nullptr);
         HDC mem = CreateCompatibleDC(screen);
 
-        BITMAPINFO bi{};
-        bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-        bi.bmiHeader.biWidth = w;
-        bi.bmiHeader.biHeight = -h; // top-down
-        bi.bmiHeader.biPlanes = 1;
-        bi.bmiHeader.biBitCount = 32;
-        bi.bmiHeader.biCompression = BI_RGB;
-
-        void* bits = nullptr;
-        HBITMAP dib = CreateDIBSection(mem, &bi, DIB_RGB_COLORS, &bits, nullptr, 0);
-        HGDIOBJ oldBmp = SelectObject(mem, dib);
-
-        // Default fully transparent.
-        if (bits) {
-            memset(bits, 0, static_cast<size_t>(w) * static_cast<size_t>(h) * 4);
-        }
-
-        if (posterVisible_ && g_videoPoster) {
-            Gdiplus::Graphics g(mem);
-            g.SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic);
-            g.SetSmoothingMode(Gdiplus::SmoothingModeHighQuality);
-
-            const int srcW = static_cast<int>(g_videoPoster->GetWidth());
-            const int srcH = static_cast<int>(g_videoPoster->GetHeight());
-            if (srcW > 0 && srcH > 0) {
-                const double scaleX = static_cast<double>(w) / static_cast<double>(srcW);
-                const double scaleY = static_cast<double>(h) / static_cast<double>(srcH);
-                const double scale = (scaleX > scaleY) ? scaleX : scaleY; // cover
-
-                const int drawW = static_cast<int>(srcW * scale);
-                const int drawH = static_cast<int>(srcH * scale);
-                const int drawX = (w - drawW) / 2;
-                const int drawY = (h - drawH) / 2;
-
-                g.DrawImage(g_videoPoster.get(), Gdiplus::Rect(drawX, drawY, drawW, drawH));
+        // 海报帧（填充模式）按屏幕尺寸缩放一次后缓存，循环播放时重复显示不再重新缩放
+        HBITMAP poster = posterVisible_ ? ScaledBackgroundFor(g_videoPoster, w, h) : nullptr;
+        HBITMAP transparent = nullptr;
+        if (!poster) {
+            // Default fully transparent.
+            BITMAPINFO bi{};
+            bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            bi.bmiHeader.biWidth = w;
+            bi.bmiHeader.biHeight = -h; // top-down
+            bi.bmiHeader.biPlanes = 1;
+            bi.bmiHeader.biBitCount = 32;
+            bi.bmiHeader.biCompression = BI_RGB;
+
+            void* bits = nullptr;
+            transparent = CreateDIBSection(mem, &bi, DIB_RGB_COLORS, &bits, nullptr, 0);
+            if (bits) {
+                memset(bits, 0, static_cast<size_t>(w) * static_cast<size_t>(h) * 4);
             }
         }
+        HGDIOBJ oldBmp = SelectObject(mem, poster ? poster : transparent);
 
         POINT ptPos{ bounds_.left, bounds_.top };
         SIZE size{ w, h };
@@ -1676,7 +2016,7 @@ namespace pomodoro {
         UpdateLayeredWindow(posterShieldWindow_, screen, &ptPos, &size, mem, &ptSrc, 0, &bf, ULW_ALPHA);
 
         SelectObject(mem, oldBmp);
-        DeleteObject(dib);
+        if (transparent) DeleteObject(transparent);
         DeleteDC(mem);
         ReleaseDC(nullptr, screen);
     }
@@ -19,6 +19,7 @@
 namespace pomodoro {
 
     struct OverlayVideoPlayerWin32;
+    class BackgroundSettingsWin32;
     LRESULT CALLBACK OverlayUiWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
     LRESULT CALLBACK OverlayPosterShieldWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
@@ -27,8 +28,16 @@ namespace pomodoro {
         using DismissCallback = std::function<void()>;
 
         // Called once per rest cycle (before creating per-monitor overlays).
-        // Picks the next background from settings and prepares shared resources (image/video/poster).
-        static void PrepareNextBackgroundForRest();
+        // Picks the next background from the shared in-memory settings and prepares shared resources
+        // (image/video/poster). No settings I/O happens here; the owner keeps the settings up to date.
+        static void PrepareNextBackgroundForRest(const BackgroundSettingsWin32& settings);
+
+        // Starts selecting and decoding the next background on a worker thread (call shortly before the
+        // rest starts, repeated calls are cheap). PrepareNextBackgroundForRest then only swaps it in.
+        static void PrefetchNextBackground(const BackgroundSettingsWin32& settings);
+
+        // Stops the prefetch worker; call before process teardown.
+        static void ShutdownBackgroundPrefetch();
 
         OverlayWindowWin32();
         ~OverlayWindowWin32();
@@ -51,6 +60,9 @@ namespace pomodoro {
         friend LRESULT CALLBACK OverlayUiWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
         friend LRESULT CALLBACK OverlayPosterShieldWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
+        // 界面层窗口的持久表面（定义见 .cpp）
+        struct UiSurface;
+
         // 实例级别的消息处理（显式传入 hwnd，避免在 WM_NCCREATE 阶段 hwnd_ 仍为 null）
         LRESULT handleMessage(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
@@ -83,6 +95,8 @@ namespace pomodoro {
         HWND uiOverlayWindow_{ nullptr };
         RECT uiCancelButtonRect_{};
         bool uiCancelPressed_{ false };
+        // 每个屏幕一份，只有尺寸、DPI 或文字变化时才整块重新栅格化
+        std::unique_ptr<UiSurface> uiSurface_{};
 
         // Poster shield window (non-layered) to cover transient black frames from video presenter.
         HWND posterShieldWindow_{ nullptr };
@@ -0,0 +1,96 @@
+#include "PixelKernels.h"
+
+#include "PixelKernelsDetail.h"
+
+#include <cstring>
+
+namespace pomodoro {
+
+    namespace {
+
+        // 精确舍入的 x / 255（x <= 255 * 255）
+        inline std::uint8_t DivideBy255(unsigned x) noexcept {
+            const unsigned t = x + 128;
+            return static_cast<std::uint8_t>((t + (t >> 8)) >> 8);
+        }
+
+        void BgrxToBgraOpaque(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+            for (std::size_t i = 0; i < count * 4; i += 4) {
+                dst[i + 0] = src[i + 0];
+                dst[i + 1] = src[i + 1];
+                dst[i + 2] = src[i + 2];
+                dst[i + 3] = 0xFF;
+            }
+        }
+
+        void Premultiply(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+            for (std::size_t i = 0; i < count * 4; i += 4) {
+                const unsigned a = src[i + 3];
+                dst[i + 0] = DivideBy255(src[i + 0] * a);
+                dst[i + 1] = DivideBy255(src[i + 1] * a);
+                dst[i + 2] = DivideBy255(src[i + 2] * a);
+                dst[i + 3] = static_cast<std::uint8_t>(a);
+            }
+        }
+
+        void Unpremultiply(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+            for (std::size_t i = 0; i < count * 4; i += 4) {
+                const unsigned a = src[i + 3];
+                if (a == 0) {
+                    dst[i + 0] = dst[i + 1] = dst[i + 2] = dst[i + 3] = 0;
+                    continue;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    const unsigned v = (src[i + c] * 255u + a / 2) / a;
+                    dst[i + c] = static_cast<std::uint8_t>(v > 255 ? 255 : v);
+                }
+                dst[i + 3] = static_cast<std::uint8_t>(a);
+            }
+        }
+
+        void ScaleAlpha(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) {
+            for (std::size_t i = 0; i < count * 4; ++i) {
+                dst[i] = DivideBy255(src[i] * static_cast<unsigned>(alpha));
+            }
+        }
+
+        void Fill(std::uint8_t* dst, std::size_t count, std::uint32_t bgra) {
+            const std::uint8_t pixel[4] = {
+                static_cast<std::uint8_t>(bgra), static_cast<std::uint8_t>(bgra >> 8),
+                static_cast<std::uint8_t>(bgra >> 16), static_cast<std::uint8_t>(bgra >> 24),
+            };
+            for (std::size_t i = 0; i < count; ++i) {
+                std::memcpy(dst + i * 4, pixel, 4);
+            }
+        }
+
+        const PixelKernels kScalarKernels{ BgrxToBgraOpaque, Premultiply, Unpremultiply, ScaleAlpha, Fill };
+
+    } // namespace
+
+    namespace detail {
+
+        const PixelKernels& scalarPixelKernels() noexcept { return kScalarKernels; }
+
+    } // namespace detail
+
+    const PixelKernels* pixelKernelsFor(SimdLevel level) noexcept {
+        if (!simdLevelSupported(level)) return nullptr;
+        switch (level) {
+        case SimdLevel::Scalar: return &kScalarKernels;
+        case SimdLevel::Sse41: return detail::sse41PixelKernels();
+        case SimdLevel::Avx2: return detail::avx2PixelKernels();
+        case SimdLevel::Neon: return detail::neonPixelKernels();
+        }
+        return nullptr;
+    }
+
+    const PixelKernels& pixelKernels() noexcept {
+        static const PixelKernels* const best = [] {
+            const PixelKernels* kernels = pixelKernelsFor(bestSimdLevel());
+            return kernels ? kernels : &kScalarKernels;
+        }();
+        return *best;
+    }
+
+} // namespace pomodoro
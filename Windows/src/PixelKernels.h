@@ -0,0 +1,40 @@
+#pragma once
+
+// Whole-buffer pixel format kernels for 32-bpp BGRA (the byte order of a 32-bpp DIB, of Media
+// Foundation RGB32 and of GDI+ PixelFormat32bppARGB / PARGB).
+//
+// Each kernel processes `count` consecutive pixels. dst may equal src for in-place conversion; partial
+// overlap is not allowed. Every instruction set gives the same bytes as the scalar reference:
+//
+// - bgrxToBgraOpaque: copy B, G, R and set A = 255. Media Foundation RGB32 leaves A undefined.
+// - premultiply:      c' = round(c * a / 255) for B, G and R. A is unchanged.
+// - unpremultiply:    c' = min(255, floor((c * 255 + a / 2) / a)). A is unchanged, and a = 0 gives 0.
+// - scaleAlpha:       every channel, including A, becomes round(c * k / 255). This applies a constant
+//                     opacity to premultiplied pixels.
+// - fill:             write the same pixel (0xAARRGGBB, stored as B, G, R, A) everywhere. 0 clears.
+//
+// round(x / 255) is computed exactly as (t + (t >> 8)) >> 8 with t = x + 128, which is why SIMD lanes can
+// use 16-bit arithmetic and still match the reference.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CpuFeatures.h"
+
+namespace pomodoro {
+
+    struct PixelKernels {
+        void (*bgrxToBgraOpaque)(const std::uint8_t* src, std::uint8_t* dst, std::size_t count);
+        void (*premultiply)(const std::uint8_t* src, std::uint8_t* dst, std::size_t count);
+        void (*unpremultiply)(const std::uint8_t* src, std::uint8_t* dst, std::size_t count);
+        void (*scaleAlpha)(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha);
+        void (*fill)(std::uint8_t* dst, std::size_t count, std::uint32_t bgra);
+    };
+
+    // 指定指令集的内核（测试与基准用）；本机不支持时返回 nullptr
+    const PixelKernels* pixelKernelsFor(SimdLevel level) noexcept;
+
+    // 当前 CPU 上最快的一组内核
+    const PixelKernels& pixelKernels() noexcept;
+
+} // namespace pomodoro
@@ -0,0 +1,117 @@
+// AVX2 pixel kernels (compiled with -mavx2 or /arch:AVX2; see CMakeLists.txt).
+
+#include "PixelKernelsDetail.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        namespace {
+
+            inline __m256i DivideBy255(__m256i x) noexcept {
+                const __m256i t = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+                return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+            }
+
+            inline __m256i BroadcastAlpha(__m256i wide) noexcept {
+                return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(wide, 0xFF), 0xFF);
+            }
+
+            // 每次 8 个像素（32 字节）。解包与打包都只在 128 位半边内进行，二者互逆，像素顺序不变
+            void BgrxToBgraOpaque(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                const __m256i opaque = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_or_si256(v, opaque));
+                }
+                scalarPixelKernels().bgrxToBgraOpaque(src + i * 4, dst + i * 4, count - i);
+            }
+
+            void Premultiply(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i alphaBytes = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                    const __m256i lo = _mm256_unpacklo_epi8(v, zero);
+                    const __m256i hi = _mm256_unpackhi_epi8(v, zero);
+                    const __m256i pl = DivideBy255(_mm256_mullo_epi16(lo, BroadcastAlpha(lo)));
+                    const __m256i ph = DivideBy255(_mm256_mullo_epi16(hi, BroadcastAlpha(hi)));
+                    const __m256i out = _mm256_blendv_epi8(_mm256_packus_epi16(pl, ph), v, alphaBytes);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), out);
+                }
+                scalarPixelKernels().premultiply(src + i * 4, dst + i * 4, count - i);
+            }
+
+            // 两个像素（每个 128 位半边一个）的 32 位分量，算法同 SSE4.1 版本
+            inline __m256i UnpremultiplyPixels(__m256i p) noexcept {
+                const __m256i a = _mm256_shuffle_epi32(p, 0xFF);
+                const __m256i numerator = _mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(p, 8), p), _mm256_srli_epi32(a, 1));
+                __m256i q = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(numerator), _mm256_cvtepi32_ps(a)));
+                q = _mm256_min_epi32(q, _mm256_set1_epi32(255));
+                q = _mm256_blend_epi16(q, p, 0xC0);
+                return _mm256_andnot_si256(_mm256_cmpeq_epi32(a, _mm256_setzero_si256()), q);
+            }
+
+            void Unpremultiply(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                // 打包后半边交错为 0 2 4 6 | 1 3 5 7，按 32 位重排回原顺序
+                const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    const std::uint8_t* p = src + i * 4;
+                    const __m256i q0 = UnpremultiplyPixels(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+                    const __m256i q1 = UnpremultiplyPixels(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + 8))));
+                    const __m256i q2 = UnpremultiplyPixels(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + 16))));
+                    const __m256i q3 = UnpremultiplyPixels(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + 24))));
+                    const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(q0, q1), _mm256_packs_epi32(q2, q3));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_permutevar8x32_epi32(packed, order));
+                }
+                scalarPixelKernels().unpremultiply(src + i * 4, dst + i * 4, count - i);
+            }
+
+            void ScaleAlpha(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i k = _mm256_set1_epi16(alpha);
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                    const __m256i lo = DivideBy255(_mm256_mullo_epi16(_mm256_unpacklo_epi8(v, zero), k));
+                    const __m256i hi = DivideBy255(_mm256_mullo_epi16(_mm256_unpackhi_epi8(v, zero), k));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(lo, hi));
+                }
+                scalarPixelKernels().scaleAlpha(src + i * 4, dst + i * 4, count - i, alpha);
+            }
+
+            void Fill(std::uint8_t* dst, std::size_t count, std::uint32_t bgra) {
+                const __m256i v = _mm256_set1_epi32(static_cast<int>(bgra));
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), v);
+                }
+                scalarPixelKernels().fill(dst + i * 4, count - i, bgra);
+            }
+
+            const PixelKernels kKernels{ BgrxToBgraOpaque, Premultiply, Unpremultiply, ScaleAlpha, Fill };
+
+        } // namespace
+
+        const PixelKernels* avx2PixelKernels() noexcept { return &kKernels; }
+
+    } // namespace detail
+
+} // namespace pomodoro
+
+#else
+
+namespace pomodoro {
+    namespace detail {
+        const PixelKernels* avx2PixelKernels() noexcept { return nullptr; }
+    } // namespace detail
+} // namespace pomodoro
+
+#endif
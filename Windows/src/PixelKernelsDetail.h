@@ -0,0 +1,22 @@
+#pragma once
+
+// Internal to PixelKernels: the per-instruction-set tables, in the same one-file-per-instruction-set layout
+// as ImageResamplerKernels.h and, like it, without inline code. The vector implementations hand the
+// leftover pixels at the end of a buffer to the scalar reference.
+
+#include "PixelKernels.h"
+
+namespace pomodoro {
+
+    namespace detail {
+
+        const PixelKernels& scalarPixelKernels() noexcept;
+
+        // 本构建未包含对应指令集时返回 nullptr
+        const PixelKernels* sse41PixelKernels() noexcept;
+        const PixelKernels* avx2PixelKernels() noexcept;
+        const PixelKernels* neonPixelKernels() noexcept;
+
+    } // namespace detail
+
+} // namespace pomodoro
@@ -0,0 +1,117 @@
+// NEON pixel kernels (ARM64, where NEON is part of the base instruction set).
+
+#include "PixelKernelsDetail.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        namespace {
+
+            // 精确舍入的 x / 255：t = x + 128，vaddhn 取 (t + (t >> 8)) 的高 8 位
+            inline uint8x8_t DivideBy255(uint16x8_t x) noexcept {
+                const uint16x8_t t = vaddq_u16(x, vdupq_n_u16(128));
+                return vaddhn_u16(t, vshrq_n_u16(t, 8));
+            }
+
+            inline uint8x16_t MultiplyDivide255(uint8x16_t c, uint8x16_t k) noexcept {
+                return vcombine_u8(DivideBy255(vmull_u8(vget_low_u8(c), vget_low_u8(k))),
+                    DivideBy255(vmull_u8(vget_high_u8(c), vget_high_u8(k))));
+            }
+
+            void BgrxToBgraOpaque(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                const uint8x16_t opaque = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000u));
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    vst1q_u8(dst + i * 4, vorrq_u8(vld1q_u8(src + i * 4), opaque));
+                }
+                scalarPixelKernels().bgrxToBgraOpaque(src + i * 4, dst + i * 4, count - i);
+            }
+
+            // 每次 16 个像素；vld4 / vst4 把 B、G、R、A 拆成独立的向量
+            void Premultiply(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    uint8x16x4_t px = vld4q_u8(src + i * 4);
+                    px.val[0] = MultiplyDivide255(px.val[0], px.val[3]);
+                    px.val[1] = MultiplyDivide255(px.val[1], px.val[3]);
+                    px.val[2] = MultiplyDivide255(px.val[2], px.val[3]);
+                    vst4q_u8(dst + i * 4, px);
+                }
+                scalarPixelKernels().premultiply(src + i * 4, dst + i * 4, count - i);
+            }
+
+            // (c * 255 + a / 2) / a，单精度除法后截断（理由见 SSE4.1 版本）；a == 0 时为 0
+            inline uint16x4_t Unpremultiply4(uint16x4_t c, uint16x4_t a) noexcept {
+                const uint32x4_t a32 = vmovl_u16(a);
+                const uint32x4_t numerator = vmlal_n_u16(vshrq_n_u32(a32, 1), c, 255);
+                uint32x4_t q = vcvtq_u32_f32(vdivq_f32(vcvtq_f32_u32(numerator), vcvtq_f32_u32(a32)));
+                q = vminq_u32(q, vdupq_n_u32(255));
+                return vmovn_u32(vandq_u32(q, vtstq_u32(a32, a32)));
+            }
+
+            inline uint8x16_t UnpremultiplyChannel(uint8x16_t c, uint8x16_t a) noexcept {
+                const uint16x8_t cl = vmovl_u8(vget_low_u8(c));
+                const uint16x8_t ch = vmovl_u8(vget_high_u8(c));
+                const uint16x8_t al = vmovl_u8(vget_low_u8(a));
+                const uint16x8_t ah = vmovl_u8(vget_high_u8(a));
+                const uint16x8_t lo = vcombine_u16(Unpremultiply4(vget_low_u16(cl), vget_low_u16(al)),
+                    Unpremultiply4(vget_high_u16(cl), vget_high_u16(al)));
+                const uint16x8_t hi = vcombine_u16(Unpremultiply4(vget_low_u16(ch), vget_low_u16(ah)),
+                    Unpremultiply4(vget_high_u16(ch), vget_high_u16(ah)));
+                return vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+            }
+
+            void Unpremultiply(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                std::size_t i = 0;
+                for (; i + 16 <= count; i += 16) {
+                    uint8x16x4_t px = vld4q_u8(src + i * 4);
+                    px.val[0] = UnpremultiplyChannel(px.val[0], px.val[3]);
+                    px.val[1] = UnpremultiplyChannel(px.val[1], px.val[3]);
+                    px.val[2] = UnpremultiplyChannel(px.val[2], px.val[3]);
+                    vst4q_u8(dst + i * 4, px);
+                }
+                scalarPixelKernels().unpremultiply(src + i * 4, dst + i * 4, count - i);
+            }
+
+            void ScaleAlpha(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) {
+                const uint8x16_t k = vdupq_n_u8(alpha);
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    vst1q_u8(dst + i * 4, MultiplyDivide255(vld1q_u8(src + i * 4), k));
+                }
+                scalarPixelKernels().scaleAlpha(src + i * 4, dst + i * 4, count - i, alpha);
+            }
+
+            void Fill(std::uint8_t* dst, std::size_t count, std::uint32_t bgra) {
+                const uint8x16_t v = vreinterpretq_u8_u32(vdupq_n_u32(bgra));
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    vst1q_u8(dst + i * 4, v);
+                }
+                scalarPixelKernels().fill(dst + i * 4, count - i, bgra);
+            }
+
+            const PixelKernels kKernels{ BgrxToBgraOpaque, Premultiply, Unpremultiply, ScaleAlpha, Fill };
+
+        } // namespace
+
+        const PixelKernels* neonPixelKernels() noexcept { return &kKernels; }
+
+    } // namespace detail
+
+} // namespace pomodoro
+
+#else
+
+namespace pomodoro {
+    namespace detail {
+        const PixelKernels* neonPixelKernels() noexcept { return nullptr; }
+    } // namespace detail
+} // namespace pomodoro
+
+#endif
@@ -0,0 +1,118 @@
+// SSE4.1 pixel kernels (compiled with -msse4.1 on GCC/Clang; see CMakeLists.txt).
+
+#include "PixelKernelsDetail.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <smmintrin.h>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        namespace {
+
+            // 每个 16 位分量的精确舍入 x / 255：t = x + 128，(t + (t >> 8)) >> 8
+            inline __m128i DivideBy255(__m128i x) noexcept {
+                const __m128i t = _mm_add_epi16(x, _mm_set1_epi16(128));
+                return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+            }
+
+            // 两个像素（8 个 16 位分量）中每个像素的 alpha 铺满该像素的 4 个分量
+            inline __m128i BroadcastAlpha(__m128i wide) noexcept {
+                return _mm_shufflehi_epi16(_mm_shufflelo_epi16(wide, 0xFF), 0xFF);
+            }
+
+            void BgrxToBgraOpaque(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(v, opaque));
+                }
+                scalarPixelKernels().bgrxToBgraOpaque(src + i * 4, dst + i * 4, count - i);
+            }
+
+            void Premultiply(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i alphaBytes = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+                    const __m128i pl = DivideBy255(_mm_mullo_epi16(lo, BroadcastAlpha(lo)));
+                    const __m128i ph = DivideBy255(_mm_mullo_epi16(hi, BroadcastAlpha(hi)));
+                    // alpha 通道保持原值
+                    const __m128i out = _mm_blendv_epi8(_mm_packus_epi16(pl, ph), v, alphaBytes);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+                }
+                scalarPixelKernels().premultiply(src + i * 4, dst + i * 4, count - i);
+            }
+
+            // 一个像素的 4 个 32 位分量：(c * 255 + a / 2) / a，用单精度除法（分子、分母都是精确整数，
+            // 商小于 256 时与整数除法的截断结果相同，更大的结果反正会被限制到 255）
+            inline __m128i UnpremultiplyPixel(__m128i p) noexcept {
+                const __m128i a = _mm_shuffle_epi32(p, 0xFF);
+                const __m128i numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(p, 8), p), _mm_srli_epi32(a, 1));
+                __m128i q = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(numerator), _mm_cvtepi32_ps(a)));
+                q = _mm_min_epi32(q, _mm_set1_epi32(255));
+                q = _mm_blend_epi16(q, p, 0xC0);  // alpha 保持原值
+                return _mm_andnot_si128(_mm_cmpeq_epi32(a, _mm_setzero_si128()), q);  // a == 0 时全部为 0
+            }
+
+            void Unpremultiply(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) {
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                    const __m128i p0 = UnpremultiplyPixel(_mm_cvtepu8_epi32(v));
+                    const __m128i p1 = UnpremultiplyPixel(_mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+                    const __m128i p2 = UnpremultiplyPixel(_mm_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+                    const __m128i p3 = UnpremultiplyPixel(_mm_cvtepu8_epi32(_mm_srli_si128(v, 12)));
+                    const __m128i out = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+                }
+                scalarPixelKernels().unpremultiply(src + i * 4, dst + i * 4, count - i);
+            }
+
+            void ScaleAlpha(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i k = _mm_set1_epi16(alpha);
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                    const __m128i lo = DivideBy255(_mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), k));
+                    const __m128i hi = DivideBy255(_mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), k));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+                }
+                scalarPixelKernels().scaleAlpha(src + i * 4, dst + i * 4, count - i, alpha);
+            }
+
+            void Fill(std::uint8_t* dst, std::size_t count, std::uint32_t bgra) {
+                const __m128i v = _mm_set1_epi32(static_cast<int>(bgra));
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), v);
+                }
+                scalarPixelKernels().fill(dst + i * 4, count - i, bgra);
+            }
+
+            const PixelKernels kKernels{ BgrxToBgraOpaque, Premultiply, Unpremultiply, ScaleAlpha, Fill };
+
+        } // namespace
+
+        const PixelKernels* sse41PixelKernels() noexcept { return &kKernels; }
+
+    } // namespace detail
+
+} // namespace pomodoro
+
+#else
+
+namespace pomodoro {
+    namespace detail {
+        const PixelKernels* sse41PixelKernels() noexcept { return nullptr; }
+    } // namespace detail
+} // namespace pomodoro
+
+#endif
@@ -1,15 +1,42 @@
 #include "PomodoroTimer.h"
+#include "TimeTextFormatter.h"
 
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
 
 namespace pomodoro {
 
+    namespace {
+        // 剩余时长向上取整到整秒：例如 25 分钟的番茄钟在第一秒走完之前一直显示 25:00
+        int CeilSeconds(PomodoroTimer::Clock::duration d) {
+            if (d <= PomodoroTimer::Clock::duration::zero()) return 0;
+            return static_cast<int>(std::chrono::ceil<std::chrono::seconds>(d).count());
+        }
+    } // namespace
+
+    class PomodoroTimer::TransitionScope {
+    public:
+        explicit TransitionScope(PomodoroTimer& timer) : timer_(timer) { ++timer_.transitionDepth_; }
+        ~TransitionScope() {
+            if (--timer_.transitionDepth_ == 0) timer_.commitTransition();
+        }
+
+        TransitionScope(const TransitionScope&) = delete;
+        TransitionScope& operator=(const TransitionScope&) = delete;
+
+    private:
+        PomodoroTimer& timer_;
+    };
+
     PomodoroTimer::PomodoroTimer()
-        : stateMachine_(AutoRestartSettings{}) {
+        : PomodoroTimer(SteadyClock::instance()) {}
+
+    PomodoroTimer::PomodoroTimer(const MonotonicClock& clock)
+        : clock_(&clock)
+        , stateMachine_(AutoRestartSettings{}, clock) {
         // 默认设置，可被 updateSettings 覆盖
         Settings s;
         updateSettings(s);
+        lastCommitted_ = persistedFingerprint();
     }
 
     void PomodoroTimer::updateSettings(const Settings& s) {
@@ -35,62 +62,92 @@ namespace pomodoro {
         stateMachine_.updateSettings(machineSettings);
     }
 
-    void PomodoroTimer::tickOneSecond() {
+    void PomodoroTimer::tick() {
+        const TransitionScope scope(*this);
         if (!isRunning()) return;
 
-        if (remainingSeconds_ > 0) {
-            --remainingSeconds_;
-            updateTimeDisplay();
+        const auto left = deadline_ - clock_->now();
+        if (left <= Clock::duration::zero()) {
+            handlePhaseFinished();
             return;
         }
 
-        handlePhaseFinished();
+        if (CeilSeconds(left) != lastDisplayedSeconds_) {
+            updateTimeDisplay();
+        }
+    }
+
+    PomodoroTimer::Clock::time_point PomodoroTimer::nextWakeup() const {
+        if (!isRunning()) return Clock::time_point::max();
+
+        const auto now = clock_->now();
+        const auto left = deadline_ - now;
+        if (left <= Clock::duration::zero()) return now;
+
+        // 显示值为 ceil(left)，下一次变化发生在剩余时间降到 ceil(left) - 1 秒的时刻
+        const auto shown = std::chrono::ceil<Seconds>(left);
+        return deadline_ - (shown - Seconds(1));
+    }
+
+    PomodoroTimer::Clock::time_point PomodoroTimer::phaseDeadline() const {
+        return isRunning() ? deadline_ : Clock::time_point::max();
+    }
+
+    int PomodoroTimer::remainingSeconds() const {
+        return CeilSeconds(remaining());
     }
 
     void PomodoroTimer::finishNow() {
+        const TransitionScope scope(*this);
         // Force-finish regardless of remaining seconds; preserve "phase finished" logic.
-        remainingSeconds_ = 0;
+        setRemaining(Clock::duration::zero());
         handlePhaseFinished();
     }
 
     void PomodoroTimer::start() {
+        const TransitionScope scope(*this);
         // 如果处于熬夜强制睡眠，则只触发遮罩，由 UI 层处理
         if (stateMachine_.isInStayUpTime()) {
             onForcedSleepTriggered();
             return;
         }
 
-        remainingSeconds_ = pomodoroSeconds_;
+        publishRestCancelledIfResting();
+        setRemaining(Seconds(pomodoroSeconds_));
         stateMachine_.setTimerType(TimerType::Pomodoro);
-        stateMachine_.processEvent(AutoRestartEvent::TimerStarted);
+        dispatch(AutoRestartEvent::TimerStarted);
         updateTimeDisplay();
     }
 
     void PomodoroTimer::stop() {
-        stateMachine_.processEvent(AutoRestartEvent::TimerStopped);
+        const TransitionScope scope(*this);
+        publishRestCancelledIfResting();
+        dispatch(AutoRestartEvent::TimerStopped);
         updateTimeDisplay();
     }
 
     void PomodoroTimer::pause() {
+        const TransitionScope scope(*this);
         if (!isRunning()) return;
-        stateMachine_.processEvent(AutoRestartEvent::TimerPaused);
+        dispatch(AutoRestartEvent::TimerPaused);
         updateTimeDisplay();
     }
 
     void PomodoroTimer::resume() {
+        const TransitionScope scope(*this);
         // 仅在状态机认为处于“暂停”状态时才允许恢复
         if (!stateMachine_.isInPausedState()) return;
 
         // 如果已经走到 0 秒，再次点击“启动”视为重新开始一轮番茄
-        if (remainingSeconds_ <= 0) {
-            remainingSeconds_ = pomodoroSeconds_;
+        if (remaining() <= Clock::duration::zero()) {
+            setRemaining(Seconds(pomodoroSeconds_));
             updateTimeDisplay();
             return;
         }
 
-        // 恢复时让状态机重新进入 TimerRunning 状态，不改变剩余时间
+        // 恢复时让状态机重新进入 TimerRunning 状态，不改变剩余时间（dispatch 会按剩余时间重新布置截止时间）
         // 这里复用 TimerStarted 事件，只触发状态迁移，不需要额外动作
-        auto action = stateMachine_.processEvent(AutoRestartEvent::TimerStarted);
+        auto action = dispatch(AutoRestartEvent::TimerStarted);
         handleAutoRestartAction(action);
     }
 
@@ -103,7 +160,8 @@ namespace pomodoro {
     }
 
     bool PomodoroTimer::canResume() const {
-        return isPausedState() || (remainingSeconds_ > 0 && remainingSeconds_ < totalCurrentSeconds());
+        const auto left = remaining();
+        return isPausedState() || (left > Clock::duration::zero() && left < Seconds(totalCurrentSeconds()));
     }
 
     bool PomodoroTimer::isInRestPeriod() const {
@@ -114,50 +172,276 @@ namespace pomodoro {
         return stateMachine_.isRestTimerRunning();
     }
 
+    bool PomodoroTimer::isInForcedSleep() const {
+        return stateMachine_.isInForcedSleep();
+    }
+
     void PomodoroTimer::onIdleTimeExceeded() {
-        auto action = stateMachine_.processEvent(AutoRestartEvent::IdleTimeExceeded);
+        const TransitionScope scope(*this);
+        auto action = dispatch(AutoRestartEvent::IdleTimeExceeded);
         handleAutoRestartAction(action);
     }
 
     void PomodoroTimer::onUserActivity() {
-        auto action = stateMachine_.processEvent(AutoRestartEvent::UserActivityDetected);
+        const TransitionScope scope(*this);
+        auto action = dispatch(AutoRestartEvent::UserActivityDetected);
         handleAutoRestartAction(action);
     }
 
     void PomodoroTimer::onScreenLocked() {
-        auto action = stateMachine_.processEvent(AutoRestartEvent::ScreenLocked);
+        const TransitionScope scope(*this);
+        auto action = dispatch(AutoRestartEvent::ScreenLocked);
         handleAutoRestartAction(action);
     }
 
     void PomodoroTimer::onScreenUnlocked() {
-        auto action = stateMachine_.processEvent(AutoRestartEvent::ScreenUnlocked);
+        const TransitionScope scope(*this);
+        auto action = dispatch(AutoRestartEvent::ScreenUnlocked);
         handleAutoRestartAction(action);
     }
 
     void PomodoroTimer::onScreensaverStarted() {
-        auto action = stateMachine_.processEvent(AutoRestartEvent::ScreensaverStarted);
+        const TransitionScope scope(*this);
+        auto action = dispatch(AutoRestartEvent::ScreensaverStarted);
         handleAutoRestartAction(action);
     }
 
     void PomodoroTimer::onScreensaverStopped() {
+        const TransitionScope scope(*this);
         stateMachine_.markScreensaverResumedNow();
-        auto action = stateMachine_.processEvent(AutoRestartEvent::ScreensaverStopped);
+        auto action = dispatch(AutoRestartEvent::ScreensaverStopped);
         handleAutoRestartAction(action);
     }
 
     void PomodoroTimer::onForcedSleepTriggered() {
+        const TransitionScope scope(*this);
+        const bool wasInForcedSleep = isInForcedSleep();
         stateMachine_.setStayUpTime(true);
-        auto action = stateMachine_.processEvent(AutoRestartEvent::ForcedSleepTriggered);
+        auto action = dispatch(AutoRestartEvent::ForcedSleepTriggered);
         handleAutoRestartAction(action);
+        if (!wasInForcedSleep && isInForcedSleep()) {
+            publish(TimerEventKind::StayUpTriggered);
+        }
     }
 
     void PomodoroTimer::onForcedSleepEnded() {
+        const TransitionScope scope(*this);
         stateMachine_.setStayUpTime(false);
-        auto action = stateMachine_.processEvent(AutoRestartEvent::ForcedSleepEnded);
+        auto action = dispatch(AutoRestartEvent::ForcedSleepEnded);
         handleAutoRestartAction(action);
         if (onForcedSleepEndedCallback) {
             onForcedSleepEndedCallback();
         }
+        publish(TimerEventKind::ForcedSleepEnded);
+    }
+
+    TimerStateSnapshot PomodoroTimer::snapshot() const {
+        return makeSnapshot(remainingSeconds());
+    }
+
+    TimerStateSnapshot PomodoroTimer::makeSnapshot(int remainingSeconds) const {
+        using S = AutoRestartState;
+        TimerStateSnapshot s;
+        s.state = stateMachine_.getCurrentState();
+        s.timerType = stateMachine_.getCurrentTimerType();
+        s.remainingSeconds = remainingSeconds;
+        s.completedPomodoros = completedPomodoros_;
+        s.isMeetingMode = meetingMode_;
+
+        // 一次 switch 得到全部状态标志，与 AutoRestartStateMachine 的各个 is* 查询保持一致
+        switch (s.state) {
+        case S::TimerRunning:
+            s.isRunning = true;
+            break;
+        case S::RestTimerRunning:
+            s.isRunning = true;
+            s.isInRestPeriod = true;
+            s.isRestTimerRunning = true;
+            break;
+        case S::TimerPausedByUser:
+        case S::TimerPausedByIdle:
+        case S::TimerPausedBySystem:
+            s.isPaused = true;
+            break;
+        case S::RestTimerPausedByUser:
+        case S::RestTimerPausedBySystem:
+            s.isPaused = true;
+            s.isInRestPeriod = true;
+            break;
+        case S::RestPeriod:
+            s.isInRestPeriod = true;
+            break;
+        case S::ForcedSleep:
+            s.isInForcedSleep = true;
+            break;
+        case S::Idle:
+        case S::AwaitingRestart:
+            break;
+        }
+        return s;
+    }
+
+    TimerSnapshot PomodoroTimer::captureSnapshot(std::int64_t wallClockMs) const {
+        TimerSnapshot s;
+        s.completedPomodoros = completedPomodoros_;
+        s.savedAtUnixMs = wallClockMs;
+        s.remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(remaining()).count();
+        s.state = static_cast<std::uint8_t>(stateMachine_.getCurrentState());
+        s.timerType = static_cast<std::uint8_t>(stateMachine_.getCurrentTimerType());
+        s.flags = static_cast<std::uint8_t>((isLongBreak_ ? TimerSnapshot::kFlagLongBreak : 0) |
+            (stateMachine_.isInStayUpTime() ? TimerSnapshot::kFlagStayUpTime : 0));
+        sealTimerSnapshot(s);
+        return s;
+    }
+
+    bool PomodoroTimer::restoreSnapshot(const TimerSnapshot& snapshot, std::int64_t wallClockMs) {
+        if (!isValidTimerSnapshot(snapshot)) return false;
+        if (snapshot.state > static_cast<std::uint8_t>(AutoRestartState::ForcedSleep)) return false;
+        if (snapshot.timerType > static_cast<std::uint8_t>(TimerType::LongBreak)) return false;
+        if (snapshot.remainingMs < 0 || snapshot.completedPomodoros < 0) return false;
+
+        completedPomodoros_ = snapshot.completedPomodoros;
+        isLongBreak_ = (snapshot.flags & TimerSnapshot::kFlagLongBreak) != 0;
+        stateMachine_.setStayUpTime((snapshot.flags & TimerSnapshot::kFlagStayUpTime) != 0);
+        stateMachine_.setTimerType(static_cast<TimerType>(snapshot.timerType));
+        stateMachine_.restoreState(static_cast<AutoRestartState>(snapshot.state));
+
+        auto left = std::chrono::milliseconds(snapshot.remainingMs);
+        if (isRunning()) {
+            // 运行中的阶段在停机期间照常流逝；墙钟被往回调时不倒加时间
+            const auto elapsed = std::chrono::milliseconds(std::max<std::int64_t>(0, wallClockMs - snapshot.savedAtUnixMs));
+            left = (elapsed < left) ? left - elapsed : std::chrono::milliseconds::zero();
+        }
+        // 已经过期的阶段不在这里补发回调：下一次 tick() 会在截止时间到达时正常结束该阶段
+        setRemaining(left);
+        lastDisplayedSeconds_ = -1;
+        lastCommitted_ = persistedFingerprint();
+        return true;
+    }
+
+    PomodoroTimer::PersistedFingerprint PomodoroTimer::persistedFingerprint() const {
+        PersistedFingerprint f;
+        f.state = stateMachine_.getCurrentState();
+        f.timerType = stateMachine_.getCurrentTimerType();
+        f.isStayUpTime = stateMachine_.isInStayUpTime();
+        f.isLongBreak = isLongBreak_;
+        f.completedPomodoros = completedPomodoros_;
+        f.deadline = deadline_;
+        f.pausedRemaining = pausedRemaining_;
+        return f;
+    }
+
+    void PomodoroTimer::commitTransition() {
+        const auto current = persistedFingerprint();
+        if (current == lastCommitted_) return;
+        lastCommitted_ = current;
+        publish(TimerEventKind::StateChanged);
+    }
+
+    void PomodoroTimer::publish(TimerEventKind kind, std::string_view timeText, int remainingSeconds, int phaseSeconds) {
+        if (!events.wants(kind)) return;
+        TimerEvent event;
+        event.kind = kind;
+        event.snapshot = makeSnapshot(remainingSeconds >= 0 ? remainingSeconds : this->remainingSeconds());
+        event.timeText = timeText;
+        event.phaseSeconds = phaseSeconds;
+        events.publish(event);
+    }
+
+    void PomodoroTimer::publishRestCancelledIfResting() {
+        if (!isInRestPeriod() || !events.wants(TimerEventKind::RestCancelled)) return;
+        // 已休息的时长按整秒向下取整（剩余时间向上取整，两者之和为计划时长）
+        const int rested = totalCurrentSeconds() - remainingSeconds();
+        publish(TimerEventKind::RestCancelled, {}, -1, rested > 0 ? rested : 0);
+    }
+
+    void PomodoroTimer::onSystemEvents(const AutoRestartEvent* events, std::size_t count) {
+        const TransitionScope scope(*this);
+        // 整批视为同一时刻到达：按当前时刻打上时间戳后走同一条路径
+        constexpr std::size_t kChunk = 64;
+        TimedAutoRestartEvent timed[kChunk];
+        const auto now = clock_->now();
+        for (std::size_t done = 0; done < count;) {
+            const std::size_t n = (std::min)(kChunk, count - done);
+            for (std::size_t i = 0; i < n; ++i) timed[i] = TimedAutoRestartEvent{ now, events[done + i] };
+            onSystemEvents(timed, n);
+            done += n;
+        }
+    }
+
+    void PomodoroTimer::onSystemEvents(const TimedAutoRestartEvent* events, std::size_t count) {
+        const TransitionScope scope(*this);
+        using E = AutoRestartEvent;
+
+        // 当前状态下已确认为空转（状态不变、无动作）的事件位集；状态或熬夜标记一变就作废
+        std::uint32_t knownNoops = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto event = events[i].event;
+            const std::uint32_t bit = 1u << static_cast<unsigned>(event);
+            if (knownNoops & bit) continue;
+
+            switch (event) {
+            case E::IdleTimeExceeded:
+            case E::UserActivityDetected:
+            case E::ScreenLocked:
+            case E::ScreenUnlocked:
+            case E::ScreensaverStarted:
+                break;
+            case E::ScreensaverStopped:
+                // 记录“屏保刚恢复”会改变后续解锁事件的转换结果
+                stateMachine_.markScreensaverResumedAt(events[i].at);
+                knownNoops &= ~(1u << static_cast<unsigned>(E::ScreenUnlocked));
+                break;
+            case E::ForcedSleepTriggered:
+                onForcedSleepTriggered();
+                knownNoops = 0;
+                continue;
+            case E::ForcedSleepEnded:
+                onForcedSleepEnded();
+                knownNoops = 0;
+                continue;
+            default:
+                continue;
+            }
+
+            const auto before = stateMachine_.getCurrentState();
+            const auto action = dispatch(event, &events[i].at);
+            handleAutoRestartAction(action);
+
+            if (stateMachine_.getCurrentState() != before) {
+                knownNoops = 0;
+            } else if (action == AutoRestartAction::None) {
+                knownNoops |= bit;
+            }
+        }
+    }
+
+    AutoRestartAction PomodoroTimer::dispatch(AutoRestartEvent event, const Clock::time_point* occurredAt) {
+        const bool wasRunning = isRunning();
+        const auto left = remaining();
+        const auto action = occurredAt ? stateMachine_.processEvent(event, *occurredAt) : stateMachine_.processEvent(event);
+        const bool running = isRunning();
+
+        if (wasRunning && !running) {
+            // 进入暂停/空闲/休息前状态：冻结剩余时间
+            pausedRemaining_ = left;
+        } else if (!wasRunning && running) {
+            // 重新开始计时：从现在起按冻结的剩余时间布置截止时间
+            deadline_ = clock_->now() + pausedRemaining_;
+        }
+        return action;
+    }
+
+    PomodoroTimer::Clock::duration PomodoroTimer::remaining() const {
+        if (!isRunning()) return pausedRemaining_;
+        const auto left = deadline_ - clock_->now();
+        return (left > Clock::duration::zero()) ? left : Clock::duration::zero();
+    }
+
+    void PomodoroTimer::setRemaining(Clock::duration value) {
+        pausedRemaining_ = value;
+        deadline_ = clock_->now() + value;
     }
 
     void PomodoroTimer::handleAutoRestartAction(AutoRestartAction action) {
@@ -173,14 +457,14 @@ namespace pomodoro {
             updateTimeDisplay();
             break;
         case A::RestartTimer:
-            remainingSeconds_ = totalCurrentSeconds();
+            setRemaining(Seconds(totalCurrentSeconds()));
             updateTimeDisplay();
             break;
         case A::ShowRestOverlay:
             // 由上层 UI 根据 onTimerFinished 回调展示遮罩
             break;
         case A::StartNextPomodoro:
-            remainingSeconds_ = pomodoroSeconds_;
+            setRemaining(Seconds(pomodoroSeconds_));
             stateMachine_.setTimerType(TimerType::Pomodoro);
             updateTimeDisplay();
             break;
@@ -194,17 +478,16 @@ namespace pomodoro {
     }
 
     void PomodoroTimer::updateTimeDisplay() {
-        if (!onTimeUpdate) return;
-        int total = remainingSeconds_;
-        if (total < 0) total = 0;
-        int minutes = total / 60;
-        int seconds = total % 60;
-
-        std::ostringstream oss;
-        oss << std::setw(2) << std::setfill('0') << minutes
-            << ":" << std::setw(2) << std::setfill('0') << seconds;
-
-        onTimeUpdate(oss.str());
+        const int total = remainingSeconds();
+        lastDisplayedSeconds_ = total;
+        if (!onTimeUpdate && !events.wants(TimerEventKind::TimeUpdated)) return;
+
+        // 栈上缓冲 + 查表格式化，每秒的显示路径不做任何堆分配
+        char text[kTimeTextCapacity];
+        const std::size_t length = formatTimeText(total, text);
+        const std::string_view view(text, length);
+        if (onTimeUpdate) onTimeUpdate(view);
+        publish(TimerEventKind::TimeUpdated, view, total);
     }
 
     int PomodoroTimer::totalCurrentSeconds() const {
@@ -219,24 +502,28 @@ namespace pomodoro {
         if (!isInRestPeriod()) {
             // 工作阶段结束 -> 进入休息
             completedPomodoros_++;
-            stateMachine_.processEvent(AutoRestartEvent::PomodoroFinished);
+            dispatch(AutoRestartEvent::PomodoroFinished);
             if (onTimerFinished) {
                 onTimerFinished();
             }
+            publish(TimerEventKind::PomodoroFinished, {}, -1, pomodoroSeconds_);
 
             // 根据 cycle 决定长休息还是短休息
             isLongBreak_ = (completedPomodoros_ > 0) &&
                 (settings_.longBreakCycle > 0) &&
                 (completedPomodoros_ % settings_.longBreakCycle == 0);
 
-            remainingSeconds_ = isLongBreak_ ? longBreakSeconds_ : breakSeconds_;
+            setRemaining(Seconds(isLongBreak_ ? longBreakSeconds_ : breakSeconds_));
             stateMachine_.setTimerType(isLongBreak_ ? TimerType::LongBreak : TimerType::ShortBreak);
-            stateMachine_.processEvent(AutoRestartEvent::RestStarted);
+            dispatch(AutoRestartEvent::RestStarted);
+            publish(TimerEventKind::RestStarted, {}, -1, isLongBreak_ ? longBreakSeconds_ : breakSeconds_);
         } else {
             // 休息阶段结束 -> 下一轮工作
-            auto action = stateMachine_.processEvent(AutoRestartEvent::RestFinished);
+            const int restSeconds = totalCurrentSeconds();
+            auto action = dispatch(AutoRestartEvent::RestFinished);
+            publish(TimerEventKind::RestFinished, {}, -1, restSeconds);
             stateMachine_.setTimerType(TimerType::Pomodoro);
-            remainingSeconds_ = pomodoroSeconds_;
+            setRemaining(Seconds(pomodoroSeconds_));
 
             // RestFinished 在状态机中会切到 Idle，需要上层决定是否立即开始下一轮番茄。
             // Windows 端用设置项控制：开启时自动开始；关闭时等待用户（例如点击“取消休息”）触发 start。
@@ -16,15 +16,19 @@
 
 #include <functional>
 #include <chrono>
-#include <string>
+#include <cstddef>
+#include <string_view>
 
 #include "AutoRestartStateMachine.h"
+#include "TimerEventBus.h"
+#include "TimerSnapshot.h"
 
 namespace pomodoro {
 
     class PomodoroTimer {
     public:
         using Seconds = std::chrono::seconds;
+        using Clock = std::chrono::steady_clock;
 
         struct Settings {
             int pomodoroMinutes{ 25 };
@@ -59,14 +63,33 @@ namespace pomodoro {
 
         // Callbacks (UI layer should subscribe)
         std::function<void()> onTimerFinished;                 // 工作计时完成
-        std::function<void(const std::string&)> onTimeUpdate;  // 每秒更新时间显示
+        std::function<void(std::string_view)> onTimeUpdate;    // 每秒更新时间显示（"MM:SS"，仅在回调期间有效）
         std::function<void()> onForcedSleepEndedCallback;      // 强制睡眠结束回调
 
+        // 多订阅者事件总线：各 UI 组件按事件掩码订阅，事件自带状态快照（见 TimerEventBus.h）。
+        // 与上面的单回调并存，发布时先调用单回调再广播。
+        TimerEventBus events;
+
         PomodoroTimer();
+        // 注入时钟（测试 / 无头模拟器使用 VirtualClock）；clock 的生命周期必须长于 timer
+        explicit PomodoroTimer(const MonotonicClock& clock);
 
         void updateSettings(const Settings& settings);
 
-        void tickOneSecond(); // 上层每秒调用一次（或用真正的计时器回调）
+        // 计时基于单调时钟上的绝对截止时间（deadline），剩余时间按需计算，不会因唤醒延迟而累计误差。
+        // 上层在 nextWakeup() 到达时调用 tick()；提前或重复调用都是安全的（没有可见变化时什么都不做）。
+        void tick();
+
+        // 下一次“可见变化”（显示秒数变化或阶段结束）发生的时刻；未在计时时返回 Clock::time_point::max()。
+        Clock::time_point nextWakeup() const;
+
+        // 当前阶段结束的时刻；不需要逐秒刷新显示的宿主（或模拟器）可以只在这一刻唤醒。
+        Clock::time_point phaseDeadline() const;
+
+        Clock::time_point now() const { return clock_->now(); }
+
+        // 当前剩余时间（向上取整到秒，与界面显示一致）
+        int remainingSeconds() const;
 
         void start();
         void stop();
@@ -79,8 +102,22 @@ namespace pomodoro {
 
         bool isInRestPeriod() const;
         bool isRestTimerRunning() const;
+        bool isInForcedSleep() const;
         bool isMeetingMode() const { return meetingMode_; }
 
+        // 当前状态的一次性快照（事件总线发布时使用，也可供 UI 主动查询）
+        TimerStateSnapshot snapshot() const;
+
+        // 崩溃恢复用的持久化快照（见 TimerSnapshot.h）。wallClockMs 为当前墙钟（Unix 毫秒）。
+        // 订阅 StateChanged 事件并保存 captureSnapshot() 即可在每次状态变化后落盘。
+        TimerSnapshot captureSnapshot(std::int64_t wallClockMs) const;
+        // 在创建任何窗口前调用：直接恢复阶段、计数与截止时间（按停机期间流逝的墙钟时间扣减运行中的阶段），
+        // 不重放任何事件。快照无效时返回 false 且不修改状态。
+        bool restoreSnapshot(const TimerSnapshot& snapshot, std::int64_t wallClockMs);
+
+        // 把状态机的每一次转换交给 sink（例如 EventJournal）；nullptr 关闭
+        void setTransitionSink(AutoRestartTransitionSink* sink) noexcept { stateMachine_.setTransitionSink(sink); }
+
         // System events that should be forwarded from Windows shell
         void onIdleTimeExceeded();
         void onUserActivity();
@@ -93,20 +130,68 @@ namespace pomodoro {
         void onForcedSleepTriggered();
         void onForcedSleepEnded();
 
+        // 批量转发系统事件（钩子以鼠标移动频率投递时使用），效果与逐个调用上面的 on* 方法相同。
+        // 整批视为同一时刻到达；在当前状态下已确认空转的事件（重复的用户活动、无效的锁屏/解锁等）
+        // 直接跳过，不再经过状态机与动作处理。计时器自身产生的事件（TimerStarted、PomodoroFinished 等）
+        // 不属于系统事件，会被忽略。
+        void onSystemEvents(const AutoRestartEvent* events, std::size_t count);
+        // 同上，但每个事件带有发生时刻（见 SystemEventQueues）：“屏保刚恢复”的 1 秒窗口与事件日志
+        // 按事件发生时刻而不是取出队列的时刻计算
+        void onSystemEvents(const TimedAutoRestartEvent* events, std::size_t count);
+
         // Force-finish the current phase immediately.
         // Used by tray menu: "Complete Now" to end the current pomodoro and enter rest (show overlay).
         void finishNow();
 
     private:
+        // 公开的变更操作用它包裹：最外层结束时若持久化状态有变化，发布一次 StateChanged
+        class TransitionScope;
+
+        struct PersistedFingerprint {
+            AutoRestartState state{ AutoRestartState::Idle };
+            TimerType timerType{ TimerType::Pomodoro };
+            bool isStayUpTime{ false };
+            bool isLongBreak{ false };
+            int completedPomodoros{ 0 };
+            Clock::time_point deadline{};
+            Clock::duration pausedRemaining{};
+
+            bool operator==(const PersistedFingerprint& o) const {
+                return state == o.state && timerType == o.timerType && isStayUpTime == o.isStayUpTime &&
+                    isLongBreak == o.isLongBreak && completedPomodoros == o.completedPomodoros &&
+                    deadline == o.deadline && pausedRemaining == o.pausedRemaining;
+            }
+            bool operator!=(const PersistedFingerprint& o) const { return !(*this == o); }
+        };
+
+        PersistedFingerprint persistedFingerprint() const;
+        void commitTransition();
+
+        // 所有状态机事件都经由这里转发：在“运行 <-> 非运行”切换时冻结或重新布置截止时间
+        // occurredAt 非空时按该时刻交给状态机（见 onSystemEvents 的带时间戳版本）
+        AutoRestartAction dispatch(AutoRestartEvent event, const Clock::time_point* occurredAt = nullptr);
         void handleAutoRestartAction(AutoRestartAction action);
         void updateTimeDisplay();
         int totalCurrentSeconds() const;
         void handlePhaseFinished();
+        TimerStateSnapshot makeSnapshot(int remainingSeconds) const;
+        // remainingSeconds < 0 表示由快照自行计算
+        void publish(TimerEventKind kind, std::string_view timeText = {}, int remainingSeconds = -1, int phaseSeconds = 0);
+        // 休息中被用户开始/停止：发布 RestCancelled（统计用）
+        void publishRestCancelledIfResting();
+
+        Clock::duration remaining() const;
+        void setRemaining(Clock::duration value);
 
     private:
+        const MonotonicClock* clock_;
         Settings settings_{};
 
-        int remainingSeconds_{ 25 * 60 };
+        // 运行中以 deadline_ 为准；暂停/空闲时以 pausedRemaining_ 为准
+        Clock::time_point deadline_{};
+        Clock::duration pausedRemaining_{ Seconds(25 * 60) };
+        int lastDisplayedSeconds_{ -1 };
+
         int pomodoroSeconds_{ 25 * 60 };
         int breakSeconds_{ 3 * 60 };
         int longBreakSeconds_{ 5 * 60 };
@@ -116,6 +201,9 @@ namespace pomodoro {
         bool meetingMode_{ false };
 
         AutoRestartStateMachine stateMachine_;
+
+        int transitionDepth_{ 0 };
+        PersistedFingerprint lastCommitted_{};
     };
 
 } // namespace pomodoro
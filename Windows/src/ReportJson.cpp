@@ -0,0 +1,208 @@
+#include "ReportJson.h"
+
+#include "HealthScores.h"
+#include "LocalCalendar.h"
+
+namespace pomodoro {
+
+    namespace {
+
+        void WriteIsoTimestamp(JsonWriter& out, std::int64_t unixMs) {
+            char text[kIsoTimestampLength];
+            formatIsoTimestamp(unixMs, text);
+            out.rawString(std::string_view(text, sizeof(text)));
+        }
+
+        void WriteDateKey(JsonWriter& out, std::int32_t dayIndex) {
+            char text[kDateKeyLength];
+            formatDateKey(dayIndex, text);
+            out.rawString(std::string_view(text, sizeof(text)));
+        }
+
+        double Seconds(std::int64_t ms) noexcept {
+            return static_cast<double>(ms) / 1000.0;
+        }
+
+        // 热力图活动类别（与 Swift generateHeatmapData 相同的归类；休息完成与心情更新不计入）。
+        // Windows 端的 BreakCancelled 只来自用户操作，统一记为 cancelled。
+        enum HeatmapActivity { kPomodoro, kBreak, kCancelled, kInterruption, kLateNight, kActivityCount };
+        constexpr std::string_view kActivityNames[kActivityCount] = { "pomodoro", "break", "cancelled", "interruption", "late_night" };
+
+        int ActivityOf(StatisticsEventType type) noexcept {
+            using T = StatisticsEventType;
+            switch (type) {
+            case T::PomodoroCompleted: return kPomodoro;
+            case T::ShortBreakStarted:
+            case T::LongBreakStarted: return kBreak;
+            case T::BreakCancelled: return kCancelled;
+            case T::ScreenLocked:
+            case T::ScreensaverActivated:
+            case T::StayUpLateTriggered: return kInterruption;
+            case T::StayUpLateActivity: return kLateNight;
+            default: return -1;
+            }
+        }
+
+        void WriteDaily(JsonWriter& out, const DailyStatistics& day, const LocalCalendar& calendar, int breakMinutes) {
+            const HealthScores scores = computeHealthScores(day, breakMinutes);
+            out.beginObject();
+            out.key("date");
+            WriteIsoTimestamp(out, calendar.dayStartUtcMs(day.dayIndex));
+            out.field("completedPomodoros", day.completedPomodoros);
+            out.field("totalWorkTime", Seconds(day.totalWorkMs));
+            out.field("shortBreakCount", day.shortBreakCount);
+            out.field("longBreakCount", day.longBreakCount);
+            out.field("totalBreakTime", Seconds(day.totalBreakMs));
+            out.field("cancelledBreakCount", day.cancelledBreakCount);
+            out.field("screenLockCount", day.screenLockCount);
+            out.field("screensaverCount", day.screensaverCount);
+            out.field("stayUpLateCount", day.stayUpLateCount);
+            if (day.moodLevel != 0) out.field("moodLevel", day.moodLevel); else out.key("moodLevel").null();
+            out.key("moodNote").null();
+            out.key("moodUpdatedAt");
+            if (day.moodUpdatedAtMs != 0) WriteIsoTimestamp(out, day.moodUpdatedAtMs); else out.null();
+            out.field("workIntensityScore", scores.workIntensity);
+            out.field("restAdequacyScore", scores.restAdequacy);
+            out.field("focusScore", scores.focus);
+            out.field("healthScore", scores.health);
+            out.endObject();
+        }
+
+        void WriteHeatmap(JsonWriter& out, const HeatmapCube& cube, std::int32_t firstDay, const LocalCalendar& calendar) {
+            out.beginArray();
+            for (int d = 0; d < kHeatmapDays; ++d) {
+                bool dayOpen = false;
+                for (int h = 0; h < kHeatmapHours; ++h) {
+                    std::uint32_t counts[kActivityCount]{};
+                    std::uint32_t total = 0;
+                    for (std::size_t t = 0; t < kStatisticsEventTypeCount; ++t) {
+                        const auto type = static_cast<StatisticsEventType>(t);
+                        const int activity = ActivityOf(type);
+                        if (activity < 0) continue;
+                        const std::uint32_t n = cube.count(d, h, type);
+                        counts[activity] += n;
+                        total += n;
+                    }
+                    if (total == 0) continue;
+
+                    // 只输出有活动的日期与小时
+                    if (!dayOpen) {
+                        out.beginObject();
+                        out.key("date");
+                        WriteDateKey(out, firstDay + d);
+                        out.field("dayOffset", d);
+                        out.key("activities").beginObject();
+                        dayOpen = true;
+                    }
+                    int primary = 0;
+                    for (int a = 1; a < kActivityCount; ++a) {
+                        if (counts[a] > counts[primary]) primary = a;
+                    }
+
+                    char hourKey[8] = { 'h', 'o', 'u', 'r', '_' };
+                    std::size_t keyLength = 5;
+                    if (h >= 10) hourKey[keyLength++] = static_cast<char>('0' + h / 10);
+                    hourKey[keyLength++] = static_cast<char>('0' + h % 10);
+
+                    out.key(std::string_view(hourKey, keyLength)).beginObject();
+                    out.key("timestamp");
+                    WriteIsoTimestamp(out, calendar.hourStartUtcMs(firstDay + d, h));
+                    out.field("hour", h);
+                    out.field("primaryActivity", kActivityNames[primary]);
+                    out.field("totalActivities", static_cast<std::int64_t>(total));
+                    out.key("activities").beginObject();
+                    for (int a = 0; a < kActivityCount; ++a) {
+                        if (counts[a] != 0) out.field(kActivityNames[a], static_cast<std::int64_t>(counts[a]));
+                    }
+                    out.endObject();
+                    out.endObject();
+                }
+                if (dayOpen) {
+                    out.endObject();
+                    out.endObject();
+                }
+            }
+            out.endArray();
+        }
+
+    } // namespace
+
+    void writeReportJson(JsonWriter& out, const StatisticsEngine& statistics, const ReportRequest& request) {
+        const LocalCalendar& calendar = statistics.calendar();
+
+        // 第一遍只累计汇总，第二遍写出趋势，避免保存中间结果
+        std::int64_t totalPomodoros = 0;
+        std::int64_t totalWorkMs = 0;
+        std::int64_t totalBreakMs = 0;
+        double intensitySum = 0;
+        double healthSum = 0;
+        std::int64_t activeDays = 0;
+        for (std::int32_t d = request.firstDay; d <= request.lastDay; ++d) {
+            const DailyStatistics day = statistics.day(d);
+            totalPomodoros += day.completedPomodoros;
+            totalWorkMs += day.totalWorkMs;
+            totalBreakMs += day.totalBreakMs;
+            if (!day.hasActivity()) continue;
+            const HealthScores scores = computeHealthScores(day, request.breakMinutes);
+            intensitySum += scores.workIntensity;
+            healthSum += scores.health;
+            ++activeDays;
+        }
+
+        out.beginObject();
+
+        out.key("daily");
+        WriteDaily(out, statistics.day(request.lastDay), calendar, request.breakMinutes);
+
+        out.key("weekly").beginObject();
+        out.key("weekStartDate");
+        WriteIsoTimestamp(out, calendar.dayStartUtcMs(request.firstDay));
+        out.field("totalPomodoros", totalPomodoros);
+        out.field("totalWorkTime", Seconds(totalWorkMs));
+        out.field("totalBreakTime", Seconds(totalBreakMs));
+        // 与 Swift 一致：没有数据时平均工作强度为 0，平均健康度为 20
+        out.field("averageWorkIntensity", activeDays > 0 ? intensitySum / static_cast<double>(activeDays) : 0.0);
+        out.field("averageHealthScore", activeDays > 0 ? healthSum / static_cast<double>(activeDays) : 20.0);
+
+        out.key("dailyTrend").beginArray();
+        for (std::int32_t d = request.firstDay; d <= request.lastDay; ++d) {
+            const DailyStatistics day = statistics.day(d);
+            const HealthScores scores = computeHealthScores(day, request.breakMinutes);
+            out.beginObject();
+            out.key("date");
+            WriteIsoTimestamp(out, calendar.dayStartUtcMs(d));
+            out.field("pomodoros", day.completedPomodoros);
+            out.field("breakCount", day.shortBreakCount + day.longBreakCount);
+            out.field("workIntensity", scores.workIntensity);
+            out.field("healthScore", scores.health);
+            out.key("moodIndex");
+            if (day.moodLevel != 0) out.value(day.moodLevel / 6.0 * 100.0); else out.null();
+            out.endObject();
+        }
+        out.endArray();
+
+        out.key("heatmapData");
+        if (request.heatmap) {
+            WriteHeatmap(out, *request.heatmap, request.heatmapFirstDay, calendar);
+        } else {
+            out.beginArray().endArray();
+        }
+        out.endObject();
+
+        const ReportConfiguration& c = request.configuration;
+        out.key("configuration").beginObject();
+        out.field("includeCharts", c.includeCharts);
+        out.field("includeTrends", c.includeTrends);
+        out.field("includeRecommendations", c.includeRecommendations);
+        out.field("chartTheme", c.chartTheme);
+        out.field("stayUpLimitEnabled", c.stayUpLimitEnabled);
+        out.field("stayUpStartHour", c.stayUpStartHour);
+        out.field("stayUpStartMinute", c.stayUpStartMinute);
+        out.field("stayUpEndHour", c.stayUpEndHour);
+        out.field("stayUpEndMinute", c.stayUpEndMinute);
+        out.endObject();
+
+        out.endObject();
+    }
+
+} // namespace pomodoro
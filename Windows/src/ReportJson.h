@@ -0,0 +1,52 @@
+#pragma once
+
+// Streams the `reportData` object consumed by Resources/js/report.html (the Windows counterpart of the
+// Swift ReportData.toJSONString) directly from StatisticsEngine's day aggregates and a HeatmapCube into
+// a JsonWriter. No dictionary tree is built. The output size is linear in the number of trend days,
+// and a reused writer keeps its buffer.
+//
+// Shape (same keys as the Swift dictionary):
+//   daily          - aggregates and scores for request.lastDay
+//   weekly         - totals / averages over [firstDay, lastDay], `dailyTrend` with one entry per day
+//                    (for long histories the trend simply covers the whole range), and `heatmapData`
+//                    for the 7 days starting at heatmapFirstDay
+//   configuration  - chart and stay-up window options
+//
+// Dates are local day starts and hour starts formatted as ISO-8601 UTC, matching ISO8601DateFormatter.
+
+#include <cstdint>
+#include <string_view>
+
+#include "JsonWriter.h"
+#include "StatisticsEngine.h"
+#include "StatisticsHeatmap.h"
+
+namespace pomodoro {
+
+    struct ReportConfiguration {
+        bool includeCharts{ true };
+        bool includeTrends{ true };
+        bool includeRecommendations{ true };
+        std::string_view chartTheme{ "light" };
+
+        // 熬夜时段：开始时间来自设置，结束时间与状态机一致（次日 06:00）
+        bool stayUpLimitEnabled{ false };
+        int stayUpStartHour{ 23 };
+        int stayUpStartMinute{ 0 };
+        int stayUpEndHour{ 6 };
+        int stayUpEndMinute{ 0 };
+    };
+
+    struct ReportRequest {
+        std::int32_t firstDay{ 0 };          // 趋势与汇总的本地日期范围 [firstDay, lastDay]
+        std::int32_t lastDay{ 0 };           // daily 部分取这一天
+        std::int32_t heatmapFirstDay{ 0 };
+        const HeatmapCube* heatmap{ nullptr }; // 由 HeatmapBinner::forWeek(calendar, heatmapFirstDay) 统计；为空时输出空数组
+        int breakMinutes{ 5 };               // 休息充足度评分使用的休息时长设置
+        ReportConfiguration configuration;
+    };
+
+    // 在 out 当前位置写出整个 reportData 对象（调用方负责 reset）
+    void writeReportJson(JsonWriter& out, const StatisticsEngine& statistics, const ReportRequest& request);
+
+} // namespace pomodoro
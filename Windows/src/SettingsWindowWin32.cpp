@@ -237,7 +237,7 @@ namespace pomodoro {
                     }
                     if (text != settings_.overlayMessage()) {
                         settings_.setOverlayMessage(std::move(text));
-                        settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+                        settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
                     }
                 }
             }
@@ -776,8 +776,8 @@ namespace pomodoro {
             file.playbackRate = 1.0;
             settings_.files().push_back(std::move(file));
             refreshList();
-            // 立即持久化到用户配置目录，供遮罩层读取
-            settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+            // 持久化到用户配置目录（后台线程在修改停止后写出）；遮罩层直接使用内存中的设置
+            settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
         }
     }
 
@@ -802,7 +802,7 @@ namespace pomodoro {
             file.playbackRate = 1.0; // TODO: 将来可在设置面板中增加播放速率调节
             settings_.files().push_back(std::move(file));
             refreshList();
-            settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+            settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
         }
     }
 
@@ -817,7 +817,7 @@ namespace pomodoro {
 
         files.erase(files.begin() + index);
         refreshList();
-        settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+        settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
     }
 
     void SettingsWindowWin32::onAutoStartNextPomodoroAfterRestChanged() {
@@ -825,7 +825,7 @@ namespace pomodoro {
         LRESULT state = SendMessageW(autoHideCheckbox_, BM_GETCHECK, 0, 0);
         bool enabled = (state == BST_CHECKED);
         settings_.setAutoStartNextPomodoroAfterRest(enabled);
-        settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+        settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
         if (onAutoStartNextPomodoroAfterRestChanged_) {
             onAutoStartNextPomodoroAfterRestChanged_(enabled);
         }
@@ -852,7 +852,7 @@ namespace pomodoro {
         // 仅当值变化时写入配置；commit 时也会触发回调（供主程序更新计时器设置）
         if (settings_.pomodoroMinutes() != minutes) {
             settings_.setPomodoroMinutes(minutes);
-            settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+            settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
         }
 
         if (commit && onPomodoroMinutesChanged_) {
@@ -880,7 +880,7 @@ namespace pomodoro {
 
         if (settings_.breakMinutes() != minutes) {
             settings_.setBreakMinutes(minutes);
-            settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+            settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
         }
 
         if (commit && onBreakMinutesChanged_) {
@@ -961,7 +961,7 @@ namespace pomodoro {
         std::swap(files[index - 1], files[index]);
         refreshList();
         SendMessageW(listBox_, LB_SETCURSEL, index - 1, 0);
-        settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+        settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
     }
 
     void SettingsWindowWin32::onMoveDown() {
@@ -976,7 +976,7 @@ namespace pomodoro {
         std::swap(files[index], files[index + 1]);
         refreshList();
         SendMessageW(listBox_, LB_SETCURSEL, index + 1, 0);
-        settings_.saveToFile(BackgroundSettingsWin32::DefaultConfigPath());
+        settings_.scheduleSave(BackgroundSettingsWin32::DefaultConfigPath());
     }
 
 } // namespace pomodoro
@@ -0,0 +1,76 @@
+#pragma once
+
+// Bounded lock-free single-producer / single-consumer ring for timestamped AutoRestartEvent records.
+//
+// One detection thread (idle, session lock, screensaver, ...) owns the producer side; the thread that
+// owns PomodoroTimer owns the consumer side. Head and tail live on separate cache lines. The producer
+// keeps a cached copy of head_ and reloads it only when the ring looks full; the consumer reads tail_
+// once per available() call, i.e. once per drain.
+// Portable C++17: only <atomic>, no platform APIs.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "AutoRestartStateMachine.h"
+
+namespace pomodoro {
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4324) // 结构因 alignas 而填充，正是这里想要的效果
+#endif
+
+    template <std::size_t Capacity>
+    class SpscEventRing {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        SpscEventRing() = default;
+        SpscEventRing(const SpscEventRing&) = delete;
+        SpscEventRing& operator=(const SpscEventRing&) = delete;
+
+        static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+        // 生产者：队列已满时返回 false（检测线程不应阻塞，由调用方决定丢弃还是重试）
+        bool tryPush(const TimedAutoRestartEvent& item) noexcept {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cachedHead_ == Capacity) {
+                cachedHead_ = head_.load(std::memory_order_acquire);
+                if (tail - cachedHead_ == Capacity) return false;
+            }
+            slots_[tail & kMask] = item;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 消费者：当前可读的元素个数（刷新对生产者进度的观察）
+        std::size_t available() const noexcept {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_relaxed);
+        }
+
+        // 消费者：队首之后第 offset 个元素；offset 必须小于最近一次 available() 的返回值
+        const TimedAutoRestartEvent& peek(std::size_t offset) const noexcept {
+            return slots_[(head_.load(std::memory_order_relaxed) + offset) & kMask];
+        }
+
+        // 消费者：一次性释放 count 个已读元素（每次 drain 只做一次 release 写）
+        void consume(std::size_t count) noexcept {
+            head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+    private:
+        static constexpr std::size_t kMask = Capacity - 1;
+        static constexpr std::size_t kCacheLine = 64;
+
+        alignas(kCacheLine) std::atomic<std::size_t> head_{ 0 }; // 消费者写
+        alignas(kCacheLine) std::atomic<std::size_t> tail_{ 0 }; // 生产者写
+        std::size_t cachedHead_{ 0 };                            // 生产者持有的 head_ 副本
+        alignas(kCacheLine) std::array<TimedAutoRestartEvent, Capacity> slots_{};
+    };
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+} // namespace pomodoro
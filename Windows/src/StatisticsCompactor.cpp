@@ -0,0 +1,105 @@
+#include "StatisticsCompactor.h"
+
+#include "StatisticsEventStore.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace pomodoro {
+
+    namespace {
+
+        void LowerCurrentThreadPriority() noexcept {
+#if defined(_WIN32)
+            // 后台模式同时降低 CPU、I/O 与内存优先级
+            SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#endif
+        }
+
+    } // namespace
+
+    StatisticsCompactor::StatisticsCompactor(StatisticsEventStore& store, StatisticsRollups& rollups, std::filesystem::path rollupPath)
+        : store_(store), rollups_(rollups), rollupPath_(std::move(rollupPath)) {
+    }
+
+    StatisticsCompactor::~StatisticsCompactor() {
+        // 析构时不再删除分段：汇总文件已写好，下次启动按其中记录的编号清理
+        if (worker_.joinable()) worker_.join();
+    }
+
+    bool StatisticsCompactor::start(std::int64_t nowUnixMs) {
+        if (busy() || !store_.isOpen()) return false;
+
+        auto job = std::make_unique<Job>();
+        job->today = calendar_.dayIndexFor(nowUnixMs);
+        job->policy = policy_;
+        job->calendar = calendar_;
+        job->firstRawSegment = rollups_.firstRawSegment();
+
+        // 最新事件早于保留期起点的前导分段
+        std::size_t compact = 0;
+        if (policy_.rawRetentionDays > 0) {
+            const std::int64_t cutoffMs = calendar_.dayStartUtcMs(job->today - policy_.rawRetentionDays);
+            const std::size_t capacity = store_.segmentCapacity();
+            while (compact < store_.sealedSegmentCount() && store_.at((compact + 1) * capacity - 1).timestampMs < cutoffMs) {
+                ++compact;
+            }
+            store_.visit(0, compact * capacity, [&job](const StatisticsEvent* records, std::size_t n) {
+                job->spans.emplace_back(records, n);
+            });
+            if (compact > 0) job->firstRawSegment = store_.firstSegmentNumber() + compact;
+        }
+
+        const auto& hourly = rollups_.hourly();
+        const auto& daily = rollups_.daily();
+        const bool expired =
+            (policy_.hourlyRetentionDays > 0 && !hourly.empty() && hourly.front().dayIndex < job->today - policy_.hourlyRetentionDays) ||
+            (policy_.dailyRetentionDays > 0 && !daily.empty() && daily.front().dayIndex < job->today - policy_.dailyRetentionDays);
+        if (compact == 0 && !expired) return false;
+
+        job_ = std::move(job);
+        done_.store(false, std::memory_order_relaxed);
+        worker_ = std::thread([this]() {
+            LowerCurrentThreadPriority();
+            run(*job_);
+            done_.store(true, std::memory_order_release);
+            if (onCompleted_) onCompleted_();
+        });
+        return true;
+    }
+
+    void StatisticsCompactor::run(Job& job) const {
+        // 所有者线程在提交之前不会修改 rollups_，这里可以直接复制
+        job.result = rollups_;
+        for (const auto& [records, n] : job.spans) job.result.addEvents(records, n, job.calendar);
+        job.result.setFirstRawSegment(job.firstRawSegment);
+
+        const Policy& policy = job.policy;
+        if (policy.hourlyRetentionDays > 0) job.result.dropHourlyBefore(job.today - policy.hourlyRetentionDays);
+        if (policy.dailyRetentionDays > 0) job.result.dropDailyBefore(job.today - policy.dailyRetentionDays);
+
+        job.saved = job.result.save(rollupPath_);
+    }
+
+    bool StatisticsCompactor::poll() {
+        if (!worker_.joinable() || !done_.load(std::memory_order_acquire)) return false;
+        return commit();
+    }
+
+    bool StatisticsCompactor::finish() {
+        if (!worker_.joinable()) return false;
+        return commit();
+    }
+
+    bool StatisticsCompactor::commit() {
+        worker_.join();
+        std::unique_ptr<Job> job = std::move(job_);
+        if (!job->saved) return false;
+
+        rollups_ = std::move(job->result);
+        store_.dropSegmentsBefore(rollups_.firstRawSegment());
+        return true;
+    }
+
+} // namespace pomodoro
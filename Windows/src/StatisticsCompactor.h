@@ -0,0 +1,93 @@
+#pragma once
+
+// Background compaction of old raw statistics events into StatisticsRollups, plus the retention policy
+// (the Swift `cleanupOldData` placeholder only deleted rows; here history is kept as aggregates).
+//
+// Once per start(), the owner thread (the one that appends to the StatisticsEventStore) picks the
+// leading sealed segments whose newest event is older than `rawRetentionDays` local days. Sealed
+// segments are never written again, so a low-priority worker thread can read their mapped records
+// while appends continue on the tail segment. The worker rolls them into daily and hourly aggregates,
+// applies the rollup retention and writes the rollup file (temporary file + rename).
+//
+// The owner collects the result in poll(): it swaps the rollups in and deletes the compacted segment
+// files, which is O(segments). Writers never wait for the worker. When the worker finishes it calls the
+// completion handler, so an owner that sleeps without a timeout (on Windows, an event in the main
+// loop's wait set) wakes up to commit. If the process stops between the
+// rename and the deletion, the rollup file records the first raw segment number, and the next start
+// finishes the deletion (StatisticsEventStore::dropSegmentsBefore).
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "LocalCalendar.h"
+#include "StatisticsRollups.h"
+
+namespace pomodoro {
+
+    class StatisticsEventStore;
+
+    class StatisticsCompactor {
+    public:
+        struct Policy {
+            int rawRetentionDays{ 90 };      // 早于这么多天的原始事件压缩为汇总；0 表示不压缩
+            int hourlyRetentionDays{ 730 };  // 小时汇总保留天数；0 表示永久保留
+            int dailyRetentionDays{ 0 };     // 日汇总保留天数；0 表示永久保留
+        };
+
+        // store 与 rollups 由所有者线程持有；rollupPath 为汇总文件路径
+        StatisticsCompactor(StatisticsEventStore& store, StatisticsRollups& rollups, std::filesystem::path rollupPath);
+        ~StatisticsCompactor();
+
+        StatisticsCompactor(const StatisticsCompactor&) = delete;
+        StatisticsCompactor& operator=(const StatisticsCompactor&) = delete;
+
+        void setPolicy(const Policy& policy) { policy_ = policy; }
+        void setCalendar(const LocalCalendar& calendar) { calendar_ = calendar; }
+        // 后台任务完成（结果可由 poll() 提交）时在后台线程上调用；必须线程安全且不阻塞。在 start() 之前设置
+        void setCompletionHandler(std::function<void()> handler) { onCompleted_ = std::move(handler); }
+
+        // 所有者线程：有可压缩的分段或过期的汇总、且没有进行中的任务时，在后台线程开始一次压缩。返回是否开始
+        bool start(std::int64_t nowUnixMs);
+
+        // 所有者线程：后台任务已完成时提交结果（替换汇总、删除已压缩的分段）。返回是否提交了新的汇总
+        bool poll();
+
+        // 等待进行中的任务并提交（退出前或测试中使用）
+        bool finish();
+
+        bool busy() const noexcept { return worker_.joinable(); }
+
+    private:
+        struct Job {
+            std::vector<std::pair<const StatisticsEvent*, std::size_t>> spans; // 待压缩的已写满分段
+            std::size_t firstRawSegment{ 0 };
+            std::int32_t today{ 0 };
+            Policy policy;              // 复制一份，后台线程运行期间所有者仍可修改设置
+            LocalCalendar calendar;
+            StatisticsRollups result;
+            bool saved{ false };
+        };
+
+        void run(Job& job) const;
+        bool commit();
+
+        StatisticsEventStore& store_;
+        StatisticsRollups& rollups_;
+        std::filesystem::path rollupPath_;
+        Policy policy_;
+        LocalCalendar calendar_;
+
+        std::unique_ptr<Job> job_;
+        std::thread worker_;
+        std::atomic<bool> done_{ false };
+        std::function<void()> onCompleted_;
+    };
+
+} // namespace pomodoro
@@ -0,0 +1,189 @@
+#include "StatisticsEngine.h"
+
+#include "TimerSnapshot.h"
+
+namespace pomodoro {
+
+    namespace {
+
+        constexpr std::int64_t kEarliestPlausibleMs = 946'684'800'000LL;     // 2000-01-01 00:00 UTC
+        constexpr std::int64_t kFutureToleranceMs = 2LL * 24 * 60 * 60 * 1000; // 时钟偏差与时区
+
+        std::uint32_t SecondsToMs(int seconds) noexcept {
+            return seconds > 0 ? static_cast<std::uint32_t>(seconds) * 1000u : 0u;
+        }
+
+    } // namespace
+
+    void applyStatisticsEvent(DailyStatistics& day, const StatisticsEvent& event) noexcept {
+        using T = StatisticsEventType;
+        switch (event.type) {
+        case T::PomodoroCompleted:
+            day.completedPomodoros += 1;
+            day.totalWorkMs += event.durationMs;
+            break;
+        case T::ShortBreakStarted:
+            day.shortBreakCount += 1;
+            break;
+        case T::LongBreakStarted:
+            day.longBreakCount += 1;
+            break;
+        case T::BreakCancelled:
+            // 仅计入用户主动取消的次数，系统自动关闭不记为“取消休息”
+            if (event.flags & StatisticsEvent::kFlagUserSource) day.cancelledBreakCount += 1;
+            break;
+        case T::BreakFinished:
+            // 休息完成：只累计实际休息时长，不增加取消次数
+            day.totalBreakMs += event.durationMs;
+            break;
+        case T::ScreenLocked:
+            day.screenLockCount += 1;
+            break;
+        case T::ScreensaverActivated:
+            day.screensaverCount += 1;
+            break;
+        case T::StayUpLateTriggered:
+            day.stayUpLateCount += 1;
+            break;
+        case T::StayUpLateActivity:
+            // 半小时熬夜活动事件仅用于热力图标记，不影响日汇总计数
+            break;
+        case T::MoodUpdated:
+            if (event.moodLevel != 0) day.moodLevel = event.moodLevel;
+            day.moodUpdatedAtMs = event.timestampMs;
+            break;
+        }
+
+        // 更新活动时间（事件可能乱序到达，取最早/最晚）
+        if (day.firstActivityMs == 0 || event.timestampMs < day.firstActivityMs) day.firstActivityMs = event.timestampMs;
+        if (event.timestampMs > day.lastActivityMs) day.lastActivityMs = event.timestampMs;
+    }
+
+    void mergeDailyStatistics(DailyStatistics& into, const DailyStatistics& from) noexcept {
+        into.completedPomodoros += from.completedPomodoros;
+        into.totalWorkMs += from.totalWorkMs;
+        into.shortBreakCount += from.shortBreakCount;
+        into.longBreakCount += from.longBreakCount;
+        into.totalBreakMs += from.totalBreakMs;
+        into.cancelledBreakCount += from.cancelledBreakCount;
+        into.screenLockCount += from.screenLockCount;
+        into.screensaverCount += from.screensaverCount;
+        into.stayUpLateCount += from.stayUpLateCount;
+
+        if (from.firstActivityMs != 0 && (into.firstActivityMs == 0 || from.firstActivityMs < into.firstActivityMs)) {
+            into.firstActivityMs = from.firstActivityMs;
+        }
+        if (from.lastActivityMs > into.lastActivityMs) into.lastActivityMs = from.lastActivityMs;
+        if (from.moodUpdatedAtMs != 0 && from.moodUpdatedAtMs >= into.moodUpdatedAtMs) {
+            if (from.moodLevel != 0) into.moodLevel = from.moodLevel;
+            into.moodUpdatedAtMs = from.moodUpdatedAtMs;
+        }
+    }
+
+    StatisticsEngine::StatisticsEngine(int utcOffsetMinutes)
+        : calendar_(utcOffsetMinutes) {
+    }
+
+    DailyStatistics StatisticsEngine::day(std::int32_t dayIndex) const noexcept {
+        const std::int64_t offset = static_cast<std::int64_t>(dayIndex) - firstDay_;
+        if (offset >= 0 && offset < static_cast<std::int64_t>(days_.size())) {
+            return days_[static_cast<std::size_t>(offset)];
+        }
+        DailyStatistics empty;
+        empty.dayIndex = dayIndex;
+        return empty;
+    }
+
+    DailyStatistics& StatisticsEngine::slotFor(std::int32_t dayIndex) {
+        if (days_.empty()) {
+            firstDay_ = dayIndex;
+            days_.emplace_back().dayIndex = dayIndex;
+            return days_.front();
+        }
+
+        if (dayIndex < firstDay_) {
+            // 早于已有范围（补录旧事件），在前面补齐占位日期；实际使用中极少发生
+            const std::size_t gap = static_cast<std::size_t>(firstDay_ - dayIndex);
+            days_.insert(days_.begin(), gap, DailyStatistics{});
+            for (std::size_t i = 0; i < gap; ++i) days_[i].dayIndex = dayIndex + static_cast<std::int32_t>(i);
+            firstDay_ = dayIndex;
+            return days_.front();
+        }
+
+        const std::size_t offset = static_cast<std::size_t>(dayIndex - firstDay_);
+        while (days_.size() <= offset) {
+            const auto next = firstDay_ + static_cast<std::int32_t>(days_.size());
+            days_.emplace_back().dayIndex = next;
+        }
+        return days_[offset];
+    }
+
+    bool StatisticsEngine::plausibleTimestamp(std::int64_t unixMs) {
+        if (unixMs < kEarliestPlausibleMs) return false;
+        if (unixMs <= latestPlausibleMs_) return true;
+        // 墙钟只在事件超过上次的上限时重新读取（正常运行中大约每天一次）
+        latestPlausibleMs_ = currentUnixMillis() + kFutureToleranceMs;
+        return unixMs <= latestPlausibleMs_;
+    }
+
+    const DailyStatistics* StatisticsEngine::restoreDay(const DailyStatistics& rollup) {
+        if (!plausibleTimestamp(calendar_.dayStartUtcMs(rollup.dayIndex))) {
+            ++rejectedCount_;
+            return nullptr;
+        }
+        DailyStatistics& day = slotFor(rollup.dayIndex);
+        mergeDailyStatistics(day, rollup);
+        return &day;
+    }
+
+    const DailyStatistics* StatisticsEngine::record(const StatisticsEvent& event) {
+        // 损坏或离谱的时间戳会让稠密的日期数组覆盖中间的每一天，一条记录就可能占用数 GB
+        if (!plausibleTimestamp(event.timestampMs)) {
+            ++rejectedCount_;
+            return nullptr;
+        }
+        DailyStatistics& day = slotFor(dayIndexFor(event.timestampMs));
+        applyStatisticsEvent(day, event);
+        ++eventCount_;
+        return &day;
+    }
+
+    std::optional<StatisticsEvent> makeStatisticsEvent(const TimerEvent& event, std::int64_t unixMs) noexcept {
+        StatisticsEvent e;
+        e.timestampMs = unixMs;
+        switch (event.kind) {
+        case TimerEventKind::PomodoroFinished:
+            e.type = StatisticsEventType::PomodoroCompleted;
+            e.durationMs = SecondsToMs(event.phaseSeconds);
+            break;
+        case TimerEventKind::RestStarted:
+            e.type = event.snapshot.timerType == TimerType::LongBreak
+                ? StatisticsEventType::LongBreakStarted : StatisticsEventType::ShortBreakStarted;
+            break;
+        case TimerEventKind::RestFinished:
+            e.type = StatisticsEventType::BreakFinished;
+            e.durationMs = SecondsToMs(event.phaseSeconds);
+            break;
+        case TimerEventKind::RestCancelled:
+            // 与 Swift recordBreakCancelled 一致：事件携带已休息时长（actual_duration），日汇总只计次数
+            e.type = StatisticsEventType::BreakCancelled;
+            e.flags = StatisticsEvent::kFlagUserSource;
+            e.durationMs = SecondsToMs(event.phaseSeconds);
+            break;
+        case TimerEventKind::StayUpTriggered:
+            e.type = StatisticsEventType::StayUpLateTriggered;
+            break;
+        default:
+            return std::nullopt;
+        }
+        return e;
+    }
+
+    bool StatisticsEngine::recordTimerEvent(const TimerEvent& event, std::int64_t unixMs) {
+        const auto e = makeStatisticsEvent(event, unixMs);
+        if (!e) return false;
+        record(*e);
+        return true;
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,91 @@
+#pragma once
+
+// Incremental daily statistics, the Windows counterpart of the Swift StatisticsDatabase
+// `daily_statistics` table.
+//
+// The Swift `updateDailyStatistics` reads the day's row, applies one event and writes the row back.
+// Here each event is applied directly to an in-memory DailyStatistics: the day is found by index into
+// a dense, day-ordered vector, so record() is O(1) (amortized; a new day appends one entry) and reading
+// a day never rescans raw events.
+//
+// Events normally come from PomodoroTimer's phase notifications via recordTimerEvent(), subscribed
+// with kTimerEventPhaseChanges on `timer.events`. Screen lock / screensaver / mood events can be
+// recorded directly with record().
+//
+// Day boundaries come from a LocalCalendar (a fixed UTC offset by default, or the DST-aware table built
+// from the system time zone); setCalendar() applies to subsequently recorded events.
+//
+// Because the day vector is dense, a corrupt or far-off timestamp (from the journal or an import) would
+// make it cover every day in between. Events and restored days outside 2000-01-01 .. today + 2 days are
+// therefore rejected and only counted.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "LocalCalendar.h"
+#include "StatisticsModels.h"
+#include "TimerEventBus.h"
+
+namespace pomodoro {
+
+    class StatisticsEngine {
+    public:
+        explicit StatisticsEngine(int utcOffsetMinutes = 0);
+
+        void setUtcOffsetMinutes(int minutes) { calendar_ = LocalCalendar(minutes); }
+        void setCalendar(const LocalCalendar& calendar) { calendar_ = calendar; }
+        const LocalCalendar& calendar() const noexcept { return calendar_; }
+
+        // 应用一条统计事件到所在日期的汇总，返回更新后的当日汇总（供 HealthScoreTracker 等增量消费者使用）；
+        // 时间戳不在可信范围内的事件不记录，返回 nullptr
+        const DailyStatistics* record(const StatisticsEvent& event);
+
+        // 计时器阶段事件 -> 统计事件（PomodoroFinished / RestStarted / RestFinished / RestCancelled /
+        // StayUpTriggered），其他事件忽略。返回是否记录。
+        bool recordTimerEvent(const TimerEvent& event, std::int64_t unixMs);
+
+        // 把压缩后的日汇总并入对应日期（启动时先恢复汇总，再重放剩余的原始事件；同一天可以两者都有）。
+        // 日期不在可信范围内时忽略，返回 nullptr
+        const DailyStatistics* restoreDay(const DailyStatistics& rollup);
+
+        // 本地日期索引（距 1970-01-01 的天数）
+        std::int32_t dayIndexFor(std::int64_t unixMs) const noexcept { return calendar_.dayIndexFor(unixMs); }
+
+        // 指定日期的汇总；没有任何事件的日期返回全 0（dayIndex 已填好）
+        DailyStatistics day(std::int32_t dayIndex) const noexcept;
+        DailyStatistics dayContaining(std::int64_t unixMs) const noexcept { return day(dayIndexFor(unixMs)); }
+
+        // 已覆盖的日期范围 [firstDay, firstDay + dayCount)，中间没有事件的日期也占位
+        std::int32_t firstDay() const noexcept { return firstDay_; }
+        std::size_t dayCount() const noexcept { return days_.size(); }
+        const DailyStatistics* days() const noexcept { return days_.data(); }
+
+        std::uint64_t eventCount() const noexcept { return eventCount_; }
+
+        // 因时间戳（或日期）不在可信范围内而被拒绝的事件与日汇总数
+        std::uint64_t rejectedCount() const noexcept { return rejectedCount_; }
+
+    private:
+        DailyStatistics& slotFor(std::int32_t dayIndex);
+        bool plausibleTimestamp(std::int64_t unixMs);
+
+        LocalCalendar calendar_;
+        std::int32_t firstDay_{ 0 };
+        std::vector<DailyStatistics> days_;
+        std::uint64_t eventCount_{ 0 };
+        std::uint64_t rejectedCount_{ 0 };
+        std::int64_t latestPlausibleMs_{ INT64_MIN };  // 上次读取墙钟得到的上限；事件超过它时才重新读取
+    };
+
+    // 计时器阶段事件 -> 统计事件；非阶段事件返回 nullopt（recordTimerEvent 与事件存储共用）
+    std::optional<StatisticsEvent> makeStatisticsEvent(const TimerEvent& event, std::int64_t unixMs) noexcept;
+
+    // 单条事件对日汇总的增量（与 Swift updateDailyStatistics 的 switch 一致），供引擎与离线重算共用
+    void applyStatisticsEvent(DailyStatistics& day, const StatisticsEvent& event) noexcept;
+
+    // 合并同一天的两份汇总（计数与时长相加，活动时间取最早/最晚，心情取更新较晚的一份）
+    void mergeDailyStatistics(DailyStatistics& into, const DailyStatistics& from) noexcept;
+
+} // namespace pomodoro
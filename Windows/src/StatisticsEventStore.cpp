@@ -0,0 +1,289 @@
+#include "StatisticsEventStore.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace pomodoro {
+
+    struct StatisticsEventStore::SegmentHeader {
+        static constexpr std::uint32_t kMagic = 0x45534D50u; // "PMSE"
+        static constexpr std::uint16_t kVersion = 1;
+
+        std::uint32_t magic{ kMagic };
+        std::uint16_t version{ kVersion };
+        std::uint16_t recordSize{ static_cast<std::uint16_t>(sizeof(StatisticsEvent)) };
+        std::uint32_t capacity{ 0 };   // 记录数上限
+        std::uint32_t count{ 0 };      // 已写入的记录数
+        std::int64_t firstTimestampMs{ 0 };
+        std::int64_t lastTimestampMs{ 0 };
+        std::uint8_t reserved[32]{};
+    };
+
+    namespace {
+
+        constexpr std::size_t kSegmentHeaderSize = 64;
+
+        std::filesystem::path SegmentPath(const std::filesystem::path& directory, std::size_t index) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "events-%06zu.seg", index);
+            return directory / name;
+        }
+
+        // 目录中编号最小的分段（压缩后前面的分段已删除）；没有分段时为 0
+        std::size_t FirstSegmentNumber(const std::filesystem::path& directory) {
+            constexpr std::string_view kPrefix = "events-";
+            constexpr std::string_view kSuffix = ".seg";
+            constexpr std::size_t kDigits = 6;
+
+            std::size_t first = 0;
+            bool found = false;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+                const std::string name = entry.path().filename().string();
+                if (name.size() != kPrefix.size() + kDigits + kSuffix.size() ||
+                    name.compare(0, kPrefix.size(), kPrefix) != 0 ||
+                    name.compare(kPrefix.size() + kDigits, kSuffix.size(), kSuffix) != 0) {
+                    continue;
+                }
+                std::size_t number = 0;
+                bool digits = true;
+                for (std::size_t i = kPrefix.size(); i < kPrefix.size() + kDigits; ++i) {
+                    digits = digits && name[i] >= '0' && name[i] <= '9';
+                    number = number * 10 + static_cast<std::size_t>(name[i] - '0');
+                }
+                if (!digits) continue;
+                if (!found || number < first) first = number;
+                found = true;
+            }
+            return first;
+        }
+
+        // SegmentHeader 是私有类型，这里按模板参数推导，不直接点名
+        template <typename HeaderT>
+        bool IsCompatibleHeader(const HeaderT& h) noexcept {
+            return h.magic == HeaderT::kMagic && h.version == HeaderT::kVersion &&
+                h.recordSize == sizeof(StatisticsEvent) && h.capacity > 0 && h.count <= h.capacity;
+        }
+
+    } // namespace
+
+    StatisticsEventStore::~StatisticsEventStore() {
+        close();
+    }
+
+    bool StatisticsEventStore::open(const std::filesystem::path& directory) {
+        return open(directory, Options{});
+    }
+
+    bool StatisticsEventStore::open(const std::filesystem::path& directory, const Options& options) {
+        close();
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec) return false;
+
+        directory_ = directory;
+        segmentRecords_ = options.segmentRecords > 0 ? options.segmentRecords : 1;
+        indexStride_ = options.indexStride > 0 ? options.indexStride : 1;
+
+        // 已有数据以第一个分段的容量为准
+        firstSegment_ = FirstSegmentNumber(directory_);
+        {
+            std::ifstream in(SegmentPath(directory_, firstSegment_), std::ios::binary);
+            SegmentHeader h;
+            if (in && in.read(reinterpret_cast<char*>(&h), sizeof(h))) {
+                if (!IsCompatibleHeader(h)) return false;
+                segmentRecords_ = h.capacity;
+            }
+        }
+
+        for (std::size_t i = firstSegment_; std::filesystem::exists(SegmentPath(directory_, i), ec); ++i) {
+            if (!openSegment(i, false)) {
+                close();
+                return false;
+            }
+        }
+        if (segments_.empty() && !openSegment(firstSegment_, true)) {
+            close();
+            return false;
+        }
+
+        // 除最后一个分段外都必须已写满，位置才能直接换算为（分段, 偏移）
+        for (std::size_t i = 0; i + 1 < segments_.size(); ++i) {
+            if (segmentHeader(i)->count != segmentRecords_) {
+                close();
+                return false;
+            }
+        }
+        size_ = (segments_.size() - 1) * segmentRecords_ + segmentHeader(segments_.size() - 1)->count;
+
+        open_ = true;
+        rebuildIndexFrom(0);
+        return true;
+    }
+
+    void StatisticsEventStore::close() {
+        flush();
+        segments_.clear();
+        index_.clear();
+        size_ = 0;
+        open_ = false;
+    }
+
+    bool StatisticsEventStore::openSegment(std::size_t number, bool create) {
+        const auto path = SegmentPath(directory_, number);
+        const std::size_t bytes = kSegmentHeaderSize + segmentRecords_ * sizeof(StatisticsEvent);
+
+        std::error_code ec;
+        if (!create && std::filesystem::file_size(path, ec) != bytes) return false;
+
+        auto file = std::make_unique<MappedFile>();
+        if (!file->open(path, bytes)) return false;
+
+        auto* h = reinterpret_cast<SegmentHeader*>(file->data());
+        if (create) {
+            *h = SegmentHeader{};
+            h->capacity = static_cast<std::uint32_t>(segmentRecords_);
+        } else if (!IsCompatibleHeader(*h) || h->capacity != segmentRecords_) {
+            return false;
+        }
+        segments_.push_back(std::move(file));
+        return true;
+    }
+
+    const StatisticsEvent* StatisticsEventStore::segmentRecords(std::size_t segment) const noexcept {
+        return reinterpret_cast<const StatisticsEvent*>(segments_[segment]->data() + kSegmentHeaderSize);
+    }
+
+    StatisticsEvent* StatisticsEventStore::segmentRecords(std::size_t segment) noexcept {
+        return reinterpret_cast<StatisticsEvent*>(segments_[segment]->data() + kSegmentHeaderSize);
+    }
+
+    StatisticsEventStore::SegmentHeader* StatisticsEventStore::segmentHeader(std::size_t segment) noexcept {
+        static_assert(sizeof(SegmentHeader) == kSegmentHeaderSize, "segment header layout is part of the file format");
+        return reinterpret_cast<SegmentHeader*>(segments_[segment]->data());
+    }
+
+    void StatisticsEventStore::rebuildIndexFrom(std::size_t position) {
+        // 只重建 position 之后的索引项（追加时为 O(1)，尾部插入时为该分段内的 O(n / stride)）
+        const std::size_t keep = (position + indexStride_ - 1) / indexStride_;
+        if (index_.size() > keep) index_.resize(keep);
+        for (std::size_t p = index_.size() * indexStride_; p < size_; p += indexStride_) {
+            index_.push_back(at(p).timestampMs);
+        }
+    }
+
+    bool StatisticsEventStore::append(const StatisticsEvent& event) {
+        if (!open_) return false;
+
+        std::size_t tail = segments_.size() - 1;
+        std::size_t tailCount = size_ - tail * segmentRecords_;
+        const bool inOrder = size_ == 0 || event.timestampMs >= at(size_ - 1).timestampMs;
+
+        if (inOrder && tailCount == segmentRecords_) {
+            if (!openSegment(firstSegment_ + tail + 1, true)) return false;
+            ++tail;
+            tailCount = 0;
+        }
+
+        std::size_t position = size_;
+        if (!inOrder) {
+            // 迟到事件：插在相同时间戳之后，只允许落在未写满的最后一个分段内
+            std::size_t lo = tail * segmentRecords_;
+            std::size_t hi = size_;
+            if (tailCount == segmentRecords_ || event.timestampMs < at(lo).timestampMs) return false;
+            while (lo < hi) {
+                const std::size_t mid = lo + (hi - lo) / 2;
+                if (at(mid).timestampMs <= event.timestampMs) lo = mid + 1; else hi = mid;
+            }
+            position = lo;
+        }
+
+        StatisticsEvent* records = segmentRecords(tail);
+        const std::size_t offset = position - tail * segmentRecords_;
+        if (offset < tailCount) {
+            std::memmove(records + offset + 1, records + offset, (tailCount - offset) * sizeof(StatisticsEvent));
+        }
+        records[offset] = event;
+
+        SegmentHeader* h = segmentHeader(tail);
+        h->count = static_cast<std::uint32_t>(tailCount + 1);
+        h->firstTimestampMs = records[0].timestampMs;
+        h->lastTimestampMs = records[tailCount].timestampMs;
+        ++size_;
+
+        if (inOrder) {
+            if (position % indexStride_ == 0) index_.push_back(event.timestampMs);
+        } else {
+            rebuildIndexFrom(position);
+        }
+        return true;
+    }
+
+    std::size_t StatisticsEventStore::dropSegmentsBefore(std::size_t number) {
+        if (!open_ || number <= firstSegment_) return 0;
+        const std::size_t drop = (std::min)(number - firstSegment_, sealedSegmentCount());
+        if (drop == 0) return 0;
+
+        // 先解除映射再删除文件（Windows 上映射中的文件无法删除）。删除失败的文件在下次打开时
+        // 仍会被读到，由调用方按汇总记录的编号再次调用本函数清理。
+        std::error_code ec;
+        for (std::size_t i = 0; i < drop; ++i) {
+            segments_[i]->close();
+            std::filesystem::remove(SegmentPath(directory_, firstSegment_ + i), ec);
+        }
+        segments_.erase(segments_.begin(), segments_.begin() + static_cast<std::ptrdiff_t>(drop));
+        firstSegment_ += drop;
+        size_ -= drop * segmentRecords_;
+
+        index_.clear();
+        rebuildIndexFrom(0);
+        return drop;
+    }
+
+    void StatisticsEventStore::flush() {
+        if (!segments_.empty()) segments_.back()->flushAsync();
+    }
+
+    std::size_t StatisticsEventStore::lowerBound(std::int64_t unixMs) const noexcept {
+        // 索引中第一个 >= unixMs 的项为 k：答案位于 ((k - 1) * stride, k * stride]
+        const auto it = std::lower_bound(index_.begin(), index_.end(), unixMs);
+        const std::size_t k = static_cast<std::size_t>(it - index_.begin());
+        if (k == 0) return 0;
+
+        std::size_t lo = (k - 1) * indexStride_ + 1;
+        std::size_t hi = (std::min)(k * indexStride_, size_);
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (at(mid).timestampMs < unixMs) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+
+    std::size_t StatisticsEventStore::range(std::int64_t fromMs, std::int64_t toMs,
+        std::vector<StatisticsEvent>& out) const {
+        if (!open_ || fromMs >= toMs) return 0;
+        const std::size_t first = lowerBound(fromMs);
+        const std::size_t last = lowerBound(toMs);
+        out.reserve(out.size() + (last - first));
+        visit(first, last, [&out](const StatisticsEvent* records, std::size_t n) {
+            out.insert(out.end(), records, records + n);
+        });
+        return last - first;
+    }
+
+    std::size_t StatisticsEventStore::recent(std::size_t limit, std::vector<StatisticsEvent>& out) const {
+        if (!open_) return 0;
+        const std::size_t first = size_ > limit ? size_ - limit : 0;
+        out.reserve(out.size() + (size_ - first));
+        visit(first, size_, [&out](const StatisticsEvent* records, std::size_t n) {
+            out.insert(out.end(), records, records + n);
+        });
+        return size_ - first;
+    }
+
+} // namespace pomodoro
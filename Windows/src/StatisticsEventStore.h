@@ -0,0 +1,115 @@
+#pragma once
+
+// Time-indexed, append-mostly store of StatisticsEvent records (the Windows counterpart of the Swift
+// `statistics_events` table and its getEvents(from:to:) / getRecentEvents(limit:) queries).
+//
+// Layout: a directory of segment files `events-NNNNNN.seg`, each a 64-byte header followed by a fixed
+// number of 16-byte records sorted by timestamp. Only the last segment is ever written; earlier ones are
+// full and immutable. Every segment is memory-mapped, so a record's global position maps directly to
+// (segment, offset) and a query result is one or two contiguous spans of mapped memory.
+//
+// A sparse in-memory index keeps the timestamp of every `indexStride`-th record. A range query is a
+// binary search over the index, a binary search inside one stride, and a contiguous read; "last N" is
+// pure arithmetic. Both stay well under a millisecond for ten years of events.
+//
+// Events normally arrive in time order. A late event that still belongs in the last segment is inserted
+// in place (memmove within that segment); one older than the last segment's first record is rejected.
+//
+// Old events are compacted by StatisticsCompactor: sealed segments at the front are rolled up and then
+// deleted with dropSegmentsBefore(). Segment file numbers keep increasing, and positions always count
+// from the first remaining segment.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "MappedFile.h"
+#include "StatisticsModels.h"
+
+namespace pomodoro {
+
+    class StatisticsEventStore {
+    public:
+        struct Options {
+            std::size_t segmentRecords{ 65536 };  // 每个分段文件的记录数（1 MiB）；打开已有数据时以文件为准
+            std::size_t indexStride{ 256 };       // 稀疏索引的步长
+        };
+
+        StatisticsEventStore() = default;
+        ~StatisticsEventStore();
+
+        StatisticsEventStore(const StatisticsEventStore&) = delete;
+        StatisticsEventStore& operator=(const StatisticsEventStore&) = delete;
+
+        // 打开（不存在则创建）目录并映射全部分段；遇到格式不符的分段返回 false
+        bool open(const std::filesystem::path& directory);
+        bool open(const std::filesystem::path& directory, const Options& options);
+        void close();
+        bool isOpen() const noexcept { return open_; }
+
+        // 追加一条事件；早于最后一个分段起点的事件无法插入，返回 false
+        bool append(const StatisticsEvent& event);
+
+        // 请求把最后一个分段的脏页写回（异步）
+        void flush();
+
+        std::size_t size() const noexcept { return size_; }
+
+        // 每个分段的记录数；除最后一个分段外都已写满且不再修改（可在其他线程只读访问）
+        std::size_t segmentCapacity() const noexcept { return segmentRecords_; }
+        std::size_t sealedSegmentCount() const noexcept { return segments_.empty() ? 0 : segments_.size() - 1; }
+        // 第一个分段的文件编号（events-NNNNNN.seg 中的 N）
+        std::size_t firstSegmentNumber() const noexcept { return firstSegment_; }
+
+        // 删除文件编号小于 number 的已写满分段（压缩之后回收空间；最后一个分段始终保留）。
+        // 之后的位置从剩余的第一个分段重新计数。返回删除的分段数。
+        std::size_t dropSegmentsBefore(std::size_t number);
+
+        // 第一条 timestampMs >= unixMs 的记录位置（全部更早时返回 size()）
+        std::size_t lowerBound(std::int64_t unixMs) const noexcept;
+
+        // 位置 [first, last) 的记录按分段拆成连续片段交给 fn(const StatisticsEvent*, std::size_t)
+        template <typename Fn>
+        void visit(std::size_t first, std::size_t last, Fn&& fn) const {
+            if (last > size_) last = size_;
+            while (first < last) {
+                const std::size_t segment = first / segmentRecords_;
+                const std::size_t offset = first % segmentRecords_;
+                const std::size_t n = (std::min)(last - first, segmentRecords_ - offset);
+                fn(segmentRecords(segment) + offset, n);
+                first += n;
+            }
+        }
+
+        // [fromMs, toMs) 内的事件，按时间顺序追加到 out；返回条数
+        std::size_t range(std::int64_t fromMs, std::int64_t toMs, std::vector<StatisticsEvent>& out) const;
+        // 最近 limit 条事件（按时间顺序）追加到 out；返回条数
+        std::size_t recent(std::size_t limit, std::vector<StatisticsEvent>& out) const;
+
+        const StatisticsEvent& at(std::size_t position) const noexcept {
+            return segmentRecords(position / segmentRecords_)[position % segmentRecords_];
+        }
+
+    private:
+        struct SegmentHeader;
+
+        bool openSegment(std::size_t number, bool create);
+        const StatisticsEvent* segmentRecords(std::size_t segment) const noexcept;
+        StatisticsEvent* segmentRecords(std::size_t segment) noexcept;
+        SegmentHeader* segmentHeader(std::size_t segment) noexcept;
+        void rebuildIndexFrom(std::size_t position);
+
+        std::filesystem::path directory_;
+        std::vector<std::unique_ptr<MappedFile>> segments_;
+        std::size_t firstSegment_{ 0 };   // segments_[0] 的文件编号
+        std::vector<std::int64_t> index_; // index_[k] = at(k * indexStride_).timestampMs
+        std::size_t segmentRecords_{ 0 };
+        std::size_t indexStride_{ 0 };
+        std::size_t size_{ 0 };
+        bool open_{ false };
+    };
+
+} // namespace pomodoro
@@ -0,0 +1,332 @@
+#include "StatisticsExport.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "LocalCalendar.h"
+#include "StatisticsEngine.h"
+#include "StatisticsEventStore.h"
+#include "StatisticsRollups.h"
+
+namespace pomodoro {
+
+    namespace {
+
+        constexpr std::size_t kMinChunkBytes = 4096;
+
+        // 固定大小的输出块：写满时交给 sink，之后复用同一块内存
+        class ChunkedOutput {
+        public:
+            ChunkedOutput(std::size_t capacity, const ExportSink& sink)
+                : buffer_((std::max)(capacity, kMinChunkBytes)), sink_(sink) {
+            }
+
+            void write(std::string_view text) {
+                while (!text.empty() && ok_) {
+                    if (size_ == buffer_.size()) flush();
+                    const std::size_t n = (std::min)(text.size(), buffer_.size() - size_);
+                    std::memcpy(buffer_.data() + size_, text.data(), n);
+                    size_ += n;
+                    text.remove_prefix(n);
+                }
+            }
+
+            void put(char c) {
+                if (size_ == buffer_.size()) flush();
+                buffer_[size_++] = c;
+            }
+
+            void flush() {
+                if (ok_ && size_ > 0) {
+                    ok_ = sink_(buffer_.data(), size_);
+                    bytes_ += size_;
+                }
+                size_ = 0;
+            }
+
+            bool ok() const noexcept { return ok_; }
+            std::uint64_t bytes() const noexcept { return bytes_; }
+
+        private:
+            std::vector<char> buffer_;
+            std::size_t size_{ 0 };
+            const ExportSink& sink_;
+            std::uint64_t bytes_{ 0 };
+            bool ok_{ true };
+        };
+
+        // 一行的字段按同一顺序写出：CSV 只写值（表头模式只写列名），NDJSON 写 "name":value
+        class RowWriter {
+        public:
+            RowWriter(ExportFormat format, ChunkedOutput& out, bool header = false)
+                : out_(out), json_(format == ExportFormat::Ndjson), header_(header) {
+            }
+
+            void beginRow() {
+                first_ = true;
+                if (json_) out_.put('{');
+            }
+
+            void endRow() {
+                if (json_) out_.put('}');
+                out_.put('\n');
+            }
+
+            void number(std::string_view name, std::int64_t v) {
+                if (!field(name)) return;
+                char text[24];
+                const auto r = std::to_chars(text, text + sizeof(text), v);
+                out_.write(std::string_view(text, static_cast<std::size_t>(r.ptr - text)));
+            }
+
+            // 毫秒 -> 秒（最短往返表示）
+            void seconds(std::string_view name, std::int64_t ms) {
+                if (!field(name)) return;
+                char text[32];
+                const auto r = std::to_chars(text, text + sizeof(text), static_cast<double>(ms) / 1000.0);
+                out_.write(std::string_view(text, static_cast<std::size_t>(r.ptr - text)));
+            }
+
+            // 只用于不含引号、逗号与控制字符的文本（类型名、日期）
+            void text(std::string_view name, std::string_view v) {
+                if (!field(name)) return;
+                if (json_) out_.put('"');
+                out_.write(v);
+                if (json_) out_.put('"');
+            }
+
+            void time(std::string_view name, std::int64_t unixMs) {
+                char text[kIsoTimestampLength];
+                formatIsoTimestamp(unixMs, text);
+                this->text(name, std::string_view(text, sizeof(text)));
+            }
+
+            void date(std::string_view name, std::int32_t dayIndex) {
+                char text[kDateKeyLength];
+                formatDateKey(dayIndex, text);
+                this->text(name, std::string_view(text, sizeof(text)));
+            }
+
+            void null(std::string_view name) {
+                if (field(name) && json_) out_.write("null");
+            }
+
+        private:
+            // 写出分隔符与列名；返回是否还需要写值
+            bool field(std::string_view name) {
+                if (!first_) out_.put(',');
+                first_ = false;
+                if (header_) {
+                    out_.write(name);
+                    return false;
+                }
+                if (json_) {
+                    out_.put('"');
+                    out_.write(name);
+                    out_.write("\":");
+                }
+                return true;
+            }
+
+            ChunkedOutput& out_;
+            bool json_;
+            bool header_;
+            bool first_{ true };
+        };
+
+        void WriteEvent(RowWriter& w, const StatisticsEvent& e) {
+            const auto type = static_cast<std::size_t>(e.type);
+            w.time("time", e.timestampMs);
+            w.number("timestamp_ms", e.timestampMs);
+            w.text("event_type", type < kStatisticsEventTypeCount ? kStatisticsEventTypeNames[type] : std::string_view("unknown"));
+            w.seconds("duration", e.durationMs);
+            if (e.flags & StatisticsEvent::kFlagUserSource) w.text("source", "user"); else w.null("source");
+            if (e.moodLevel != 0) w.number("mood_level", e.moodLevel); else w.null("mood_level");
+        }
+
+        void WriteHour(RowWriter& w, const HourlyRollup& h) {
+            w.date("date", h.dayIndex);
+            w.number("hour", h.hour);
+            w.time("hour_start", h.hourStartUtcMs);
+            w.seconds("work_time", h.workMs);
+            w.seconds("break_time", h.breakMs);
+            for (std::size_t t = 0; t < kStatisticsEventTypeCount; ++t) w.number(kStatisticsEventTypeNames[t], h.counts[t]);
+        }
+
+        void WriteDay(RowWriter& w, const DailyStatistics& d) {
+            w.date("date", d.dayIndex);
+            w.number("completed_pomodoros", d.completedPomodoros);
+            w.seconds("total_work_time", d.totalWorkMs);
+            w.number("short_break_count", d.shortBreakCount);
+            w.number("long_break_count", d.longBreakCount);
+            w.seconds("total_break_time", d.totalBreakMs);
+            w.number("cancelled_break_count", d.cancelledBreakCount);
+            w.number("screen_lock_count", d.screenLockCount);
+            w.number("screensaver_count", d.screensaverCount);
+            w.number("stay_up_late_count", d.stayUpLateCount);
+            if (d.moodLevel != 0) w.number("mood_level", d.moodLevel); else w.null("mood_level");
+            if (d.moodUpdatedAtMs != 0) w.time("mood_updated_at", d.moodUpdatedAtMs); else w.null("mood_updated_at");
+            w.time("first_activity_time", d.firstActivityMs);
+            w.time("last_activity_time", d.lastActivityMs);
+        }
+
+        template <typename Row, typename WriteFn>
+        void WriteHeader(ExportFormat format, ChunkedOutput& out, WriteFn write) {
+            if (format != ExportFormat::Csv) return;
+            RowWriter header(format, out, true);
+            header.beginRow();
+            write(header, Row{});
+            header.endRow();
+        }
+
+        // 小时汇总的流式输出：同一小时的连续部分（压缩边界两侧）先合并再写出，只保留一行待写
+        class HourlyStream {
+        public:
+            HourlyStream(RowWriter& w, ExportResult& result) : w_(w), result_(result) {}
+
+            void add(const HourlyRollup& h) {
+                if (hasPending_ && pending_.hourStartUtcMs == h.hourStartUtcMs) {
+                    for (std::size_t t = 0; t < kStatisticsEventTypeCount; ++t) {
+                        pending_.counts[t] = static_cast<std::uint16_t>((std::min)(0xFFFF, pending_.counts[t] + h.counts[t]));
+                    }
+                    pending_.workMs += h.workMs;
+                    pending_.breakMs += h.breakMs;
+                    return;
+                }
+                finish();
+                pending_ = h;
+                hasPending_ = true;
+            }
+
+            void finish() {
+                if (!hasPending_) return;
+                w_.beginRow();
+                WriteHour(w_, pending_);
+                w_.endRow();
+                ++result_.rows;
+                hasPending_ = false;
+            }
+
+        private:
+            RowWriter& w_;
+            ExportResult& result_;
+            HourlyRollup pending_;
+            bool hasPending_{ false };
+        };
+
+        void ExportEvents(const StatisticsEventStore& store, const ExportOptions& options, ChunkedOutput& out, ExportResult& result) {
+            WriteHeader<StatisticsEvent>(options.format, out, WriteEvent);
+            RowWriter w(options.format, out);
+            store.visit(store.lowerBound(options.fromMs), store.lowerBound(options.toMs),
+                [&](const StatisticsEvent* records, std::size_t n) {
+                    for (std::size_t i = 0; i < n && out.ok(); ++i) {
+                        w.beginRow();
+                        WriteEvent(w, records[i]);
+                        w.endRow();
+                        ++result.rows;
+                    }
+                });
+        }
+
+        void ExportHourly(const LocalCalendar& calendar, const StatisticsEventStore& store, const StatisticsRollups& rollups,
+            const ExportOptions& options, ChunkedOutput& out, ExportResult& result) {
+            WriteHeader<HourlyRollup>(options.format, out, WriteHour);
+            RowWriter w(options.format, out);
+            HourlyStream stream(w, result);
+
+            const auto& hourly = rollups.hourly();
+            for (std::size_t i = rollups.hourlyLowerBound(options.fromMs); i < hourly.size() && hourly[i].hourStartUtcMs < options.toMs && out.ok(); ++i) {
+                stream.add(hourly[i]);
+            }
+
+            // 原始事件按所在小时逐条合并；只有小时起点在范围内的才输出（本地小时最长 2 小时）
+            constexpr std::int64_t kLongestHourMs = 2LL * 60 * 60 * 1000;
+            const std::int64_t scanEnd = options.toMs > (std::numeric_limits<std::int64_t>::max)() - kLongestHourMs
+                ? options.toMs : options.toMs + kLongestHourMs;
+            store.visit(store.lowerBound(options.fromMs), store.lowerBound(scanEnd), [&](const StatisticsEvent* records, std::size_t n) {
+                for (std::size_t i = 0; i < n && out.ok(); ++i) {
+                    const LocalCalendar::Position at = calendar.locate(records[i].timestampMs);
+                    HourlyRollup h;
+                    h.hourStartUtcMs = calendar.hourStartUtcMs(at.dayIndex, at.hour);
+                    if (h.hourStartUtcMs < options.fromMs || h.hourStartUtcMs >= options.toMs) continue;
+                    h.dayIndex = at.dayIndex;
+                    h.hour = at.hour;
+                    applyStatisticsEvent(h, records[i]);
+                    stream.add(h);
+                }
+            });
+            stream.finish();
+        }
+
+        void ExportDaily(const StatisticsEngine& engine, const ExportOptions& options, ChunkedOutput& out, ExportResult& result) {
+            WriteHeader<DailyStatistics>(options.format, out, WriteDay);
+            RowWriter w(options.format, out);
+            const LocalCalendar& calendar = engine.calendar();
+            const DailyStatistics* days = engine.days();
+            for (std::size_t i = 0; i < engine.dayCount() && out.ok(); ++i) {
+                const DailyStatistics& d = days[i];
+                if (!d.hasActivity()) continue;
+                const std::int64_t start = calendar.dayStartUtcMs(d.dayIndex);
+                if (start < options.fromMs) continue;
+                if (start >= options.toMs) break;
+                w.beginRow();
+                WriteDay(w, d);
+                w.endRow();
+                ++result.rows;
+            }
+        }
+
+    } // namespace
+
+    ExportResult exportStatistics(const StatisticsEngine& engine, const StatisticsEventStore& store,
+        const StatisticsRollups& rollups, const ExportOptions& options, const ExportSink& sink) {
+        ExportResult result;
+        ChunkedOutput out(options.chunkBytes, sink);
+        switch (options.table) {
+        case ExportTable::Events:
+            ExportEvents(store, options, out, result);
+            break;
+        case ExportTable::Hourly:
+            ExportHourly(engine.calendar(), store, rollups, options, out, result);
+            break;
+        case ExportTable::Daily:
+            ExportDaily(engine, options, out, result);
+            break;
+        }
+        out.flush();
+        result.ok = out.ok();
+        result.bytes = out.bytes();
+        return result;
+    }
+
+    ExportResult exportStatisticsToFile(const std::filesystem::path& path, const StatisticsEngine& engine,
+        const StatisticsEventStore& store, const StatisticsRollups& rollups, const ExportOptions& options) {
+        auto temp = path;
+        temp += ".tmp";
+        ExportResult result;
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file) return result;
+            result = exportStatistics(engine, store, rollups, options, [&file](const char* data, std::size_t size) {
+                return static_cast<bool>(file.write(data, static_cast<std::streamsize>(size)));
+            });
+            file.flush();
+            result.ok = result.ok && static_cast<bool>(file);
+        }
+
+        std::error_code ec;
+        if (result.ok) {
+            std::filesystem::rename(temp, path, ec);
+            result.ok = !ec;
+        }
+        if (!result.ok) std::filesystem::remove(temp, ec);
+        return result;
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,65 @@
+#pragma once
+
+// Streaming export of the statistics history to CSV or NDJSON (the Swift `StatisticsManager.exportData`
+// builds one `[String: Any]` of everything instead).
+//
+// Rows are formatted straight into one fixed-size chunk buffer that is handed to the sink whenever it
+// fills up. Memory therefore stays at one chunk whatever the history length, and the cost per row is a
+// few integer formats. Sources:
+//   Events  raw events still in the StatisticsEventStore (compacted periods only exist as rollups)
+//   Hourly  HourlyRollups of compacted periods, followed by raw events aggregated hour by hour on the
+//           fly; an hour split by the compaction boundary is emitted once
+//   Daily   the StatisticsEngine day aggregates (compacted days are restored into the engine at startup)
+//
+// Column names follow the Swift SQLite tables (`statistics_events`, `daily_statistics`); durations are
+// seconds, times are ISO-8601 UTC, dates are local "yyyy-MM-dd".
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <limits>
+
+namespace pomodoro {
+
+    class StatisticsEngine;
+    class StatisticsEventStore;
+    class StatisticsRollups;
+
+    enum class ExportFormat {
+        Csv,     // 第一行为列名
+        Ndjson   // 每行一个 JSON 对象
+    };
+
+    enum class ExportTable {
+        Events,
+        Hourly,
+        Daily
+    };
+
+    struct ExportOptions {
+        ExportFormat format{ ExportFormat::Csv };
+        ExportTable table{ ExportTable::Events };
+        // 时间范围 [fromMs, toMs)：事件按时间戳，小时/日汇总按本地小时/日期的起点
+        std::int64_t fromMs{ (std::numeric_limits<std::int64_t>::min)() };
+        std::int64_t toMs{ (std::numeric_limits<std::int64_t>::max)() };
+        std::size_t chunkBytes{ 64 * 1024 };  // 每次交给 sink 的最大字节数（至少 4 KiB）
+    };
+
+    struct ExportResult {
+        bool ok{ false };
+        std::uint64_t rows{ 0 };   // 不含 CSV 表头
+        std::uint64_t bytes{ 0 };
+    };
+
+    // 接收一块输出；返回 false 时中止导出
+    using ExportSink = std::function<bool(const char* data, std::size_t size)>;
+
+    ExportResult exportStatistics(const StatisticsEngine& engine, const StatisticsEventStore& store,
+        const StatisticsRollups& rollups, const ExportOptions& options, const ExportSink& sink);
+
+    // 导出到文件：先写入 path.tmp，完成后替换 path；失败时不留下半个文件
+    ExportResult exportStatisticsToFile(const std::filesystem::path& path, const StatisticsEngine& engine,
+        const StatisticsEventStore& store, const StatisticsRollups& rollups, const ExportOptions& options);
+
+} // namespace pomodoro
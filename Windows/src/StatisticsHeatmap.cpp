@@ -0,0 +1,117 @@
+#include "StatisticsHeatmap.h"
+
+#include "StatisticsHeatmapKernels.h"
+
+namespace pomodoro {
+
+    namespace {
+
+        constexpr std::int64_t kSlotMs = detail::kHeatmapSlotMs;
+        constexpr std::int64_t kMaxWindowMs = 8LL * 24 * 60 * 60 * 1000;
+
+        static_assert(kMaxWindowMs < (1LL << 30), "window must stay inside the exact range of the slot division");
+        static_assert((kSlotMs >> detail::kHeatmapSlotPreShift) == 28125 && (kSlotMs & ((1 << detail::kHeatmapSlotPreShift) - 1)) == 0,
+            "slot magic is derived for 30-minute slots");
+        static_assert(detail::kHeatmapTypeColumnMask == HeatmapCube::kTypeStride - 1, "type column mask must match the cube row");
+
+        // 没有对应内核（或 CPU 不支持）的指令集使用标量实现
+        detail::HeatmapBinKernel KernelFor(SimdLevel level) noexcept {
+            if (!simdLevelSupported(level)) return detail::binHeatmapScalar;
+            detail::HeatmapBinKernel kernel = nullptr;
+            switch (level) {
+            case SimdLevel::Sse41: kernel = detail::sse41HeatmapKernel(); break;
+            case SimdLevel::Avx2: kernel = detail::avx2HeatmapKernel(); break;
+            default: break;
+            }
+            return kernel ? kernel : detail::binHeatmapScalar;
+        }
+
+    } // namespace
+
+    namespace detail {
+
+        // 单条事件：无符号相减把“早于窗口”和“晚于窗口”合并为一次比较
+        void binHeatmapScalar(const StatisticsEvent* events, std::size_t count, std::uint64_t startMs,
+            std::uint32_t windowMs, std::uint32_t slotCount, const std::int32_t* lut, std::uint32_t* cells) noexcept {
+            for (std::size_t i = 0; i < count; ++i) {
+                const StatisticsEvent& e = events[i];
+                const std::uint64_t rel = static_cast<std::uint64_t>(e.timestampMs) - startMs;
+                const std::uint32_t type = static_cast<std::uint8_t>(e.type);
+                const bool valid = rel < windowMs && type < kStatisticsEventTypeCount;
+                const std::uint32_t slot = valid ? static_cast<std::uint32_t>(rel) / static_cast<std::uint32_t>(kHeatmapSlotMs) : slotCount;
+                ++cells[static_cast<std::uint32_t>(lut[slot]) + (type & kHeatmapTypeColumnMask)];
+            }
+        }
+
+    } // namespace detail
+
+    std::uint32_t HeatmapCube::hourTotal(int day, int hour) const noexcept {
+        const std::size_t row = static_cast<std::size_t>(day * kHeatmapHours + hour) * kTypeStride;
+        std::uint32_t total = 0;
+        for (std::size_t t = 0; t < kStatisticsEventTypeCount; ++t) total += cells_[row + t];
+        return total;
+    }
+
+    std::uint32_t HeatmapCube::outsideCount() const noexcept {
+        std::uint32_t total = 0;
+        for (std::size_t t = 0; t < kTypeStride; ++t) total += cells_[kHeatmapCells * kTypeStride + t];
+        return total;
+    }
+
+    HeatmapBinner HeatmapBinner::uniform(std::int64_t windowStartUtcMs) {
+        constexpr std::int64_t kMsPerHour = 60LL * 60 * 1000;
+        std::array<std::int64_t, kHeatmapCells + 1> starts{};
+        for (int k = 0; k <= kHeatmapCells; ++k) starts[static_cast<std::size_t>(k)] = windowStartUtcMs + k * kMsPerHour;
+        return *fromHourStarts(starts);
+    }
+
+    HeatmapBinner HeatmapBinner::forWeek(const LocalCalendar& calendar, std::int32_t firstDay) {
+        if (auto binner = fromHourStarts(calendar.weekHourStarts(firstDay))) return *binner;
+        return uniform(calendar.dayStartUtcMs(firstDay));
+    }
+
+    std::optional<HeatmapBinner> HeatmapBinner::fromHourStarts(const std::array<std::int64_t, kHeatmapCells + 1>& hourStartsUtcMs) {
+        const std::int64_t start = hourStartsUtcMs.front();
+        const std::int64_t window = hourStartsUtcMs.back() - start;
+        if (window <= 0 || window > kMaxWindowMs) return std::nullopt;
+        for (std::size_t k = 1; k < hourStartsUtcMs.size(); ++k) {
+            const std::int64_t rel = hourStartsUtcMs[k] - start;
+            if (hourStartsUtcMs[k] < hourStartsUtcMs[k - 1] || rel % kSlotMs != 0) return std::nullopt;
+        }
+
+        HeatmapBinner binner;
+        binner.startMs_ = start;
+        binner.windowMs_ = static_cast<std::uint32_t>(window);
+        binner.slotCount_ = static_cast<std::uint32_t>(window / kSlotMs);
+        binner.lut_.resize(binner.slotCount_ + 1);
+
+        // 每个半小时归入起点不晚于它的最后一个本地小时；长度为 0 的小时（夏令时跳过）自然被越过
+        std::size_t cell = 0;
+        for (std::uint32_t slot = 0; slot < binner.slotCount_; ++slot) {
+            const std::int64_t at = start + slot * kSlotMs;
+            while (cell + 1 < static_cast<std::size_t>(kHeatmapCells) && hourStartsUtcMs[cell + 1] <= at) ++cell;
+            binner.lut_[slot] = static_cast<std::int32_t>(cell * HeatmapCube::kTypeStride);
+        }
+        binner.lut_[binner.slotCount_] = static_cast<std::int32_t>(kHeatmapCells * HeatmapCube::kTypeStride);
+        return binner;
+    }
+
+    void HeatmapBinner::binHourly(const HourlyRollup* rollups, std::size_t count, HeatmapCube& cube) const {
+        std::uint32_t* cells = cube.data();
+        for (std::size_t i = 0; i < count; ++i) {
+            const HourlyRollup& h = rollups[i];
+            if (h.hourStartUtcMs < startMs_ || h.hourStartUtcMs - startMs_ >= static_cast<std::int64_t>(windowMs_)) continue;
+            std::uint32_t* row = cells + lut_[static_cast<std::size_t>((h.hourStartUtcMs - startMs_) / kSlotMs)];
+            for (std::size_t t = 0; t < kStatisticsEventTypeCount; ++t) row[t] += h.counts[t];
+        }
+    }
+
+    void HeatmapBinner::bin(const StatisticsEvent* events, std::size_t count, HeatmapCube& cube) const {
+        bin(events, count, cube, bestSimdLevel());
+    }
+
+    void HeatmapBinner::bin(const StatisticsEvent* events, std::size_t count, HeatmapCube& cube, SimdLevel level) const {
+        KernelFor(level)(events, count, static_cast<std::uint64_t>(startMs_), windowMs_, slotCount_, lut_.data(), cube.data());
+    }
+
+} // namespace pomodoro
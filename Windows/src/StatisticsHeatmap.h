@@ -0,0 +1,89 @@
+#pragma once
+
+// Weekday x hour x event-type heatmap cube, the Windows counterpart of the Swift
+// `generateHeatmapData` (StatisticsModels.swift) and `debugEventTypeCounts(for:hour:)`.
+//
+// The Swift code calls Calendar / DateFormatter for every event. Here the local calendar is resolved
+// once per window: HeatmapBinner receives the UTC start of each local hour of the 7-day window and
+// turns it into a lookup table indexed by "half hours since window start". Binning an event is then
+// an unsigned subtract, an exact multiply-shift division, one table lookup and one increment, which
+// vectorizes over the contiguous 16-byte StatisticsEvent records (SSE4.1 / AVX2 kernels in their own
+// translation units, scalar fallback, selected at runtime through CpuFeatures).
+//
+// Local hours may be 0, 1 or 2 real hours long (DST spring-forward / fall-back); any offset change
+// that is a multiple of 30 minutes is represented exactly.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "CpuFeatures.h"
+#include "LocalCalendar.h"
+#include "StatisticsModels.h"
+
+namespace pomodoro {
+
+    constexpr int kHeatmapDays = 7;
+    constexpr int kHeatmapHours = 24;
+    constexpr int kHeatmapCells = kHeatmapDays * kHeatmapHours;
+
+    class HeatmapCube {
+    public:
+        // 每个格子按事件类型计数；列数补齐到 16 便于用位运算定位
+        static constexpr std::size_t kTypeStride = 16;
+        static_assert(kStatisticsEventTypeCount <= kTypeStride, "event types must fit in one cube row");
+
+        std::uint32_t count(int day, int hour, StatisticsEventType type) const noexcept {
+            return cells_[static_cast<std::size_t>(day * kHeatmapHours + hour) * kTypeStride + static_cast<std::size_t>(type)];
+        }
+
+        // 某个小时内所有类型的事件数（Swift totalActivities 的原始计数）
+        std::uint32_t hourTotal(int day, int hour) const noexcept;
+
+        // 落在窗口之外（或类型无效）的事件数
+        std::uint32_t outsideCount() const noexcept;
+
+        void clear() noexcept { cells_.fill(0); }
+
+        std::uint32_t* data() noexcept { return cells_.data(); }
+
+    private:
+        // 最后一行收集窗口外的事件，避免内核里出现分支
+        std::array<std::uint32_t, (kHeatmapCells + 1) * kTypeStride> cells_{};
+    };
+
+    class HeatmapBinner {
+    public:
+        // 以固定时区偏移划分：windowStartUtcMs 为第一天本地零点对应的 UTC 毫秒，之后每小时等长
+        static HeatmapBinner uniform(std::int64_t windowStartUtcMs);
+
+        // 本地日历中从 firstDay 开始的 7 天（含夏令时切换）；无法精确表示的时区退回等长小时
+        static HeatmapBinner forWeek(const LocalCalendar& calendar, std::int32_t firstDay);
+
+        // 由本地日历预先算好的每小时起点（UTC 毫秒，day * 24 + hour 顺序）与窗口结束时间构造。
+        // 起点必须不减，且与窗口起点相差 30 分钟的整数倍；窗口不超过 8 天。否则返回 nullopt。
+        static std::optional<HeatmapBinner> fromHourStarts(const std::array<std::int64_t, kHeatmapCells + 1>& hourStartsUtcMs);
+
+        std::int64_t windowStartMs() const noexcept { return startMs_; }
+        std::int64_t windowEndMs() const noexcept { return startMs_ + windowMs_; }
+
+        // 把 events[0, count) 累加到 cube（不清零，可分片多次调用，例如配合 StatisticsEventStore::visit）
+        void bin(const StatisticsEvent* events, std::size_t count, HeatmapCube& cube) const;
+        // 指定指令集（测试与基准用）；本构建没有该指令集的内核或 CPU 不支持时使用标量实现
+        void bin(const StatisticsEvent* events, std::size_t count, HeatmapCube& cube, SimdLevel level) const;
+
+        // 把已压缩的小时汇总按小时起点归入格子，按类型累加计数（窗口外的忽略）
+        void binHourly(const HourlyRollup* rollups, std::size_t count, HeatmapCube& cube) const;
+
+    private:
+        HeatmapBinner() = default;
+
+        std::int64_t startMs_{ 0 };
+        std::uint32_t windowMs_{ 0 };
+        std::uint32_t slotCount_{ 0 };     // 窗口内的半小时数；等于该值的下标表示“窗口外”
+        std::vector<std::int32_t> lut_;    // 半小时下标 -> 格子在 cube 中的偏移（行号 * kTypeStride）
+    };
+
+} // namespace pomodoro
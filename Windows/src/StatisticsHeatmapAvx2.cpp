@@ -0,0 +1,80 @@
+// AVX2 binning kernel for StatisticsHeatmap (compiled with -mavx2 or /arch:AVX2; see CMakeLists.txt).
+
+#include "StatisticsHeatmapKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        namespace {
+
+            // 8 条记录一组；256 位的 unpack 在两个 128 位通道内各自进行，得到的顺序为
+            // [e0 e2 e4 e6 | e1 e3 e5 e7]，slot 与类型列使用同一顺序，计数结果不受影响。
+            // 查表用 gather 直接得到格子偏移。
+            void Bin(const StatisticsEvent* events, std::size_t count, std::uint64_t startMs, std::uint32_t windowMs,
+                std::uint32_t slotCount, const std::int32_t* lut, std::uint32_t* cells) {
+                const __m256i base = _mm256_set_epi64x(0, static_cast<long long>(startMs), 0, static_cast<long long>(startMs));
+                const __m256i window = _mm256_set1_epi32(static_cast<int>(windowMs));
+                const __m256i minusOne = _mm256_set1_epi32(-1);
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i typeByte = _mm256_set1_epi32(0xFF);
+                const __m256i typeColumn = _mm256_set1_epi32(static_cast<int>(kHeatmapTypeColumnMask));
+                const __m256i typeCount = _mm256_set1_epi32(static_cast<int>(kStatisticsEventTypeCount));
+                const __m256i magic = _mm256_set1_epi32(static_cast<int>(kHeatmapSlotMagic));
+                const __m256i outside = _mm256_set1_epi32(static_cast<int>(slotCount));
+
+                alignas(32) std::int32_t offset[8];
+
+                std::size_t i = 0;
+                for (; i + 8 <= count; i += 8) {
+                    const auto* p = reinterpret_cast<const __m256i*>(events + i);
+                    const __m256i a = _mm256_sub_epi64(_mm256_loadu_si256(p + 0), base);
+                    const __m256i b = _mm256_sub_epi64(_mm256_loadu_si256(p + 1), base);
+                    const __m256i c = _mm256_sub_epi64(_mm256_loadu_si256(p + 2), base);
+                    const __m256i d = _mm256_sub_epi64(_mm256_loadu_si256(p + 3), base);
+
+                    const __m256i abLo = _mm256_unpacklo_epi32(a, b);
+                    const __m256i cdLo = _mm256_unpacklo_epi32(c, d);
+                    const __m256i relLo = _mm256_unpacklo_epi64(abLo, cdLo);
+                    const __m256i relHi = _mm256_unpackhi_epi64(abLo, cdLo);
+                    const __m256i meta = _mm256_unpackhi_epi64(_mm256_unpackhi_epi32(a, b), _mm256_unpackhi_epi32(c, d));
+                    const __m256i type = _mm256_and_si256(meta, typeByte);
+
+                    __m256i valid = _mm256_and_si256(_mm256_cmpeq_epi32(relHi, zero),
+                        _mm256_and_si256(_mm256_cmpgt_epi32(relLo, minusOne), _mm256_cmpgt_epi32(window, relLo)));
+                    valid = _mm256_and_si256(valid, _mm256_cmpgt_epi32(typeCount, type));
+
+                    const __m256i y = _mm256_srli_epi32(relLo, kHeatmapSlotPreShift);
+                    const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(y, magic), kHeatmapSlotMagicShift);
+                    const __m256i odd = _mm256_slli_epi64(
+                        _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(y, 32), magic), kHeatmapSlotMagicShift), 32);
+                    const __m256i s = _mm256_blendv_epi8(outside, _mm256_or_si256(even, odd), valid);
+
+                    const __m256i cell = _mm256_i32gather_epi32(lut, s, 4);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(offset), _mm256_add_epi32(cell, _mm256_and_si256(meta, typeColumn)));
+                    for (int k = 0; k < 8; ++k) ++cells[static_cast<std::uint32_t>(offset[k])];
+                }
+                binHeatmapScalar(events + i, count - i, startMs, windowMs, slotCount, lut, cells);
+            }
+
+        } // namespace
+
+        HeatmapBinKernel avx2HeatmapKernel() noexcept { return Bin; }
+
+    } // namespace detail
+
+} // namespace pomodoro
+
+#else
+
+namespace pomodoro {
+    namespace detail {
+        HeatmapBinKernel avx2HeatmapKernel() noexcept { return nullptr; }
+    } // namespace detail
+} // namespace pomodoro
+
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+// Internal to StatisticsHeatmap: the per-instruction-set binning kernels, in the same
+// one-file-per-instruction-set layout as ImageResamplerKernels.h. Besides intrinsics, the kernel units
+// include only this header and the plain StatisticsEvent record, so no inline library code built with
+// wider instructions can be picked by the linker for the rest of the program.
+//
+// A kernel adds every event in events[0, count) to cells: the half-hour slot of (timestamp - startMs)
+// is looked up in lut, and events outside [startMs, startMs + windowMs) or with an invalid type use
+// lut[slotCount], the "outside" row. All kernels give the same counts as the scalar reference.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "StatisticsModels.h"
+
+namespace pomodoro {
+
+    namespace detail {
+
+        constexpr std::int64_t kHeatmapSlotMs = 30LL * 60 * 1000;
+
+        // 半小时下标 = rel / 1'800'000 = ((rel >> 6) * kHeatmapSlotMagic) >> kHeatmapSlotMagicShift。
+        // 1'800'000 = 2^6 * 28125；magic = ceil(2^38 / 28125)，误差 8681 * y < 2^38 对 y < 2^24 成立，
+        // 即对 rel < 2^30（约 12 天）精确。multiply-shift 可以用 32x32->64 位的向量乘法实现。
+        constexpr std::uint32_t kHeatmapSlotPreShift = 6;
+        constexpr std::uint64_t kHeatmapSlotMagic = 9'773'437;
+        constexpr int kHeatmapSlotMagicShift = 38;
+
+        // 类型在格子行内的列（HeatmapCube::kTypeStride - 1）
+        constexpr std::uint32_t kHeatmapTypeColumnMask = 15;
+
+        using HeatmapBinKernel = void (*)(const StatisticsEvent* events, std::size_t count, std::uint64_t startMs,
+            std::uint32_t windowMs, std::uint32_t slotCount, const std::int32_t* lut, std::uint32_t* cells);
+
+        // 标量参考实现；向量实现用它处理末尾不足一组的事件
+        void binHeatmapScalar(const StatisticsEvent* events, std::size_t count, std::uint64_t startMs,
+            std::uint32_t windowMs, std::uint32_t slotCount, const std::int32_t* lut, std::uint32_t* cells) noexcept;
+
+        // 本构建未包含对应指令集时返回 nullptr
+        HeatmapBinKernel sse41HeatmapKernel() noexcept;
+        HeatmapBinKernel avx2HeatmapKernel() noexcept;
+
+    } // namespace detail
+
+} // namespace pomodoro
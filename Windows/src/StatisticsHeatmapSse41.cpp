@@ -0,0 +1,81 @@
+// SSE4.1 binning kernel for StatisticsHeatmap (compiled with -msse4.1 on GCC/Clang; see CMakeLists.txt).
+
+#include "StatisticsHeatmapKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <smmintrin.h>
+
+namespace pomodoro {
+
+    namespace detail {
+
+        namespace {
+
+            // 4 条记录（每条 16 字节：ts_lo, ts_hi, duration, type|flags|mood|reserved）转置为按字段的向量后计算半小时下标。
+            // 输出 slot 与 column（类型列）各 4 个，顺序与输入一致。
+            void Bin(const StatisticsEvent* events, std::size_t count, std::uint64_t startMs, std::uint32_t windowMs,
+                std::uint32_t slotCount, const std::int32_t* lut, std::uint32_t* cells) {
+                const __m128i base = _mm_set_epi64x(0, static_cast<long long>(startMs));
+                const __m128i window = _mm_set1_epi32(static_cast<int>(windowMs));
+                const __m128i minusOne = _mm_set1_epi32(-1);
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i typeByte = _mm_set1_epi32(0xFF);
+                const __m128i typeColumn = _mm_set1_epi32(static_cast<int>(kHeatmapTypeColumnMask));
+                const __m128i typeCount = _mm_set1_epi32(static_cast<int>(kStatisticsEventTypeCount));
+                const __m128i magic = _mm_set1_epi32(static_cast<int>(kHeatmapSlotMagic));
+                const __m128i outside = _mm_set1_epi32(static_cast<int>(slotCount));
+
+                alignas(16) std::int32_t slot[4];
+                alignas(16) std::int32_t column[4];
+
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4) {
+                    const auto* p = reinterpret_cast<const __m128i*>(events + i);
+                    const __m128i a = _mm_sub_epi64(_mm_loadu_si128(p + 0), base);
+                    const __m128i b = _mm_sub_epi64(_mm_loadu_si128(p + 1), base);
+                    const __m128i c = _mm_sub_epi64(_mm_loadu_si128(p + 2), base);
+                    const __m128i d = _mm_sub_epi64(_mm_loadu_si128(p + 3), base);
+
+                    const __m128i abLo = _mm_unpacklo_epi32(a, b);
+                    const __m128i cdLo = _mm_unpacklo_epi32(c, d);
+                    const __m128i relLo = _mm_unpacklo_epi64(abLo, cdLo);
+                    const __m128i relHi = _mm_unpackhi_epi64(abLo, cdLo);
+                    const __m128i meta = _mm_unpackhi_epi64(_mm_unpackhi_epi32(a, b), _mm_unpackhi_epi32(c, d));
+                    const __m128i type = _mm_and_si128(meta, typeByte);
+
+                    // 无符号 rel < windowMs：高 32 位为 0 且低 32 位在 [0, windowMs)（windowMs < 2^31）
+                    __m128i valid = _mm_and_si128(_mm_cmpeq_epi32(relHi, zero),
+                        _mm_and_si128(_mm_cmpgt_epi32(relLo, minusOne), _mm_cmplt_epi32(relLo, window)));
+                    valid = _mm_and_si128(valid, _mm_cmplt_epi32(type, typeCount));
+
+                    const __m128i y = _mm_srli_epi32(relLo, kHeatmapSlotPreShift);
+                    const __m128i even = _mm_srli_epi64(_mm_mul_epu32(y, magic), kHeatmapSlotMagicShift);
+                    const __m128i odd = _mm_slli_epi64(
+                        _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(y, 32), magic), kHeatmapSlotMagicShift), 32);
+                    const __m128i s = _mm_blendv_epi8(outside, _mm_or_si128(even, odd), valid);
+
+                    _mm_store_si128(reinterpret_cast<__m128i*>(slot), s);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(column), _mm_and_si128(meta, typeColumn));
+                    for (int k = 0; k < 4; ++k) ++cells[static_cast<std::uint32_t>(lut[slot[k]] + column[k])];
+                }
+                binHeatmapScalar(events + i, count - i, startMs, windowMs, slotCount, lut, cells);
+            }
+
+        } // namespace
+
+        HeatmapBinKernel sse41HeatmapKernel() noexcept { return Bin; }
+
+    } // namespace detail
+
+} // namespace pomodoro
+
+#else
+
+namespace pomodoro {
+    namespace detail {
+        HeatmapBinKernel sse41HeatmapKernel() noexcept { return nullptr; }
+    } // namespace detail
+} // namespace pomodoro
+
+#endif
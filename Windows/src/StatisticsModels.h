@@ -0,0 +1,89 @@
+#pragma once
+
+// C++ counterparts of the Swift statistics models (PomodoroScreen/Statistics/StatisticsModels.swift).
+//
+// StatisticsEvent is a fixed 16-byte, trivially copyable record so it can be stored and scanned
+// in bulk; the free-form Swift metadata dictionary is reduced to the fields the aggregates actually
+// read (source of a cancelled break, mood level). DailyStatistics mirrors the Swift struct's stored
+// counters; times are integer milliseconds instead of TimeInterval. HourlyRollup is the compacted form
+// of one local hour of raw events (see StatisticsCompactor).
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace pomodoro {
+
+    enum class StatisticsEventType : std::uint8_t {
+        PomodoroCompleted,     // 番茄钟完成
+        ShortBreakStarted,     // 短休息开始
+        LongBreakStarted,      // 长休息开始
+        BreakCancelled,        // 取消休息
+        BreakFinished,         // 休息完成
+        ScreenLocked,          // 息屏
+        ScreensaverActivated,  // 屏保激活
+        StayUpLateTriggered,   // 熬夜模式触发
+        StayUpLateActivity,    // 熬夜时段实际活动（每半小时记录）
+        MoodUpdated            // 心情/感受更新
+    };
+
+    constexpr std::size_t kStatisticsEventTypeCount = static_cast<std::size_t>(StatisticsEventType::MoodUpdated) + 1;
+
+    // 与 Swift StatisticsEventType 的 rawValue 相同（导出、报告等文本格式使用）
+    constexpr std::string_view kStatisticsEventTypeNames[kStatisticsEventTypeCount] = {
+        "pomodoro_completed", "short_break_started", "long_break_started", "break_cancelled", "break_finished",
+        "screen_locked", "screensaver_activated", "stay_up_late_triggered", "stay_up_late_activity", "mood_updated",
+    };
+
+    struct StatisticsEvent {
+        // 标志位
+        static constexpr std::uint8_t kFlagUserSource = 1u << 0; // 取消休息由用户主动发起（Swift metadata["source"] == "user"）
+
+        std::int64_t timestampMs{ 0 };    // Unix 毫秒
+        std::uint32_t durationMs{ 0 };    // 完成类事件的持续时间
+        StatisticsEventType type{ StatisticsEventType::PomodoroCompleted };
+        std::uint8_t flags{ 0 };
+        std::uint8_t moodLevel{ 0 };      // MoodUpdated：1-6
+        std::uint8_t reserved{ 0 };
+    };
+
+    static_assert(std::is_trivially_copyable_v<StatisticsEvent>, "StatisticsEvent is stored byte-for-byte");
+    static_assert(sizeof(StatisticsEvent) == 16, "StatisticsEvent must stay a fixed 16-byte record");
+
+    // 日统计数据：dayIndex 为本地日期距 1970-01-01 的天数
+    struct DailyStatistics {
+        std::int32_t dayIndex{ 0 };
+        std::int32_t completedPomodoros{ 0 };   // 完成的番茄钟数量
+        std::int64_t totalWorkMs{ 0 };          // 总工作时间
+        std::int32_t shortBreakCount{ 0 };      // 短休息次数
+        std::int32_t longBreakCount{ 0 };       // 长休息次数
+        std::int64_t totalBreakMs{ 0 };         // 总休息时间
+        std::int32_t cancelledBreakCount{ 0 };  // 取消休息次数（仅用户主动取消）
+        std::int32_t screenLockCount{ 0 };      // 息屏次数
+        std::int32_t screensaverCount{ 0 };     // 屏保次数
+        std::int32_t stayUpLateCount{ 0 };      // 熬夜次数
+        std::int64_t firstActivityMs{ 0 };      // 首次活动时间（0 表示当天没有事件）
+        std::int64_t lastActivityMs{ 0 };       // 最后活动时间
+        std::int32_t moodLevel{ 0 };            // 心情级别（1-6，0 表示未设置）
+        std::int64_t moodUpdatedAtMs{ 0 };
+
+        bool hasActivity() const noexcept { return firstActivityMs != 0; }
+    };
+
+    // 小时汇总：一个本地小时内原始事件的按类型计数与时长，原始事件被压缩后由它回答热力图等按小时的查询
+    struct HourlyRollup {
+        std::int64_t hourStartUtcMs{ 0 };      // 本地小时起点（LocalCalendar::hourStartUtcMs）
+        std::int32_t dayIndex{ 0 };
+        std::int32_t hour{ 0 };                // 本地小时（0-23）
+        std::uint32_t workMs{ 0 };             // PomodoroCompleted 的时长合计
+        std::uint32_t breakMs{ 0 };            // BreakFinished 的时长合计
+        std::uint16_t counts[kStatisticsEventTypeCount]{};
+        std::uint8_t reserved[48 - 24 - 2 * kStatisticsEventTypeCount]{};
+    };
+
+    static_assert(std::is_trivially_copyable_v<HourlyRollup>, "HourlyRollup is stored byte-for-byte");
+    static_assert(sizeof(HourlyRollup) == 48, "HourlyRollup must stay a fixed 48-byte record");
+    static_assert(std::is_trivially_copyable_v<DailyStatistics>, "DailyStatistics is stored byte-for-byte");
+
+} // namespace pomodoro
@@ -0,0 +1,146 @@
+#include "StatisticsRollups.h"
+
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+#include "DebouncedFileWriter.h"
+#include "StatisticsEngine.h"
+#include "StatisticsEventStore.h"
+
+namespace pomodoro {
+
+    namespace {
+
+        struct RollupFileHeader {
+            static constexpr std::uint32_t kMagic = 0x55524D50u; // "PMRU"
+            static constexpr std::uint16_t kVersion = 1;
+
+            std::uint32_t magic{ kMagic };
+            std::uint16_t version{ kVersion };
+            std::uint16_t dailySize{ static_cast<std::uint16_t>(sizeof(DailyStatistics)) };
+            std::uint16_t hourlySize{ static_cast<std::uint16_t>(sizeof(HourlyRollup)) };
+            std::uint16_t reserved0{ 0 };
+            std::uint32_t dailyCount{ 0 };
+            std::uint64_t hourlyCount{ 0 };
+            std::uint64_t firstRawSegment{ 0 };
+            std::uint8_t reserved[32]{};
+        };
+
+        static_assert(sizeof(RollupFileHeader) == 64, "rollup header layout is part of the file format");
+
+        template <typename T>
+        bool ReadRecords(std::ifstream& in, std::vector<T>& out, std::size_t count) {
+            out.resize(count);
+            return count == 0 || static_cast<bool>(in.read(reinterpret_cast<char*>(out.data()),
+                static_cast<std::streamsize>(count * sizeof(T))));
+        }
+
+        // 按键（日期 / 小时起点）找到汇总所在的位置：通常就是末尾，只有补录旧事件时才需要二分插入
+        template <typename T, typename Key, typename KeyOf>
+        T& SlotFor(std::vector<T>& rows, Key key, KeyOf keyOf) {
+            if (rows.empty() || keyOf(rows.back()) < key) return rows.emplace_back();
+            if (keyOf(rows.back()) == key) return rows.back();
+            auto it = std::lower_bound(rows.begin(), rows.end(), key,
+                [&keyOf](const T& row, Key k) { return keyOf(row) < k; });
+            if (it == rows.end() || keyOf(*it) != key) it = rows.insert(it, T{});
+            return *it;
+        }
+
+    } // namespace
+
+    void applyStatisticsEvent(HourlyRollup& hour, const StatisticsEvent& event) noexcept {
+        const auto type = static_cast<std::size_t>(event.type);
+        if (type >= kStatisticsEventTypeCount) return;
+        if (hour.counts[type] != 0xFFFF) ++hour.counts[type];
+        if (event.type == StatisticsEventType::PomodoroCompleted) hour.workMs += event.durationMs;
+        if (event.type == StatisticsEventType::BreakFinished) hour.breakMs += event.durationMs;
+    }
+
+    bool StatisticsRollups::load(const std::filesystem::path& path) {
+        daily_.clear();
+        hourly_.clear();
+        firstRawSegment_ = 0;
+
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec)) return true;
+
+        std::ifstream in(path, std::ios::binary);
+        RollupFileHeader h;
+        if (!in || !in.read(reinterpret_cast<char*>(&h), sizeof(h))) return false;
+        if (h.magic != RollupFileHeader::kMagic || h.version != RollupFileHeader::kVersion ||
+            h.dailySize != sizeof(DailyStatistics) || h.hourlySize != sizeof(HourlyRollup)) {
+            return false;
+        }
+        const std::uint64_t expected = sizeof(h) + h.dailyCount * sizeof(DailyStatistics) + h.hourlyCount * sizeof(HourlyRollup);
+        if (std::filesystem::file_size(path, ec) != expected) return false;
+
+        if (!ReadRecords(in, daily_, h.dailyCount) || !ReadRecords(in, hourly_, static_cast<std::size_t>(h.hourlyCount))) {
+            daily_.clear();
+            hourly_.clear();
+            return false;
+        }
+        firstRawSegment_ = static_cast<std::size_t>(h.firstRawSegment);
+        return true;
+    }
+
+    bool StatisticsRollups::save(const std::filesystem::path& path) const {
+        return writeFileAtomically(path, [this](const std::filesystem::path& temp) {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            RollupFileHeader h;
+            h.dailyCount = static_cast<std::uint32_t>(daily_.size());
+            h.hourlyCount = hourly_.size();
+            h.firstRawSegment = firstRawSegment_;
+            out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+            out.write(reinterpret_cast<const char*>(daily_.data()), static_cast<std::streamsize>(daily_.size() * sizeof(DailyStatistics)));
+            out.write(reinterpret_cast<const char*>(hourly_.data()), static_cast<std::streamsize>(hourly_.size() * sizeof(HourlyRollup)));
+            out.close();
+            return static_cast<bool>(out);
+        });
+    }
+
+    void StatisticsRollups::addEvents(const StatisticsEvent* events, std::size_t count, const LocalCalendar& calendar) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const StatisticsEvent& e = events[i];
+            const LocalCalendar::Position at = calendar.locate(e.timestampMs);
+
+            DailyStatistics& day = SlotFor(daily_, at.dayIndex, [](const DailyStatistics& d) { return d.dayIndex; });
+            day.dayIndex = at.dayIndex;
+            applyStatisticsEvent(day, e);
+
+            const std::int64_t hourStart = calendar.hourStartUtcMs(at.dayIndex, at.hour);
+            HourlyRollup& hour = SlotFor(hourly_, hourStart, [](const HourlyRollup& h) { return h.hourStartUtcMs; });
+            hour.hourStartUtcMs = hourStart;
+            hour.dayIndex = at.dayIndex;
+            hour.hour = at.hour;
+            applyStatisticsEvent(hour, e);
+        }
+    }
+
+    void StatisticsRollups::dropHourlyBefore(std::int32_t dayIndex) {
+        const auto end = std::find_if(hourly_.begin(), hourly_.end(), [dayIndex](const HourlyRollup& h) { return h.dayIndex >= dayIndex; });
+        hourly_.erase(hourly_.begin(), end);
+    }
+
+    void StatisticsRollups::dropDailyBefore(std::int32_t dayIndex) {
+        const auto end = std::find_if(daily_.begin(), daily_.end(), [dayIndex](const DailyStatistics& d) { return d.dayIndex >= dayIndex; });
+        daily_.erase(daily_.begin(), end);
+    }
+
+    std::size_t StatisticsRollups::hourlyLowerBound(std::int64_t unixMs) const noexcept {
+        const auto it = std::lower_bound(hourly_.begin(), hourly_.end(), unixMs,
+            [](const HourlyRollup& h, std::int64_t at) { return h.hourStartUtcMs < at; });
+        return static_cast<std::size_t>(it - hourly_.begin());
+    }
+
+    void binHeatmapWindow(const HeatmapBinner& binner, const StatisticsRollups& rollups,
+        const StatisticsEventStore& store, HeatmapCube& cube) {
+        const std::size_t first = rollups.hourlyLowerBound(binner.windowStartMs());
+        const std::size_t last = rollups.hourlyLowerBound(binner.windowEndMs());
+        binner.binHourly(rollups.hourly().data() + first, last - first, cube);
+
+        store.visit(store.lowerBound(binner.windowStartMs()), store.lowerBound(binner.windowEndMs()),
+            [&binner, &cube](const StatisticsEvent* records, std::size_t n) { binner.bin(records, n, cube); });
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,64 @@
+#pragma once
+
+// Compacted statistics history: per-day (DailyStatistics) and per-local-hour (HourlyRollup) aggregates
+// of raw events that StatisticsCompactor has removed from the StatisticsEventStore.
+//
+// Both tables are sorted by time and only ever grow at the end (new compactions cover later events).
+// A day or hour that straddles the compaction boundary is split: its early part lives here and the
+// rest is still raw, and readers add the two (StatisticsEngine::restoreDay, binHeatmapWindow).
+//
+// File format (`statistics/rollups.bin`): a 64-byte header, the daily records, then the hourly records.
+// The file is small (about 3 MB for ten years) and is rewritten whole through a temporary file and a
+// rename, so a crash leaves either the old or the new version.
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "LocalCalendar.h"
+#include "StatisticsHeatmap.h"
+#include "StatisticsModels.h"
+
+namespace pomodoro {
+
+    class StatisticsEventStore;
+
+    class StatisticsRollups {
+    public:
+        // 读取汇总文件；文件不存在时为空并返回 true，格式不符返回 false（内容保持为空）
+        bool load(const std::filesystem::path& path);
+        // 写入 path.tmp 并落盘后替换 path（writeFileAtomically）
+        bool save(const std::filesystem::path& path) const;
+
+        // 并入一段按时间排序的原始事件（日期与小时按 calendar 划分）
+        void addEvents(const StatisticsEvent* events, std::size_t count, const LocalCalendar& calendar);
+
+        // 保留策略：删除早于 dayIndex 的汇总
+        void dropHourlyBefore(std::int32_t dayIndex);
+        void dropDailyBefore(std::int32_t dayIndex);
+
+        const std::vector<DailyStatistics>& daily() const noexcept { return daily_; }
+        const std::vector<HourlyRollup>& hourly() const noexcept { return hourly_; }
+
+        // 第一个小时起点 >= unixMs 的小时汇总位置
+        std::size_t hourlyLowerBound(std::int64_t unixMs) const noexcept;
+
+        // 事件存储中第一个尚未压缩的分段编号（更早的分段都已并入汇总，可以删除）
+        std::size_t firstRawSegment() const noexcept { return firstRawSegment_; }
+        void setFirstRawSegment(std::size_t number) noexcept { firstRawSegment_ = number; }
+
+    private:
+        std::vector<DailyStatistics> daily_;
+        std::vector<HourlyRollup> hourly_;
+        std::size_t firstRawSegment_{ 0 };
+    };
+
+    // 小时汇总对该小时的增量（与 applyStatisticsEvent 对日汇总的增量对应）
+    void applyStatisticsEvent(HourlyRollup& hour, const StatisticsEvent& event) noexcept;
+
+    // 热力图查询：窗口内已压缩的部分读小时汇总，仍是原始事件的部分读事件存储，两者累加到 cube
+    void binHeatmapWindow(const HeatmapBinner& binner, const StatisticsRollups& rollups,
+        const StatisticsEventStore& store, HeatmapCube& cube);
+
+} // namespace pomodoro
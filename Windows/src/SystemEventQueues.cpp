@@ -0,0 +1,71 @@
+#include "SystemEventQueues.h"
+
+#include "PomodoroTimer.h"
+
+namespace pomodoro {
+
+    SystemEventQueues::SystemEventQueues(const MonotonicClock& clock)
+        : clock_(&clock) {}
+
+    bool SystemEventQueues::post(SystemEventSource source, AutoRestartEvent event) {
+        return post(source, event, clock_->now());
+    }
+
+    bool SystemEventQueues::post(SystemEventSource source, AutoRestartEvent event, MonotonicClock::time_point at) {
+        if (rings_[static_cast<std::size_t>(source)].tryPush(TimedAutoRestartEvent{ at, event })) {
+            // acq_rel：消费者清除标记时同时看到这次写入，不会漏掉唤醒
+            if (wake_ && !wakePending_.exchange(true, std::memory_order_acq_rel)) wake_();
+            return true;
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::size_t SystemEventQueues::drain(TimedAutoRestartEvent* out, std::size_t maxCount) {
+        // 先清除唤醒标记再取快照：快照之后到达的事件会重新唤醒消费者
+        wakePending_.exchange(false, std::memory_order_acq_rel);
+
+        // 先对每个队列取一次快照，合并期间新到的事件留给下一次 drain
+        std::array<std::size_t, kSystemEventSourceCount> avail{};
+        std::array<std::size_t, kSystemEventSourceCount> taken{};
+        for (std::size_t s = 0; s < kSystemEventSourceCount; ++s) {
+            avail[s] = rings_[s].available();
+        }
+
+        std::size_t written = 0;
+        while (written < maxCount) {
+            // 来源只有几个，线性选最小时间戳比堆更快
+            std::size_t best = kSystemEventSourceCount;
+            for (std::size_t s = 0; s < kSystemEventSourceCount; ++s) {
+                if (taken[s] == avail[s]) continue;
+                if (best == kSystemEventSourceCount ||
+                    rings_[s].peek(taken[s]).at < rings_[best].peek(taken[best]).at) {
+                    best = s;
+                }
+            }
+            if (best == kSystemEventSourceCount) break;
+            out[written++] = rings_[best].peek(taken[best]++);
+        }
+
+        for (std::size_t s = 0; s < kSystemEventSourceCount; ++s) {
+            if (taken[s] != 0) rings_[s].consume(taken[s]);
+        }
+        return written;
+    }
+
+    std::size_t SystemEventQueues::drainTo(PomodoroTimer& timer) {
+        constexpr std::size_t kChunk = 64;
+        TimedAutoRestartEvent timed[kChunk];
+
+        std::size_t total = 0;
+        while (true) {
+            const std::size_t n = drain(timed, kChunk);
+            if (n == 0) break;
+            timer.onSystemEvents(timed, n);
+            total += n;
+            if (n < kChunk) break;
+        }
+        return total;
+    }
+
+} // namespace pomodoro
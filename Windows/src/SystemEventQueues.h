@@ -0,0 +1,69 @@
+#pragma once
+
+// Per-source event rings between detection threads and the timer thread.
+//
+// Each detection source (idle polling, session lock notifications, screensaver polling) runs on its own
+// thread and posts into its own SpscEventRing, so producers never contend with each other or with the
+// UI thread. A post into empty queues calls the wake handler once (on Windows it sets an auto-reset
+// event that the main loop waits on), so the owner does not sleep through events that arrive while
+// the timer is not running. The owner then calls drainTo(), which merges all rings in timestamp order
+// and feeds the timestamped events to PomodoroTimer::onSystemEvents in batches.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "MonotonicClock.h"
+#include "SpscEventRing.h"
+
+namespace pomodoro {
+
+    class PomodoroTimer;
+
+    enum class SystemEventSource : std::uint8_t {
+        Idle,        // 无操作检测（IdleTimeExceeded / UserActivityDetected）
+        SessionLock, // 锁屏/解锁通知
+        Screensaver  // 屏保启动/停止
+    };
+
+    constexpr std::size_t kSystemEventSourceCount = 3;
+
+    class SystemEventQueues {
+    public:
+        static constexpr std::size_t kRingCapacity = 1024;
+        using Ring = SpscEventRing<kRingCapacity>;
+
+        // 时间戳取自 clock；clock 的生命周期必须长于本对象
+        explicit SystemEventQueues(const MonotonicClock& clock = SteadyClock::instance());
+
+        SystemEventQueues(const SystemEventQueues&) = delete;
+        SystemEventQueues& operator=(const SystemEventQueues&) = delete;
+
+        // 在任何生产者开始 post 之前设置。之后在生产者线程上调用，必须线程安全且不阻塞。
+        // 消费者 drain 之后的第一次 post 才会调用，连续投递只唤醒一次
+        void setWakeHandler(std::function<void()> wake) { wake_ = std::move(wake); }
+
+        // 生产者：每个 source 只能由一个线程调用。队列满时丢弃并计数，返回 false。
+        bool post(SystemEventSource source, AutoRestartEvent event);
+        bool post(SystemEventSource source, AutoRestartEvent event, MonotonicClock::time_point at);
+
+        // 消费者：把各队列当前已有的事件按时间戳合并（时间相同按来源顺序），最多写入 maxCount 个，返回写入数
+        std::size_t drain(TimedAutoRestartEvent* out, std::size_t maxCount);
+
+        // 消费者：取空所有队列，连同时间戳分批交给 timer.onSystemEvents；返回处理的事件数
+        std::size_t drainTo(PomodoroTimer& timer);
+
+        std::uint64_t droppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        std::array<Ring, kSystemEventSourceCount> rings_;
+        std::atomic<std::uint64_t> dropped_{ 0 };
+        std::atomic<bool> wakePending_{ false }; // 已唤醒、消费者尚未 drain
+        std::function<void()> wake_;
+        const MonotonicClock* clock_;
+    };
+
+} // namespace pomodoro
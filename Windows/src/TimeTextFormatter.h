@@ -0,0 +1,68 @@
+#pragma once
+
+// Allocation-free "MM:SS" formatting for the per-second time display.
+//
+// Writes into a caller-owned buffer of kTimeTextCapacity characters, for both narrow (UTF-8) and wide
+// (UTF-16 wchar_t on Windows) text, using a precomputed "00".."99" digit-pair table. The output is
+// NUL-terminated; the return value is the length without the terminator. Minutes are printed with at
+// least two digits (same as the former `std::setw(2)` formatting), up to 9999:59.
+
+#include <array>
+#include <cstddef>
+
+namespace pomodoro {
+
+    constexpr std::size_t kTimeTextCapacity = 8; // "9999:59" + NUL
+
+    namespace detail {
+
+        struct DigitPairTable {
+            std::array<char, 200> chars{};
+
+            constexpr DigitPairTable() {
+                for (int i = 0; i < 100; ++i) {
+                    chars[static_cast<std::size_t>(i) * 2] = static_cast<char>('0' + i / 10);
+                    chars[static_cast<std::size_t>(i) * 2 + 1] = static_cast<char>('0' + i % 10);
+                }
+            }
+        };
+
+        inline constexpr DigitPairTable kDigitPairs{};
+
+        template <typename CharT>
+        constexpr CharT* writeDigitPair(CharT* out, int value) noexcept {
+            const std::size_t i = static_cast<std::size_t>(value) * 2;
+            out[0] = static_cast<CharT>(kDigitPairs.chars[i]);
+            out[1] = static_cast<CharT>(kDigitPairs.chars[i + 1]);
+            return out + 2;
+        }
+
+    } // namespace detail
+
+    // totalSeconds < 0 视为 0；超过 9999:59 时截断显示为 9999:59
+    template <typename CharT>
+    constexpr std::size_t formatTimeText(int totalSeconds, CharT (&out)[kTimeTextCapacity]) noexcept {
+        constexpr int kMaxSeconds = 9999 * 60 + 59;
+        if (totalSeconds < 0) totalSeconds = 0;
+        if (totalSeconds > kMaxSeconds) totalSeconds = kMaxSeconds;
+
+        const int minutes = totalSeconds / 60;
+        const int seconds = totalSeconds % 60;
+
+        CharT* p = out;
+        if (minutes >= 100) {
+            p = detail::writeDigitPair(p, minutes / 100);
+            // 三位数分钟不补前导零：100..999 -> "100".."999"
+            if (minutes < 1000) {
+                p[-2] = p[-1];
+                --p;
+            }
+        }
+        p = detail::writeDigitPair(p, minutes % 100);
+        *p++ = static_cast<CharT>(':');
+        p = detail::writeDigitPair(p, seconds);
+        *p = static_cast<CharT>(0);
+        return static_cast<std::size_t>(p - out);
+    }
+
+} // namespace pomodoro
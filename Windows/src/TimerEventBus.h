@@ -0,0 +1,135 @@
+#pragma once
+
+// Typed multi-subscriber observer bus for PomodoroTimer notifications.
+//
+// - Subscribers live in a fixed number of inline slots; each slot stores the callable itself (up to
+//   kInlineCallableSize bytes, trivially copyable — e.g. lambdas capturing a few references/pointers),
+//   so subscribe/publish never allocate.
+// - Each subscriber has an event mask; publish() skips slots whose mask does not match.
+// - Events carry a TimerStateSnapshot computed once by the timer, so subscribers read plain fields
+//   instead of calling back into PomodoroTimer / AutoRestartStateMachine.
+//
+// Single-threaded: subscribe/unsubscribe/publish must all run on the thread that owns the timer.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+#include "AutoRestartStateMachine.h"
+
+namespace pomodoro {
+
+    enum class TimerEventKind : std::uint8_t {
+        TimeUpdated,       // 显示秒数变化（原 onTimeUpdate）
+        PomodoroFinished,  // 工作阶段结束，进入休息（原 onTimerFinished）
+        ForcedSleepEnded,  // 熬夜强制睡眠结束（原 onForcedSleepEndedCallback）
+        StateChanged,      // 需要持久化的状态（阶段、截止时间、计数等）发生变化，每次公开操作结束时最多一次
+        RestStarted,       // 进入短/长休息（snapshot.timerType 区分），phaseSeconds 为计划休息时长
+        RestFinished,      // 休息自然结束，phaseSeconds 为休息时长
+        RestCancelled,     // 用户在休息中开始/停止计时，phaseSeconds 为已休息的时长
+        StayUpTriggered    // 熬夜限制触发，进入强制睡眠
+    };
+
+    using TimerEventMask = std::uint32_t;
+
+    constexpr TimerEventMask timerEventBit(TimerEventKind kind) noexcept {
+        return TimerEventMask{ 1 } << static_cast<unsigned>(kind);
+    }
+
+    constexpr TimerEventMask kTimerEventTimeUpdated = timerEventBit(TimerEventKind::TimeUpdated);
+    constexpr TimerEventMask kTimerEventPomodoroFinished = timerEventBit(TimerEventKind::PomodoroFinished);
+    constexpr TimerEventMask kTimerEventForcedSleepEnded = timerEventBit(TimerEventKind::ForcedSleepEnded);
+    constexpr TimerEventMask kTimerEventStateChanged = timerEventBit(TimerEventKind::StateChanged);
+    constexpr TimerEventMask kTimerEventRestStarted = timerEventBit(TimerEventKind::RestStarted);
+    constexpr TimerEventMask kTimerEventRestFinished = timerEventBit(TimerEventKind::RestFinished);
+    constexpr TimerEventMask kTimerEventRestCancelled = timerEventBit(TimerEventKind::RestCancelled);
+    constexpr TimerEventMask kTimerEventStayUpTriggered = timerEventBit(TimerEventKind::StayUpTriggered);
+    // 阶段变化（统计模块订阅的事件集合）
+    constexpr TimerEventMask kTimerEventPhaseChanges = kTimerEventPomodoroFinished | kTimerEventRestStarted |
+        kTimerEventRestFinished | kTimerEventRestCancelled | kTimerEventStayUpTriggered;
+    constexpr TimerEventMask kTimerEventAll = kTimerEventTimeUpdated | kTimerEventForcedSleepEnded |
+        kTimerEventStateChanged | kTimerEventPhaseChanges;
+
+    // 发布时刻的计时器状态（一次计算，所有订阅者共享）
+    struct TimerStateSnapshot {
+        AutoRestartState state{ AutoRestartState::Idle };
+        TimerType timerType{ TimerType::Pomodoro };
+        int remainingSeconds{ 0 };
+        int completedPomodoros{ 0 };
+        bool isRunning{ false };
+        bool isPaused{ false };
+        bool isInRestPeriod{ false };
+        bool isRestTimerRunning{ false };
+        bool isInForcedSleep{ false };
+        bool isMeetingMode{ false };
+    };
+
+    struct TimerEvent {
+        TimerEventKind kind{ TimerEventKind::TimeUpdated };
+        TimerStateSnapshot snapshot{};
+        std::string_view timeText{}; // 仅 TimeUpdated 携带 "MM:SS"，只在回调期间有效
+        int phaseSeconds{ 0 };       // 阶段事件携带的时长（见 TimerEventKind），其他事件为 0
+    };
+
+    class TimerEventBus {
+    public:
+        static constexpr std::size_t kMaxSubscribers = 8;
+        static constexpr std::size_t kInlineCallableSize = 4 * sizeof(void*);
+
+        using SubscriptionId = std::uint32_t; // 0 表示无效（槽位已满）
+
+        // 注册订阅者；槽位已满时返回 0。callable 签名为 void(const TimerEvent&)。
+        template <typename Fn>
+        SubscriptionId subscribe(TimerEventMask mask, Fn callable) {
+            static_assert(sizeof(Fn) <= kInlineCallableSize, "callable too large for an inline slot; capture less");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable over-aligned");
+            static_assert(std::is_trivially_copyable_v<Fn> && std::is_trivially_destructible_v<Fn>,
+                "callable must be trivially copyable (capture references / pointers only)");
+
+            for (std::size_t i = 0; i < kMaxSubscribers; ++i) {
+                Slot& slot = slots_[i];
+                if (slot.invoke != nullptr) continue;
+                ::new (static_cast<void*>(slot.storage)) Fn(callable);
+                slot.invoke = [](const void* storage, const TimerEvent& event) {
+                    (*static_cast<const Fn*>(storage))(event);
+                };
+                slot.mask = mask;
+                activeMask_ |= mask;
+                return static_cast<SubscriptionId>(i + 1);
+            }
+            return 0;
+        }
+
+        void unsubscribe(SubscriptionId id) noexcept {
+            if (id == 0 || id > kMaxSubscribers) return;
+            slots_[id - 1] = Slot{};
+            activeMask_ = 0;
+            for (const auto& slot : slots_) activeMask_ |= slot.mask;
+        }
+
+        // 是否有订阅者关心该事件；发布方据此跳过快照计算
+        bool wants(TimerEventKind kind) const noexcept { return (activeMask_ & timerEventBit(kind)) != 0; }
+
+        void publish(const TimerEvent& event) const {
+            const TimerEventMask bit = timerEventBit(event.kind);
+            if ((activeMask_ & bit) == 0) return;
+            for (const auto& slot : slots_) {
+                if ((slot.mask & bit) != 0) slot.invoke(slot.storage, event);
+            }
+        }
+
+    private:
+        struct Slot {
+            alignas(std::max_align_t) unsigned char storage[kInlineCallableSize]{};
+            void (*invoke)(const void*, const TimerEvent&){ nullptr };
+            TimerEventMask mask{ 0 };
+        };
+
+        std::array<Slot, kMaxSubscribers> slots_{};
+        TimerEventMask activeMask_{ 0 };
+    };
+
+} // namespace pomodoro
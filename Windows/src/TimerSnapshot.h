@@ -0,0 +1,72 @@
+#pragma once
+
+// Compact, versioned binary snapshot of PomodoroTimer + AutoRestartStateMachine state.
+//
+// Written (via TimerSnapshotStore) on every state transition and restored at startup, so a crash,
+// update or reboot resumes the exact phase and deadline instead of starting from scratch. The struct
+// is trivially copyable, fixed-layout and < 64 bytes; it is copied byte-for-byte into a memory-mapped
+// file. Remaining time is stored together with the wall-clock time of the write, because monotonic
+// clock values do not survive a reboot.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace pomodoro {
+
+    struct TimerSnapshot {
+        static constexpr std::uint32_t kMagic = 0x4E534D50u; // "PMSN"
+        static constexpr std::uint16_t kVersion = 1;
+
+        // 标志位
+        static constexpr std::uint8_t kFlagLongBreak = 1u << 0;
+        static constexpr std::uint8_t kFlagStayUpTime = 1u << 1;
+
+        std::uint32_t magic{ kMagic };
+        std::uint16_t version{ kVersion };
+        std::uint16_t size{ 0 };              // sizeof(TimerSnapshot)，用于识别布局变化
+        std::uint32_t sequence{ 0 };          // 每次写入递增，恢复时取最新的有效副本
+        std::int32_t completedPomodoros{ 0 };
+        std::int64_t savedAtUnixMs{ 0 };      // 写入时的墙钟时间
+        std::int64_t remainingMs{ 0 };        // 写入时当前阶段的剩余时间
+        std::uint8_t state{ 0 };              // AutoRestartState
+        std::uint8_t timerType{ 0 };          // TimerType
+        std::uint8_t flags{ 0 };
+        std::uint8_t reserved{ 0 };
+        std::uint32_t checksum{ 0 };          // 以上字段的 FNV-1a，检测写到一半的副本
+    };
+
+    static_assert(std::is_trivially_copyable_v<TimerSnapshot>, "TimerSnapshot is copied byte-for-byte");
+    static_assert(sizeof(TimerSnapshot) <= 64, "TimerSnapshot must stay within one cache line");
+
+    inline std::uint32_t computeTimerSnapshotChecksum(const TimerSnapshot& s) noexcept {
+        unsigned char bytes[sizeof(TimerSnapshot)];
+        std::memcpy(bytes, &s, sizeof(bytes));
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < offsetof(TimerSnapshot, checksum); ++i) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    inline void sealTimerSnapshot(TimerSnapshot& s) noexcept {
+        s.magic = TimerSnapshot::kMagic;
+        s.version = TimerSnapshot::kVersion;
+        s.size = static_cast<std::uint16_t>(sizeof(TimerSnapshot));
+        s.checksum = computeTimerSnapshotChecksum(s);
+    }
+
+    inline bool isValidTimerSnapshot(const TimerSnapshot& s) noexcept {
+        return s.magic == TimerSnapshot::kMagic && s.version == TimerSnapshot::kVersion &&
+            s.size == sizeof(TimerSnapshot) && s.checksum == computeTimerSnapshotChecksum(s);
+    }
+
+    // 快照使用的墙钟（Unix 毫秒）
+    inline std::int64_t currentUnixMillis() {
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+} // namespace pomodoro
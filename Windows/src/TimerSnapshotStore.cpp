@@ -0,0 +1,37 @@
+#include "TimerSnapshotStore.h"
+
+#include <cstring>
+
+namespace pomodoro {
+
+    bool TimerSnapshotStore::open(const std::filesystem::path& path) {
+        if (!file_.open(path, kFileSize)) return false;
+        const auto latest = load();
+        nextSequence_ = latest ? latest->sequence + 1 : 1;
+        return true;
+    }
+
+    std::optional<TimerSnapshot> TimerSnapshotStore::load() const {
+        if (!file_.isOpen()) return std::nullopt;
+
+        std::optional<TimerSnapshot> best;
+        for (std::size_t slot = 0; slot < kSlotCount; ++slot) {
+            TimerSnapshot s;
+            std::memcpy(&s, file_.data() + slot * kSlotSize, sizeof(s));
+            if (!isValidTimerSnapshot(s)) continue;
+            // 序号按无符号差比较，回绕后仍然正确
+            if (!best || static_cast<std::int32_t>(s.sequence - best->sequence) > 0) best = s;
+        }
+        return best;
+    }
+
+    void TimerSnapshotStore::save(const TimerSnapshot& snapshot) {
+        if (!file_.isOpen()) return;
+
+        TimerSnapshot s = snapshot;
+        s.sequence = nextSequence_++;
+        sealTimerSnapshot(s);
+        std::memcpy(file_.data() + (s.sequence % kSlotCount) * kSlotSize, &s, sizeof(s));
+    }
+
+} // namespace pomodoro
@@ -0,0 +1,38 @@
+#pragma once
+
+// Persists TimerSnapshot into a small memory-mapped file with two alternating slots.
+//
+// Each save() writes the next slot (sequence + 1) with a checksum; load() returns the newest slot
+// whose checksum is valid. A write torn by a crash therefore falls back to the previous snapshot
+// instead of a corrupt one.
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+#include "MappedFile.h"
+#include "TimerSnapshot.h"
+
+namespace pomodoro {
+
+    class TimerSnapshotStore {
+    public:
+        static constexpr std::size_t kSlotSize = 64;
+        static constexpr std::size_t kSlotCount = 2;
+        static constexpr std::size_t kFileSize = kSlotSize * kSlotCount;
+
+        bool open(const std::filesystem::path& path);
+        void close() { file_.close(); }
+        bool isOpen() const noexcept { return file_.isOpen(); }
+
+        std::optional<TimerSnapshot> load() const;
+
+        // 写入下一个槽位：只是一次 64 字节以内的内存拷贝，不触发系统调用
+        void save(const TimerSnapshot& snapshot);
+
+    private:
+        MappedFile file_;
+        std::uint32_t nextSequence_{ 1 };
+    };
+
+} // namespace pomodoro
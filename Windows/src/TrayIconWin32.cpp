@@ -1,4 +1,5 @@
 #include "TrayIconWin32.h"
+#include "TimeTextFormatter.h"
 
 #include <shellapi.h>
 
@@ -176,12 +177,11 @@ namespace pomodoro {
         Shell_NotifyIconW(NIM_ADD, &nid_);
     }
 
-    void TrayIconWin32::updateTime(const std::string& timeText, bool isRest, bool isForcedSleep, bool isRunning) {
-        // 记录时间字符串（转换为 UTF-16）
-        int len = static_cast<int>(timeText.size());
-        std::wstring wtime(len, L' ');
-        MultiByteToWideChar(CP_UTF8, 0, timeText.c_str(), len, &wtime[0], len);
-        lastTimeText_ = wtime;
+    void TrayIconWin32::updateTime(int remainingSeconds, bool isRest, bool isForcedSleep, bool isRunning) {
+        // 直接格式化为 UTF-16；"MM:SS" 在 wstring 的短字符串缓冲内，assign 不会分配
+        wchar_t timeText[kTimeTextCapacity];
+        const std::size_t length = formatTimeText(remainingSeconds, timeText);
+        lastTimeText_.assign(timeText, length);
 
         // 选择状态
         TrayIconState state = TrayIconState::Work;
@@ -197,7 +197,7 @@ namespace pomodoro {
         updateIcon(state, isRunning);
 
         // 同步弹窗内容（如果当前可见）
-        std::wstring status;
+        const wchar_t* status = L"";
         switch (state) {
         case TrayIconState::Work:
             status = isRunning ? L"\u4e13\u6ce8\u4e2d" : L"\u5df2\u6682\u505c"; // "专注中" / "已暂停"
@@ -20,8 +20,11 @@ namespace pomodoro {
         TrayIconWin32(HINSTANCE hInstance, HWND messageHwnd, PomodoroTimer& timer);
         ~TrayIconWin32();
 
-        // 更新时间与状态，由 PomodoroTimer 的回调驱动
-        void updateTime(const std::string& timeText, bool isRest, bool isForcedSleep, bool isRunning);
+        // 更新时间与状态，由 PomodoroTimer 的回调驱动（每秒调用，不做堆分配）
+        void updateTime(int remainingSeconds, bool isRest, bool isForcedSleep, bool isRunning);
+
+        // 当天实时评分（来自 HealthScoreTracker 的快照），转交弹窗
+        void updateScores(const HealthScores& scores) { popup_.updateScores(scores); }
 
         // 处理来自托盘的回调消息
         void handleTrayMessage(WPARAM wParam, LPARAM lParam);
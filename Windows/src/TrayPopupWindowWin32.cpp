@@ -189,14 +189,20 @@ namespace pomodoro {
         ShowWindow(hwnd_, SW_HIDE);
     }
 
-    void TrayPopupWindowWin32::updateContent(const std::wstring& statusText, const std::wstring& timeText) {
-        statusText_ = statusText;
-        timeText_ = timeText;
+    void TrayPopupWindowWin32::updateContent(std::wstring_view statusText, std::wstring_view timeText) {
+        // assign 复用已有容量：每秒刷新时不产生新的分配
+        statusText_.assign(statusText.data(), statusText.size());
+        timeText_.assign(timeText.data(), timeText.size());
         if (hwnd_ && IsWindowVisible(hwnd_)) {
             renderLayered();
         }
     }
 
+    void TrayPopupWindowWin32::updateScores(const HealthScores& scores) {
+        scores_ = scores;
+        hasScores_ = true;
+    }
+
     LRESULT CALLBACK TrayPopupWindowWin32::WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         TrayPopupWindowWin32* self = nullptr;
 
@@ -433,10 +439,33 @@ namespace pomodoro {
             g.DrawString(statusText_.c_str(), -1, &font, rc, &fmt, &white);
         }
 
+        // Score line (small, right above the buttons)
+        const int scoresH = hasScores_ ? S(18) : 0;
+        if (hasScores_) {
+            // 固定缓冲区格式化：每秒重绘不产生堆分配
+            wchar_t text[96];
+            swprintf_s(text, L"\u4e13\u6ce8 %.0f   \u4f11\u606f %.0f   \u5065\u5eb7 %.0f   \u5f3a\u5ea6 %.0f", // 专注 / 休息 / 健康 / 强度
+                scores_.focus, scores_.restAdequacy, scores_.health, scores_.workIntensity);
+
+            Gdiplus::FontFamily family(L"Segoe UI");
+            Gdiplus::Font font(&family, static_cast<Gdiplus::REAL>(S(11)), Gdiplus::FontStyleRegular, Gdiplus::UnitPixel);
+            Gdiplus::SolidBrush gray(Gdiplus::Color(255, 190, 190, 200));
+            Gdiplus::RectF rc(
+                0.0f,
+                static_cast<Gdiplus::REAL>(rcStart_.top - S(6) - scoresH),
+                static_cast<Gdiplus::REAL>(width),
+                static_cast<Gdiplus::REAL>(scoresH)
+            );
+            Gdiplus::StringFormat fmt;
+            fmt.SetAlignment(Gdiplus::StringAlignmentCenter);
+            fmt.SetLineAlignment(Gdiplus::StringAlignmentCenter);
+            g.DrawString(text, -1, &font, rc, &fmt, &gray);
+        }
+
         // Time text (bigger + vertically centered between status and bottom buttons)
         {
             const int top = statusBottom + S(10);
-            const int bottom = rcStart_.top - S(10);
+            const int bottom = rcStart_.top - S(10) - scoresH;
             const int availableH = (bottom > top) ? (bottom - top) : S(60);
 
             Gdiplus::FontFamily family(L"Segoe UI");
@@ -2,8 +2,11 @@
 
 #include <windows.h>
 #include <string>
+#include <string_view>
 #include <functional>
 
+#include "HealthScores.h"
+
 namespace pomodoro {
 
     // 状态弹窗窗口：显示当前状态 + 倒计时 + 基本控制按钮（启动 / 暂停 / 重置）
@@ -18,7 +21,10 @@ namespace pomodoro {
         void hide();
         bool isVisible() const { return hwnd_ != nullptr && IsWindowVisible(hwnd_) != FALSE; }
 
-        void updateContent(const std::wstring& statusText, const std::wstring& timeText);
+        void updateContent(std::wstring_view statusText, std::wstring_view timeText);
+
+        // 当天实时评分（只保存，随下一次 updateContent 一起重绘）
+        void updateScores(const HealthScores& scores);
 
         // 同步当前运行状态，用于更新“启动/暂停”按钮文本
         void setRunningState(bool running);
@@ -56,6 +62,8 @@ namespace pomodoro {
 
         std::wstring statusText_;
         std::wstring timeText_;
+        HealthScores scores_;
+        bool hasScores_{ false };
 
         // 当前是否处于运行状态（由外部计时器驱动同步）
         bool isRunning_{ false };
@@ -2,11 +2,22 @@
 #include <conio.h>
 #include <iostream>
 #include <chrono>
-#include <thread>
+#include <cstdlib>
+#include <filesystem>
 #include <objbase.h>
+#include <vector>
 
 
 #include "PomodoroTimer.h"
+#include "EventJournal.h"
+#include "StatisticsEngine.h"
+#include "HealthScores.h"
+#include "StatisticsEventStore.h"
+#include "StatisticsRollups.h"
+#include "StatisticsCompactor.h"
+#include "StatisticsExport.h"
+#include "SystemEventQueues.h"
+#include "TimerSnapshotStore.h"
 #include "MultiScreenOverlayManagerWin32.h"
 #include "BackgroundSettingsWin32.h"
 #include "SettingsWindowWin32.h"
@@ -45,6 +56,59 @@ namespace {
             }
         }
     }
+
+    // TimerEventBus 的订阅槽位是固定的（kMaxSubscribers），槽位已满时 subscribe 返回 0。
+    // 在这里立刻终止（发布版同样如此），免得新加的订阅者静默地永远收不到事件
+    void RequireSubscribed(pomodoro::TimerEventBus::SubscriptionId id, const char* subscriber) {
+        if (id != 0) return;
+        std::cerr << "[TimerEventBus] no free subscriber slot for " << subscriber
+                  << " (TimerEventBus::kMaxSubscribers exhausted)\n";
+        std::abort();
+    }
+
+    pomodoro::DstTransitionRule ToTransitionRule(const SYSTEMTIME& st) {
+        pomodoro::DstTransitionRule rule;
+        rule.month = st.wMonth;
+        rule.hour = st.wHour;
+        rule.minute = st.wMinute;
+        if (st.wYear != 0) {
+            // 绝对日期格式（少数时区的个别年份）
+            rule.week = 0;
+            rule.dayOfMonth = st.wDay;
+        } else {
+            rule.week = st.wDay;
+            rule.dayOfWeek = st.wDayOfWeek;
+        }
+        return rule;
+    }
+
+    // 当前时区逐年的夏令时规则（2000 年至明年），用于统计的本地日期/小时划分
+    pomodoro::LocalCalendar CurrentLocalCalendar() {
+        SYSTEMTIME now{};
+        GetLocalTime(&now);
+
+        std::vector<pomodoro::TimeZoneYearRules> years;
+        for (USHORT year = 2000; year <= now.wYear + 1; ++year) {
+            TIME_ZONE_INFORMATION tzi{};
+            if (!GetTimeZoneInformationForYear(year, nullptr, &tzi)) continue;
+            pomodoro::TimeZoneYearRules rules;
+            rules.year = year;
+            // UTC = 本地时间 + Bias
+            rules.standardOffsetMinutes = -static_cast<int>(tzi.Bias + tzi.StandardBias);
+            rules.daylightOffsetMinutes = -static_cast<int>(tzi.Bias + tzi.DaylightBias);
+            if (tzi.DaylightDate.wMonth != 0 && tzi.StandardDate.wMonth != 0) {
+                rules.daylightStart = ToTransitionRule(tzi.DaylightDate);
+                rules.standardStart = ToTransitionRule(tzi.StandardDate);
+            }
+            years.push_back(rules);
+        }
+        if (years.empty()) {
+            TIME_ZONE_INFORMATION tzi{};
+            GetTimeZoneInformation(&tzi);
+            return pomodoro::LocalCalendar(-static_cast<int>(tzi.Bias));
+        }
+        return pomodoro::LocalCalendar::fromYearRules(years);
+    }
 } // namespace
 
 // NOTE:
@@ -60,6 +124,20 @@ int main() {
     using pomodoro::BackgroundSettingsWin32;
     using pomodoro::SettingsWindowWin32;
     using pomodoro::TrayIconWin32;
+    using pomodoro::SystemEventQueues;
+    using pomodoro::TimerEvent;
+    using pomodoro::TimerSnapshotStore;
+    using pomodoro::EventJournal;
+    using pomodoro::StatisticsEngine;
+    using pomodoro::StatisticsEventStore;
+    using pomodoro::StatisticsRollups;
+    using pomodoro::StatisticsCompactor;
+    using pomodoro::HealthScoreTracker;
+    using pomodoro::kTimerEventTimeUpdated;
+    using pomodoro::kTimerEventPomodoroFinished;
+    using pomodoro::kTimerEventForcedSleepEnded;
+    using pomodoro::kTimerEventStateChanged;
+    using pomodoro::kTimerEventPhaseChanges;
 
     EnablePerMonitorDpiAwareness();
 
@@ -77,6 +155,8 @@ int main() {
     const std::wstring settingsPath = BackgroundSettingsWin32::DefaultConfigPath();
     backgroundSettings.loadFromFile(settingsPath);
     g_backgroundSettings = &backgroundSettings;
+    // 进入休息时直接使用这份内存中的设置，不再读盘；外部修改由下面主循环里的目录监视触发重新加载
+    overlayManager.setBackgroundSettings(&backgroundSettings);
 
     // 当用户点击“取消休息”按钮或按下 ESC 关闭遮罩时：
     // - 隐藏所有遮罩（由 MultiScreenOverlayManagerWin32 完成）
@@ -100,6 +180,77 @@ int main() {
     settings.autoStartNextPomodoroAfterRest = backgroundSettings.autoStartNextPomodoroAfterRest();
     timer.updateSettings(settings);
 
+    // 快照与事件日志是本进程频繁改写的映射文件，放在 state\ 子目录：配置目录的变化通知（见主循环）
+    // 不监视子目录，应用自己的写入不会唤醒主循环。旧版本放在配置目录下的文件搬过去一次
+    const auto stateDir = std::filesystem::path(settingsPath).replace_filename(L"state");
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(stateDir, ec);
+        const wchar_t* const stateFiles[] = { L"timer_state.bin", L"events.journal" };
+        for (const wchar_t* name : stateFiles) {
+            const auto legacy = std::filesystem::path(settingsPath).replace_filename(name);
+            if (std::filesystem::exists(legacy, ec) && !std::filesystem::exists(stateDir / name, ec)) {
+                std::filesystem::rename(legacy, stateDir / name, ec);
+            }
+        }
+    }
+
+    // 崩溃/更新/重启后恢复：在创建任何窗口之前直接还原阶段与截止时间，之后每次状态变化都写入映射文件
+    static TimerSnapshotStore snapshotStore;
+    if (snapshotStore.open(stateDir / L"timer_state.bin")) {
+        if (const auto saved = snapshotStore.load()) {
+            timer.restoreSnapshot(*saved, pomodoro::currentUnixMillis());
+        }
+        RequireSubscribed(timer.events.subscribe(kTimerEventStateChanged, [&timer](const TimerEvent&) {
+            snapshotStore.save(timer.captureSnapshot(pomodoro::currentUnixMillis()));
+        }), "timer snapshot");
+    }
+
+    // 状态机事件日志：恢复快照之后再挂上，每次会话的第一条记录从恢复后的状态开始
+    static EventJournal eventJournal;
+    if (eventJournal.open(stateDir / L"events.journal")) {
+        timer.setTransitionSink(&eventJournal);
+    }
+
+    // 日统计：阶段变化时增量更新当天汇总（番茄数、休息次数、取消休息、熬夜），原始事件写入按时间索引的事件存储。
+    // 启动时先恢复已压缩的日汇总，再用剩余的原始事件补齐。
+    static StatisticsEngine statistics;
+    statistics.setCalendar(CurrentLocalCalendar());
+    static StatisticsEventStore eventStore;
+    static StatisticsRollups rollups;
+    static HealthScoreTracker healthScores(settings.breakMinutes);
+    const auto statisticsDir = std::filesystem::path(settingsPath).replace_filename(L"statistics");
+    static StatisticsCompactor compactor(eventStore, rollups, statisticsDir / L"rollups.bin");
+    compactor.setCalendar(statistics.calendar());
+    // 压缩完成时唤醒主循环提交结果（未计时时主循环无限等待，不能指望别的消息顺路唤醒）
+    HANDLE compactionDone = CreateEventW(nullptr, FALSE, FALSE, nullptr); // 自动重置
+    if (compactionDone) {
+        compactor.setCompletionHandler([compactionDone]() { SetEvent(compactionDone); });
+    }
+    bool compactionEnabled = false;
+    if (eventStore.open(statisticsDir)) {
+        // 汇总文件损坏时不做压缩，避免覆盖它；原始事件照常重放
+        if (rollups.load(statisticsDir / L"rollups.bin")) {
+            compactionEnabled = true;
+            // 上次压缩在删除分段前中断：补删已并入汇总的分段，避免重复计数
+            eventStore.dropSegmentsBefore(rollups.firstRawSegment());
+            for (const auto& rollup : rollups.daily()) {
+                if (const auto* day = statistics.restoreDay(rollup)) healthScores.update(*day);
+            }
+        }
+        eventStore.visit(0, eventStore.size(), [](const pomodoro::StatisticsEvent* records, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (const auto* day = statistics.record(records[i])) healthScores.update(*day);
+            }
+        });
+    }
+    RequireSubscribed(timer.events.subscribe(kTimerEventPhaseChanges, [](const TimerEvent& e) {
+        if (const auto event = pomodoro::makeStatisticsEvent(e, pomodoro::currentUnixMillis())) {
+            if (const auto* day = statistics.record(*event)) healthScores.update(*day);
+            eventStore.append(*event);
+        }
+    }), "statistics");
+
     // 让 MainWndProc（托盘打开设置窗口的路径）也能同步更新 timer 的设置
     g_pomodoroTimer = &timer;
     g_pomodoroTimerSettings = &settings;
@@ -126,44 +277,92 @@ int main() {
         SetWindowLongPtrW(mainHwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(trayIcon));
     }
 
-    timer.onTimeUpdate = [trayIcon, &timer, &overlayManager, &backgroundSettings](const std::string& text) {
-        std::cout << "\rTime: " << text << "    " << std::flush;
-        if (trayIcon) {
-            bool isRest = timer.isInRestPeriod();
-            bool isForced = false; // TODO: 暂未暴露强制休眠状态，可在 AutoRestartStateMachine 上增加只读接口
-            bool isRunning = timer.isRunning();
-            trayIcon->updateTime(text, isRest, isForced, isRunning);
-        }
+    // 各组件分别订阅计时器事件；事件自带状态快照，订阅者不再回头查询 timer
+    RequireSubscribed(timer.events.subscribe(kTimerEventTimeUpdated, [](const TimerEvent& e) {
+        std::cout << "\rTime: " << e.timeText << "    " << std::flush;
+    }), "console time");
+
+    if (trayIcon) {
+        RequireSubscribed(timer.events.subscribe(kTimerEventTimeUpdated, [trayIcon, &settings](const TimerEvent& e) {
+            // 托盘直接按剩余秒数格式化为 UTF-16，省去 UTF-8 -> UTF-16 的转换
+            const auto& s = e.snapshot;
+            // 评分只在统计事件到达时重算，这里只读取缓存的快照；休息时长设置（托盘或控制台修改）未变时为空操作
+            healthScores.setBreakMinutes(settings.breakMinutes);
+            trayIcon->updateScores(healthScores.scoresFor(statistics.dayIndexFor(pomodoro::currentUnixMillis())));
+            trayIcon->updateTime(s.remainingSeconds, s.isInRestPeriod, s.isInForcedSleep, s.isRunning);
+        }), "tray icon");
+    }
 
-        // 休息结束后：根据设置决定是否自动隐藏遮罩层并进入下一轮番茄
+    // 番茄钟进入最后一分钟时：在后台线程上提前解码下一次休息的背景，遮罩出现时只需换上现成的位图。
+    // 每个番茄只在跨过 60 秒时触发一次（之后设置若有修改，进入休息时当场重新解码）。
+    // 休息结束后：根据设置决定是否自动隐藏遮罩层并进入下一轮番茄
+    bool nextBackgroundPrefetched = false;
+    RequireSubscribed(timer.events.subscribe(kTimerEventTimeUpdated, [&overlayManager, &backgroundSettings, &nextBackgroundPrefetched](const TimerEvent& e) {
+        const auto& s = e.snapshot;
+        if (s.timerType == pomodoro::TimerType::Pomodoro && s.isRunning && !s.isInRestPeriod &&
+            !s.isInForcedSleep && s.remainingSeconds <= 60) {
+            if (!nextBackgroundPrefetched) {
+                nextBackgroundPrefetched = true;
+                overlayManager.prefetchNextBackground();
+            }
+        } else {
+            nextBackgroundPrefetched = false;
+        }
         if (backgroundSettings.autoStartNextPomodoroAfterRest()) {
-            if (!timer.isInRestPeriod() && !timer.isRestTimerRunning()) {
+            if (!e.snapshot.isInRestPeriod && !e.snapshot.isRestTimerRunning) {
                 if (overlayManager.hasOverlays()) {
                     overlayManager.hideAllOverlays();
                 }
             }
         }
-    };
+    }), "background prefetch / auto hide");
 
     // 工作阶段结束 -> 进入休息期时，在所有屏幕上展示遮罩层
-    timer.onTimerFinished = [&overlayManager]() {
+    RequireSubscribed(timer.events.subscribe(kTimerEventPomodoroFinished, [&overlayManager](const TimerEvent&) {
         std::cout << "\n[Pomodoro Finished] -> Enter rest period, show overlay on all screens\n";
         overlayManager.showOverlaysOnAllScreens();
-    };
+    }), "rest overlay");
 
     // 熬夜强制睡眠结束时，隐藏遮罩
-    timer.onForcedSleepEndedCallback = [&overlayManager]() {
+    RequireSubscribed(timer.events.subscribe(kTimerEventForcedSleepEnded, [&overlayManager](const TimerEvent&) {
         std::cout << "\n[Forced Sleep Ended] -> Hide stay-up overlay\n";
         overlayManager.hideAllOverlays();
-    };
+    }), "forced sleep overlay");
+
+    // 从快照恢复到休息阶段时，遮罩需要重新展示（恢复不重放 onTimerFinished）
+    if (timer.isInRestPeriod()) {
+        overlayManager.showOverlaysOnAllScreens();
+    }
 
     std::cout << "PomodoroScreen Windows (console + overlay + tray icon)\n";
-    std::cout << "Commands: s=start, p=pause, r=resume, c=config, q=quit\n";
+    std::cout << "Commands: s=start, p=pause, r=resume, c=config, e=export statistics, q=quit\n";
 
     bool running = true;
+    std::int64_t nextCompactionCheckMs = 0;
+
+    // 系统事件队列：主循环每次醒来时按时间戳合并后交给 timer。目前还没有生产者；无操作/锁屏/屏保检测
+    // 接入后各自在独立线程上 post。投递会置位 systemEventsReady，未计时（无限等待）时也能及时处理
+    static SystemEventQueues systemEvents;
+    HANDLE systemEventsReady = CreateEventW(nullptr, FALSE, FALSE, nullptr); // 自动重置
+    if (systemEventsReady) {
+        systemEvents.setWakeHandler([systemEventsReady]() { SetEvent(systemEventsReady); });
+    }
 
-    // 记录上一秒 tick 的时间，用于每秒调用一次 timer.tickOneSecond()
-    auto lastTick = steady_clock::now();
+    // 控制台输入句柄：主循环阻塞等待时也要能被按键唤醒（输入被重定向时不可等待，退化为纯超时）
+    HANDLE consoleIn = GetStdHandle(STD_INPUT_HANDLE);
+    DWORD consoleMode = 0;
+    const bool canWaitConsole = consoleIn != nullptr && consoleIn != INVALID_HANDLE_VALUE &&
+        GetConsoleMode(consoleIn, &consoleMode) != FALSE;
+
+    // 配置目录变化通知：有写入时才比较 backgrounds.json 的大小与修改时间，确实变化才重新解析。
+    // 只监视目录本身（不含子目录）：快照、事件日志与统计数据都在子目录中，它们的写入不会触发通知。
+    // 无法监视时（例如网络路径）退化为每次醒来比较一次元数据
+    std::filesystem::path settingsDir = std::filesystem::path(settingsPath).parent_path();
+    if (settingsDir.empty()) settingsDir = L".";
+    HANDLE settingsChange = FindFirstChangeNotificationW(settingsDir.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    if (settingsChange == INVALID_HANDLE_VALUE) settingsChange = nullptr;
+    bool settingsCheckPending = false;
 
     while (running) {
         // 处理 Win32 消息，使遮罩窗口能够正常绘制和响应输入
@@ -192,6 +391,22 @@ int main() {
                 timer.pause();
             } else if (ch == 'r' || ch == 'R') {
                 timer.resume();
+            } else if (ch == 'e' || ch == 'E') {
+                // 导出统计数据：事件 / 小时 / 日汇总各一个 CSV，分块流式写出，内存占用与历史长度无关
+                std::error_code ec;
+                const auto exportDir = statisticsDir.parent_path() / L"export";
+                std::filesystem::create_directories(exportDir, ec);
+                const struct { pomodoro::ExportTable table; const char* file; } tables[] = {
+                    { pomodoro::ExportTable::Events, "events.csv" },
+                    { pomodoro::ExportTable::Hourly, "hourly.csv" },
+                    { pomodoro::ExportTable::Daily, "daily.csv" },
+                };
+                for (const auto& t : tables) {
+                    pomodoro::ExportOptions options;
+                    options.table = t.table;
+                    const auto result = pomodoro::exportStatisticsToFile(exportDir / t.file, statistics, eventStore, rollups, options);
+                    std::cout << "\n[Export] " << t.file << (result.ok ? ": " : ": failed, ") << result.rows << " rows\n";
+                }
             } else if (ch == 'c' || ch == 'C') {
                 if (!g_settingsWindow) {
                     g_settingsWindow = new SettingsWindowWin32(hInstance, backgroundSettings);
@@ -212,20 +427,87 @@ int main() {
             }
         }
 
-        // 每 1 秒调用一次 tickOneSecond，驱动番茄计时逻辑
-        auto now = steady_clock::now();
-        if (duration_cast<seconds>(now - lastTick).count() >= 1) {
-            timer.tickOneSecond();
-            lastTick = now;
+        // 先消化检测线程投递的系统事件，再驱动番茄计时逻辑（timer 基于绝对截止时间，提前/重复调用都是安全的）
+        // 设置窗口打开期间由它编辑并写回文件，外部修改等窗口关闭后再合并
+        if ((settingsCheckPending || !settingsChange) && !(g_settingsWindow && g_settingsWindow->isOpen())) {
+            settingsCheckPending = false;
+            if (backgroundSettings.reloadIfChanged(settingsPath)) {
+                std::cout << "\n[Settings] backgrounds.json changed, reloaded\n";
+                if (settings.pomodoroMinutes != backgroundSettings.pomodoroMinutes() ||
+                    settings.breakMinutes != backgroundSettings.breakMinutes() ||
+                    settings.autoStartNextPomodoroAfterRest != backgroundSettings.autoStartNextPomodoroAfterRest()) {
+                    settings.pomodoroMinutes = backgroundSettings.pomodoroMinutes();
+                    settings.breakMinutes = backgroundSettings.breakMinutes();
+                    settings.autoStartNextPomodoroAfterRest = backgroundSettings.autoStartNextPomodoroAfterRest();
+                    timer.updateSettings(settings);
+                }
+            }
         }
 
-        // 避免空转占用 100% CPU
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        systemEvents.drainTo(timer);
+        timer.tick();
+        eventJournal.commitIfDue(timer.now());
+
+        // 旧事件压缩：后台低优先级线程完成后置位 compactionDone，在这里提交（替换汇总、删除分段）。
+        // 每小时检查一次是否有可压缩的分段；空闲时推迟到下一次醒来（空闲期间没有新事件写入，推迟无害）
+        if (compactionEnabled) {
+            compactor.poll();
+            const std::int64_t nowMs = pomodoro::currentUnixMillis();
+            if (nowMs >= nextCompactionCheckMs) {
+                compactor.start(nowMs);
+                nextCompactionCheckMs = nowMs + 60LL * 60 * 1000;
+            }
+        }
+
+        // 一直睡到下一次可见变化（显示秒数变化或阶段结束），期间被窗口消息或控制台按键唤醒。
+        // 空闲（未计时）时不设超时，没有任何周期性唤醒。
+        DWORD timeoutMs = INFINITE;
+        const auto wakeAt = timer.nextWakeup();
+        if (wakeAt != (PomodoroTimer::Clock::time_point::max)()) { // 括号避免 windows.h 的 max 宏
+            const auto wait = wakeAt - timer.now();
+            // 向上取整，避免在边界前几微秒醒来后立刻再次 0ms 等待
+            const auto waitMs = std::chrono::ceil<milliseconds>(wait).count();
+            timeoutMs = waitMs > 0 ? static_cast<DWORD>(waitMs) : 0;
+        }
+
+        // 系统事件与压缩完成句柄被置位后无需额外处理：下一轮循环会 drain / poll。
+        // 控制台句柄必须排在这两者之后、配置目录通知之前（下面按下标判断）
+        HANDLE waitHandles[4];
+        DWORD waitCount = 0;
+        if (systemEventsReady) waitHandles[waitCount++] = systemEventsReady;
+        if (compactionDone) waitHandles[waitCount++] = compactionDone;
+        if (canWaitConsole) waitHandles[waitCount++] = consoleIn;
+        if (settingsChange) waitHandles[waitCount++] = settingsChange;
+        const DWORD waitResult = MsgWaitForMultipleObjectsEx(
+            waitCount,
+            waitCount ? waitHandles : nullptr,
+            timeoutMs,
+            QS_ALLINPUT,
+            MWMO_INPUTAVAILABLE);
+        const DWORD consoleIndex = (systemEventsReady ? 1 : 0) + (compactionDone ? 1 : 0);
+        if (canWaitConsole && waitResult == WAIT_OBJECT_0 + consoleIndex && !_kbhit()) {
+            // 仅有鼠标/焦点等非按键控制台事件：丢弃它们，否则句柄保持有信号导致空转
+            FlushConsoleInputBuffer(consoleIn);
+        }
+        if (settingsChange && waitResult == WAIT_OBJECT_0 + waitCount - 1) {
+            // 重新挂起通知后再检查，检查期间的新写入会再次触发
+            FindNextChangeNotification(settingsChange);
+            settingsCheckPending = true;
+        }
     }
 
-    // 退出前确保遮罩隐藏并持久化背景设置
+    // 退出前确保遮罩隐藏；设置的修改都经由后台写入器，这里只写出尚未落盘的那份（没有就不写）
+    if (settingsChange) FindCloseChangeNotification(settingsChange);
+    systemEvents.setWakeHandler(nullptr);
+    if (systemEventsReady) CloseHandle(systemEventsReady);
     overlayManager.hideAllOverlays();
-    backgroundSettings.saveToFile(settingsPath);
+    backgroundSettings.flushPendingSave();
+    timer.setTransitionSink(nullptr);
+    eventJournal.close();
+    compactor.finish();
+    compactor.setCompletionHandler(nullptr);
+    if (compactionDone) CloseHandle(compactionDone);
+    eventStore.close();
 
     delete trayIcon;
     DestroyWindow(mainHwnd);
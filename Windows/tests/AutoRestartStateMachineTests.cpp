@@ -0,0 +1,265 @@
+#include "TestHarness.h"
+#include "LegacyAutoRestartEngine.h"
+
+#include "AutoRestartStateMachine.h"
+#include "AutoRestartTransitionTable.h"
+#include "MonotonicClock.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    AutoRestartSettings settingsFromKey(std::uint32_t key) {
+        AutoRestartSettings s;
+        s.idleEnabled = (key & kKeyIdleEnabled) != 0;
+        s.idleActionIsRestart = (key & kKeyIdleActionIsRestart) != 0;
+        s.screenLockEnabled = (key & kKeyScreenLockEnabled) != 0;
+        s.screenLockActionIsRestart = (key & kKeyScreenLockActionIsRestart) != 0;
+        s.screensaverEnabled = (key & kKeyScreensaverEnabled) != 0;
+        s.screensaverActionIsRestart = (key & kKeyScreensaverActionIsRestart) != 0;
+        s.stayUpLimitEnabled = (key & kKeyStayUpLimitEnabled) != 0;
+        return s;
+    }
+
+    AutoRestartSettings allEnabledPauseMode() {
+        // 与 Swift AutoRestartStateMachineTests.setUp 一致：全部启用，均为“暂停计时”模式
+        AutoRestartSettings s;
+        s.idleEnabled = true;
+        s.idleActionIsRestart = false;
+        s.screenLockEnabled = true;
+        s.screenLockActionIsRestart = false;
+        s.screensaverEnabled = true;
+        s.screensaverActionIsRestart = false;
+        return s;
+    }
+
+    // 逐个处理事件的参考实现：批内 ScreensaverStopped 先记录屏保恢复时间（与 PomodoroTimer 一致），
+    // 再把紧邻且回到原状态的 PauseTimer/ResumeTimer 抵消掉，得到批量接口应返回的动作序列。
+    std::vector<AutoRestartAction> processOneByOne(AutoRestartStateMachine& machine,
+        const std::vector<AutoRestartEvent>& events) {
+        std::vector<AutoRestartAction> actions;
+        bool lastWasPause = false;
+        AutoRestartState stateBeforePause = AutoRestartState::Idle;
+        for (const auto event : events) {
+            if (event == AutoRestartEvent::ScreensaverStopped) machine.markScreensaverResumedNow();
+            const auto before = machine.getCurrentState();
+            const auto action = machine.processEvent(event);
+            const auto after = machine.getCurrentState();
+            if (action == AutoRestartAction::None && after == before) continue;
+
+            if (action == AutoRestartAction::ResumeTimer && lastWasPause && after == stateBeforePause) {
+                actions.pop_back();
+                lastWasPause = false;
+                continue;
+            }
+            lastWasPause = (action == AutoRestartAction::PauseTimer);
+            stateBeforePause = before;
+            if (action != AutoRestartAction::None) actions.push_back(action);
+        }
+        return actions;
+    }
+
+    // 钩子风格的事件流：同一事件常常成串出现（例如鼠标移动）
+    std::vector<AutoRestartEvent> stormStream(std::mt19937& rng, std::size_t length) {
+        std::uniform_int_distribution<int> eventDist(0, static_cast<int>(kAutoRestartEventCount) - 1);
+        std::uniform_int_distribution<int> runDist(1, 8);
+        std::vector<AutoRestartEvent> events;
+        while (events.size() < length) {
+            const auto event = static_cast<AutoRestartEvent>(eventDist(rng));
+            for (int n = runDist(rng); n > 0 && events.size() < length; --n) events.push_back(event);
+        }
+        return events;
+    }
+
+} // namespace
+
+// MARK: - 转换表与旧引擎逐项对比
+
+TEST_CASE(testTableMatchesLegacyEngineExhaustively) {
+    int mismatches = 0;
+    for (std::uint32_t key = 0; key < kAutoRestartKeyCount; ++key) {
+        legacy::LegacyContext ctx;
+        ctx.settings = settingsFromKey(key);
+        ctx.isStayUpTime = (key & kKeyStayUpTime) != 0;
+        CHECK_EQ(makeAutoRestartKey(ctx.settings, ctx.isStayUpTime), key);
+
+        for (int recent = 0; recent < 2; ++recent) {
+            ctx.recentlyResumedByScreensaver = recent != 0;
+            for (std::size_t s = 0; s < kAutoRestartStateCount; ++s) {
+                for (std::size_t e = 0; e < kAutoRestartEventCount; ++e) {
+                    auto legacyState = static_cast<AutoRestartState>(s);
+                    const auto event = static_cast<AutoRestartEvent>(e);
+                    const auto legacyAction = legacy::processEvent(ctx, legacyState, event);
+                    const auto& t = kAutoRestartTransitionTables[key][recent][s][e];
+                    if (t.newState != legacyState || t.action != legacyAction) {
+                        ++mismatches;
+                    }
+                }
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST_CASE(testMachineMatchesLegacyOnRandomStreams) {
+    std::mt19937 rng(20240601u);
+    std::uniform_int_distribution<int> eventDist(0, static_cast<int>(kAutoRestartEventCount) - 1);
+
+    for (std::uint32_t key = 0; key < kAutoRestartKeyCount; ++key) {
+        legacy::LegacyContext ctx;
+        ctx.settings = settingsFromKey(key);
+        ctx.isStayUpTime = (key & kKeyStayUpTime) != 0;
+
+        AutoRestartStateMachine machine(ctx.settings);
+        machine.setStayUpTime(ctx.isStayUpTime);
+        AutoRestartState legacyState = AutoRestartState::Idle;
+
+        for (int i = 0; i < 500; ++i) {
+            const auto event = static_cast<AutoRestartEvent>(eventDist(rng));
+            const auto expected = legacy::processEvent(ctx, legacyState, event);
+            CHECK_EQ(machine.processEvent(event), expected);
+            CHECK_EQ(machine.getCurrentState(), legacyState);
+        }
+    }
+}
+
+// MARK: - 基础状态转换
+
+TEST_CASE(testTimerLifecycle) {
+    AutoRestartStateMachine machine(allEnabledPauseMode());
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::Idle);
+
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::TimerStarted), AutoRestartAction::None);
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::TimerRunning);
+
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::TimerStopped), AutoRestartAction::None);
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::Idle);
+}
+
+TEST_CASE(testUpdateSettingsSwitchesTable) {
+    AutoRestartSettings s = allEnabledPauseMode();
+    s.idleEnabled = false;
+    AutoRestartStateMachine machine(s);
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::IdleTimeExceeded), AutoRestartAction::None);
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::TimerRunning);
+
+    s.idleEnabled = true;
+    machine.updateSettings(s);
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::IdleTimeExceeded), AutoRestartAction::PauseTimer);
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::TimerPausedByIdle);
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::UserActivityDetected), AutoRestartAction::ResumeTimer);
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::TimerRunning);
+}
+
+TEST_CASE(testStayUpTimeBlocksUnlockExit) {
+    AutoRestartSettings s = allEnabledPauseMode();
+    s.stayUpLimitEnabled = true;
+    AutoRestartStateMachine machine(s);
+
+    machine.setStayUpTime(true);
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::ForcedSleepTriggered), AutoRestartAction::EnterForcedSleep);
+    CHECK(machine.isInForcedSleep());
+
+    // 熬夜时间内解锁不能退出强制睡眠
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::ScreenUnlocked), AutoRestartAction::None);
+    CHECK(machine.isInForcedSleep());
+
+    machine.setStayUpTime(false);
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::ScreenUnlocked), AutoRestartAction::ExitForcedSleep);
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::Idle);
+}
+
+TEST_CASE(testUnlockRightAfterScreensaverIsIgnored) {
+    AutoRestartStateMachine machine(allEnabledPauseMode());
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::ScreenLocked), AutoRestartAction::PauseTimer);
+
+    // 屏保刚刚恢复时的解锁事件不应重复触发动作，但状态仍切回运行
+    machine.markScreensaverResumedNow();
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::ScreenUnlocked), AutoRestartAction::None);
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::TimerRunning);
+}
+
+TEST_CASE(testScreensaverGraceWindowEndsAfterOneSecond) {
+    VirtualClock clock;
+    AutoRestartStateMachine machine(allEnabledPauseMode(), clock);
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+
+    // 999 ms：仍在 1 秒窗口内，解锁被忽略
+    machine.processEvent(AutoRestartEvent::ScreenLocked);
+    machine.markScreensaverResumedNow();
+    clock.advance(std::chrono::milliseconds(999));
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::ScreenUnlocked), AutoRestartAction::None);
+
+    // 1000 ms：窗口已过，解锁按正常规则恢复计时
+    machine.processEvent(AutoRestartEvent::ScreenLocked);
+    machine.markScreensaverResumedNow();
+    clock.advance(std::chrono::milliseconds(1000));
+    CHECK_EQ(machine.processEvent(AutoRestartEvent::ScreenUnlocked), AutoRestartAction::ResumeTimer);
+}
+
+// MARK: - 批量处理
+
+TEST_CASE(testBatchMatchesOneByOneOnStormStreams) {
+    std::mt19937 rng(7u);
+    for (std::uint32_t key = 0; key < kAutoRestartKeyCount; ++key) {
+        const auto settings = settingsFromKey(key);
+        const bool stayUp = (key & kKeyStayUpTime) != 0;
+
+        VirtualClock clock;
+        AutoRestartStateMachine single(settings, clock);
+        AutoRestartStateMachine batched(settings, clock);
+        single.setStayUpTime(stayUp);
+        batched.setStayUpTime(stayUp);
+
+        std::vector<AutoRestartAction> actions;
+        for (int batch = 0; batch < 20; ++batch) {
+            const auto events = stormStream(rng, 64);
+            const auto expected = processOneByOne(single, events);
+            actions.clear();
+            batched.processEvents(events.data(), events.size(), actions);
+
+            CHECK(actions == expected);
+            CHECK_EQ(batched.getCurrentState(), single.getCurrentState());
+
+            // 批次之间时间前进，让“屏保刚恢复”窗口有时仍有效、有时已过期
+            clock.advance(std::chrono::milliseconds(batch % 2 == 0 ? 400 : 1500));
+        }
+    }
+}
+
+TEST_CASE(testActivityStormProducesSingleAction) {
+    AutoRestartStateMachine machine(allEnabledPauseMode());
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+    machine.processEvent(AutoRestartEvent::IdleTimeExceeded);
+
+    std::vector<AutoRestartEvent> events(1000, AutoRestartEvent::UserActivityDetected);
+    std::vector<AutoRestartAction> actions;
+    machine.processEvents(events.data(), events.size(), actions);
+
+    CHECK_EQ(actions.size(), 1u);
+    CHECK(!actions.empty() && actions.front() == AutoRestartAction::ResumeTimer);
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::TimerRunning);
+}
+
+TEST_CASE(testLockUnlockPairsCancelOut) {
+    AutoRestartStateMachine machine(allEnabledPauseMode());
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+
+    std::vector<AutoRestartEvent> events;
+    for (int i = 0; i < 50; ++i) {
+        events.push_back(AutoRestartEvent::ScreenLocked);
+        events.push_back(AutoRestartEvent::ScreenUnlocked);
+    }
+    std::vector<AutoRestartAction> actions;
+    machine.processEvents(events.data(), events.size(), actions);
+
+    CHECK(actions.empty());
+    CHECK_EQ(machine.getCurrentState(), AutoRestartState::TimerRunning);
+}
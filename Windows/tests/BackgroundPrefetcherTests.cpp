@@ -0,0 +1,215 @@
+#include "TestHarness.h"
+
+#include "BackgroundPrefetcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace pomodoro;
+using namespace std::chrono_literals;
+
+namespace {
+
+    using Prefetcher = BackgroundPrefetcher<std::wstring>;
+
+    BackgroundEntry image(const wchar_t* path) { return BackgroundEntry{ path, false, 1.0 }; }
+    BackgroundEntry video(const wchar_t* path, double rate = 1.0) { return BackgroundEntry{ path, true, rate }; }
+
+    // 路径以 "bad" 开头的条目解码失败；解码结果为路径本身
+    bool decodePath(const BackgroundEntry& entry, std::wstring& out) {
+        if (entry.path.rfind(L"bad", 0) == 0) return false;
+        out = entry.path;
+        return true;
+    }
+
+    // 解码器在 open() 之前阻塞，用来观察“正在解码”时的行为
+    class Gate {
+    public:
+        void open() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                open_ = true;
+            }
+            cv_.notify_all();
+        }
+        void pass() {
+            ++waiting_;
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return open_; });
+        }
+        bool waitForArrivals(int count) const {
+            const auto deadline = std::chrono::steady_clock::now() + 5s;
+            while (waiting_.load() < count) {
+                if (std::chrono::steady_clock::now() > deadline) return false;
+                std::this_thread::sleep_for(1ms);
+            }
+            return true;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool open_{ false };
+        std::atomic<int> waiting_{ 0 };
+    };
+
+    bool waitReady(const Prefetcher& prefetcher, const std::vector<BackgroundEntry>& entries, std::size_t cursor) {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!prefetcher.ready(entries, cursor)) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+} // namespace
+
+// MARK: - 轮换规则
+
+TEST_CASE(testRotationSkipsEmptyAndUndecodableEntries) {
+    Prefetcher prefetcher(decodePath);
+    const std::vector<BackgroundEntry> entries = { image(L"a.jpg"), image(L""), image(L"bad.png"), video(L"c.mp4", 1.5) };
+
+    auto first = prefetcher.take(entries, 0);
+    CHECK(first.has_value());
+    CHECK_EQ(first->index, std::size_t(0));
+    CHECK_EQ(first->nextCursor, std::size_t(1));
+    CHECK(first->decoded == L"a.jpg");
+
+    auto second = prefetcher.take(entries, first->nextCursor);
+    CHECK(second.has_value());
+    CHECK_EQ(second->index, std::size_t(3));
+    CHECK_EQ(second->nextCursor, std::size_t(0)); // 回到开头
+    CHECK(second->entry.video);
+    CHECK(second->entry.playbackRate == 1.5);
+    CHECK_EQ(prefetcher.decodeCount(), std::size_t(3)); // 空路径不调用解码器
+
+    // 游标越界（列表变短）时从头开始
+    auto wrapped = prefetcher.take(entries, 10);
+    CHECK(wrapped && wrapped->index == 0);
+}
+
+TEST_CASE(testNoUsableEntry) {
+    Prefetcher prefetcher(decodePath);
+    CHECK(!prefetcher.take({}, 0).has_value());
+    CHECK(!prefetcher.take({ image(L""), image(L"bad1.jpg"), image(L"bad2.jpg") }, 1).has_value());
+    CHECK_EQ(prefetcher.decodeCount(), std::size_t(2));
+}
+
+// MARK: - 预取
+
+TEST_CASE(testPrefetchedResultIsTakenWithoutDecoding) {
+    Prefetcher prefetcher(decodePath);
+    const std::vector<BackgroundEntry> entries = { image(L"a.jpg"), image(L"b.jpg") };
+
+    prefetcher.prefetch(entries, 1);
+    CHECK(waitReady(prefetcher, entries, 1));
+    prefetcher.prefetch(entries, 1); // 重复请求（最后一分钟每秒都会调用）不会重新解码
+    CHECK_EQ(prefetcher.decodeCount(), std::size_t(1));
+
+    auto prepared = prefetcher.take(entries, 1);
+    CHECK(prepared && prepared->decoded == L"b.jpg");
+    CHECK_EQ(prefetcher.decodeCount(), std::size_t(1));
+    CHECK(!prefetcher.ready(entries, 1)); // 取走后清空
+}
+
+TEST_CASE(testStalePrefetchIsIgnored) {
+    Prefetcher prefetcher(decodePath);
+    const std::vector<BackgroundEntry> before = { image(L"a.jpg"), image(L"b.jpg") };
+    prefetcher.prefetch(before, 0);
+    CHECK(waitReady(prefetcher, before, 0));
+
+    // 预取之后设置被修改：按新列表重新选择
+    const std::vector<BackgroundEntry> after = { image(L"c.jpg"), image(L"b.jpg") };
+    auto prepared = prefetcher.take(after, 0);
+    CHECK(prepared && prepared->decoded == L"c.jpg");
+    CHECK_EQ(prefetcher.decodeCount(), std::size_t(2));
+
+    // 游标不同同样视为过期
+    prefetcher.prefetch(after, 0);
+    CHECK(waitReady(prefetcher, after, 0));
+    prepared = prefetcher.take(after, 1);
+    CHECK(prepared && prepared->decoded == L"b.jpg");
+}
+
+TEST_CASE(testTakeWaitsForDecodeInProgress) {
+    Gate gate;
+    Prefetcher prefetcher([&gate](const BackgroundEntry& entry, std::wstring& out) {
+        gate.pass();
+        return decodePath(entry, out);
+    });
+    const std::vector<BackgroundEntry> entries = { video(L"v.mp4") };
+    prefetcher.prefetch(entries, 0);
+    CHECK(gate.waitForArrivals(1));
+
+    std::thread release([&gate] {
+        std::this_thread::sleep_for(20ms);
+        gate.open();
+    });
+    auto prepared = prefetcher.take(entries, 0);
+    release.join();
+    CHECK(prepared && prepared->decoded == L"v.mp4");
+    CHECK_EQ(prefetcher.decodeCount(), std::size_t(1)); // 没有重新开始
+}
+
+TEST_CASE(testNewerRequestAbandonsStaleRotation) {
+    Gate gate;
+    Prefetcher prefetcher([&gate](const BackgroundEntry& entry, std::wstring& out) {
+        if (entry.path == L"bad-slow.jpg") gate.pass();
+        return decodePath(entry, out);
+    });
+
+    // 旧请求卡在第一个（失败的）候选上，后面还有三个候选
+    const std::vector<BackgroundEntry> stale = { image(L"bad-slow.jpg"), image(L"bad1.jpg"), image(L"bad2.jpg"), image(L"x.jpg") };
+    prefetcher.prefetch(stale, 0);
+    CHECK(gate.waitForArrivals(1));
+
+    const std::vector<BackgroundEntry> fresh = { image(L"y.jpg") };
+    prefetcher.prefetch(fresh, 0);
+    gate.open();
+
+    auto prepared = prefetcher.take(fresh, 0);
+    CHECK(prepared && prepared->decoded == L"y.jpg");
+    CHECK_EQ(prefetcher.decodeCount(), std::size_t(2)); // 旧请求在第一个候选之后放弃
+    CHECK(!prefetcher.ready(stale, 0));
+}
+
+TEST_CASE(testTakeRequeuesRequestAboutToBeAbandoned) {
+    Gate gate;
+    Prefetcher prefetcher([&gate](const BackgroundEntry& entry, std::wstring& out) {
+        if (entry.path == L"bad-slow.jpg") gate.pass();
+        return decodePath(entry, out);
+    });
+
+    // 正在处理 A 时排队了 B；随后 take(A) 必须拿到 A 的结果而不是永远等待
+    const std::vector<BackgroundEntry> a = { image(L"bad-slow.jpg"), image(L"a.jpg") };
+    const std::vector<BackgroundEntry> b = { image(L"b.jpg") };
+    prefetcher.prefetch(a, 0);
+    CHECK(gate.waitForArrivals(1));
+    prefetcher.prefetch(b, 0);
+
+    std::thread release([&gate] {
+        std::this_thread::sleep_for(20ms);
+        gate.open();
+    });
+    auto prepared = prefetcher.take(a, 0);
+    release.join();
+    CHECK(prepared && prepared->decoded == L"a.jpg");
+}
+
+TEST_CASE(testDestructorWithDecodeInFlight) {
+    Gate gate;
+    {
+        Prefetcher prefetcher([&gate](const BackgroundEntry& entry, std::wstring& out) {
+            gate.pass();
+            return decodePath(entry, out);
+        });
+        prefetcher.prefetch({ image(L"a.jpg"), image(L"b.jpg") }, 0);
+        CHECK(gate.waitForArrivals(1));
+        gate.open();
+    }
+    CHECK(true);
+}
@@ -0,0 +1,228 @@
+#include "TestHarness.h"
+
+#include "BackgroundsJson.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    struct Entry {
+        std::wstring path;
+        std::wstring type;
+        std::wstring name;
+        bool hasName{ false };
+        double rate{ 1.0 };
+    };
+
+    bool parse(std::wstring_view json, BackgroundsJsonSettings& settings, std::vector<Entry>& entries) {
+        entries.clear();
+        return parseBackgroundsJson(json, settings, [&entries](const BackgroundJsonEntry& e) {
+            entries.push_back(Entry{ std::wstring(e.path), std::wstring(e.type), std::wstring(e.name), e.hasName, e.playbackRate });
+        });
+    }
+
+    // 与 BackgroundSettingsWin32::saveToFile 相同的布局
+    std::wstring serialize(const std::vector<Entry>& entries, const std::wstring& message) {
+        std::wstring out = L"{\n  \"backgrounds\": [\n";
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            out += L"    { \"path\": \"";
+            appendJsonEscaped(out, entries[i].path);
+            out += L"\", \"type\": \"" + entries[i].type + L"\", \"name\": \"";
+            appendJsonEscaped(out, entries[i].name);
+            out += L"\", \"playbackRate\": " + std::to_wstring(entries[i].rate) + L" }";
+            out += i + 1 < entries.size() ? L",\n" : L"\n";
+        }
+        out += L"  ],\n  \"pomodoroMinutes\": 25,\n  \"breakMinutes\": 5,\n  \"autoStartNextPomodoroAfterRest\": false,\n";
+        out += L"  \"overlayMessage\": \"";
+        appendJsonEscaped(out, message);
+        out += L"\"\n}\n";
+        return out;
+    }
+
+    std::wstring randomText(std::mt19937& rng, std::size_t maxLength) {
+        // 偏向结构字符、转义字符与非 ASCII
+        static const wchar_t kAlphabet[] = L"ab/\\\"{}[]:,. \t\n\x01\x1f\u4e2d\u6587\u00e9";
+        std::uniform_int_distribution<std::size_t> length(0, maxLength);
+        std::uniform_int_distribution<std::size_t> pick(0, sizeof(kAlphabet) / sizeof(wchar_t) - 2);
+        std::wstring s(length(rng), L' ');
+        for (auto& c : s) c = kAlphabet[pick(rng)];
+        return s;
+    }
+
+} // namespace
+
+// MARK: - 解析
+
+TEST_CASE(testParsesSavedLayout) {
+    const std::wstring json =
+        L"{\n  \"backgrounds\": [\n"
+        L"    { \"path\": \"C:\\\\Pictures\\\\a.jpg\", \"type\": \"image\", \"name\": \"a.jpg\", \"playbackRate\": 1 },\n"
+        L"    { \"path\": \"D:\\\\Videos\\\\b.mp4\", \"type\": \"video\", \"playbackRate\": 1.5 }\n"
+        L"  ],\n  \"pomodoroMinutes\": 30,\n  \"breakMinutes\": 5,\n"
+        L"  \"autoStartNextPomodoroAfterRest\": false,\n  \"overlayMessage\": \"\\u4f11\\u606f\"\n}\n";
+
+    BackgroundsJsonSettings settings;
+    std::vector<Entry> entries;
+    CHECK(parse(json, settings, entries));
+    CHECK(settings.hasBackgrounds);
+    CHECK_EQ(entries.size(), std::size_t(2));
+    CHECK(entries[0].path == L"C:\\Pictures\\a.jpg");
+    CHECK(entries[0].type == L"image");
+    CHECK(entries[0].hasName && entries[0].name == L"a.jpg");
+    CHECK(entries[1].type == L"video");
+    CHECK(!entries[1].hasName);
+    CHECK(entries[1].rate == 1.5);
+    CHECK(settings.pomodoroMinutes && *settings.pomodoroMinutes == 30);
+    CHECK(settings.breakMinutes && *settings.breakMinutes == 5);
+    CHECK(settings.autoStartNextPomodoroAfterRest && !*settings.autoStartNextPomodoroAfterRest);
+    CHECK(settings.overlayMessage && *settings.overlayMessage == L"\u4f11\u606f");
+}
+
+TEST_CASE(testStructuralCharactersInsideStrings) {
+    // 旧实现把对象截到下一个 '}'，数组截到下一个 ']'
+    const std::wstring json =
+        L"{\"backgrounds\":[{\"name\":\"x}]\",\"path\":\"C:\\\\{odd}\\\\[dir]\\\\\\\"q\\\".png\",\"type\":\"image\"},"
+        L"{\"path\":\"/b\",\"type\":\"video\",\"extra\":{\"nested\":[1,{\"path\":\"ignored\"}]}}],"
+        L"\"overlayMessage\":\"a\\\"pomodoroMinutes\\\": 99\"}";
+
+    BackgroundsJsonSettings settings;
+    std::vector<Entry> entries;
+    CHECK(parse(json, settings, entries));
+    CHECK_EQ(entries.size(), std::size_t(2));
+    CHECK(entries[0].name == L"x}]");
+    CHECK(entries[0].path == L"C:\\{odd}\\[dir]\\\"q\".png");
+    CHECK(entries[1].path == L"/b");
+    CHECK(!settings.pomodoroMinutes); // 只认根对象上的键，不在字符串里找
+    CHECK(*settings.overlayMessage == L"a\"pomodoroMinutes\": 99");
+}
+
+TEST_CASE(testEntriesWithoutPathOrTypeAreSkipped) {
+    BackgroundsJsonSettings settings;
+    std::vector<Entry> entries;
+    CHECK(parse(L"{\"backgrounds\":[{\"path\":\"a\"},{\"type\":\"image\"},{},3,\"s\",{\"path\":\"b\",\"type\":\"image\",\"playbackRate\":\"fast\"}]}", settings, entries));
+    CHECK_EQ(entries.size(), std::size_t(1));
+    CHECK(entries[0].path == L"b");
+    CHECK(entries[0].rate == 1.0);
+
+    CHECK(parse(L"{\"pomodoroMinutes\":25}", settings, entries));
+    CHECK(!settings.hasBackgrounds);
+}
+
+TEST_CASE(testUnicodeEscapes) {
+    BackgroundsJsonSettings settings;
+    std::vector<Entry> entries;
+    CHECK(parse(L"{\"backgrounds\":[{\"path\":\"\\ud83c\\udf45\\u00e9\\/\\b\\f\",\"type\":\"image\"}]}", settings, entries));
+    std::wstring expected;
+    if constexpr (sizeof(wchar_t) == 2) {
+        expected = std::wstring{ static_cast<wchar_t>(0xD83C), static_cast<wchar_t>(0xDF45) };
+    } else {
+        expected = std::wstring{ static_cast<wchar_t>(0x1F345) };
+    }
+    expected += L"\u00e9/\b\f";
+    CHECK(entries[0].path == expected);
+}
+
+TEST_CASE(testRejectsMalformedDocuments) {
+    const wchar_t* bad[] = {
+        L"",
+        L"[]",
+        L"{\"backgrounds\":[}",
+        L"{\"backgrounds\":[{\"path\":\"a\",\"type\":\"image\"}]",
+        L"{\"backgrounds\":[],}",
+        L"{\"a\":\"unterminated}",
+        L"{\"a\":\"bad \\x escape\"}",
+        L"{\"a\":\"raw\ncontrol\"}",
+        L"{\"a\":01}",
+        L"{\"a\":1.}",
+        L"{\"a\":tru}",
+        L"{} trailing",
+    };
+    for (const wchar_t* json : bad) {
+        BackgroundsJsonSettings settings;
+        std::vector<Entry> entries;
+        CHECK(!parse(json, settings, entries));
+    }
+
+    // 过深的嵌套直接失败，不会耗尽栈
+    std::wstring deep = L"{\"a\":";
+    for (int i = 0; i < 100'000; ++i) deep += L'[';
+    BackgroundsJsonSettings settings;
+    std::vector<Entry> entries;
+    CHECK(!parse(deep, settings, entries));
+}
+
+// MARK: - 随机
+
+TEST_CASE(testRandomEntriesRoundTrip) {
+    std::mt19937 rng(7u);
+    std::uniform_int_distribution<int> count(0, 20);
+    std::uniform_int_distribution<int> kind(0, 1);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<Entry> written(static_cast<std::size_t>(count(rng)));
+        for (auto& e : written) {
+            e.path = randomText(rng, 40);
+            e.type = kind(rng) ? L"video" : L"image";
+            e.name = randomText(rng, 10);
+            e.hasName = true;
+            e.rate = 0.5 * (1 + kind(rng));
+        }
+        const std::wstring message = randomText(rng, 30);
+
+        BackgroundsJsonSettings settings;
+        std::vector<Entry> read;
+        CHECK(parse(serialize(written, message), settings, read));
+        CHECK_EQ(read.size(), written.size());
+        for (std::size_t i = 0; i < read.size() && i < written.size(); ++i) {
+            CHECK(read[i].path == written[i].path);
+            CHECK(read[i].name == written[i].name);
+            CHECK(read[i].type == written[i].type);
+            CHECK(read[i].rate == written[i].rate);
+        }
+        CHECK(settings.overlayMessage && *settings.overlayMessage == message);
+    }
+}
+
+TEST_CASE(testFuzzMutationsTerminate) {
+    // 对合法文档做随机截断、替换、插入与删除：解析必须正常返回（结果可以是失败），条目视图必须落在有效内存内
+    std::mt19937 rng(13u);
+    std::vector<Entry> seed(5);
+    for (std::size_t i = 0; i < seed.size(); ++i) {
+        seed[i].path = L"C:\\dir\\" + randomText(rng, 12);
+        seed[i].type = L"image";
+        seed[i].name = randomText(rng, 6);
+        seed[i].hasName = true;
+    }
+    const std::wstring base = serialize(seed, L"message");
+    static const wchar_t kNoise[] = L"{}[]\",:\\u0tfn-1e. \x01\xd800";
+    std::uniform_int_distribution<std::size_t> noise(0, sizeof(kNoise) / sizeof(wchar_t) - 2);
+    std::uniform_int_distribution<int> op(0, 3);
+    std::uniform_int_distribution<int> edits(1, 8);
+
+    std::size_t accepted = 0;
+    for (int round = 0; round < 20'000; ++round) {
+        std::wstring doc = base;
+        for (int e = edits(rng); e > 0 && !doc.empty(); --e) {
+            const std::size_t at = std::uniform_int_distribution<std::size_t>(0, doc.size() - 1)(rng);
+            switch (op(rng)) {
+            case 0: doc.resize(at); break;
+            case 1: doc[at] = kNoise[noise(rng)]; break;
+            case 2: doc.insert(doc.begin() + static_cast<std::ptrdiff_t>(at), kNoise[noise(rng)]); break;
+            default: doc.erase(at, 1); break;
+            }
+        }
+        BackgroundsJsonSettings settings;
+        std::size_t characters = 0;
+        const bool ok = parseBackgroundsJson(doc, settings, [&characters](const BackgroundJsonEntry& entry) {
+            for (const wchar_t c : entry.path) characters += c != 0;
+            for (const wchar_t c : entry.name) characters += c != 0;
+        });
+        accepted += ok;
+        CHECK(characters <= doc.size() * 2);
+    }
+    CHECK(accepted > 0);
+}
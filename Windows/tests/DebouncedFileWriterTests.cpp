@@ -0,0 +1,158 @@
+#include "TestHarness.h"
+
+#include "DebouncedFileWriter.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+using namespace pomodoro;
+using namespace std::chrono_literals;
+
+namespace {
+
+    std::filesystem::path freshDir(const char* name) {
+        auto dir = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    std::string readText(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    FileWriteFunction writeText(std::string text) {
+        return [text = std::move(text)](const std::filesystem::path& temp) {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            out << text;
+            out.flush();
+            return static_cast<bool>(out);
+        };
+    }
+
+    // 写了一半后失败（模拟磁盘满或进程在写入过程中出错）
+    bool writeHalfThenFail(const std::filesystem::path& temp) {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out << "{\"backgrounds\": [";
+        return false;
+    }
+
+    bool waitForWrites(const DebouncedFileWriter& writer, std::size_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (writer.writeCount() < count) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(5ms);
+        }
+        return true;
+    }
+
+} // namespace
+
+TEST_CASE(testAtomicWriteReplacesOrKeepsOriginal) {
+    const auto dir = freshDir("pomodoro_writer_atomic");
+    const auto path = dir / "backgrounds.json";
+
+    CHECK(writeFileAtomically(path, writeText("v1")));
+    CHECK(readText(path) == "v1");
+    CHECK(writeFileAtomically(path, writeText("version 2")));
+    CHECK(readText(path) == "version 2");
+
+    // 失败时原文件不变，临时文件被清理
+    CHECK(!writeFileAtomically(path, writeHalfThenFail));
+    CHECK(readText(path) == "version 2");
+    CHECK(!std::filesystem::exists(dir / "backgrounds.json.tmp"));
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE(testBurstIsCoalescedIntoOneWrite) {
+    const auto dir = freshDir("pomodoro_writer_burst");
+    const auto path = dir / "backgrounds.json";
+    DebouncedFileWriter writer(path, 100ms, 10s);
+
+    // 模拟拖动滑块：连续提交 50 个版本，只有最后一个落盘
+    for (int minutes = 1; minutes <= 50; ++minutes) {
+        writer.submit(writeText("pomodoroMinutes=" + std::to_string(minutes)));
+    }
+    CHECK(writer.busy());
+    CHECK_EQ(writer.writeCount(), std::size_t(0));
+
+    CHECK(waitForWrites(writer, 1));
+    std::this_thread::sleep_for(200ms);
+    CHECK_EQ(writer.writeCount(), std::size_t(1));
+    CHECK(!writer.busy());
+    CHECK(readText(path) == "pomodoroMinutes=50");
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE(testContinuousSubmissionsWriteByMaxDelay) {
+    const auto dir = freshDir("pomodoro_writer_max_delay");
+    const auto path = dir / "backgrounds.json";
+    DebouncedFileWriter writer(path, 10s, 50ms);
+
+    // 静默期永远不会到来，仍然至少每 maxDelay 写一次
+    const auto until = std::chrono::steady_clock::now() + 400ms;
+    int version = 0;
+    while (std::chrono::steady_clock::now() < until) {
+        writer.submit(writeText(std::to_string(++version)));
+        std::this_thread::sleep_for(5ms);
+    }
+    CHECK(writer.writeCount() >= 2);
+    CHECK(writer.writeCount() < static_cast<std::size_t>(version));
+    CHECK(writer.flush());
+    CHECK(readText(path) == std::to_string(version));
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE(testFlushAndDestructorWritePendingContent) {
+    const auto dir = freshDir("pomodoro_writer_flush");
+    const auto path = dir / "backgrounds.json";
+    {
+        DebouncedFileWriter writer(path, 1h, 1h);
+        CHECK(writer.flush()); // 没有待写内容
+        writer.submit(writeText("flushed"));
+        CHECK(writer.flush());
+        CHECK(readText(path) == "flushed");
+        CHECK(!writer.busy());
+
+        writer.submit(writeText("on exit"));
+    }
+    CHECK(readText(path) == "on exit");
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE(testFailedWriteKeepsPreviousFile) {
+    const auto dir = freshDir("pomodoro_writer_failure");
+    const auto path = dir / "backgrounds.json";
+    DebouncedFileWriter writer(path, 1h, 1h);
+    writer.submit(writeText("good"));
+    CHECK(writer.flush());
+    CHECK(writer.takeWrittenStamp().has_value());
+
+    writer.submit(writeHalfThenFail);
+    CHECK(!writer.flush());
+    CHECK(readText(path) == "good");
+    CHECK(!writer.takeWrittenStamp().has_value());
+
+    writer.submit(writeText("good again"));
+    CHECK(writer.flush());
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE(testWrittenStampMatchesFile) {
+    const auto dir = freshDir("pomodoro_writer_stamp");
+    const auto path = dir / "backgrounds.json";
+    DebouncedFileWriter writer(path, 1h, 1h);
+    writer.submit(writeText("{}"));
+    CHECK(writer.flush());
+
+    const auto stamp = writer.takeWrittenStamp();
+    CHECK(stamp.has_value());
+    CHECK(stamp && *stamp == readFileStamp(path));
+    CHECK(!writer.takeWrittenStamp().has_value()); // 取走后清空
+    std::filesystem::remove_all(dir);
+}
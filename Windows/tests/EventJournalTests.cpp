@@ -0,0 +1,257 @@
+#include "TestHarness.h"
+
+#include "AutoRestartStateMachine.h"
+#include "EventJournal.h"
+#include "MonotonicClock.h"
+#include "PomodoroTimer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kWallStartNs = 1'700'000'000'000'000'000; // 任意固定的墙钟起点
+
+    std::filesystem::path tempJournalPath(const char* name) {
+        auto path = std::filesystem::temp_directory_path() / (std::string("pomodoro_") + name + ".journal");
+        std::filesystem::remove(path);
+        return path;
+    }
+
+    AutoRestartSettings allEnabledPauseMode() {
+        AutoRestartSettings s;
+        s.idleEnabled = true;
+        s.idleActionIsRestart = false;
+        s.screenLockEnabled = true;
+        s.screenLockActionIsRestart = false;
+        s.screensaverEnabled = true;
+        s.screensaverActionIsRestart = false;
+        return s;
+    }
+
+    template <typename E>
+    std::uint8_t raw(E e) { return static_cast<std::uint8_t>(e); }
+
+} // namespace
+
+// MARK: - 记录格式
+
+TEST_CASE(testRecordsCaptureEveryProcessEvent) {
+    const auto path = tempJournalPath("journal_records");
+    VirtualClock clock;
+    AutoRestartStateMachine machine(allEnabledPauseMode(), clock);
+
+    EventJournal journal;
+    CHECK(journal.open(path));
+    journal.anchorTime(clock.now(), kWallStartNs);
+    machine.setTransitionSink(&journal);
+
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+    clock.advance(std::chrono::milliseconds(1500));
+    machine.processEvent(AutoRestartEvent::ScreenLocked);
+    machine.processEvent(AutoRestartEvent::ScreenLocked); // 空转事件同样是一次 processEvent 调用
+
+    CHECK_EQ(journal.size(), std::size_t(3));
+    const JournalRecord* r = journal.records();
+    CHECK_EQ(r[0].unixNs, kWallStartNs);
+    CHECK_EQ(r[0].event, raw(AutoRestartEvent::TimerStarted));
+    CHECK_EQ(r[0].oldState, raw(AutoRestartState::Idle));
+    CHECK_EQ(r[0].newState, raw(AutoRestartState::TimerRunning));
+    CHECK(r[0].flags & JournalRecord::kFlagSessionStart);
+
+    CHECK_EQ(r[1].unixNs, kWallStartNs + 1'500'000'000);
+    CHECK_EQ(r[1].newState, raw(AutoRestartState::TimerPausedBySystem));
+    CHECK_EQ(r[1].action, raw(AutoRestartAction::PauseTimer));
+    CHECK(!(r[1].flags & JournalRecord::kFlagSessionStart));
+
+    CHECK_EQ(r[2].oldState, r[2].newState);
+    CHECK_EQ(r[2].action, raw(AutoRestartAction::None));
+    CHECK_EQ(findJournalDivergence(r, journal.size()), journal.size());
+}
+
+TEST_CASE(testRecentScreensaverResumeIsRecorded) {
+    const auto path = tempJournalPath("journal_recent");
+    VirtualClock clock;
+    AutoRestartStateMachine machine(allEnabledPauseMode(), clock);
+    EventJournal journal;
+    CHECK(journal.open(path));
+    machine.setTransitionSink(&journal);
+
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+    machine.processEvent(AutoRestartEvent::ScreensaverStarted);
+    machine.markScreensaverResumedNow();
+    machine.processEvent(AutoRestartEvent::ScreensaverStopped);
+    machine.processEvent(AutoRestartEvent::ScreenUnlocked);
+
+    const JournalRecord& unlock = journal.records()[journal.size() - 1];
+    CHECK_EQ(unlock.event, raw(AutoRestartEvent::ScreenUnlocked));
+    CHECK(unlock.flags & JournalRecord::kFlagRecentResume);
+    CHECK_EQ(findJournalDivergence(journal.records(), journal.size()), journal.size());
+}
+
+// MARK: - 组提交与恢复
+
+TEST_CASE(testGroupCommitPublishesInBatches) {
+    const auto path = tempJournalPath("journal_group");
+    VirtualClock clock;
+    AutoRestartStateMachine machine(allEnabledPauseMode(), clock);
+
+    EventJournal::Options options;
+    options.groupCommitRecords = 4;
+    options.groupCommitInterval = std::chrono::milliseconds(100);
+    EventJournal journal;
+    CHECK(journal.open(path, options));
+    machine.setTransitionSink(&journal);
+
+    for (int i = 0; i < 3; ++i) machine.processEvent(AutoRestartEvent::UserActivityDetected);
+    CHECK_EQ(journal.committedSize(), std::size_t(0));
+    machine.processEvent(AutoRestartEvent::UserActivityDetected);
+    CHECK_EQ(journal.committedSize(), std::size_t(4));
+
+    // 不足一组的尾部由主循环按时间间隔提交
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+    clock.advance(std::chrono::milliseconds(99));
+    journal.commitIfDue(clock.now());
+    CHECK_EQ(journal.committedSize(), std::size_t(4));
+    clock.advance(std::chrono::milliseconds(1));
+    journal.commitIfDue(clock.now());
+    CHECK_EQ(journal.committedSize(), std::size_t(5));
+}
+
+TEST_CASE(testUncommittedTailSurvivesProcessCrash) {
+    const auto path = tempJournalPath("journal_live");
+    const auto crashed = tempJournalPath("journal_crashed");
+    VirtualClock clock;
+    AutoRestartStateMachine machine(allEnabledPauseMode(), clock);
+
+    EventJournal::Options options;
+    options.groupCommitRecords = 1000;
+    EventJournal journal;
+    CHECK(journal.open(path, options));
+    machine.setTransitionSink(&journal);
+    machine.processEvent(AutoRestartEvent::TimerStarted);
+    machine.processEvent(AutoRestartEvent::TimerPaused);
+    CHECK_EQ(journal.committedSize(), std::size_t(0));
+
+    // 进程在提交前崩溃：映射页已在页缓存中，文件内容即为崩溃时的状态
+    std::filesystem::copy_file(path, crashed);
+
+    const auto recovered = EventJournal::readAll(crashed);
+    CHECK_EQ(recovered.size(), std::size_t(2));
+
+    EventJournal reopened;
+    CHECK(reopened.open(crashed));
+    CHECK_EQ(reopened.size(), std::size_t(2));
+    CHECK_EQ(reopened.committedSize(), std::size_t(2));
+    CHECK_EQ(reopened.records()[1].newState, raw(AutoRestartState::TimerPausedByUser));
+}
+
+TEST_CASE(testJournalGrowsAndAppendsAcrossReopen) {
+    const auto path = tempJournalPath("journal_grow");
+    VirtualClock clock;
+
+    EventJournal::Options options;
+    options.initialCapacity = 8;
+    options.groupCommitRecords = 16;
+    {
+        AutoRestartStateMachine machine(allEnabledPauseMode(), clock);
+        EventJournal journal;
+        CHECK(journal.open(path, options));
+        machine.setTransitionSink(&journal);
+        for (int i = 0; i < 100; ++i) {
+            machine.processEvent(i % 2 ? AutoRestartEvent::TimerPaused : AutoRestartEvent::TimerStarted);
+        }
+        CHECK_EQ(journal.size(), std::size_t(100));
+        CHECK_EQ(journal.droppedRecords(), std::uint64_t(0));
+    }
+    {
+        // 新进程：状态机从 Idle 重新开始，第一条记录带会话起点标记
+        AutoRestartStateMachine machine(allEnabledPauseMode(), clock);
+        EventJournal journal;
+        CHECK(journal.open(path, options));
+        CHECK_EQ(journal.size(), std::size_t(100));
+        machine.setTransitionSink(&journal);
+        machine.processEvent(AutoRestartEvent::TimerStarted);
+    }
+
+    const auto all = EventJournal::readAll(path);
+    CHECK_EQ(all.size(), std::size_t(101));
+    CHECK(all[100].flags & JournalRecord::kFlagSessionStart);
+    CHECK_EQ(findJournalDivergence(all.data(), all.size()), all.size());
+}
+
+TEST_CASE(testForeignFileIsRejected) {
+    const auto path = tempJournalPath("journal_foreign");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a journal, just some settings text that is long enough to hold a header";
+    }
+    const auto before = std::filesystem::file_size(path);
+
+    EventJournal journal;
+    CHECK(!journal.open(path));
+    CHECK_EQ(std::filesystem::file_size(path), before);
+    CHECK(EventJournal::readAll(path).empty());
+}
+
+// MARK: - 回放
+
+TEST_CASE(testReplayMatchesRandomTimerSession) {
+    const auto path = tempJournalPath("journal_replay");
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    PomodoroTimer::Settings settings;
+    settings.idleRestartEnabled = true;
+    settings.idleActionIsRestart = false;
+    settings.screenLockRestartEnabled = true;
+    settings.screensaverRestartEnabled = true;
+    settings.stayUpLimitEnabled = true;
+    timer.updateSettings(settings);
+
+    EventJournal journal;
+    CHECK(journal.open(path));
+    timer.setTransitionSink(&journal);
+
+    std::mt19937 rng(7u);
+    std::uniform_int_distribution<int> pick(0, 11);
+    std::uniform_int_distribution<int> waitMs(0, 90'000);
+    std::vector<AutoRestartEvent> batch;
+    for (int i = 0; i < 5000; ++i) {
+        clock.advance(std::chrono::milliseconds(waitMs(rng)));
+        timer.tick();
+        switch (pick(rng)) {
+        case 0: timer.start(); break;
+        case 1: timer.pause(); break;
+        case 2: timer.resume(); break;
+        case 3: timer.onIdleTimeExceeded(); break;
+        case 4: timer.onUserActivity(); break;
+        case 5: timer.onScreenLocked(); break;
+        case 6: timer.onScreenUnlocked(); break;
+        case 7: timer.onScreensaverStarted(); break;
+        case 8: timer.onScreensaverStopped(); timer.onScreenUnlocked(); break;
+        case 9: timer.onForcedSleepTriggered(); break;
+        case 10: timer.onForcedSleepEnded(); break;
+        default:
+            batch.assign({ AutoRestartEvent::UserActivityDetected, AutoRestartEvent::ScreenLocked,
+                AutoRestartEvent::ScreenUnlocked, AutoRestartEvent::UserActivityDetected });
+            timer.onSystemEvents(batch.data(), batch.size());
+            break;
+        }
+    }
+
+    CHECK(journal.size() > 5000);
+    CHECK_EQ(findJournalDivergence(journal.records(), journal.size()), journal.size());
+
+    // 篡改一条记录的结果，回放应定位到它
+    auto records = EventJournal::readAll((journal.close(), path));
+    const std::size_t victim = records.size() / 2;
+    records[victim].newState = static_cast<std::uint8_t>((records[victim].newState + 1) % 11);
+    CHECK_EQ(findJournalDivergence(records.data(), records.size()), victim);
+}
@@ -0,0 +1,73 @@
+#include "TestHarness.h"
+
+#include "FileStamp.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace pomodoro;
+
+namespace {
+
+    std::filesystem::path freshDir(const char* name) {
+        auto dir = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    void writeText(const std::filesystem::path& path, const char* text) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    }
+
+} // namespace
+
+TEST_CASE(testMissingFileHasEmptyStamp) {
+    const auto dir = freshDir("pomodoro_file_stamp_missing");
+    const FileStamp stamp = readFileStamp(dir / "backgrounds.json");
+    CHECK(!stamp.exists);
+    CHECK(stamp == FileStamp{});
+
+    // 目录不是普通文件
+    CHECK(!readFileStamp(dir).exists);
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE(testUnchangedFileKeepsStamp) {
+    const auto dir = freshDir("pomodoro_file_stamp_same");
+    const auto path = dir / "backgrounds.json";
+    writeText(path, "{\"backgrounds\":[]}");
+
+    const FileStamp first = readFileStamp(path);
+    CHECK(first.exists);
+    CHECK_EQ(first.size, std::uintmax_t(18));
+    CHECK(readFileStamp(path) == first);
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE(testRewriteChangesStamp) {
+    const auto dir = freshDir("pomodoro_file_stamp_rewrite");
+    const auto path = dir / "backgrounds.json";
+    writeText(path, "{\"backgrounds\":[]}");
+    const auto written = std::filesystem::last_write_time(path);
+    const FileStamp first = readFileStamp(path);
+
+    // 大小变化
+    writeText(path, "{\"backgrounds\":[ ]}");
+    std::filesystem::last_write_time(path, written);
+    CHECK(readFileStamp(path) != first);
+
+    // 大小不变、只有修改时间变化（显式设置时间，不依赖文件系统的时间精度）
+    writeText(path, "{\"backgrounds\":[]}");
+    std::filesystem::last_write_time(path, written + std::chrono::seconds(2));
+    const FileStamp touched = readFileStamp(path);
+    CHECK_EQ(touched.size, first.size);
+    CHECK(touched != first);
+
+    // 删除
+    std::filesystem::remove(path);
+    CHECK(!readFileStamp(path).exists);
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,142 @@
+#include "TestHarness.h"
+
+#include "HealthScores.h"
+#include "StatisticsEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerMinute = 60'000;
+    constexpr std::int64_t kMsPerDay = 24 * 60 * kMsPerMinute;
+    constexpr std::int64_t kDay0 = 19'700LL * kMsPerDay;
+
+    bool near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+    bool sameScores(const HealthScores& a, const HealthScores& b) {
+        return near(a.workIntensity, b.workIntensity) && near(a.restAdequacy, b.restAdequacy) &&
+            near(a.focus, b.focus) && near(a.health, b.health);
+    }
+
+    StatisticsEvent makeEvent(StatisticsEventType type, std::int64_t at, std::uint32_t durationMs = 0,
+        std::uint8_t flags = 0) {
+        StatisticsEvent e;
+        e.type = type;
+        e.timestampMs = at;
+        e.durationMs = durationMs;
+        e.flags = flags;
+        return e;
+    }
+
+    // Swift 计算属性的逐行翻译（秒为单位），作为对照
+    HealthScores swiftScores(const DailyStatistics& d, int breakMinutes) {
+        const double work = d.totalWorkMs / 1000.0;
+        const double rest = d.totalBreakMs / 1000.0;
+        HealthScores s;
+        const double ratio = work > 0 ? rest / work : 0;
+        s.workIntensity = std::min(d.completedPomodoros / 8.0, 1.0) * 50 + std::min(ratio / 0.25, 1.0) * 30 +
+            (d.cancelledBreakCount == 0 ? 20.0 : std::max(0.0, 20 - d.cancelledBreakCount * 5.0));
+        s.restAdequacy = d.completedPomodoros > 0
+            ? std::min(rest / (d.completedPomodoros * breakMinutes * 60.0), 1.0) * 100 : 0;
+        s.focus = d.completedPomodoros > 0
+            ? std::max(0.0, std::min(100.0, d.completedPomodoros * 10.0 - (d.cancelledBreakCount + d.screenLockCount) * 5.0))
+            : 0;
+        if (d.completedPomodoros > 0 || work > 0) {
+            double h = 100 - d.stayUpLateCount * 20.0 - d.cancelledBreakCount * 5.0;
+            if (work > 8 * 60 * 60) h -= 20;
+            s.health = std::max(0.0, h);
+        } else {
+            s.health = 20;
+        }
+        return s;
+    }
+
+} // namespace
+
+// MARK: - 公式
+
+TEST_CASE(testEmptyDayScores) {
+    const auto s = computeHealthScores(DailyStatistics{}, 5);
+    CHECK(near(s.workIntensity, 20)); // 没有取消休息：一致性满分
+    CHECK(near(s.restAdequacy, 0));
+    CHECK(near(s.focus, 0));
+    CHECK(near(s.health, 20));
+}
+
+TEST_CASE(testTypicalDayScores) {
+    DailyStatistics d;
+    d.completedPomodoros = 4;
+    d.totalWorkMs = 4 * 25 * kMsPerMinute;
+    d.totalBreakMs = 3 * 5 * kMsPerMinute;
+    d.cancelledBreakCount = 1;
+    d.screenLockCount = 2;
+
+    const auto s = computeHealthScores(d, 5);
+    CHECK(near(s.workIntensity, 25 + 18 + 15)); // 4/8*50 + (15/100)/0.25*30 + (20-5)
+    CHECK(near(s.restAdequacy, 75));
+    CHECK(near(s.focus, 25));
+    CHECK(near(s.health, 95));
+
+    d.stayUpLateCount = 6;
+    d.totalWorkMs = 9 * 60 * kMsPerMinute;
+    CHECK(near(computeHealthScores(d, 5).health, 0)); // 扣分下限为 0
+}
+
+TEST_CASE(testZeroBreakMinutesDoesNotDivideByZero) {
+    DailyStatistics d;
+    d.completedPomodoros = 2;
+    CHECK(near(computeHealthScores(d, 0).restAdequacy, 100));
+}
+
+// MARK: - 增量跟踪
+
+TEST_CASE(testTrackerMatchesSwiftFormulasOnRandomStream) {
+    std::mt19937 rng(12u);
+    std::uniform_int_distribution<int> type(0, static_cast<int>(kStatisticsEventTypeCount) - 1);
+    std::uniform_int_distribution<std::int64_t> gap(0, 20 * kMsPerMinute);
+    std::uniform_int_distribution<std::uint32_t> duration(0, 30 * 60 * 1000);
+
+    StatisticsEngine engine;
+    HealthScoreTracker tracker(5);
+    std::int64_t t = kDay0;
+    for (int i = 0; i < 5000; ++i) {
+        t += gap(rng);
+        const auto* day = engine.record(makeEvent(static_cast<StatisticsEventType>(type(rng)), t, duration(rng),
+            (i % 2 == 0) ? StatisticsEvent::kFlagUserSource : 0));
+        CHECK(day != nullptr);
+        tracker.update(*day);
+
+        const auto& snapshot = tracker.snapshot();
+        CHECK_EQ(snapshot.dayIndex, engine.dayIndexFor(t));
+        CHECK(sameScores(snapshot.scores, swiftScores(engine.dayContaining(t), 5)));
+    }
+}
+
+TEST_CASE(testTrackerFollowsLatestDayAndSettings) {
+    StatisticsEngine engine;
+    HealthScoreTracker tracker(5);
+    const std::int32_t day0 = engine.dayIndexFor(kDay0);
+
+    tracker.update(*engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, kDay0 + kMsPerDay, 25 * kMsPerMinute)));
+    tracker.update(*engine.record(makeEvent(StatisticsEventType::BreakFinished, kDay0 + kMsPerDay + 1, 5 * kMsPerMinute)));
+    CHECK(near(tracker.scoresFor(day0 + 1).restAdequacy, 100));
+
+    // 补录前一天的事件不影响当天的快照
+    const auto version = tracker.snapshot().version;
+    tracker.update(*engine.record(makeEvent(StatisticsEventType::StayUpLateTriggered, kDay0)));
+    CHECK_EQ(tracker.snapshot().version, version);
+    CHECK(near(tracker.scoresFor(day0 + 1).health, 100));
+
+    // 休息时长设置翻倍：同样的休息只够一半
+    tracker.setBreakMinutes(10);
+    CHECK(near(tracker.scoresFor(day0 + 1).restAdequacy, 50));
+    CHECK(tracker.snapshot().version > version);
+
+    // 跨日后还没有事件：显示空白日期的分数
+    CHECK(sameScores(tracker.scoresFor(day0 + 2), computeHealthScores(DailyStatistics{}, 10)));
+}
@@ -0,0 +1,299 @@
+#include "TestHarness.h"
+
+#include "ImageResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    // 固定内容的测试图：横向渐变 + 纵向渐变 + 斜向条纹，alpha 全不透明
+    BgraImage makePattern(int w, int h) {
+        BgraImage img(w, h);
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                std::uint8_t* p = &img.pixels[(static_cast<std::size_t>(y) * w + x) * 4];
+                p[0] = static_cast<std::uint8_t>(x * 255 / (w > 1 ? w - 1 : 1));
+                p[1] = static_cast<std::uint8_t>(y * 255 / (h > 1 ? h - 1 : 1));
+                p[2] = static_cast<std::uint8_t>(((x + y) / 3) % 2 ? 230 : 20);
+                p[3] = 255;
+            }
+        }
+        return img;
+    }
+
+    std::uint64_t fnv1a(const BgraImage& img) {
+        std::uint64_t hash = 1469598103934665603ull;
+        for (const std::uint8_t b : img.pixels) {
+            hash ^= b;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // 随机的预乘像素（颜色 <= alpha），覆盖半透明与振铃的情况
+    BgraImage makeNoise(int w, int h, std::uint32_t seed) {
+        BgraImage img(w, h);
+        for (std::size_t i = 0; i < img.pixels.size(); i += 4) {
+            seed = seed * 1664525u + 1013904223u;
+            const std::uint8_t alpha = (seed >> 24) & 1 ? 255 : static_cast<std::uint8_t>(seed >> 16);
+            for (int c = 0; c < 3; ++c) {
+                seed = seed * 1664525u + 1013904223u;
+                img.pixels[i + c] = static_cast<std::uint8_t>((seed >> 16) % (alpha + 1u));
+            }
+            img.pixels[i + 3] = alpha;
+        }
+        return img;
+    }
+
+    const SimdLevel kAllLevels[] = { SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2, SimdLevel::Neon };
+
+    const std::uint8_t* pixelAt(const BgraImage& img, int x, int y) {
+        return &img.pixels[(static_cast<std::size_t>(y) * img.width + x) * 4];
+    }
+
+} // namespace
+
+// MARK: - 几何
+
+TEST_CASE(testCoverGeometry) {
+    // 同宽高比：使用整张源图
+    FitGeometry g = computeFit(FitMode::Cover, 3840, 2160, 1920, 1080);
+    CHECK_EQ(g.dstX, 0);
+    CHECK_EQ(g.dstWidth, 1920);
+    CHECK_EQ(g.dstHeight, 1080);
+    CHECK(g.srcX == 0.0 && g.srcY == 0.0);
+    CHECK(g.srcWidth == 3840.0 && g.srcHeight == 2160.0);
+
+    // 横图放到竖屏：按高度缩放，左右裁掉
+    g = computeFit(FitMode::Cover, 1920, 1080, 1080, 1920);
+    CHECK(std::fabs(g.srcWidth - 607.5) < 1e-9);
+    CHECK(g.srcHeight == 1080.0);
+    CHECK(std::fabs(g.srcX - 656.25) < 1e-9);
+    CHECK(g.srcY == 0.0);
+
+    // 超宽屏：上下裁掉
+    g = computeFit(FitMode::Cover, 1600, 1200, 3440, 1440);
+    CHECK(g.srcWidth == 1600.0);
+    CHECK(std::fabs(g.srcHeight - 1600.0 * 1440 / 3440) < 1e-9);
+    CHECK(std::fabs(g.srcY - (1200 - g.srcHeight) / 2) < 1e-9);
+
+    // 非法尺寸
+    g = computeFit(FitMode::Cover, 0, 100, 100, 100);
+    CHECK_EQ(g.dstWidth, 0);
+}
+
+TEST_CASE(testContainGeometry) {
+    // 横图放到竖屏：按宽度缩放，上下留边，使用整张源图
+    FitGeometry g = computeFit(FitMode::Contain, 1920, 1080, 1080, 1920);
+    CHECK_EQ(g.dstWidth, 1080);
+    CHECK_EQ(g.dstHeight, 608);
+    CHECK_EQ(g.dstX, 0);
+    CHECK_EQ(g.dstY, (1920 - 608) / 2);
+    CHECK(g.srcX == 0.0 && g.srcY == 0.0);
+    CHECK(g.srcWidth == 1920.0 && g.srcHeight == 1080.0);
+
+    // 4:3 放到超宽屏：左右留边
+    g = computeFit(FitMode::Contain, 1600, 1200, 3440, 1440);
+    CHECK_EQ(g.dstHeight, 1440);
+    CHECK_EQ(g.dstWidth, 1920);
+    CHECK_EQ(g.dstX, (3440 - 1920) / 2);
+    CHECK_EQ(g.dstY, 0);
+
+    // 极端宽高比：至少保留 1 个像素
+    g = computeFit(FitMode::Contain, 10000, 1, 100, 100);
+    CHECK_EQ(g.dstWidth, 100);
+    CHECK_EQ(g.dstHeight, 1);
+}
+
+// MARK: - 重采样
+
+TEST_CASE(testSameSizeIsExactCopy) {
+    const BgraImage src = makePattern(37, 23);
+    BgraImage dst(37, 23);
+    CHECK(resampleBgraToFit(src.view(), dst.mutableView(), FitMode::Cover));
+    CHECK(dst.pixels == src.pixels);
+}
+
+TEST_CASE(testFlatColorStaysFlat) {
+    BgraImage src(61, 47);
+    for (std::size_t i = 0; i < src.pixels.size(); i += 4) {
+        src.pixels[i + 0] = 12;
+        src.pixels[i + 1] = 200;
+        src.pixels[i + 2] = 99;
+        src.pixels[i + 3] = 255;
+    }
+    const int sizes[][2] = { { 7, 5 }, { 61, 47 }, { 250, 90 }, { 13, 200 }, { 1, 1 } };
+    for (const ResampleFilter filter : { ResampleFilter::Bicubic, ResampleFilter::Lanczos3 }) {
+        for (const auto& s : sizes) {
+            BgraImage dst(s[0], s[1]);
+            CHECK(resampleBgraToFit(src.view(), dst.mutableView(), FitMode::Cover, filter));
+            bool flat = true;
+            for (std::size_t i = 0; i < dst.pixels.size(); i += 4) {
+                flat = flat && dst.pixels[i] == 12 && dst.pixels[i + 1] == 200 && dst.pixels[i + 2] == 99 && dst.pixels[i + 3] == 255;
+            }
+            CHECK(flat);
+        }
+    }
+}
+
+TEST_CASE(testContainLeavesBorderUntouched) {
+    const BgraImage src = makePattern(40, 10);
+    BgraImage dst(20, 20);
+    std::fill(dst.pixels.begin(), dst.pixels.end(), static_cast<std::uint8_t>(0x5A));
+    CHECK(resampleBgraToFit(src.view(), dst.mutableView(), FitMode::Contain));
+    // 目标矩形为 20x5，位于 y = 7..11
+    for (int y = 0; y < 20; ++y) {
+        const bool inside = y >= 7 && y < 12;
+        CHECK_EQ(pixelAt(dst, 10, y)[3] == 0x5A, !inside);
+    }
+}
+
+TEST_CASE(testGoldenUpscaleRow) {
+    // 2 -> 4 像素放大，Catmull-Rom 在边缘处按有效权重归一化（手算：255 * 0.2266 / 1.0938 = 52.8）
+    BgraImage src(2, 1);
+    const std::uint8_t row[] = { 0, 0, 0, 255, 255, 255, 255, 255 };
+    std::copy(row, row + 8, src.pixels.begin());
+    BgraImage dst(4, 1);
+    CHECK(resampleBgraToFit(src.view(), dst.mutableView(), FitMode::Cover));
+    const std::uint8_t expected[] = { 0, 53, 202, 255 };
+    for (int x = 0; x < 4; ++x) {
+        CHECK_EQ(static_cast<int>(pixelAt(dst, x, 0)[0]), static_cast<int>(expected[x]));
+        CHECK_EQ(static_cast<int>(pixelAt(dst, x, 0)[3]), 255);
+    }
+}
+
+TEST_CASE(testDownscaleAveragesFinePattern) {
+    // 1 像素棋盘格缩小 8 倍：放宽的滤波器覆盖所有源像素，结果接近 50% 灰，而不是随机取到黑或白
+    BgraImage src(256, 256);
+    for (int y = 0; y < 256; ++y) {
+        for (int x = 0; x < 256; ++x) {
+            std::uint8_t* p = &src.pixels[(static_cast<std::size_t>(y) * 256 + x) * 4];
+            const std::uint8_t v = ((x ^ y) & 1) ? 255 : 0;
+            p[0] = p[1] = p[2] = v;
+            p[3] = 255;
+        }
+    }
+    BgraImage dst(32, 32);
+    CHECK(resampleBgraToFit(src.view(), dst.mutableView(), FitMode::Cover));
+    int worst = 0;
+    for (int y = 2; y < 30; ++y) {
+        for (int x = 2; x < 30; ++x) {
+            const int d = std::abs(static_cast<int>(pixelAt(dst, x, y)[1]) - 128);
+            worst = d > worst ? d : worst;
+        }
+    }
+    CHECK(worst <= 2);
+}
+
+TEST_CASE(testPremultipliedOutputStaysValid) {
+    // 半透明的锐利边缘：振铃不能让颜色超过 alpha
+    BgraImage src(16, 16);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            std::uint8_t* p = &src.pixels[(static_cast<std::size_t>(y) * 16 + x) * 4];
+            const bool on = x >= 8;
+            p[0] = p[1] = p[2] = on ? 128 : 0;
+            p[3] = on ? 128 : 0;
+        }
+    }
+    BgraImage dst(41, 9);
+    CHECK(resampleBgraToFit(src.view(), dst.mutableView(), FitMode::Cover));
+    bool valid = true;
+    for (std::size_t i = 0; i < dst.pixels.size(); i += 4) {
+        valid = valid && dst.pixels[i] <= dst.pixels[i + 3] && dst.pixels[i + 1] <= dst.pixels[i + 3] && dst.pixels[i + 2] <= dst.pixels[i + 3];
+    }
+    CHECK(valid);
+}
+
+TEST_CASE(testStridedViewsAndTargetRect) {
+    // 源与目标都带行填充；只写目标矩形，其余像素保持原值
+    const BgraImage pattern = makePattern(30, 20);
+    std::vector<std::uint8_t> padded(static_cast<std::size_t>(20) * 136, 0xEE);
+    for (int y = 0; y < 20; ++y) {
+        std::copy(pattern.pixels.begin() + y * 120, pattern.pixels.begin() + (y + 1) * 120, padded.begin() + y * 136);
+    }
+    const ImageView src{ padded.data(), 30, 20, 136 };
+
+    BgraImage reference(12, 8);
+    CHECK(resampleBgraToFit(pattern.view(), reference.mutableView(), FitMode::Cover));
+
+    std::vector<std::uint8_t> canvas(static_cast<std::size_t>(16) * 80, 0x11);
+    const MutableImageView dst{ canvas.data(), 18, 16, 80 };
+    FitGeometry g = computeFit(FitMode::Cover, 30, 20, 12, 8);
+    g.dstX = 3;
+    g.dstY = 5;
+    CHECK(resampleBgra(src, dst, g));
+    bool same = true;
+    bool untouched = true;
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            const std::uint8_t* p = &canvas[static_cast<std::size_t>(y) * 80 + x * 4];
+            const bool inside = x >= 3 && x < 15 && y >= 5 && y < 13;
+            for (int c = 0; c < 4; ++c) {
+                if (inside) same = same && p[c] == pixelAt(reference, x - 3, y - 5)[c];
+                else untouched = untouched && p[c] == 0x11;
+            }
+        }
+    }
+    CHECK(same);
+    CHECK(untouched);
+
+    // 目标矩形越界
+    g.dstX = 10;
+    CHECK(!resampleBgra(src, dst, g));
+}
+
+TEST_CASE(testGoldenChecksums) {
+    // 回归基准：定点实现在所有平台上逐位一致，任何优化路径必须得到相同的结果
+    struct Case { int srcW, srcH, dstW, dstH; FitMode mode; ResampleFilter filter; std::uint64_t hash; };
+    const Case cases[] = {
+        { 97, 61, 40, 30, FitMode::Cover, ResampleFilter::Bicubic, 0xbcf46312e7db4d55ull },   // 缩小 + 左右裁剪
+        { 50, 80, 173, 91, FitMode::Cover, ResampleFilter::Bicubic, 0x51c7951567ee3bd4ull },  // 放大 + 上下裁剪
+        { 640, 360, 96, 54, FitMode::Cover, ResampleFilter::Bicubic, 0x2158b2d75339c99full }, // 大比例缩小
+        { 97, 61, 40, 30, FitMode::Cover, ResampleFilter::Lanczos3, 0xc5a606293e5cf0e8ull },
+        { 640, 360, 96, 54, FitMode::Cover, ResampleFilter::Lanczos3, 0x9586b6eaf8759be7ull },
+        { 50, 80, 173, 91, FitMode::Contain, ResampleFilter::Lanczos3, 0x693d8bfbaf7f1027ull },  // 左右留边（保持为 0）
+    };
+    for (const auto& c : cases) {
+        const BgraImage src = makePattern(c.srcW, c.srcH);
+        for (const SimdLevel level : kAllLevels) {
+            if (!simdLevelSupported(level)) continue;
+            BgraImage dst(c.dstW, c.dstH);
+            const FitGeometry g = computeFit(c.mode, c.srcW, c.srcH, c.dstW, c.dstH);
+            CHECK(resampleBgra(src.view(), dst.mutableView(), g, c.filter, level));
+            CHECK_EQ(fnv1a(dst), c.hash);
+        }
+    }
+}
+
+TEST_CASE(testSimdLevelsMatchScalar) {
+    // 各种宽度（含不足一个向量的行尾）、放大与缩小、两种滤波器：向量实现与标量参考逐字节相同
+    const int sizes[][4] = {
+        { 64, 48, 64, 48 }, { 33, 17, 7, 5 }, { 200, 120, 31, 19 }, { 21, 13, 67, 41 },
+        { 1000, 10, 9, 3 }, { 5, 300, 3, 11 }, { 129, 77, 128, 77 }, { 3, 3, 1, 1 },
+    };
+    std::uint32_t seed = 7;
+    for (const auto& s : sizes) {
+        const BgraImage src = makeNoise(s[0], s[1], seed++);
+        for (const ResampleFilter filter : { ResampleFilter::Bicubic, ResampleFilter::Lanczos3 }) {
+            for (const FitMode mode : { FitMode::Cover, FitMode::Contain }) {
+                const FitGeometry g = computeFit(mode, s[0], s[1], s[2], s[3]);
+                BgraImage reference(s[2], s[3]);
+                CHECK(resampleBgra(src.view(), reference.mutableView(), g, filter, SimdLevel::Scalar));
+                for (const SimdLevel level : kAllLevels) {
+                    BgraImage dst(s[2], s[3]);
+                    const bool ok = resampleBgra(src.view(), dst.mutableView(), g, filter, level);
+                    CHECK_EQ(ok, simdLevelSupported(level));
+                    if (ok) CHECK(dst.pixels == reference.pixels);
+                }
+            }
+        }
+    }
+    CHECK(simdLevelSupported(bestSimdLevel()));
+}
@@ -0,0 +1,151 @@
+#include "TestHarness.h"
+
+#include "LocalCalendar.h"
+#include "StatisticsEngine.h"
+#include "StatisticsHeatmap.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerMinute = 60'000;
+    constexpr std::int64_t kMsPerHour = 60 * kMsPerMinute;
+    constexpr std::int64_t kMsPerDay = 24 * kMsPerHour;
+
+    // 2024 年的切换时刻（UTC）
+    constexpr std::int64_t kEasternSpringForward = 1'710'054'000'000; // 2024-03-10 07:00Z（本地 02:00 EST -> 03:00 EDT）
+    constexpr std::int64_t kEasternFallBack = 1'730'613'600'000;      // 2024-11-03 06:00Z（本地 02:00 EDT -> 01:00 EST）
+    constexpr std::int32_t kMarch10 = 19'792;
+    constexpr std::int32_t kNovember3 = 20'030;
+
+    std::int64_t floorDiv(std::int64_t a, std::int64_t b) {
+        return a / b - ((a % b != 0 && (a < 0) != (b < 0)) ? 1 : 0);
+    }
+
+    DstTransitionRule rule(int month, int week, int hour) {
+        DstTransitionRule r;
+        r.month = month;
+        r.week = week;
+        r.dayOfWeek = 0; // 周日
+        r.hour = hour;
+        return r;
+    }
+
+    // 美国东部：3 月第 2 个周日 02:00 进入夏令时，11 月第 1 个周日 02:00 回到标准时间
+    LocalCalendar easternCalendar(int fromYear, int toYear) {
+        std::vector<TimeZoneYearRules> years;
+        for (int y = fromYear; y <= toYear; ++y) {
+            TimeZoneYearRules r;
+            r.year = y;
+            r.standardOffsetMinutes = -5 * 60;
+            r.daylightOffsetMinutes = -4 * 60;
+            r.daylightStart = rule(3, 2, 2);
+            r.standardStart = rule(11, 1, 2);
+            years.push_back(r);
+        }
+        return LocalCalendar::fromYearRules(years);
+    }
+
+} // namespace
+
+// MARK: - 偏移与切换
+
+TEST_CASE(testFixedOffsetIsPlainArithmetic) {
+    const LocalCalendar calendar(8 * 60);
+    const std::int64_t t = 19'700LL * kMsPerDay + 16 * kMsPerHour - 1; // UTC 15:59:59.999 = 本地 23:59
+    CHECK_EQ(calendar.dayIndexFor(t), 19'700);
+    CHECK_EQ(calendar.dayIndexFor(t + 1), 19'701);
+    CHECK_EQ(calendar.locate(t).hour, 23);
+    CHECK_EQ(calendar.dayStartUtcMs(19'701), t + 1);
+    CHECK_EQ(calendar.locate(-1).dayIndex, 0); // 1970-01-01 08:00 之前仍是当天
+    CHECK(!calendar.hasTransitions());
+}
+
+TEST_CASE(testSpringForwardDayHasTwentyThreeHours) {
+    const auto calendar = easternCalendar(2020, 2026);
+    CHECK_EQ(calendar.offsetMsAt(kEasternSpringForward - 1), -5 * kMsPerHour);
+    CHECK_EQ(calendar.offsetMsAt(kEasternSpringForward), -4 * kMsPerHour);
+
+    CHECK_EQ(calendar.dayStartUtcMs(kMarch10), kEasternSpringForward - 2 * kMsPerHour);
+    CHECK_EQ(calendar.hourStartUtcMs(kMarch10, 24) - calendar.dayStartUtcMs(kMarch10), 23 * kMsPerHour);
+    // 02:00 被跳过：长度为 0，起点即 03:00 的起点
+    CHECK_EQ(calendar.hourStartUtcMs(kMarch10, 2), kEasternSpringForward);
+    CHECK_EQ(calendar.hourStartUtcMs(kMarch10, 3), kEasternSpringForward);
+    CHECK_EQ(calendar.locate(kEasternSpringForward - 1).hour, 1);
+    CHECK_EQ(calendar.locate(kEasternSpringForward).hour, 3);
+    CHECK_EQ(calendar.dayIndexFor(calendar.dayStartUtcMs(kMarch10) - 1), kMarch10 - 1);
+}
+
+TEST_CASE(testFallBackDayRepeatsOneHour) {
+    const auto calendar = easternCalendar(2020, 2026);
+    CHECK_EQ(calendar.hourStartUtcMs(kNovember3, 24) - calendar.dayStartUtcMs(kNovember3), 25 * kMsPerHour);
+    CHECK_EQ(calendar.hourStartUtcMs(kNovember3, 1), kEasternFallBack - kMsPerHour);
+    CHECK_EQ(calendar.hourStartUtcMs(kNovember3, 2), kEasternFallBack + kMsPerHour);
+    CHECK_EQ(calendar.locate(kEasternFallBack - 30 * kMsPerMinute).hour, 1);
+    CHECK_EQ(calendar.locate(kEasternFallBack + 30 * kMsPerMinute).hour, 1); // 第二次 01:30
+    CHECK_EQ(calendar.locate(kEasternFallBack + kMsPerHour).hour, 2);
+}
+
+TEST_CASE(testSouthernHemisphereStartsYearInDaylightTime) {
+    // 悉尼：4 月第 1 个周日 03:00 回到标准时间（+10），10 月第 1 个周日 02:00 进入夏令时（+11）
+    std::vector<TimeZoneYearRules> years;
+    for (int y = 2023; y <= 2025; ++y) {
+        TimeZoneYearRules r;
+        r.year = y;
+        r.standardOffsetMinutes = 10 * 60;
+        r.daylightOffsetMinutes = 11 * 60;
+        r.daylightStart = rule(10, 1, 2);
+        r.standardStart = rule(4, 1, 3);
+        years.push_back(r);
+    }
+    const auto calendar = LocalCalendar::fromYearRules(years);
+    CHECK_EQ(calendar.offsetMsAt(1'704'067'200'000), 11 * kMsPerHour); // 2024-01-01 00:00Z
+    CHECK_EQ(calendar.offsetMsAt(1'712'419'200'000 - 1), 11 * kMsPerHour); // 2024-04-06 16:00Z 前
+    CHECK_EQ(calendar.offsetMsAt(1'712'419'200'000), 10 * kMsPerHour);
+    CHECK_EQ(calendar.offsetMsAt(1'728'144'000'000), 11 * kMsPerHour); // 2024-10-05 16:00Z
+}
+
+// MARK: - 查表与逐时刻计算一致
+
+TEST_CASE(testTableAgreesWithTransitionSearch) {
+    // 规则覆盖 2010-2025，随机时刻落在 2000-2035：范围内走日期表，范围外走二分
+    const auto calendar = easternCalendar(2010, 2025);
+    std::mt19937_64 rng(14u);
+    std::uniform_int_distribution<std::int64_t> at(946'684'800'000, 2'082'758'400'000);
+    for (int i = 0; i < 200'000; ++i) {
+        const std::int64_t t = at(rng);
+        const std::int64_t local = t + calendar.offsetMsAt(t);
+        const auto p = calendar.locate(t);
+        CHECK_EQ(p.dayIndex, static_cast<std::int32_t>(floorDiv(local, kMsPerDay)));
+        CHECK_EQ(p.hour, static_cast<int>(floorDiv(local, kMsPerHour) % 24));
+        CHECK(calendar.hourStartUtcMs(p.dayIndex, p.hour) <= t);
+        CHECK(t < calendar.hourStartUtcMs(p.dayIndex, p.hour + 1) || p.hour == 23);
+    }
+}
+
+// MARK: - 统计路径共用
+
+TEST_CASE(testEngineAndHeatmapUseCalendar) {
+    const auto calendar = easternCalendar(2020, 2026);
+
+    StatisticsEngine engine;
+    engine.setCalendar(calendar);
+    StatisticsEvent e;
+    e.timestampMs = calendar.dayStartUtcMs(kMarch10) - kMsPerMinute; // 本地 3 月 9 日 23:59
+    engine.record(e);
+    e.timestampMs = kEasternSpringForward + 30 * kMsPerMinute;       // 本地 3 月 10 日 03:30
+    engine.record(e);
+    CHECK_EQ(engine.day(kMarch10 - 1).completedPomodoros, 1);
+    CHECK_EQ(engine.day(kMarch10).completedPomodoros, 1);
+
+    const auto binner = HeatmapBinner::forWeek(calendar, kMarch10);
+    CHECK_EQ(binner.windowEndMs() - binner.windowStartMs(), 7 * kMsPerDay - kMsPerHour);
+    HeatmapCube cube;
+    binner.bin(&e, 1, cube);
+    CHECK_EQ(cube.hourTotal(0, 3), 1u);
+    CHECK_EQ(cube.hourTotal(0, 2), 0u);
+}
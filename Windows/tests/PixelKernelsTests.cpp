@@ -0,0 +1,204 @@
+#include "TestHarness.h"
+
+#include "PixelKernels.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    const SimdLevel kAllLevels[] = { SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2, SimdLevel::Neon };
+
+    std::vector<std::uint8_t> makeNoise(std::size_t pixels, std::uint32_t seed) {
+        std::vector<std::uint8_t> out(pixels * 4);
+        for (auto& b : out) {
+            seed = seed * 1664525u + 1013904223u;
+            b = static_cast<std::uint8_t>(seed >> 24);
+        }
+        return out;
+    }
+
+    // 每个 (颜色, alpha) 组合各一个像素，B、G、R 取不同的组合
+    std::vector<std::uint8_t> makeAllPairs() {
+        std::vector<std::uint8_t> out(256 * 256 * 4);
+        for (unsigned i = 0; i < 256 * 256; ++i) {
+            const unsigned c = i & 0xFF;
+            out[i * 4 + 0] = static_cast<std::uint8_t>(c);
+            out[i * 4 + 1] = static_cast<std::uint8_t>(255 - c);
+            out[i * 4 + 2] = static_cast<std::uint8_t>((c * 7) & 0xFF);
+            out[i * 4 + 3] = static_cast<std::uint8_t>(i >> 8);
+        }
+        return out;
+    }
+
+} // namespace
+
+// MARK: - 标量参考
+
+TEST_CASE(testScalarPremultiplyIsRoundedDivision) {
+    const PixelKernels& k = *pixelKernelsFor(SimdLevel::Scalar);
+    const std::vector<std::uint8_t> src = makeAllPairs();
+    std::vector<std::uint8_t> dst(src.size());
+    k.premultiply(src.data(), dst.data(), src.size() / 4);
+    bool exact = true;
+    for (std::size_t i = 0; i < src.size(); i += 4) {
+        const unsigned a = src[i + 3];
+        for (int c = 0; c < 3; ++c) {
+            // 四舍五入的 c * a / 255
+            const unsigned expected = (2 * src[i + c] * a + 255) / 510;
+            exact = exact && dst[i + c] == expected;
+        }
+        exact = exact && dst[i + 3] == a;
+    }
+    CHECK(exact);
+}
+
+TEST_CASE(testScalarUnpremultiplyInvertsPremultiply) {
+    const PixelKernels& k = *pixelKernelsFor(SimdLevel::Scalar);
+    const std::vector<std::uint8_t> src = makeAllPairs();
+    std::vector<std::uint8_t> premultiplied(src.size());
+    std::vector<std::uint8_t> restored(src.size());
+    k.premultiply(src.data(), premultiplied.data(), src.size() / 4);
+    k.unpremultiply(premultiplied.data(), restored.data(), src.size() / 4);
+    int worstOpaqueHalf = 0;
+    bool opaqueExact = true;
+    bool transparentZero = true;
+    for (std::size_t i = 0; i < src.size(); i += 4) {
+        const unsigned a = src[i + 3];
+        for (int c = 0; c < 3; ++c) {
+            const int error = std::abs(static_cast<int>(restored[i + c]) - static_cast<int>(src[i + c]));
+            if (a == 255) opaqueExact = opaqueExact && error == 0;
+            if (a >= 128) worstOpaqueHalf = error > worstOpaqueHalf ? error : worstOpaqueHalf;
+            if (a == 0) transparentZero = transparentZero && restored[i + c] == 0;
+        }
+    }
+    CHECK(opaqueExact);
+    CHECK(worstOpaqueHalf <= 1);
+    CHECK(transparentZero);
+
+    // 非法输入（颜色 > alpha）限制到 255
+    const std::uint8_t invalid[4] = { 200, 10, 0, 100 };
+    std::uint8_t out[4] = {};
+    k.unpremultiply(invalid, out, 1);
+    CHECK_EQ(static_cast<int>(out[0]), 255);
+    CHECK_EQ(static_cast<int>(out[1]), 26);  // (10 * 255 + 50) / 100
+    CHECK_EQ(static_cast<int>(out[2]), 0);
+    CHECK_EQ(static_cast<int>(out[3]), 100);
+}
+
+TEST_CASE(testScalarOpaqueScaleAndFill) {
+    const PixelKernels& k = *pixelKernelsFor(SimdLevel::Scalar);
+    const std::uint8_t bgrx[8] = { 1, 2, 3, 0, 250, 251, 252, 17 };
+    std::uint8_t out[8] = {};
+    k.bgrxToBgraOpaque(bgrx, out, 2);
+    const std::uint8_t opaque[8] = { 1, 2, 3, 255, 250, 251, 252, 255 };
+    bool same = true;
+    for (int i = 0; i < 8; ++i) same = same && out[i] == opaque[i];
+    CHECK(same);
+
+    // 半透明：所有通道（含 alpha）乘 128 / 255 并四舍五入
+    const std::uint8_t premultiplied[4] = { 100, 0, 255, 255 };
+    k.scaleAlpha(premultiplied, out, 1, 128);
+    CHECK_EQ(static_cast<int>(out[0]), 50);
+    CHECK_EQ(static_cast<int>(out[1]), 0);
+    CHECK_EQ(static_cast<int>(out[2]), 128);
+    CHECK_EQ(static_cast<int>(out[3]), 128);
+    k.scaleAlpha(premultiplied, out, 1, 255);
+    CHECK_EQ(static_cast<int>(out[0]), 100);
+    CHECK_EQ(static_cast<int>(out[3]), 255);
+
+    k.fill(out, 2, 0x80112233u);
+    const std::uint8_t filled[8] = { 0x33, 0x22, 0x11, 0x80, 0x33, 0x22, 0x11, 0x80 };
+    same = true;
+    for (int i = 0; i < 8; ++i) same = same && out[i] == filled[i];
+    CHECK(same);
+}
+
+// MARK: - 向量实现
+
+TEST_CASE(testLevelsAvailability) {
+    for (const SimdLevel level : kAllLevels) {
+        CHECK_EQ(pixelKernelsFor(level) != nullptr, simdLevelSupported(level));
+    }
+    CHECK(pixelKernelsFor(SimdLevel::Scalar) != nullptr);
+    CHECK(pixelKernels().premultiply != nullptr);
+}
+
+TEST_CASE(testSimdMatchesScalar) {
+    // 覆盖行尾（不足一个向量宽度）与整块；每个长度都检查缓冲区末尾之后没有被写入
+    const std::size_t counts[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 64, 1003 };
+    const PixelKernels& scalar = *pixelKernelsFor(SimdLevel::Scalar);
+    std::uint32_t seed = 99;
+    for (const SimdLevel level : kAllLevels) {
+        const PixelKernels* k = pixelKernelsFor(level);
+        if (!k) continue;
+        for (const std::size_t n : counts) {
+            const std::vector<std::uint8_t> src = makeNoise(n, seed++);
+            const std::size_t guard = 64;
+            std::vector<std::uint8_t> expected(n * 4 + guard, 0xA5);
+            std::vector<std::uint8_t> actual(n * 4 + guard, 0xA5);
+
+            scalar.bgrxToBgraOpaque(src.data(), expected.data(), n);
+            k->bgrxToBgraOpaque(src.data(), actual.data(), n);
+            CHECK(actual == expected);
+
+            scalar.premultiply(src.data(), expected.data(), n);
+            k->premultiply(src.data(), actual.data(), n);
+            CHECK(actual == expected);
+
+            scalar.unpremultiply(src.data(), expected.data(), n);
+            k->unpremultiply(src.data(), actual.data(), n);
+            CHECK(actual == expected);
+
+            for (const std::uint8_t alpha : { std::uint8_t{ 0 }, std::uint8_t{ 1 }, std::uint8_t{ 127 }, std::uint8_t{ 200 }, std::uint8_t{ 255 } }) {
+                scalar.scaleAlpha(src.data(), expected.data(), n, alpha);
+                k->scaleAlpha(src.data(), actual.data(), n, alpha);
+                CHECK(actual == expected);
+            }
+
+            scalar.fill(expected.data(), n, 0xDEADBEEFu);
+            k->fill(actual.data(), n, 0xDEADBEEFu);
+            CHECK(actual == expected);
+
+            bool guardIntact = true;
+            for (std::size_t i = n * 4; i < actual.size(); ++i) guardIntact = guardIntact && actual[i] == 0xA5;
+            CHECK(guardIntact);
+        }
+    }
+}
+
+TEST_CASE(testSimdExhaustiveAlphaPairs) {
+    // 所有 (颜色, alpha) 组合：舍入除法与浮点除法路径在每个取值上都与标量一致
+    const std::vector<std::uint8_t> src = makeAllPairs();
+    const std::size_t n = src.size() / 4;
+    const PixelKernels& scalar = *pixelKernelsFor(SimdLevel::Scalar);
+    std::vector<std::uint8_t> expected(src.size());
+    std::vector<std::uint8_t> actual(src.size());
+    for (const SimdLevel level : kAllLevels) {
+        const PixelKernels* k = pixelKernelsFor(level);
+        if (!k) continue;
+        scalar.premultiply(src.data(), expected.data(), n);
+        k->premultiply(src.data(), actual.data(), n);
+        CHECK(actual == expected);
+        scalar.unpremultiply(src.data(), expected.data(), n);
+        k->unpremultiply(src.data(), actual.data(), n);
+        CHECK(actual == expected);
+    }
+}
+
+TEST_CASE(testInPlace) {
+    const std::vector<std::uint8_t> src = makeNoise(257, 5);
+    const PixelKernels& scalar = *pixelKernelsFor(SimdLevel::Scalar);
+    std::vector<std::uint8_t> expected(src.size());
+    scalar.premultiply(src.data(), expected.data(), 257);
+    for (const SimdLevel level : kAllLevels) {
+        const PixelKernels* k = pixelKernelsFor(level);
+        if (!k) continue;
+        std::vector<std::uint8_t> buffer = src;
+        k->premultiply(buffer.data(), buffer.data(), 257);
+        CHECK(buffer == expected);
+    }
+}
@@ -0,0 +1,79 @@
+#include "TestHarness.h"
+
+#include "PomodoroSimulator.h"
+
+using namespace pomodoro;
+using namespace pomodoro::sim;
+
+namespace {
+
+    SimulationConfig autoConfig(int days, std::uint64_t seed) {
+        SimulationConfig c;
+        c.days = days;
+        c.seed = seed;
+        c.timerSettings.idleRestartEnabled = true;
+        c.timerSettings.screenLockRestartEnabled = true;
+        c.timerSettings.screensaverRestartEnabled = true;
+        c.timerSettings.stayUpLimitEnabled = true;
+        return c;
+    }
+
+    int workdays(int days) {
+        int n = 0;
+        for (int d = 0; d < days; ++d) {
+            if (d % 7 < 5) ++n;
+        }
+        return n;
+    }
+
+} // namespace
+
+TEST_CASE(testSameSeedIsDeterministic) {
+    const auto a = PomodoroSimulator(autoConfig(14, 7)).run();
+    const auto b = PomodoroSimulator(autoConfig(14, 7)).run();
+
+    CHECK_EQ(a.eventsProcessed, b.eventsProcessed);
+    CHECK_EQ(a.timerWakeups, b.timerWakeups);
+    CHECK_EQ(a.pomodorosCompleted, b.pomodorosCompleted);
+    CHECK_EQ(a.restsCompleted, b.restsCompleted);
+    CHECK_EQ(a.restsCancelled, b.restsCancelled);
+    CHECK_EQ(a.forcedSleepsEntered, b.forcedSleepsEntered);
+    CHECK(a.simulatedTime == std::chrono::hours(24 * 14));
+}
+
+TEST_CASE(testWorkdaysProducePomodorosAndRests) {
+    const auto r = PomodoroSimulator(autoConfig(7, 3)).run();
+    CHECK(r.eventsProcessed > 0);
+    CHECK(r.pomodorosCompleted > 0);
+    CHECK(r.restsCompleted + r.restsCancelled > 0);
+}
+
+TEST_CASE(testEveryStayUpNightEntersAndLeavesForcedSleep) {
+    auto config = autoConfig(21, 11);
+    config.stayUpNightProbability = 1.0;
+    const auto r = PomodoroSimulator(config).run();
+
+    CHECK_EQ(r.forcedSleepsEntered, workdays(21));
+    CHECK_EQ(r.forcedSleepsEnded, workdays(21));
+}
+
+TEST_CASE(testStayUpLimitDisabledNeverForcesSleep) {
+    auto config = autoConfig(7, 5);
+    config.stayUpNightProbability = 1.0;
+    config.timerSettings.stayUpLimitEnabled = false;
+    const auto r = PomodoroSimulator(config).run();
+    CHECK_EQ(r.forcedSleepsEntered, 0);
+}
+
+TEST_CASE(testDisplayModeWakesEverySecondWithoutChangingPhases) {
+    auto fast = autoConfig(2, 9);
+    auto display = fast;
+    display.emitTimeDisplay = true;
+
+    const auto a = PomodoroSimulator(fast).run();
+    const auto b = PomodoroSimulator(display).run();
+    CHECK_EQ(a.pomodorosCompleted, b.pomodorosCompleted);
+    CHECK_EQ(a.restsCompleted, b.restsCompleted);
+    CHECK(b.timerWakeups > a.timerWakeups);
+    CHECK(b.timeDisplayUpdates > 0);
+}
@@ -0,0 +1,222 @@
+#include "TestHarness.h"
+
+#include "PomodoroTimer.h"
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    PomodoroTimer::Settings shortSettings() {
+        PomodoroTimer::Settings s;
+        s.pomodoroMinutes = 25;
+        s.breakMinutes = 3;
+        return s;
+    }
+
+} // namespace
+
+// MARK: - 截止时间与唤醒时刻
+
+TEST_CASE(testIdleTimerHasNoWakeup) {
+    PomodoroTimer timer;
+    CHECK(!timer.isRunning());
+    CHECK(timer.nextWakeup() == PomodoroTimer::Clock::time_point::max());
+}
+
+TEST_CASE(testStartSchedulesWakeupWithinOneSecond) {
+    PomodoroTimer timer;
+    timer.updateSettings(shortSettings());
+
+    std::vector<std::string> shown;
+    timer.onTimeUpdate = [&shown](std::string_view text) { shown.emplace_back(text); };
+
+    const auto before = PomodoroTimer::Clock::now();
+    timer.start();
+    const auto wake = timer.nextWakeup();
+
+    CHECK(timer.isRunning());
+    CHECK_EQ(timer.remainingSeconds(), 25 * 60);
+    CHECK(!shown.empty() && shown.back() == "25:00");
+    CHECK(wake > before);
+    CHECK(wake <= PomodoroTimer::Clock::now() + std::chrono::seconds(1));
+
+    // 提前调用 tick 不会产生重复的显示更新
+    const auto count = shown.size();
+    timer.tick();
+    CHECK_EQ(shown.size(), count);
+}
+
+TEST_CASE(testPauseFreezesRemainingAndClearsWakeup) {
+    PomodoroTimer timer;
+    timer.updateSettings(shortSettings());
+    timer.start();
+    timer.pause();
+
+    CHECK(!timer.isRunning());
+    CHECK(timer.isPausedState());
+    CHECK_EQ(timer.remainingSeconds(), 25 * 60);
+    CHECK(timer.nextWakeup() == PomodoroTimer::Clock::time_point::max());
+
+    timer.resume();
+    CHECK(timer.isRunning());
+    CHECK(timer.nextWakeup() != PomodoroTimer::Clock::time_point::max());
+}
+
+TEST_CASE(testFinishNowEntersRestWithBreakDeadline) {
+    PomodoroTimer timer;
+    timer.updateSettings(shortSettings());
+
+    int finished = 0;
+    timer.onTimerFinished = [&finished]() { ++finished; };
+
+    timer.start();
+    timer.finishNow();
+
+    CHECK_EQ(finished, 1);
+    CHECK(timer.isInRestPeriod());
+    CHECK(timer.isRestTimerRunning());
+    CHECK_EQ(timer.remainingSeconds(), 3 * 60);
+}
+
+// MARK: - 虚拟时钟
+
+TEST_CASE(testVirtualClockAdvancesDisplayBySecond) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    timer.updateSettings(shortSettings());
+
+    std::vector<std::string> shown;
+    timer.onTimeUpdate = [&shown](std::string_view text) { shown.emplace_back(text); };
+
+    timer.start();
+    CHECK(timer.nextWakeup() == clock.now() + std::chrono::seconds(1));
+
+    clock.advance(std::chrono::seconds(1));
+    timer.tick();
+    CHECK(!shown.empty() && shown.back() == "24:59");
+    CHECK(timer.nextWakeup() == clock.now() + std::chrono::seconds(1));
+}
+
+TEST_CASE(testLateWakeupDoesNotDrift) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    timer.updateSettings(shortSettings());
+    timer.start();
+    const auto deadline = timer.phaseDeadline();
+
+    // 宿主迟到 1.7 秒才唤醒：剩余时间按截止时间计算，不累计误差
+    clock.advance(std::chrono::milliseconds(1700));
+    timer.tick();
+    CHECK_EQ(timer.remainingSeconds(), 25 * 60 - 1);
+    CHECK(timer.phaseDeadline() == deadline);
+    CHECK(timer.nextWakeup() == deadline - std::chrono::seconds(25 * 60 - 2));
+}
+
+TEST_CASE(testPhaseFinishesExactlyAtDeadline) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    timer.updateSettings(shortSettings());
+
+    int finished = 0;
+    timer.onTimerFinished = [&finished]() { ++finished; };
+
+    timer.start();
+    const auto deadline = timer.phaseDeadline();
+    CHECK(deadline == clock.now() + std::chrono::minutes(25));
+
+    clock.advanceTo(deadline - std::chrono::milliseconds(1));
+    timer.tick();
+    CHECK_EQ(finished, 0);
+    CHECK_EQ(timer.remainingSeconds(), 1);
+
+    clock.advanceTo(deadline);
+    timer.tick();
+    CHECK_EQ(finished, 1);
+    CHECK(timer.isInRestPeriod());
+}
+
+TEST_CASE(testPausedTimerIgnoresVirtualTime) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    timer.updateSettings(shortSettings());
+    timer.start();
+    clock.advance(std::chrono::minutes(5));
+    timer.pause();
+
+    clock.advance(std::chrono::hours(3));
+    timer.tick();
+    CHECK_EQ(timer.remainingSeconds(), 20 * 60);
+
+    timer.resume();
+    CHECK(timer.phaseDeadline() == clock.now() + std::chrono::minutes(20));
+}
+
+// MARK: - 批量系统事件
+
+TEST_CASE(testSystemEventBatchMatchesOneByOne) {
+    PomodoroTimer::Settings settings = shortSettings();
+    settings.idleRestartEnabled = true;
+    settings.idleActionIsRestart = false;
+    settings.screenLockRestartEnabled = true;
+    settings.screenLockActionIsRestart = false;
+    settings.screensaverRestartEnabled = true;
+    settings.stayUpLimitEnabled = true;
+
+    using E = AutoRestartEvent;
+    const E systemEvents[] = { E::IdleTimeExceeded, E::UserActivityDetected, E::UserActivityDetected,
+        E::UserActivityDetected, E::ScreenLocked, E::ScreenUnlocked, E::ScreensaverStarted,
+        E::ScreensaverStopped, E::ForcedSleepTriggered, E::ForcedSleepEnded };
+
+    VirtualClock clock;
+    PomodoroTimer single(clock);
+    PomodoroTimer batched(clock);
+    single.updateSettings(settings);
+    batched.updateSettings(settings);
+
+    std::vector<std::string> shownSingle, shownBatched;
+    single.onTimeUpdate = [&](std::string_view text) { shownSingle.emplace_back(text); };
+    batched.onTimeUpdate = [&](std::string_view text) { shownBatched.emplace_back(text); };
+    single.start();
+    batched.start();
+
+    std::mt19937 rng(99u);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(std::size(systemEvents)) - 1);
+    std::uniform_int_distribution<int> runDist(1, 20);
+    for (int batch = 0; batch < 200; ++batch) {
+        std::vector<E> events;
+        while (events.size() < 64) {
+            const E event = systemEvents[pick(rng)];
+            for (int n = runDist(rng); n > 0; --n) events.push_back(event);
+        }
+
+        for (const E event : events) {
+            switch (event) {
+            case E::IdleTimeExceeded: single.onIdleTimeExceeded(); break;
+            case E::UserActivityDetected: single.onUserActivity(); break;
+            case E::ScreenLocked: single.onScreenLocked(); break;
+            case E::ScreenUnlocked: single.onScreenUnlocked(); break;
+            case E::ScreensaverStarted: single.onScreensaverStarted(); break;
+            case E::ScreensaverStopped: single.onScreensaverStopped(); break;
+            case E::ForcedSleepTriggered: single.onForcedSleepTriggered(); break;
+            case E::ForcedSleepEnded: single.onForcedSleepEnded(); break;
+            default: break;
+            }
+        }
+        batched.onSystemEvents(events.data(), events.size());
+
+        CHECK_EQ(batched.isRunning(), single.isRunning());
+        CHECK_EQ(batched.isPausedState(), single.isPausedState());
+        CHECK_EQ(batched.isInForcedSleep(), single.isInForcedSleep());
+        CHECK_EQ(batched.remainingSeconds(), single.remainingSeconds());
+
+        clock.advance(std::chrono::milliseconds(700));
+        single.tick();
+        batched.tick();
+    }
+    CHECK(shownBatched == shownSingle);
+}
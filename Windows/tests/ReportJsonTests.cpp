@@ -0,0 +1,183 @@
+#include "TestHarness.h"
+
+#include "JsonWriter.h"
+#include "ReportJson.h"
+#include "StatisticsEngine.h"
+#include "StatisticsHeatmap.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerMinute = 60'000;
+    constexpr std::int64_t kMsPerHour = 60 * kMsPerMinute;
+    constexpr std::int64_t kMsPerDay = 24 * kMsPerHour;
+    constexpr std::int32_t kDay = 19'800; // 2024-03-18（周一）
+
+    StatisticsEvent makeEvent(StatisticsEventType type, std::int64_t at, std::uint32_t durationMs = 0) {
+        StatisticsEvent e;
+        e.type = type;
+        e.timestampMs = at;
+        e.durationMs = durationMs;
+        return e;
+    }
+
+    bool contains(std::string_view text, std::string_view part) {
+        return text.find(part) != std::string_view::npos;
+    }
+
+} // namespace
+
+// MARK: - JsonWriter
+
+TEST_CASE(testWriterNestingAndCommas) {
+    JsonWriter w;
+    w.beginObject();
+    w.field("a", 1);
+    w.key("b").beginArray().value(true).value(false).null().beginObject().endObject().beginArray().endArray().endArray();
+    w.field("c", "x");
+    w.endObject();
+    CHECK_EQ(std::string(w.view()), std::string(R"({"a":1,"b":[true,false,null,{},[]],"c":"x"})"));
+}
+
+TEST_CASE(testWriterEscapesStrings) {
+    JsonWriter w;
+    w.value(std::string_view("q\"b\\n\nt\tc\x01", 10));
+    CHECK_EQ(std::string(w.view()), std::string(R"("q\"b\\n\nt\tc\u0001")"));
+}
+
+TEST_CASE(testWriterNumbers) {
+    JsonWriter w;
+    w.beginArray();
+    w.value(std::int64_t(-9'007'199'254'740'993LL));
+    w.value(0.5);
+    w.value(1500.0);
+    w.value(std::numeric_limits<double>::quiet_NaN());
+    w.value(std::numeric_limits<double>::infinity());
+    w.endArray();
+    CHECK_EQ(std::string(w.view()), std::string("[-9007199254740993,0.5,1500,null,null]"));
+}
+
+TEST_CASE(testWriterResetKeepsCapacity) {
+    JsonWriter w;
+    w.beginArray();
+    for (int i = 0; i < 1000; ++i) w.value(i);
+    w.endArray();
+    const std::size_t capacity = w.capacity();
+    w.reset();
+    CHECK_EQ(w.size(), std::size_t(0));
+    CHECK_EQ(w.capacity(), capacity);
+    w.beginObject().field("k", 1).endObject();
+    CHECK_EQ(std::string(w.view()), std::string(R"({"k":1})"));
+}
+
+// MARK: - reportData
+
+TEST_CASE(testReportDailyAndWeekly) {
+    StatisticsEngine statistics(480); // UTC+8
+    const std::int64_t dayStart = kDay * kMsPerDay - 8 * kMsPerHour;
+    for (int i = 0; i < 4; ++i) {
+        statistics.record(makeEvent(StatisticsEventType::PomodoroCompleted, dayStart + (9 + i) * kMsPerHour, 25 * 60'000));
+        statistics.record(makeEvent(StatisticsEventType::ShortBreakStarted, dayStart + (9 + i) * kMsPerHour + kMsPerMinute));
+        statistics.record(makeEvent(StatisticsEventType::BreakFinished, dayStart + (9 + i) * kMsPerHour + 6 * kMsPerMinute, 5 * 60'000));
+    }
+    StatisticsEvent cancel = makeEvent(StatisticsEventType::BreakCancelled, dayStart + 14 * kMsPerHour);
+    cancel.flags = StatisticsEvent::kFlagUserSource;
+    statistics.record(cancel);
+    StatisticsEvent mood = makeEvent(StatisticsEventType::MoodUpdated, dayStart + 20 * kMsPerHour);
+    mood.moodLevel = 3;
+    statistics.record(mood);
+
+    ReportRequest request;
+    request.firstDay = kDay - 6;
+    request.lastDay = kDay;
+    request.configuration.stayUpLimitEnabled = true;
+
+    JsonWriter w;
+    writeReportJson(w, statistics, request);
+    const std::string_view json = w.view();
+
+    // 本地零点 = 前一天 16:00 UTC
+    CHECK(contains(json, R"("daily":{"date":"2024-03-17T16:00:00Z","completedPomodoros":4,"totalWorkTime":6000,)"));
+    CHECK(contains(json, R"("shortBreakCount":4,"longBreakCount":0,"totalBreakTime":1200,"cancelledBreakCount":1,)"));
+    CHECK(contains(json, R"("moodLevel":3,"moodNote":null,"moodUpdatedAt":"2024-03-18T12:00:00Z",)"));
+    CHECK(contains(json, R"("weekly":{"weekStartDate":"2024-03-11T16:00:00Z","totalPomodoros":4,)"));
+    // 只有一天有数据：平均值就是当天评分
+    CHECK(contains(json, R"("averageWorkIntensity":)"));
+    CHECK(contains(json, R"("moodIndex":50})"));
+    CHECK(contains(json, R"("moodIndex":null})"));
+    CHECK(contains(json, R"("heatmapData":[]})"));
+    CHECK(contains(json, R"("stayUpLimitEnabled":true,"stayUpStartHour":23,"stayUpStartMinute":0,"stayUpEndHour":6,"stayUpEndMinute":0}})"));
+
+    // 趋势每天一项
+    std::size_t entries = 0;
+    for (std::size_t at = json.find("\"breakCount\""); at != std::string_view::npos; at = json.find("\"breakCount\"", at + 1)) ++entries;
+    CHECK_EQ(entries, std::size_t(7));
+}
+
+TEST_CASE(testReportEmptyRangeDefaults) {
+    StatisticsEngine statistics;
+    ReportRequest request;
+    request.firstDay = kDay;
+    request.lastDay = kDay;
+
+    JsonWriter w;
+    writeReportJson(w, statistics, request);
+    const std::string_view json = w.view();
+    CHECK(contains(json, R"("moodLevel":null,"moodNote":null,"moodUpdatedAt":null,)"));
+    CHECK(contains(json, R"("averageWorkIntensity":0,"averageHealthScore":20,)"));
+    CHECK(contains(json, R"("healthScore":20})"));
+}
+
+TEST_CASE(testReportHeatmap) {
+    StatisticsEngine statistics;
+    const std::int64_t dayStart = kDay * kMsPerDay;
+    const StatisticsEvent events[] = {
+        makeEvent(StatisticsEventType::PomodoroCompleted, dayStart + 9 * kMsPerHour + 1),
+        makeEvent(StatisticsEventType::PomodoroCompleted, dayStart + 9 * kMsPerHour + 2),
+        makeEvent(StatisticsEventType::ShortBreakStarted, dayStart + 9 * kMsPerHour + 3),
+        makeEvent(StatisticsEventType::BreakFinished, dayStart + 9 * kMsPerHour + 4),     // 不计入
+        makeEvent(StatisticsEventType::ScreenLocked, dayStart + 2 * kMsPerDay + 23 * kMsPerHour),
+        makeEvent(StatisticsEventType::StayUpLateActivity, dayStart + 2 * kMsPerDay + 23 * kMsPerHour),
+    };
+    HeatmapCube cube;
+    HeatmapBinner::forWeek(statistics.calendar(), kDay).bin(events, sizeof(events) / sizeof(events[0]), cube);
+
+    ReportRequest request;
+    request.firstDay = kDay;
+    request.lastDay = kDay + 6;
+    request.heatmapFirstDay = kDay;
+    request.heatmap = &cube;
+
+    JsonWriter w;
+    writeReportJson(w, statistics, request);
+    const std::string_view json = w.view();
+    CHECK(contains(json, R"("heatmapData":[{"date":"2024-03-18","dayOffset":0,"activities":{"hour_9":{"timestamp":"2024-03-18T09:00:00Z","hour":9,"primaryActivity":"pomodoro","totalActivities":3,"activities":{"pomodoro":2,"break":1}}}},)"));
+    // 并列时取前一个类别
+    CHECK(contains(json, R"({"date":"2024-03-20","dayOffset":2,"activities":{"hour_23":{"timestamp":"2024-03-20T23:00:00Z","hour":23,"primaryActivity":"interruption","totalActivities":2,"activities":{"interruption":1,"late_night":1}}}}])"));
+}
+
+TEST_CASE(testReportReusesBuffer) {
+    StatisticsEngine statistics;
+    for (int d = 0; d < 30; ++d) {
+        statistics.record(makeEvent(StatisticsEventType::PomodoroCompleted, (kDay - d) * kMsPerDay + 10 * kMsPerHour, 25 * 60'000));
+    }
+    ReportRequest request;
+    request.firstDay = kDay - 29;
+    request.lastDay = kDay;
+
+    JsonWriter w;
+    writeReportJson(w, statistics, request);
+    const std::string first(w.view());
+    const std::size_t capacity = w.capacity();
+    w.reset();
+    writeReportJson(w, statistics, request);
+    CHECK_EQ(std::string(w.view()), first);
+    CHECK_EQ(w.capacity(), capacity);
+}
@@ -0,0 +1,334 @@
+#include "TestHarness.h"
+
+#include "StatisticsCompactor.h"
+#include "StatisticsEngine.h"
+#include "StatisticsEventStore.h"
+#include "StatisticsHeatmap.h"
+#include "StatisticsRollups.h"
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerMinute = 60'000;
+    constexpr std::int64_t kMsPerHour = 60 * kMsPerMinute;
+    constexpr std::int64_t kMsPerDay = 24 * kMsPerHour;
+    constexpr std::int32_t kFirstDay = 19'500;
+    constexpr int kDays = 200;
+
+    std::filesystem::path tempDir(const char* name) {
+        auto dir = std::filesystem::temp_directory_path() / (std::string("pomodoro_") + name);
+        std::filesystem::remove_all(dir);
+        return dir;
+    }
+
+    StatisticsEventStore::Options smallSegments() {
+        StatisticsEventStore::Options o;
+        o.segmentRecords = 64;
+        o.indexStride = 8;
+        return o;
+    }
+
+    // 每天若干个工作小时内的随机事件（含跨日的熬夜时段），按时间排序
+    std::vector<StatisticsEvent> syntheticHistory(std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> perDay(0, 12);
+        std::uniform_int_distribution<std::int64_t> offset(8 * kMsPerHour, 26 * kMsPerHour);
+        std::uniform_int_distribution<int> type(0, static_cast<int>(kStatisticsEventTypeCount) - 1);
+        std::uniform_int_distribution<int> mood(1, 6);
+
+        std::vector<StatisticsEvent> events;
+        std::int64_t last = 0;
+        for (int d = 0; d < kDays; ++d) {
+            const int n = perDay(rng);
+            std::vector<std::int64_t> at;
+            for (int i = 0; i < n; ++i) at.push_back((kFirstDay + d) * kMsPerDay + offset(rng));
+            std::sort(at.begin(), at.end());
+            for (const auto t : at) {
+                StatisticsEvent e;
+                e.timestampMs = (std::max)(t, last);
+                e.type = static_cast<StatisticsEventType>(type(rng));
+                e.durationMs = 25 * 60'000;
+                e.flags = StatisticsEvent::kFlagUserSource;
+                if (e.type == StatisticsEventType::MoodUpdated) e.moodLevel = static_cast<std::uint8_t>(mood(rng));
+                last = e.timestampMs;
+                events.push_back(e);
+            }
+        }
+        return events;
+    }
+
+    bool sameDay(const DailyStatistics& a, const DailyStatistics& b) {
+        return std::memcmp(&a, &b, sizeof(DailyStatistics)) == 0;
+    }
+
+    bool sameCube(const HeatmapCube& a, const HeatmapCube& b) {
+        for (int d = 0; d < kHeatmapDays; ++d) {
+            for (int h = 0; h < kHeatmapHours; ++h) {
+                for (std::size_t t = 0; t < kStatisticsEventTypeCount; ++t) {
+                    const auto type = static_cast<StatisticsEventType>(t);
+                    if (a.count(d, h, type) != b.count(d, h, type)) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+// MARK: - 汇总
+
+TEST_CASE(testRollupsSplitByLocalDayAndHour) {
+    const LocalCalendar calendar(480); // UTC+8
+    const std::int64_t dayStart = kFirstDay * kMsPerDay - 8 * kMsPerHour;
+
+    StatisticsEvent a;
+    a.timestampMs = dayStart + 9 * kMsPerHour + 5 * kMsPerMinute;
+    a.durationMs = 25 * 60'000;
+    StatisticsEvent b = a;
+    b.timestampMs += 30 * kMsPerMinute;
+    StatisticsEvent c = a;
+    c.timestampMs = dayStart + kMsPerDay + 1;  // 次日 00:00
+    c.type = StatisticsEventType::BreakFinished;
+    c.durationMs = 5 * 60'000;
+
+    // 分两次并入：同一小时的两部分合并为一条
+    StatisticsRollups rollups;
+    rollups.addEvents(&a, 1, calendar);
+    const StatisticsEvent rest[] = { b, c };
+    rollups.addEvents(rest, 2, calendar);
+
+    CHECK_EQ(rollups.daily().size(), std::size_t(2));
+    CHECK_EQ(rollups.daily()[0].dayIndex, kFirstDay);
+    CHECK_EQ(rollups.daily()[0].completedPomodoros, 2);
+    CHECK_EQ(rollups.daily()[1].totalBreakMs, std::int64_t(5 * 60'000));
+
+    CHECK_EQ(rollups.hourly().size(), std::size_t(2));
+    const HourlyRollup& nine = rollups.hourly()[0];
+    CHECK_EQ(nine.hourStartUtcMs, dayStart + 9 * kMsPerHour);
+    CHECK_EQ(nine.hour, 9);
+    CHECK_EQ(nine.counts[0], std::uint16_t(2));
+    CHECK_EQ(nine.workMs, std::uint32_t(50 * 60'000));
+    CHECK_EQ(rollups.hourly()[1].dayIndex, kFirstDay + 1);
+    CHECK_EQ(rollups.hourly()[1].hour, 0);
+    CHECK_EQ(rollups.hourlyLowerBound(dayStart + 9 * kMsPerHour + 1), std::size_t(1));
+}
+
+TEST_CASE(testRollupsSaveAndLoad) {
+    const auto dir = tempDir("rollups_file");
+    std::filesystem::create_directories(dir);
+    const auto path = dir / "rollups.bin";
+
+    StatisticsRollups empty;
+    CHECK(empty.load(path)); // 文件不存在：空汇总
+    CHECK(empty.daily().empty());
+
+    const auto events = syntheticHistory(3u);
+    StatisticsRollups rollups;
+    rollups.addEvents(events.data(), events.size(), LocalCalendar(-300));
+    rollups.setFirstRawSegment(7);
+    CHECK(rollups.save(path));
+    CHECK(!std::filesystem::exists(dir / "rollups.bin.tmp"));
+
+    StatisticsRollups loaded;
+    CHECK(loaded.load(path));
+    CHECK_EQ(loaded.firstRawSegment(), std::size_t(7));
+    CHECK_EQ(loaded.daily().size(), rollups.daily().size());
+    CHECK_EQ(loaded.hourly().size(), rollups.hourly().size());
+    CHECK(std::memcmp(loaded.hourly().data(), rollups.hourly().data(), rollups.hourly().size() * sizeof(HourlyRollup)) == 0);
+
+    // 截断的文件视为损坏
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    CHECK(!loaded.load(path));
+    CHECK(loaded.daily().empty());
+}
+
+// MARK: - 压缩
+
+TEST_CASE(testCompactionPreservesDailyAndHeatmapQueries) {
+    const auto dir = tempDir("compactor_queries");
+    const LocalCalendar calendar(120);
+    const auto events = syntheticHistory(11u);
+
+    StatisticsEventStore store;
+    CHECK(store.open(dir, smallSegments()));
+    for (const auto& e : events) CHECK(store.append(e));
+    const std::size_t segmentsBefore = store.sealedSegmentCount();
+
+    StatisticsRollups rollups;
+    StatisticsCompactor compactor(store, rollups, dir / "rollups.bin");
+    compactor.setCalendar(calendar);
+    StatisticsCompactor::Policy policy;
+    policy.rawRetentionDays = 60;
+    policy.hourlyRetentionDays = 0;
+    compactor.setPolicy(policy);
+
+    const std::int64_t now = (kFirstDay + kDays) * kMsPerDay;
+    CHECK(compactor.start(now));
+    CHECK(compactor.finish());
+    CHECK(!compactor.busy());
+
+    // 旧分段已删除，剩余的原始事件都不早于保留期之前的最后一个分段
+    CHECK(store.sealedSegmentCount() < segmentsBefore);
+    CHECK(store.firstSegmentNumber() > 0);
+    CHECK_EQ(rollups.firstRawSegment(), store.firstSegmentNumber());
+    CHECK(!std::filesystem::exists(dir / "events-000000.seg"));
+    CHECK(store.at(0).timestampMs < calendar.dayStartUtcMs(calendar.dayIndexFor(now) - 60));
+    std::size_t compacted = 0;
+    for (const auto& h : rollups.hourly()) {
+        for (auto n : h.counts) compacted += n;
+    }
+    CHECK_EQ(compacted + store.size(), events.size());
+
+    // 日汇总：汇总 + 剩余原始事件 == 全部原始事件
+    StatisticsEngine expected;
+    expected.setCalendar(calendar);
+    for (const auto& e : events) expected.record(e);
+    StatisticsEngine restored;
+    restored.setCalendar(calendar);
+    for (const auto& d : rollups.daily()) restored.restoreDay(d);
+    store.visit(0, store.size(), [&restored](const StatisticsEvent* records, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) restored.record(records[i]);
+    });
+    for (std::int32_t d = kFirstDay - 1; d <= kFirstDay + kDays + 1; ++d) CHECK(sameDay(restored.day(d), expected.day(d)));
+
+    // 热力图：覆盖压缩边界前后的每个窗口
+    for (std::int32_t first = kFirstDay; first < kFirstDay + kDays; first += 5) {
+        const auto binner = HeatmapBinner::forWeek(calendar, first);
+        HeatmapCube raw;
+        binner.bin(events.data(), events.size(), raw);
+        HeatmapCube mixed;
+        binHeatmapWindow(binner, rollups, store, mixed);
+        CHECK(sameCube(raw, mixed));
+    }
+
+    // 没有新的可压缩分段时不启动
+    CHECK(!compactor.start(now));
+}
+
+TEST_CASE(testAppendsContinueWhileCompacting) {
+    const auto dir = tempDir("compactor_concurrent");
+    const auto events = syntheticHistory(23u);
+    const std::size_t half = events.size() / 2;
+
+    StatisticsEventStore store;
+    CHECK(store.open(dir, smallSegments()));
+    for (std::size_t i = 0; i < half; ++i) store.append(events[i]);
+
+    StatisticsRollups rollups;
+    StatisticsCompactor compactor(store, rollups, dir / "rollups.bin");
+    StatisticsCompactor::Policy policy;
+    policy.rawRetentionDays = 1;
+    compactor.setPolicy(policy);
+    std::atomic<int> completions{ 0 };
+    compactor.setCompletionHandler([&completions]() { completions.fetch_add(1); });
+    CHECK(compactor.start((kFirstDay + kDays) * kMsPerDay));
+
+    // 后台线程读取已写满的分段，同时继续追加（会创建新分段）
+    for (std::size_t i = half; i < events.size(); ++i) CHECK(store.append(events[i]));
+    while (!compactor.poll()) std::this_thread::yield();
+    // 完成通知在结果可提交之后发出，每次压缩一次
+    CHECK_EQ(completions.load(), 1);
+
+    std::size_t compacted = 0;
+    for (const auto& d : rollups.daily()) {
+        compacted += static_cast<std::size_t>(d.completedPomodoros);
+    }
+    std::size_t pomodoros = 0;
+    for (const auto& e : events) pomodoros += e.type == StatisticsEventType::PomodoroCompleted;
+    std::size_t rawPomodoros = 0;
+    for (std::size_t i = 0; i < store.size(); ++i) rawPomodoros += store.at(i).type == StatisticsEventType::PomodoroCompleted;
+    CHECK_EQ(compacted + rawPomodoros, pomodoros);
+    CHECK_EQ(store.at(store.size() - 1).timestampMs, events.back().timestampMs);
+}
+
+TEST_CASE(testReopenFinishesInterruptedCompaction) {
+    const auto dir = tempDir("compactor_reopen");
+    const auto events = syntheticHistory(31u);
+    {
+        StatisticsEventStore store;
+        CHECK(store.open(dir, smallSegments()));
+        for (const auto& e : events) store.append(e);
+    }
+
+    // 模拟汇总文件已写入、分段尚未删除时进程退出
+    std::size_t firstRaw = 0;
+    {
+        StatisticsEventStore store;
+        CHECK(store.open(dir));
+        StatisticsRollups rollups;
+        std::vector<StatisticsEvent> head;
+        store.visit(0, 3 * store.segmentCapacity(), [&head](const StatisticsEvent* r, std::size_t n) { head.insert(head.end(), r, r + n); });
+        rollups.addEvents(head.data(), head.size(), LocalCalendar());
+        rollups.setFirstRawSegment(3);
+        CHECK(rollups.save(dir / "rollups.bin"));
+        firstRaw = rollups.firstRawSegment();
+    }
+
+    StatisticsRollups rollups;
+    CHECK(rollups.load(dir / "rollups.bin"));
+    StatisticsEventStore store;
+    CHECK(store.open(dir));
+    const std::size_t before = store.size();
+    CHECK_EQ(store.dropSegmentsBefore(firstRaw), std::size_t(3));
+    CHECK_EQ(store.size(), before - 3 * store.segmentCapacity());
+    CHECK_EQ(store.at(0).timestampMs, events[3 * store.segmentCapacity()].timestampMs);
+
+    // 重新打开时从编号 3 开始，新分段继续编号
+    store.close();
+    CHECK(store.open(dir));
+    CHECK_EQ(store.firstSegmentNumber(), std::size_t(3));
+    CHECK_EQ(store.size(), before - 3 * 64);
+    StatisticsEvent late = events.back();
+    for (int i = 0; i < 200; ++i) {
+        late.timestampMs += 1000;
+        CHECK(store.append(late));
+    }
+    CHECK_EQ(store.lowerBound(late.timestampMs), store.size() - 1);
+    CHECK_EQ(store.dropSegmentsBefore(2), std::size_t(0));
+}
+
+TEST_CASE(testRetentionDropsOldRollups) {
+    const auto dir = tempDir("compactor_retention");
+    const auto events = syntheticHistory(41u);
+
+    StatisticsEventStore store;
+    CHECK(store.open(dir, smallSegments()));
+    for (const auto& e : events) store.append(e);
+
+    StatisticsRollups rollups;
+    StatisticsCompactor compactor(store, rollups, dir / "rollups.bin");
+    StatisticsCompactor::Policy policy;
+    policy.rawRetentionDays = 30;
+    policy.hourlyRetentionDays = 100;
+    policy.dailyRetentionDays = 150;
+    compactor.setPolicy(policy);
+
+    const std::int32_t today = kFirstDay + kDays;
+    CHECK(compactor.start(today * kMsPerDay));
+    CHECK(compactor.finish());
+    CHECK(!rollups.hourly().empty());
+    CHECK(rollups.hourly().front().dayIndex >= today - 100);
+    CHECK(rollups.daily().front().dayIndex >= today - 150);
+    CHECK(rollups.daily().front().dayIndex < today - 100);
+
+    // 再过一段时间：只有汇总过期也会启动一次
+    CHECK(compactor.start((today + 60) * kMsPerDay));
+    CHECK(compactor.finish());
+    CHECK(rollups.daily().front().dayIndex >= today + 60 - 150);
+
+    StatisticsRollups loaded;
+    CHECK(loaded.load(dir / "rollups.bin"));
+    CHECK_EQ(loaded.daily().size(), rollups.daily().size());
+    CHECK_EQ(loaded.hourly().size(), rollups.hourly().size());
+}
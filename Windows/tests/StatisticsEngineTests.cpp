@@ -0,0 +1,238 @@
+#include "TestHarness.h"
+
+#include "MonotonicClock.h"
+#include "PomodoroTimer.h"
+#include "StatisticsEngine.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerHour = 60LL * 60 * 1000;
+    constexpr std::int64_t kMsPerDay = 24 * kMsPerHour;
+    constexpr std::int64_t kDay0 = 19'700LL * kMsPerDay; // 2023-12-08 00:00 UTC
+
+    StatisticsEvent makeEvent(StatisticsEventType type, std::int64_t at, std::uint32_t durationMs = 0,
+        std::uint8_t flags = 0) {
+        StatisticsEvent e;
+        e.type = type;
+        e.timestampMs = at;
+        e.durationMs = durationMs;
+        e.flags = flags;
+        return e;
+    }
+
+    bool sameCounters(const DailyStatistics& a, const DailyStatistics& b) {
+        return a.dayIndex == b.dayIndex && a.completedPomodoros == b.completedPomodoros &&
+            a.totalWorkMs == b.totalWorkMs && a.shortBreakCount == b.shortBreakCount &&
+            a.longBreakCount == b.longBreakCount && a.totalBreakMs == b.totalBreakMs &&
+            a.cancelledBreakCount == b.cancelledBreakCount && a.screenLockCount == b.screenLockCount &&
+            a.screensaverCount == b.screensaverCount && a.stayUpLateCount == b.stayUpLateCount &&
+            a.firstActivityMs == b.firstActivityMs && a.lastActivityMs == b.lastActivityMs &&
+            a.moodLevel == b.moodLevel;
+    }
+
+    // 计时器 + 统计引擎：墙钟 = 起点 + 虚拟单调时钟的流逝
+    struct TimerFixture {
+        VirtualClock clock;
+        PomodoroTimer timer{ clock };
+        StatisticsEngine statistics;
+        MonotonicClock::time_point epoch{ clock.now() };
+
+        TimerFixture() {
+            PomodoroTimer::Settings s;
+            s.pomodoroMinutes = 25;
+            s.breakMinutes = 5;
+            s.longBreakCycle = 2;
+            s.longBreakMinutes = 15;
+            s.autoStartNextPomodoroAfterRest = false;
+            s.stayUpLimitEnabled = true;
+            timer.updateSettings(s);
+            timer.events.subscribe(kTimerEventPhaseChanges, [this](const TimerEvent& e) {
+                statistics.recordTimerEvent(e, wallMs());
+            });
+        }
+
+        std::int64_t wallMs() const {
+            return kDay0 + 9 * kMsPerHour +
+                std::chrono::duration_cast<std::chrono::milliseconds>(clock.now() - epoch).count();
+        }
+
+        void runFor(std::chrono::seconds d) {
+            clock.advance(d);
+            timer.tick();
+        }
+    };
+
+} // namespace
+
+// MARK: - 日汇总
+
+TEST_CASE(testCountersFollowSwiftUpdateRules) {
+    StatisticsEngine engine;
+    const auto t = kDay0 + 10 * kMsPerHour;
+    engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, t, 25 * 60 * 1000));
+    engine.record(makeEvent(StatisticsEventType::ShortBreakStarted, t + 1));
+    engine.record(makeEvent(StatisticsEventType::BreakFinished, t + 2, 5 * 60 * 1000));
+    engine.record(makeEvent(StatisticsEventType::LongBreakStarted, t + 3));
+    engine.record(makeEvent(StatisticsEventType::BreakCancelled, t + 4, 1000, StatisticsEvent::kFlagUserSource));
+    engine.record(makeEvent(StatisticsEventType::BreakCancelled, t + 5, 1000)); // 系统关闭，不计取消
+    engine.record(makeEvent(StatisticsEventType::ScreenLocked, t + 6));
+    engine.record(makeEvent(StatisticsEventType::ScreensaverActivated, t + 7));
+    engine.record(makeEvent(StatisticsEventType::StayUpLateTriggered, t + 8));
+    engine.record(makeEvent(StatisticsEventType::StayUpLateActivity, t + 9));
+
+    const auto d = engine.dayContaining(t);
+    CHECK_EQ(d.completedPomodoros, 1);
+    CHECK_EQ(d.totalWorkMs, std::int64_t(25 * 60 * 1000));
+    CHECK_EQ(d.shortBreakCount, 1);
+    CHECK_EQ(d.longBreakCount, 1);
+    CHECK_EQ(d.totalBreakMs, std::int64_t(5 * 60 * 1000));
+    CHECK_EQ(d.cancelledBreakCount, 1);
+    CHECK_EQ(d.screenLockCount, 1);
+    CHECK_EQ(d.screensaverCount, 1);
+    CHECK_EQ(d.stayUpLateCount, 1);
+    CHECK_EQ(d.firstActivityMs, t);
+    CHECK_EQ(d.lastActivityMs, t + 9);
+    CHECK_EQ(engine.eventCount(), std::uint64_t(10));
+}
+
+TEST_CASE(testDayBoundaryUsesUtcOffset) {
+    // UTC+8：UTC 15:59 仍是当天，16:00 已是次日
+    StatisticsEngine engine(8 * 60);
+    engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, kDay0 + 16 * kMsPerHour - 1));
+    engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, kDay0 + 16 * kMsPerHour));
+
+    const std::int32_t day0 = static_cast<std::int32_t>(kDay0 / kMsPerDay);
+    CHECK_EQ(engine.day(day0).completedPomodoros, 1);
+    CHECK_EQ(engine.day(day0 + 1).completedPomodoros, 1);
+    CHECK_EQ(engine.dayCount(), std::size_t(2));
+}
+
+TEST_CASE(testDaysAreDenseAndAcceptLateEvents) {
+    StatisticsEngine engine;
+    const std::int32_t day0 = static_cast<std::int32_t>(kDay0 / kMsPerDay);
+    engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, kDay0 + 3 * kMsPerDay));
+    engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, kDay0 + 5 * kMsPerDay));
+    engine.record(makeEvent(StatisticsEventType::ScreenLocked, kDay0)); // 补录更早的事件
+
+    CHECK_EQ(engine.firstDay(), day0);
+    CHECK_EQ(engine.dayCount(), std::size_t(6));
+    for (std::size_t i = 0; i < engine.dayCount(); ++i) {
+        CHECK_EQ(engine.days()[i].dayIndex, day0 + static_cast<std::int32_t>(i));
+    }
+    CHECK_EQ(engine.day(day0).screenLockCount, 1);
+    CHECK(!engine.day(day0 + 4).hasActivity());
+    CHECK_EQ(engine.day(day0 + 5).completedPomodoros, 1);
+    CHECK(!engine.day(day0 + 100).hasActivity());
+}
+
+TEST_CASE(testOutOfRangeTimestampsAreRejected) {
+    // 损坏的时间戳（远未来、1970 年、极值）不记录，也不会把日期数组撑到覆盖中间的每一天
+    StatisticsEngine engine;
+    const std::int32_t day0 = static_cast<std::int32_t>(kDay0 / kMsPerDay);
+    CHECK(engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, kDay0)) != nullptr);
+    CHECK(engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, 1'000'000'000'000'000LL)) == nullptr);
+    CHECK(engine.record(makeEvent(StatisticsEventType::ScreenLocked, 0)) == nullptr);
+    CHECK(engine.record(makeEvent(StatisticsEventType::ScreenLocked, INT64_MAX)) == nullptr);
+    CHECK(engine.record(makeEvent(StatisticsEventType::ScreenLocked, INT64_MIN)) == nullptr);
+
+    DailyStatistics farFuture;
+    farFuture.dayIndex = day0 + 1'000'000;
+    farFuture.completedPomodoros = 1;
+    CHECK(engine.restoreDay(farFuture) == nullptr);
+
+    CHECK_EQ(engine.firstDay(), day0);
+    CHECK_EQ(engine.dayCount(), std::size_t(1));
+    CHECK_EQ(engine.eventCount(), std::uint64_t(1));
+    CHECK_EQ(engine.rejectedCount(), std::uint64_t(5));
+
+    // 当前时间附近的事件照常记录
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    CHECK(engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, now)) != nullptr);
+    CHECK_EQ(engine.day(engine.dayIndexFor(now)).completedPomodoros, 1);
+}
+
+TEST_CASE(testIncrementalMatchesFullRecompute) {
+    // 随机事件流：增量结果与“从原始事件重新计算整天”（Swift updateDailyStatistics 的做法）一致
+    std::mt19937 rng(11u);
+    std::uniform_int_distribution<int> type(0, static_cast<int>(kStatisticsEventTypeCount) - 1);
+    std::uniform_int_distribution<std::int64_t> at(0, 30 * kMsPerDay);
+    std::uniform_int_distribution<std::uint32_t> duration(0, 3'600'000);
+
+    StatisticsEngine engine(-5 * 60);
+    std::vector<StatisticsEvent> events;
+    for (int i = 0; i < 20000; ++i) {
+        auto e = makeEvent(static_cast<StatisticsEventType>(type(rng)), kDay0 + at(rng), duration(rng),
+            (i % 3 == 0) ? StatisticsEvent::kFlagUserSource : 0);
+        e.moodLevel = static_cast<std::uint8_t>(i % 7);
+        events.push_back(e);
+        engine.record(e);
+    }
+
+    std::map<std::int32_t, DailyStatistics> recomputed;
+    for (const auto& e : events) {
+        const auto day = engine.dayIndexFor(e.timestampMs);
+        auto& d = recomputed[day];
+        d.dayIndex = day;
+        applyStatisticsEvent(d, e);
+    }
+    for (const auto& [day, expected] : recomputed) {
+        CHECK(sameCounters(engine.day(day), expected));
+    }
+}
+
+// MARK: - 由计时器阶段驱动
+
+TEST_CASE(testTimerPhaseTransitionsFeedAggregates) {
+    using std::chrono::minutes;
+    using std::chrono::seconds;
+    TimerFixture f;
+
+    // 第 1 个番茄 -> 短休息完成
+    f.timer.start();
+    f.runFor(minutes(25));
+    CHECK(f.timer.isInRestPeriod());
+    f.runFor(minutes(5));
+    CHECK(!f.timer.isInRestPeriod());
+
+    // 第 2 个番茄 -> 长休息，休息 2 分钟后用户取消
+    f.timer.start();
+    f.runFor(minutes(25));
+    f.runFor(minutes(2));
+    f.timer.start();
+
+    // 熬夜限制触发
+    f.timer.onForcedSleepTriggered();
+    f.timer.onForcedSleepTriggered(); // 已在强制睡眠中，不重复计数
+
+    const auto d = f.statistics.dayContaining(f.wallMs());
+    CHECK_EQ(d.completedPomodoros, 2);
+    CHECK_EQ(d.totalWorkMs, std::int64_t(2 * 25 * 60 * 1000));
+    CHECK_EQ(d.shortBreakCount, 1);
+    CHECK_EQ(d.longBreakCount, 1);
+    CHECK_EQ(d.totalBreakMs, std::int64_t(5 * 60 * 1000));
+    CHECK_EQ(d.cancelledBreakCount, 1);
+    CHECK_EQ(d.stayUpLateCount, 1);
+    CHECK_EQ(d.firstActivityMs, kDay0 + 9 * kMsPerHour + 25 * 60 * 1000);
+}
+
+TEST_CASE(testStopDuringRestCountsAsCancelled) {
+    TimerFixture f;
+    f.timer.start();
+    f.runFor(std::chrono::minutes(25));
+    f.runFor(std::chrono::seconds(30));
+    f.timer.stop();
+    f.timer.stop(); // 已不在休息中
+
+    const auto d = f.statistics.dayContaining(f.wallMs());
+    CHECK_EQ(d.cancelledBreakCount, 1);
+    CHECK_EQ(d.totalBreakMs, std::int64_t(0));
+}
@@ -0,0 +1,169 @@
+#include "TestHarness.h"
+
+#include "StatisticsEventStore.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kStartMs = 1'700'000'000'000;
+
+    std::filesystem::path tempStoreDir(const char* name) {
+        auto dir = std::filesystem::temp_directory_path() / (std::string("pomodoro_") + name);
+        std::filesystem::remove_all(dir);
+        return dir;
+    }
+
+    StatisticsEventStore::Options smallSegments() {
+        // 小分段 + 小步长：少量数据即可覆盖跨分段、跨索引块的情况
+        StatisticsEventStore::Options o;
+        o.segmentRecords = 64;
+        o.indexStride = 8;
+        return o;
+    }
+
+    StatisticsEvent makeEvent(std::int64_t at, StatisticsEventType type = StatisticsEventType::PomodoroCompleted) {
+        StatisticsEvent e;
+        e.timestampMs = at;
+        e.type = type;
+        return e;
+    }
+
+    std::vector<std::int64_t> timestamps(const std::vector<StatisticsEvent>& events) {
+        std::vector<std::int64_t> out;
+        for (const auto& e : events) out.push_back(e.timestampMs);
+        return out;
+    }
+
+} // namespace
+
+// MARK: - 查询
+
+TEST_CASE(testRangeAndRecentAcrossSegments) {
+    StatisticsEventStore store;
+    CHECK(store.open(tempStoreDir("store_range"), smallSegments()));
+    for (int i = 0; i < 500; ++i) CHECK(store.append(makeEvent(kStartMs + i * 1000)));
+    CHECK_EQ(store.size(), std::size_t(500));
+
+    std::vector<StatisticsEvent> out;
+    CHECK_EQ(store.range(kStartMs + 60'000, kStartMs + 130'000, out), std::size_t(70));
+    CHECK_EQ(out.front().timestampMs, kStartMs + 60'000);
+    CHECK_EQ(out.back().timestampMs, kStartMs + 129'000);
+
+    out.clear();
+    CHECK_EQ(store.recent(10, out), std::size_t(10));
+    CHECK_EQ(out.front().timestampMs, kStartMs + 490'000);
+    CHECK_EQ(out.back().timestampMs, kStartMs + 499'000);
+
+    out.clear();
+    CHECK_EQ(store.recent(10'000, out), std::size_t(500));
+    out.clear();
+    CHECK_EQ(store.range(kStartMs - 10, kStartMs, out), std::size_t(0));
+    CHECK_EQ(store.range(kStartMs + 5000, kStartMs + 5000, out), std::size_t(0));
+    CHECK_EQ(store.lowerBound(kStartMs + 10'000'000), store.size());
+}
+
+TEST_CASE(testEqualTimestampsAreHalfOpen) {
+    StatisticsEventStore store;
+    CHECK(store.open(tempStoreDir("store_equal"), smallSegments()));
+    // 大量相同时间戳跨越多个索引块与分段边界
+    for (int i = 0; i < 10; ++i) store.append(makeEvent(kStartMs));
+    for (int i = 0; i < 100; ++i) store.append(makeEvent(kStartMs + 1));
+    for (int i = 0; i < 10; ++i) store.append(makeEvent(kStartMs + 2));
+
+    std::vector<StatisticsEvent> out;
+    CHECK_EQ(store.range(kStartMs + 1, kStartMs + 2, out), std::size_t(100));
+    CHECK_EQ(store.lowerBound(kStartMs + 1), std::size_t(10));
+    CHECK_EQ(store.lowerBound(kStartMs + 2), std::size_t(110));
+}
+
+TEST_CASE(testQueriesMatchLinearScan) {
+    std::mt19937 rng(5u);
+    std::uniform_int_distribution<std::int64_t> gap(0, 5000);
+    StatisticsEventStore store;
+    CHECK(store.open(tempStoreDir("store_random"), smallSegments()));
+
+    std::vector<StatisticsEvent> all;
+    std::int64_t t = kStartMs;
+    for (int i = 0; i < 3000; ++i) {
+        t += gap(rng);
+        all.push_back(makeEvent(t));
+        store.append(all.back());
+    }
+
+    std::uniform_int_distribution<std::int64_t> probe(kStartMs - 1000, t + 1000);
+    for (int q = 0; q < 500; ++q) {
+        auto from = probe(rng);
+        auto to = probe(rng);
+        if (from > to) std::swap(from, to);
+
+        std::vector<StatisticsEvent> expected;
+        for (const auto& e : all) {
+            if (e.timestampMs >= from && e.timestampMs < to) expected.push_back(e);
+        }
+        std::vector<StatisticsEvent> got;
+        store.range(from, to, got);
+        CHECK(timestamps(got) == timestamps(expected));
+    }
+}
+
+// MARK: - 持久化与乱序
+
+TEST_CASE(testReopenKeepsEventsAndSegmentSize) {
+    const auto dir = tempStoreDir("store_reopen");
+    {
+        StatisticsEventStore store;
+        CHECK(store.open(dir, smallSegments()));
+        for (int i = 0; i < 200; ++i) store.append(makeEvent(kStartMs + i, StatisticsEventType::ScreenLocked));
+    }
+    CHECK(std::filesystem::exists(dir / "events-000003.seg"));
+
+    StatisticsEventStore store;
+    CHECK(store.open(dir)); // 默认选项：分段大小以已有文件为准
+    CHECK_EQ(store.size(), std::size_t(200));
+    CHECK(store.append(makeEvent(kStartMs + 200)));
+    CHECK_EQ(store.at(150).timestampMs, kStartMs + 150);
+    CHECK(store.at(150).type == StatisticsEventType::ScreenLocked);
+
+    std::vector<StatisticsEvent> out;
+    CHECK_EQ(store.range(kStartMs + 190, kStartMs + 1000, out), std::size_t(11));
+}
+
+TEST_CASE(testLateEventInsertedWithinLastSegment) {
+    StatisticsEventStore store;
+    CHECK(store.open(tempStoreDir("store_late"), smallSegments()));
+    for (int i = 0; i < 100; ++i) store.append(makeEvent(kStartMs + i * 10));
+
+    // 最后一个分段从位置 64 开始：插入到其中
+    CHECK(store.append(makeEvent(kStartMs + 805)));
+    CHECK_EQ(store.size(), std::size_t(101));
+    CHECK_EQ(store.at(81).timestampMs, kStartMs + 805);
+    for (std::size_t i = 1; i < store.size(); ++i) CHECK(store.at(i - 1).timestampMs <= store.at(i).timestampMs);
+    CHECK_EQ(store.lowerBound(kStartMs + 806), std::size_t(82));
+
+    // 早于最后一个分段的事件无法插入
+    CHECK(!store.append(makeEvent(kStartMs + 5)));
+    CHECK_EQ(store.size(), std::size_t(101));
+}
+
+TEST_CASE(testForeignSegmentIsRejected) {
+    const auto dir = tempStoreDir("store_foreign");
+    std::filesystem::create_directories(dir);
+    {
+        std::FILE* f = std::fopen((dir / "events-000000.seg").string().c_str(), "wb");
+        const char junk[128] = "definitely not a segment";
+        std::fwrite(junk, 1, sizeof(junk), f);
+        std::fclose(f);
+    }
+    StatisticsEventStore store;
+    CHECK(!store.open(dir));
+    CHECK(!store.isOpen());
+}
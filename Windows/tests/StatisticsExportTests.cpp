@@ -0,0 +1,235 @@
+#include "TestHarness.h"
+
+#include "StatisticsCompactor.h"
+#include "StatisticsEngine.h"
+#include "StatisticsEventStore.h"
+#include "StatisticsExport.h"
+#include "StatisticsRollups.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerMinute = 60'000;
+    constexpr std::int64_t kMsPerHour = 60 * kMsPerMinute;
+    constexpr std::int64_t kMsPerDay = 24 * kMsPerHour;
+    constexpr std::int32_t kDay = 19'800; // 2024-03-18
+
+    std::filesystem::path tempDir(const char* name) {
+        auto dir = std::filesystem::temp_directory_path() / (std::string("pomodoro_") + name);
+        std::filesystem::remove_all(dir);
+        return dir;
+    }
+
+    StatisticsEventStore::Options smallSegments() {
+        StatisticsEventStore::Options o;
+        o.segmentRecords = 64;
+        o.indexStride = 8;
+        return o;
+    }
+
+    StatisticsEvent makeEvent(StatisticsEventType type, std::int64_t at, std::uint32_t durationMs = 0) {
+        StatisticsEvent e;
+        e.type = type;
+        e.timestampMs = at;
+        e.durationMs = durationMs;
+        return e;
+    }
+
+    struct Collected {
+        std::string text;
+        std::size_t chunks{ 0 };
+        std::size_t largestChunk{ 0 };
+    };
+
+    ExportResult exportTo(Collected& out, const StatisticsEngine& engine, const StatisticsEventStore& store,
+        const StatisticsRollups& rollups, const ExportOptions& options) {
+        return exportStatistics(engine, store, rollups, options, [&out](const char* data, std::size_t size) {
+            out.text.append(data, size);
+            ++out.chunks;
+            out.largestChunk = (std::max)(out.largestChunk, size);
+            return true;
+        });
+    }
+
+} // namespace
+
+// MARK: - 事件
+
+TEST_CASE(testEventsCsvAndNdjson) {
+    StatisticsEventStore store;
+    CHECK(store.open(tempDir("export_events"), smallSegments()));
+    const std::int64_t t = kDay * kMsPerDay;
+    store.append(makeEvent(StatisticsEventType::PomodoroCompleted, t + 9 * kMsPerHour, 1'500'000));
+    StatisticsEvent cancel = makeEvent(StatisticsEventType::BreakCancelled, t + 10 * kMsPerHour + 1, 61'500);
+    cancel.flags = StatisticsEvent::kFlagUserSource;
+    store.append(cancel);
+    StatisticsEvent mood = makeEvent(StatisticsEventType::MoodUpdated, t + 11 * kMsPerHour);
+    mood.moodLevel = 4;
+    store.append(mood);
+
+    StatisticsEngine engine;
+    StatisticsRollups rollups;
+    ExportOptions options;
+
+    Collected csv;
+    auto result = exportTo(csv, engine, store, rollups, options);
+    CHECK(result.ok);
+    CHECK_EQ(result.rows, std::uint64_t(3));
+    CHECK_EQ(result.bytes, std::uint64_t(csv.text.size()));
+    CHECK_EQ(csv.text, std::string(
+        "time,timestamp_ms,event_type,duration,source,mood_level\n"
+        "2024-03-18T09:00:00Z,1710752400000,pomodoro_completed,1500,,\n"
+        "2024-03-18T10:00:00Z,1710756000001,break_cancelled,61.5,user,\n"
+        "2024-03-18T11:00:00Z,1710759600000,mood_updated,0,,4\n"));
+
+    // 时间范围 [from, to)
+    options.format = ExportFormat::Ndjson;
+    options.fromMs = t + 10 * kMsPerHour;
+    options.toMs = t + 11 * kMsPerHour;
+    Collected json;
+    result = exportTo(json, engine, store, rollups, options);
+    CHECK_EQ(result.rows, std::uint64_t(1));
+    CHECK_EQ(json.text, std::string(
+        R"({"time":"2024-03-18T10:00:00Z","timestamp_ms":1710756000001,"event_type":"break_cancelled","duration":61.5,"source":"user","mood_level":null})" "\n"));
+}
+
+TEST_CASE(testLargeExportUsesFixedChunks) {
+    StatisticsEventStore store;
+    CHECK(store.open(tempDir("export_chunks")));
+    for (int i = 0; i < 50'000; ++i) store.append(makeEvent(StatisticsEventType::ScreenLocked, kDay * kMsPerDay + i * 1000LL));
+
+    StatisticsEngine engine;
+    StatisticsRollups rollups;
+    ExportOptions options;
+    options.format = ExportFormat::Ndjson;
+    options.chunkBytes = 100; // 小于下限时按 4 KiB
+
+    Collected out;
+    const auto result = exportTo(out, engine, store, rollups, options);
+    CHECK(result.ok);
+    CHECK_EQ(result.rows, std::uint64_t(50'000));
+    CHECK_EQ(out.largestChunk, std::size_t(4096));
+    CHECK(out.chunks > 100);
+    CHECK_EQ(static_cast<std::size_t>(std::count(out.text.begin(), out.text.end(), '\n')), std::size_t(50'000));
+
+    // sink 返回 false 时立即停止
+    std::size_t calls = 0;
+    const auto aborted = exportStatistics(engine, store, rollups, options, [&calls](const char*, std::size_t) {
+        ++calls;
+        return false;
+    });
+    CHECK(!aborted.ok);
+    CHECK_EQ(calls, std::size_t(1));
+    // 只计入停止前实际格式化的行（第一个 4 KiB 块），而不是整个分段
+    CHECK(aborted.rows > 0);
+    CHECK(aborted.rows < std::uint64_t(100));
+}
+
+// MARK: - 汇总
+
+TEST_CASE(testHourlyExportMatchesAcrossCompaction) {
+    const auto dir = tempDir("export_hourly");
+    std::mt19937 rng(9u);
+    std::uniform_int_distribution<std::int64_t> gap(0, 40 * kMsPerMinute);
+    std::uniform_int_distribution<int> type(0, static_cast<int>(kStatisticsEventTypeCount) - 1);
+
+    StatisticsEventStore store;
+    CHECK(store.open(dir, smallSegments()));
+    StatisticsEngine engine(60);
+    std::int64_t t = (kDay - 100) * kMsPerDay;
+    while (t < kDay * kMsPerDay) {
+        t += gap(rng);
+        const auto e = makeEvent(static_cast<StatisticsEventType>(type(rng)), t, 60'000);
+        store.append(e);
+        engine.record(e);
+    }
+
+    ExportOptions options;
+    options.table = ExportTable::Hourly;
+    options.fromMs = (kDay - 90) * kMsPerDay + 30 * kMsPerMinute;
+    options.toMs = (kDay - 5) * kMsPerDay;
+
+    StatisticsRollups none;
+    Collected before;
+    CHECK(exportTo(before, engine, store, none, options).ok);
+
+    StatisticsRollups rollups;
+    StatisticsCompactor compactor(store, rollups, dir / "rollups.bin");
+    compactor.setCalendar(engine.calendar());
+    StatisticsCompactor::Policy policy;
+    policy.rawRetentionDays = 40;
+    compactor.setPolicy(policy);
+    CHECK(compactor.start(kDay * kMsPerDay));
+    CHECK(compactor.finish());
+    CHECK(!rollups.hourly().empty());
+
+    Collected after;
+    const auto result = exportTo(after, engine, store, rollups, options);
+    CHECK(result.ok);
+    CHECK(result.rows > 1000);
+    CHECK(before.text == after.text);
+    CHECK_EQ(after.text.substr(0, after.text.find('\n')), std::string(
+        "date,hour,hour_start,work_time,break_time,pomodoro_completed,short_break_started,long_break_started,"
+        "break_cancelled,break_finished,screen_locked,screensaver_activated,stay_up_late_triggered,"
+        "stay_up_late_activity,mood_updated"));
+}
+
+TEST_CASE(testDailyExport) {
+    StatisticsEventStore store;
+    CHECK(store.open(tempDir("export_daily")));
+    StatisticsEngine engine(480);
+    const std::int64_t dayStart = kDay * kMsPerDay - 8 * kMsPerHour;
+    engine.record(makeEvent(StatisticsEventType::PomodoroCompleted, dayStart + 9 * kMsPerHour, 1'500'000));
+    engine.record(makeEvent(StatisticsEventType::BreakFinished, dayStart + 9 * kMsPerHour + 30 * kMsPerMinute, 300'000));
+    engine.record(makeEvent(StatisticsEventType::ScreenLocked, dayStart + 2 * kMsPerDay));
+
+    StatisticsRollups rollups;
+    ExportOptions options;
+    options.table = ExportTable::Daily;
+    options.toMs = dayStart + kMsPerDay;
+
+    Collected out;
+    const auto result = exportTo(out, engine, store, rollups, options);
+    CHECK_EQ(result.rows, std::uint64_t(1));
+    CHECK_EQ(out.text, std::string(
+        "date,completed_pomodoros,total_work_time,short_break_count,long_break_count,total_break_time,"
+        "cancelled_break_count,screen_lock_count,screensaver_count,stay_up_late_count,mood_level,mood_updated_at,"
+        "first_activity_time,last_activity_time\n"
+        "2024-03-18,1,1500,0,0,300,0,0,0,0,,,2024-03-18T01:00:00Z,2024-03-18T01:30:00Z\n"));
+}
+
+TEST_CASE(testExportToFileReplacesAtomically) {
+    const auto dir = tempDir("export_file");
+    StatisticsEventStore store;
+    CHECK(store.open(dir));
+    for (int i = 0; i < 1000; ++i) store.append(makeEvent(StatisticsEventType::PomodoroCompleted, kDay * kMsPerDay + i));
+
+    StatisticsEngine engine;
+    StatisticsRollups rollups;
+    ExportOptions options;
+    const auto path = dir / "events.csv";
+    {
+        std::ofstream old(path);
+        old << "old";
+    }
+    const auto result = exportStatisticsToFile(path, engine, store, rollups, options);
+    CHECK(result.ok);
+    CHECK(!std::filesystem::exists(dir / "events.csv.tmp"));
+
+    std::ifstream in(path, std::ios::binary);
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    Collected expected;
+    exportTo(expected, engine, store, rollups, options);
+    CHECK(text == expected.text);
+    CHECK_EQ(std::uint64_t(text.size()), result.bytes);
+}
@@ -0,0 +1,165 @@
+#include "TestHarness.h"
+
+#include "StatisticsHeatmap.h"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kMsPerMinute = 60'000;
+    constexpr std::int64_t kMsPerHour = 60 * kMsPerMinute;
+    constexpr std::int64_t kMsPerDay = 24 * kMsPerHour;
+    constexpr std::int64_t kWeekStart = 19'700LL * kMsPerDay - 8 * kMsPerHour; // UTC+8 的本地零点
+
+    constexpr SimdLevel kLevels[] = { SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2, SimdLevel::Neon };
+
+    StatisticsEvent makeEvent(std::int64_t at, StatisticsEventType type = StatisticsEventType::PomodoroCompleted) {
+        StatisticsEvent e;
+        e.timestampMs = at;
+        e.type = type;
+        e.durationMs = 0xFFFFFFFFu; // 相邻字段填满，确认转置时不会串到时间戳或类型
+        e.flags = 0xFF;
+        e.moodLevel = 0xFF;
+        e.reserved = 0xFF;
+        return e;
+    }
+
+    bool sameCube(const HeatmapCube& a, const HeatmapCube& b) {
+        for (int d = 0; d < kHeatmapDays; ++d) {
+            for (int h = 0; h < kHeatmapHours; ++h) {
+                for (std::size_t t = 0; t < kStatisticsEventTypeCount; ++t) {
+                    const auto type = static_cast<StatisticsEventType>(t);
+                    if (a.count(d, h, type) != b.count(d, h, type)) return false;
+                }
+            }
+        }
+        return a.outsideCount() == b.outsideCount();
+    }
+
+} // namespace
+
+// MARK: - 分桶
+
+TEST_CASE(testUniformWindowBinsByLocalDayAndHour) {
+    const auto binner = HeatmapBinner::uniform(kWeekStart);
+    std::vector<StatisticsEvent> events = {
+        makeEvent(kWeekStart),                                                       // 第 0 天 0 点
+        makeEvent(kWeekStart + 2 * kMsPerDay + 9 * kMsPerHour + 59 * kMsPerMinute),  // 第 2 天 9 点
+        makeEvent(kWeekStart + 2 * kMsPerDay + 10 * kMsPerHour, StatisticsEventType::ScreenLocked),
+        makeEvent(kWeekStart + 7 * kMsPerDay - 1, StatisticsEventType::StayUpLateActivity),
+        makeEvent(kWeekStart + 7 * kMsPerDay),                                       // 窗口外
+        makeEvent(kWeekStart - 1),                                                   // 窗口外
+    };
+    for (const auto level : kLevels) {
+        if (!simdLevelSupported(level)) continue;
+        HeatmapCube cube;
+        binner.bin(events.data(), events.size(), cube, level);
+        CHECK_EQ(cube.count(0, 0, StatisticsEventType::PomodoroCompleted), 1u);
+        CHECK_EQ(cube.count(2, 9, StatisticsEventType::PomodoroCompleted), 1u);
+        CHECK_EQ(cube.count(2, 10, StatisticsEventType::ScreenLocked), 1u);
+        CHECK_EQ(cube.hourTotal(2, 10), 1u);
+        CHECK_EQ(cube.count(6, 23, StatisticsEventType::StayUpLateActivity), 1u);
+        CHECK_EQ(cube.outsideCount(), 2u);
+    }
+}
+
+TEST_CASE(testDstHourStartsMapRepeatedAndSkippedHours) {
+    // 第 1 天 02:00 跳到 03:00（当天 23 小时），第 4 天 01:00 重复一次（当天 25 小时）
+    std::array<std::int64_t, kHeatmapCells + 1> starts{};
+    std::int64_t at = kWeekStart;
+    for (int k = 0; k <= kHeatmapCells; ++k) {
+        starts[static_cast<std::size_t>(k)] = at;
+        const int day = k / kHeatmapHours;
+        const int hour = k % kHeatmapHours;
+        if (day == 1 && hour == 2) continue; // 长度为 0 的本地小时
+        at += (day == 4 && hour == 1) ? 2 * kMsPerHour : kMsPerHour;
+    }
+    const auto binner = HeatmapBinner::fromHourStarts(starts);
+    CHECK(binner.has_value());
+
+    const std::int64_t day1 = starts[1 * kHeatmapHours];
+    const std::int64_t day4 = starts[4 * kHeatmapHours];
+    std::vector<StatisticsEvent> events = {
+        makeEvent(day1 + 2 * kMsPerHour + 1),             // UTC 上第 3 个小时 = 本地 03:00
+        makeEvent(day4 + 1 * kMsPerHour + 10 * kMsPerMinute), // 第一次 01:xx
+        makeEvent(day4 + 2 * kMsPerHour + 10 * kMsPerMinute), // 第二次 01:xx
+        makeEvent(day4 + 3 * kMsPerHour),                 // 本地 02:00
+        makeEvent(starts.back() - 1),
+    };
+    for (const auto level : kLevels) {
+        if (!simdLevelSupported(level)) continue;
+        HeatmapCube cube;
+        binner->bin(events.data(), events.size(), cube, level);
+        CHECK_EQ(cube.hourTotal(1, 2), 0u);
+        CHECK_EQ(cube.hourTotal(1, 3), 1u);
+        CHECK_EQ(cube.hourTotal(4, 1), 2u);
+        CHECK_EQ(cube.hourTotal(4, 2), 1u);
+        CHECK_EQ(cube.hourTotal(6, 23), 1u);
+        CHECK_EQ(cube.outsideCount(), 0u);
+    }
+}
+
+TEST_CASE(testInvalidHourStartsAreRejected) {
+    std::array<std::int64_t, kHeatmapCells + 1> starts{};
+    for (int k = 0; k <= kHeatmapCells; ++k) starts[static_cast<std::size_t>(k)] = kWeekStart + k * kMsPerHour;
+    auto shifted = starts;
+    shifted[5] += 15 * kMsPerMinute; // 不是 30 分钟的整数倍
+    CHECK(!HeatmapBinner::fromHourStarts(shifted).has_value());
+    auto reversed = starts;
+    reversed[5] = reversed[3];
+    CHECK(!HeatmapBinner::fromHourStarts(reversed).has_value());
+    auto tooLong = starts;
+    tooLong.back() += 2 * kMsPerDay;
+    CHECK(!HeatmapBinner::fromHourStarts(tooLong).has_value());
+}
+
+// MARK: - 向量内核与标量一致
+
+TEST_CASE(testKernelsAgreeOnSlotBoundaries) {
+    // multiply-shift 除法出错只可能发生在整除边界附近：逐个半小时边界检查 ±1 毫秒
+    const auto binner = HeatmapBinner::uniform(kWeekStart);
+    std::vector<StatisticsEvent> events;
+    for (std::int64_t at = kWeekStart; at <= binner.windowEndMs(); at += 30 * kMsPerMinute) {
+        for (std::int64_t d = -1; d <= 1; ++d) events.push_back(makeEvent(at + d));
+    }
+    HeatmapCube expected;
+    binner.bin(events.data(), events.size(), expected, SimdLevel::Scalar);
+    CHECK_EQ(expected.outsideCount(), 3u); // 起点 - 1、终点、终点 + 1
+    for (const auto level : kLevels) {
+        if (!simdLevelSupported(level)) continue;
+        HeatmapCube cube;
+        binner.bin(events.data(), events.size(), cube, level);
+        CHECK(sameCube(cube, expected));
+    }
+}
+
+TEST_CASE(testKernelsAgreeOnRandomEvents) {
+    std::mt19937_64 rng(13u);
+    std::uniform_int_distribution<std::int64_t> at(kWeekStart - kMsPerDay, kWeekStart + 8 * kMsPerDay);
+    std::uniform_int_distribution<int> type(0, 12); // 含无效类型
+    std::uniform_int_distribution<std::int64_t> wild(INT64_MIN, INT64_MAX);
+
+    std::vector<StatisticsEvent> events;
+    for (int i = 0; i < 20'003; ++i) { // 非 8 的倍数：覆盖尾部的标量路径
+        const auto ts = (i % 97 == 0) ? wild(rng) : at(rng);
+        events.push_back(makeEvent(ts, static_cast<StatisticsEventType>(type(rng))));
+    }
+    const auto binner = HeatmapBinner::uniform(kWeekStart);
+
+    HeatmapCube expected;
+    for (const auto& e : events) binner.bin(&e, 1, expected, SimdLevel::Scalar);
+    for (const auto level : kLevels) {
+        if (!simdLevelSupported(level)) continue;
+        HeatmapCube cube;
+        binner.bin(events.data(), events.size(), cube, level);
+        CHECK(sameCube(cube, expected));
+    }
+    HeatmapCube best;
+    binner.bin(events.data(), events.size(), best);
+    CHECK(sameCube(best, expected));
+}
@@ -0,0 +1,225 @@
+#include "TestHarness.h"
+
+#include "PomodoroTimer.h"
+#include "SpscEventRing.h"
+#include "SystemEventQueues.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace pomodoro;
+
+namespace {
+
+    using TimePoint = MonotonicClock::time_point;
+
+    TimePoint at(std::int64_t ns) {
+        return TimePoint(std::chrono::nanoseconds(ns));
+    }
+
+} // namespace
+
+// MARK: - SpscEventRing
+
+TEST_CASE(testRingIsFifoAndBounded) {
+    SpscEventRing<4> ring;
+    CHECK_EQ(ring.available(), 0u);
+
+    for (int i = 0; i < 4; ++i) {
+        CHECK(ring.tryPush(TimedAutoRestartEvent{ at(i), AutoRestartEvent::UserActivityDetected }));
+    }
+    CHECK(!ring.tryPush(TimedAutoRestartEvent{ at(4), AutoRestartEvent::ScreenLocked }));
+    CHECK_EQ(ring.available(), 4u);
+    CHECK(ring.peek(0).at == at(0));
+    CHECK(ring.peek(3).at == at(3));
+
+    ring.consume(2);
+    CHECK_EQ(ring.available(), 2u);
+    CHECK(ring.tryPush(TimedAutoRestartEvent{ at(4), AutoRestartEvent::ScreenLocked }));
+    CHECK_EQ(ring.available(), 3u);
+    CHECK(ring.peek(2).event == AutoRestartEvent::ScreenLocked);
+}
+
+TEST_CASE(testRingStressSingleProducerSingleConsumer) {
+    constexpr std::int64_t kCount = 500000;
+    SpscEventRing<256> ring;
+
+    std::thread producer([&ring]() {
+        for (std::int64_t i = 0; i < kCount; ++i) {
+            const TimedAutoRestartEvent item{ at(i), static_cast<AutoRestartEvent>(i % 15) };
+            while (!ring.tryPush(item)) std::this_thread::yield();
+        }
+    });
+
+    std::int64_t expected = 0;
+    int outOfOrder = 0;
+    while (expected < kCount) {
+        const std::size_t n = ring.available();
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& item = ring.peek(i);
+            if (item.at != at(expected) || item.event != static_cast<AutoRestartEvent>(expected % 15)) ++outOfOrder;
+            ++expected;
+        }
+        ring.consume(n);
+        if (n == 0) std::this_thread::yield();
+    }
+    producer.join();
+
+    CHECK_EQ(outOfOrder, 0);
+    CHECK_EQ(ring.available(), 0u);
+}
+
+// MARK: - SystemEventQueues
+
+TEST_CASE(testDrainMergesSourcesInTimestampOrder) {
+    SystemEventQueues queues;
+    queues.post(SystemEventSource::Idle, AutoRestartEvent::IdleTimeExceeded, at(30));
+    queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected, at(50));
+    queues.post(SystemEventSource::SessionLock, AutoRestartEvent::ScreenLocked, at(10));
+    queues.post(SystemEventSource::SessionLock, AutoRestartEvent::ScreenUnlocked, at(40));
+    queues.post(SystemEventSource::Screensaver, AutoRestartEvent::ScreensaverStarted, at(20));
+    queues.post(SystemEventSource::Screensaver, AutoRestartEvent::ScreensaverStopped, at(30));
+
+    TimedAutoRestartEvent out[8];
+    const std::size_t n = queues.drain(out, 8);
+    CHECK_EQ(n, 6u);
+    CHECK(out[0].event == AutoRestartEvent::ScreenLocked);
+    CHECK(out[1].event == AutoRestartEvent::ScreensaverStarted);
+    // 时间相同按来源顺序：Idle 在 Screensaver 之前
+    CHECK(out[2].event == AutoRestartEvent::IdleTimeExceeded);
+    CHECK(out[3].event == AutoRestartEvent::ScreensaverStopped);
+    CHECK(out[4].event == AutoRestartEvent::ScreenUnlocked);
+    CHECK(out[5].event == AutoRestartEvent::UserActivityDetected);
+    CHECK_EQ(queues.drain(out, 8), 0u);
+}
+
+TEST_CASE(testDrainRespectsMaxCountAndKeepsRemainder) {
+    SystemEventQueues queues;
+    for (int i = 0; i < 10; ++i) {
+        queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected, at(i));
+    }
+    TimedAutoRestartEvent out[4];
+    CHECK_EQ(queues.drain(out, 4), 4u);
+    CHECK(out[3].at == at(3));
+    CHECK_EQ(queues.drain(out, 4), 4u);
+    CHECK(out[0].at == at(4));
+    CHECK_EQ(queues.drain(out, 4), 2u);
+}
+
+TEST_CASE(testFullRingDropsAndCounts) {
+    SystemEventQueues queues;
+    for (std::size_t i = 0; i < SystemEventQueues::kRingCapacity; ++i) {
+        CHECK(queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected));
+    }
+    CHECK(!queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected));
+    CHECK(queues.post(SystemEventSource::SessionLock, AutoRestartEvent::ScreenLocked));
+    CHECK_EQ(queues.droppedCount(), 1u);
+}
+
+TEST_CASE(testDrainToFeedsTimer) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    PomodoroTimer::Settings settings;
+    settings.screenLockRestartEnabled = true;
+    settings.screenLockActionIsRestart = false;
+    timer.updateSettings(settings);
+    timer.start();
+
+    SystemEventQueues queues(clock);
+    for (int i = 0; i < 100; ++i) queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected);
+    queues.post(SystemEventSource::SessionLock, AutoRestartEvent::ScreenLocked);
+
+    CHECK_EQ(queues.drainTo(timer), 101u);
+    CHECK(!timer.isRunning());
+    CHECK(timer.isPausedState());
+}
+
+TEST_CASE(testDrainToUsesEventTimestamps) {
+    // 屏保停止后 0.5 秒解锁：属于“屏保刚恢复”，即使 5 秒后才取出队列也不应重新开始计时
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    PomodoroTimer::Settings settings;
+    settings.screenLockRestartEnabled = true;
+    settings.screenLockActionIsRestart = true;
+    timer.updateSettings(settings);
+    timer.start();
+    clock.advance(std::chrono::seconds(60));
+
+    SystemEventQueues queues(clock);
+    queues.post(SystemEventSource::Screensaver, AutoRestartEvent::ScreensaverStopped, clock.now());
+    queues.post(SystemEventSource::SessionLock, AutoRestartEvent::ScreenUnlocked, clock.now() + std::chrono::milliseconds(500));
+    clock.advance(std::chrono::seconds(5));
+
+    CHECK_EQ(queues.drainTo(timer), 2u);
+    CHECK(timer.isRunning());
+    CHECK_EQ(timer.remainingSeconds(), 25 * 60 - 65);
+}
+
+TEST_CASE(testWakeHandlerFiresOncePerDrain) {
+    SystemEventQueues queues;
+    int wakes = 0;
+    queues.setWakeHandler([&wakes]() { ++wakes; });
+
+    queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected, at(1));
+    queues.post(SystemEventSource::SessionLock, AutoRestartEvent::ScreenLocked, at(2));
+    queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected, at(3));
+    CHECK_EQ(wakes, 1);
+
+    TimedAutoRestartEvent out[8];
+    CHECK_EQ(queues.drain(out, 8), 3u);
+    queues.post(SystemEventSource::Screensaver, AutoRestartEvent::ScreensaverStarted, at(4));
+    CHECK_EQ(wakes, 2);
+
+    // 队列满而丢弃的事件不唤醒
+    CHECK_EQ(queues.drain(out, 8), 1u);
+    for (std::size_t i = 0; i < SystemEventQueues::kRingCapacity; ++i) {
+        queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected, at(5));
+    }
+    CHECK_EQ(wakes, 3);
+    CHECK(!queues.post(SystemEventSource::Idle, AutoRestartEvent::UserActivityDetected, at(6)));
+    CHECK_EQ(wakes, 3);
+}
+
+TEST_CASE(testStressThreeProducersMergedConsumer) {
+    // 每个来源一个生产者线程，时间戳按 (序号 * 3 + 来源) 编码，便于校验顺序与完整性
+    constexpr std::int64_t kPerSource = 200000;
+    SystemEventQueues queues;
+    std::atomic<bool> go{ false };
+
+    std::vector<std::thread> producers;
+    for (std::size_t s = 0; s < kSystemEventSourceCount; ++s) {
+        producers.emplace_back([&queues, &go, s]() {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            const auto source = static_cast<SystemEventSource>(s);
+            for (std::int64_t i = 0; i < kPerSource; ++i) {
+                const auto stamp = at(i * 3 + static_cast<std::int64_t>(s));
+                while (!queues.post(source, AutoRestartEvent::UserActivityDetected, stamp)) std::this_thread::yield();
+            }
+        });
+    }
+    go.store(true, std::memory_order_release);
+
+    std::int64_t nextPerSource[kSystemEventSourceCount] = {};
+    std::int64_t received = 0;
+    int orderViolations = 0;
+    TimedAutoRestartEvent out[128];
+    while (received < kPerSource * static_cast<std::int64_t>(kSystemEventSourceCount)) {
+        const std::size_t n = queues.drain(out, 128);
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::int64_t stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(out[i].at.time_since_epoch()).count();
+            const std::size_t s = static_cast<std::size_t>(stamp % 3);
+            if (stamp / 3 != nextPerSource[s]) ++orderViolations;     // 单个来源内保持 FIFO、不丢不重
+            if (i > 0 && out[i].at < out[i - 1].at) ++orderViolations; // 同一次 drain 内按时间戳有序
+            ++nextPerSource[s];
+        }
+        received += static_cast<std::int64_t>(n);
+        if (n == 0) std::this_thread::yield();
+    }
+    for (auto& t : producers) t.join();
+
+    CHECK_EQ(orderViolations, 0);
+    CHECK_EQ(received, kPerSource * static_cast<std::int64_t>(kSystemEventSourceCount));
+    CHECK_EQ(queues.drain(out, 128), 0u);
+}
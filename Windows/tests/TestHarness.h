@@ -0,0 +1,62 @@
+#pragma once
+
+// Minimal self-contained test harness for the portable C++ core.
+// The Windows port has no third-party dependencies, so instead of pulling in a test framework we
+// keep a tiny registry of test functions plus CHECK macros. Each test executable links TestMain.cpp,
+// which runs every registered TEST_CASE and returns a non-zero exit code on failure (ctest-friendly).
+
+#include <cstdio>
+#include <vector>
+
+namespace pomodoro::test {
+
+    struct TestCase {
+        const char* name;
+        void (*fn)();
+    };
+
+    inline std::vector<TestCase>& registry() {
+        static std::vector<TestCase> cases;
+        return cases;
+    }
+
+    inline int& failureCount() {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, void (*fn)()) { registry().push_back(TestCase{ name, fn }); }
+    };
+
+    inline void reportFailure(const char* file, int line, const char* expr) {
+        ++failureCount();
+        std::fprintf(stderr, "  FAILED %s:%d: %s\n", file, line, expr);
+    }
+
+    inline int runAll() {
+        int failedCases = 0;
+        for (const auto& tc : registry()) {
+            const int before = failureCount();
+            tc.fn();
+            const bool ok = failureCount() == before;
+            if (!ok) ++failedCases;
+            std::printf("[%s] %s\n", ok ? "  OK  " : " FAIL ", tc.name);
+        }
+        std::printf("%zu test(s), %d failed\n", registry().size(), failedCases);
+        return failedCases == 0 ? 0 : 1;
+    }
+
+} // namespace pomodoro::test
+
+#define TEST_CASE(name)                                                                   \
+    static void name();                                                                   \
+    static const ::pomodoro::test::Registrar name##_registrar(#name, &name);              \
+    static void name()
+
+#define CHECK(expr)                                                                       \
+    do {                                                                                  \
+        if (!(expr)) ::pomodoro::test::reportFailure(__FILE__, __LINE__, #expr);          \
+    } while (0)
+
+#define CHECK_EQ(a, b) CHECK((a) == (b))
@@ -0,0 +1,5 @@
+#include "TestHarness.h"
+
+int main() {
+    return pomodoro::test::runAll();
+}
@@ -0,0 +1,64 @@
+#include "TestHarness.h"
+
+#include "TimeTextFormatter.h"
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+using namespace pomodoro;
+
+namespace {
+
+    // 旧实现（PomodoroTimer::updateTimeDisplay 中的 ostringstream 版本），作为对照
+    std::string legacyFormat(int total) {
+        std::ostringstream oss;
+        oss << std::setw(2) << std::setfill('0') << total / 60
+            << ":" << std::setw(2) << std::setfill('0') << total % 60;
+        return oss.str();
+    }
+
+} // namespace
+
+TEST_CASE(testMatchesLegacyFormattingForAllDisplayableValues) {
+    int mismatches = 0;
+    char text[kTimeTextCapacity];
+    for (int total = 0; total <= 9999 * 60 + 59; ++total) {
+        const std::size_t n = formatTimeText(total, text);
+        if (std::string_view(text, n) != legacyFormat(total) || text[n] != '\0') ++mismatches;
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST_CASE(testWideOutputMatchesNarrow) {
+    char narrow[kTimeTextCapacity];
+    wchar_t wide[kTimeTextCapacity];
+    int mismatches = 0;
+    for (int total : { 0, 59, 60, 25 * 60, 99 * 60 + 59, 100 * 60, 999 * 60 + 1, 1000 * 60 + 30 }) {
+        const std::size_t n = formatTimeText(total, narrow);
+        if (formatTimeText(total, wide) != n) ++mismatches;
+        for (std::size_t i = 0; i <= n; ++i) {
+            if (wide[i] != static_cast<wchar_t>(narrow[i])) ++mismatches;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST_CASE(testOutOfRangeValuesAreClamped) {
+    char text[kTimeTextCapacity];
+    std::size_t n = formatTimeText(-5, text);
+    CHECK(std::string_view(text, n) == "00:00");
+    n = formatTimeText(10000 * 60, text);
+    CHECK(std::string_view(text, n) == "9999:59");
+}
+
+TEST_CASE(testFormattingIsConstexpr) {
+    constexpr auto check = []() {
+        char text[kTimeTextCapacity]{};
+        const std::size_t n = formatTimeText(25 * 60, text);
+        return n == 5 && text[0] == '2' && text[1] == '5' && text[2] == ':' && text[3] == '0' && text[4] == '0';
+    };
+    static_assert(check(), "formatTimeText must be usable in constant expressions");
+    CHECK(check());
+}
@@ -0,0 +1,184 @@
+#include "TestHarness.h"
+
+#include "PomodoroTimer.h"
+#include "TimerEventBus.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace pomodoro;
+
+// 统计本测试进程内的堆分配次数，用来验证每秒的发布路径不分配
+namespace {
+    std::atomic<long> g_allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+    TimerEvent makeEvent(TimerEventKind kind) {
+        TimerEvent e;
+        e.kind = kind;
+        return e;
+    }
+
+} // namespace
+
+// MARK: - 总线本身
+
+TEST_CASE(testSubscribersReceiveOnlyMaskedEvents) {
+    TimerEventBus bus;
+    int timeUpdates = 0;
+    int finished = 0;
+    int all = 0;
+    bus.subscribe(kTimerEventTimeUpdated, [&timeUpdates](const TimerEvent&) { ++timeUpdates; });
+    bus.subscribe(kTimerEventPomodoroFinished, [&finished](const TimerEvent&) { ++finished; });
+    bus.subscribe(kTimerEventAll, [&all](const TimerEvent&) { ++all; });
+
+    bus.publish(makeEvent(TimerEventKind::TimeUpdated));
+    bus.publish(makeEvent(TimerEventKind::TimeUpdated));
+    bus.publish(makeEvent(TimerEventKind::PomodoroFinished));
+    bus.publish(makeEvent(TimerEventKind::ForcedSleepEnded));
+
+    CHECK_EQ(timeUpdates, 2);
+    CHECK_EQ(finished, 1);
+    CHECK_EQ(all, 4);
+}
+
+TEST_CASE(testCapacityAndUnsubscribe) {
+    TimerEventBus bus;
+    int calls = 0;
+    TimerEventBus::SubscriptionId ids[TimerEventBus::kMaxSubscribers] = {};
+    for (auto& id : ids) {
+        id = bus.subscribe(kTimerEventForcedSleepEnded, [&calls](const TimerEvent&) { ++calls; });
+        CHECK(id != 0);
+    }
+    CHECK_EQ(bus.subscribe(kTimerEventForcedSleepEnded, [&calls](const TimerEvent&) { ++calls; }), 0u);
+
+    bus.publish(makeEvent(TimerEventKind::ForcedSleepEnded));
+    CHECK_EQ(calls, static_cast<int>(TimerEventBus::kMaxSubscribers));
+
+    for (auto id : ids) bus.unsubscribe(id);
+    CHECK(!bus.wants(TimerEventKind::ForcedSleepEnded));
+    bus.publish(makeEvent(TimerEventKind::ForcedSleepEnded));
+    CHECK_EQ(calls, static_cast<int>(TimerEventBus::kMaxSubscribers));
+
+    // 释放的槽位可以复用
+    CHECK(bus.subscribe(kTimerEventForcedSleepEnded, [&calls](const TimerEvent&) { ++calls; }) != 0);
+}
+
+// MARK: - 与 PomodoroTimer 的集成
+
+TEST_CASE(testTimerPublishesSnapshotWithTimeText) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+
+    std::string lastText;
+    TimerStateSnapshot last;
+    timer.events.subscribe(kTimerEventTimeUpdated, [&lastText, &last](const TimerEvent& e) {
+        lastText.assign(e.timeText.data(), e.timeText.size());
+        last = e.snapshot;
+    });
+
+    timer.start();
+    CHECK(lastText == "25:00");
+    CHECK(last.isRunning);
+    CHECK(!last.isInRestPeriod);
+    CHECK_EQ(last.remainingSeconds, 25 * 60);
+    CHECK_EQ(last.state, AutoRestartState::TimerRunning);
+
+    clock.advance(std::chrono::seconds(1));
+    timer.tick();
+    CHECK(lastText == "24:59");
+    CHECK_EQ(last.remainingSeconds, 25 * 60 - 1);
+}
+
+TEST_CASE(testPomodoroFinishedSnapshotIsInRest) {
+    PomodoroTimer timer;
+    TimerStateSnapshot atFinish;
+    int finished = 0;
+    timer.events.subscribe(kTimerEventPomodoroFinished, [&atFinish, &finished](const TimerEvent& e) {
+        atFinish = e.snapshot;
+        ++finished;
+    });
+
+    timer.start();
+    timer.finishNow();
+    CHECK_EQ(finished, 1);
+    CHECK(atFinish.isInRestPeriod);
+    CHECK_EQ(atFinish.completedPomodoros, 1);
+}
+
+TEST_CASE(testPerSecondPathDoesNotAllocate) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    int received = 0;
+    for (std::size_t i = 0; i < TimerEventBus::kMaxSubscribers; ++i) {
+        timer.events.subscribe(kTimerEventTimeUpdated, [&received](const TimerEvent& e) {
+            received += static_cast<int>(e.timeText.size());
+        });
+    }
+    timer.start();
+
+    const long before = g_allocations.load();
+    for (int i = 0; i < 600; ++i) {
+        clock.advance(std::chrono::seconds(1));
+        timer.tick();
+    }
+    CHECK_EQ(g_allocations.load() - before, 0L);
+    CHECK(received > 0);
+}
+
+TEST_CASE(testSnapshotFlagsMatchStateQueries) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    PomodoroTimer::Settings settings;
+    settings.idleRestartEnabled = true;
+    settings.idleActionIsRestart = false;
+    settings.screenLockRestartEnabled = true;
+    settings.screenLockActionIsRestart = false;
+    settings.screensaverRestartEnabled = true;
+    settings.stayUpLimitEnabled = true;
+    timer.updateSettings(settings);
+
+    int mismatches = 0;
+    unsigned seed = 12345u;
+    for (int i = 0; i < 5000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        switch ((seed >> 16) % 12) {
+        case 0: timer.start(); break;
+        case 1: timer.pause(); break;
+        case 2: timer.resume(); break;
+        case 3: timer.stop(); break;
+        case 4: timer.finishNow(); break;
+        case 5: timer.onIdleTimeExceeded(); break;
+        case 6: timer.onUserActivity(); break;
+        case 7: timer.onScreenLocked(); break;
+        case 8: timer.onScreenUnlocked(); break;
+        case 9: timer.onScreensaverStarted(); break;
+        case 10: timer.onForcedSleepTriggered(); break;
+        default: timer.onForcedSleepEnded(); break;
+        }
+        clock.advance(std::chrono::milliseconds(300));
+        timer.tick();
+
+        const auto s = timer.snapshot();
+        if (s.isRunning != timer.isRunning() || s.isPaused != timer.isPausedState() ||
+            s.isInRestPeriod != timer.isInRestPeriod() || s.isRestTimerRunning != timer.isRestTimerRunning() ||
+            s.isInForcedSleep != timer.isInForcedSleep() || s.remainingSeconds != timer.remainingSeconds()) {
+            ++mismatches;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
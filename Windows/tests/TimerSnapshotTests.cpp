@@ -0,0 +1,214 @@
+#include "TestHarness.h"
+
+#include "PomodoroTimer.h"
+#include "TimerSnapshot.h"
+#include "TimerSnapshotStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+using namespace pomodoro;
+
+namespace {
+
+    constexpr std::int64_t kWallStart = 1'700'000'000'000; // 任意固定的墙钟起点
+
+    std::filesystem::path tempSnapshotPath(const char* name) {
+        auto path = std::filesystem::temp_directory_path() / (std::string("pomodoro_") + name + ".bin");
+        std::filesystem::remove(path);
+        return path;
+    }
+
+} // namespace
+
+// MARK: - 快照格式
+
+TEST_CASE(testSnapshotIsCompactAndSealed) {
+    static_assert(sizeof(TimerSnapshot) <= 64, "snapshot must fit in 64 bytes");
+
+    PomodoroTimer timer;
+    timer.start();
+    auto s = timer.captureSnapshot(kWallStart);
+    CHECK(isValidTimerSnapshot(s));
+
+    s.remainingMs += 1;
+    CHECK(!isValidTimerSnapshot(s));
+}
+
+// MARK: - 恢复
+
+TEST_CASE(testRestoreRunningPhaseDeductsDowntime) {
+    VirtualClock clockA;
+    PomodoroTimer before(clockA);
+    before.start();
+    clockA.advance(std::chrono::minutes(5));
+    const auto saved = before.captureSnapshot(kWallStart);
+
+    // 进程重启：新的单调时钟起点与旧进程无关，停机 2 分钟
+    VirtualClock clockB(MonotonicClock::time_point(std::chrono::hours(1000)));
+    PomodoroTimer after(clockB);
+    CHECK(after.restoreSnapshot(saved, kWallStart + 2 * 60 * 1000));
+
+    CHECK(after.isRunning());
+    CHECK_EQ(after.remainingSeconds(), 18 * 60);
+    CHECK(after.phaseDeadline() == clockB.now() + std::chrono::minutes(18));
+}
+
+TEST_CASE(testRestorePausedPhaseKeepsRemaining) {
+    VirtualClock clock;
+    PomodoroTimer before(clock);
+    before.start();
+    clock.advance(std::chrono::seconds(90));
+    before.pause();
+    const auto saved = before.captureSnapshot(kWallStart);
+
+    VirtualClock clockB;
+    PomodoroTimer after(clockB);
+    CHECK(after.restoreSnapshot(saved, kWallStart + 3'600'000));
+    CHECK(after.isPausedState());
+    CHECK_EQ(after.remainingSeconds(), 25 * 60 - 90);
+
+    after.resume();
+    CHECK(after.phaseDeadline() == clockB.now() + std::chrono::seconds(25 * 60 - 90));
+}
+
+TEST_CASE(testRestoreLongBreakAndCounters) {
+    PomodoroTimer::Settings settings;
+    settings.longBreakCycle = 2;
+    settings.longBreakMinutes = 15;
+
+    VirtualClock clock;
+    PomodoroTimer before(clock);
+    before.updateSettings(settings);
+    before.start();
+    before.finishNow();   // 短休息
+    before.finishNow();   // 休息结束，自动开始下一轮
+    before.finishNow();   // 第二个番茄 -> 长休息
+    CHECK(before.isInRestPeriod());
+    const auto saved = before.captureSnapshot(kWallStart);
+
+    VirtualClock clockB;
+    PomodoroTimer after(clockB);
+    after.updateSettings(settings);
+    CHECK(after.restoreSnapshot(saved, kWallStart));
+    CHECK(after.isInRestPeriod());
+    CHECK(after.isRestTimerRunning());
+    CHECK_EQ(after.remainingSeconds(), 15 * 60);
+    CHECK_EQ(after.snapshot().completedPomodoros, 2);
+    CHECK(after.snapshot().timerType == TimerType::LongBreak);
+}
+
+TEST_CASE(testExpiredPhaseFinishesOnFirstTick) {
+    VirtualClock clock;
+    PomodoroTimer before(clock);
+    before.start();
+    const auto saved = before.captureSnapshot(kWallStart);
+
+    VirtualClock clockB;
+    PomodoroTimer after(clockB);
+    int finished = 0;
+    after.onTimerFinished = [&finished]() { ++finished; };
+    CHECK(after.restoreSnapshot(saved, kWallStart + 26 * 60 * 1000));
+    CHECK_EQ(finished, 0);
+    after.tick();
+    CHECK_EQ(finished, 1);
+    CHECK(after.isInRestPeriod());
+}
+
+TEST_CASE(testInvalidSnapshotIsRejected) {
+    PomodoroTimer timer;
+    TimerSnapshot bogus{};
+    CHECK(!timer.restoreSnapshot(bogus, kWallStart));
+
+    TimerSnapshot badState = timer.captureSnapshot(kWallStart);
+    badState.state = 200;
+    sealTimerSnapshot(badState);
+    CHECK(!timer.restoreSnapshot(badState, kWallStart));
+    CHECK(!timer.isRunning());
+}
+
+// MARK: - 状态变化通知
+
+TEST_CASE(testStateChangedPublishedOncePerTransition) {
+    VirtualClock clock;
+    PomodoroTimer timer(clock);
+    int changes = 0;
+    timer.events.subscribe(kTimerEventStateChanged, [&changes](const TimerEvent&) { ++changes; });
+
+    timer.start();
+    CHECK_EQ(changes, 1);
+
+    // 普通的每秒 tick 不改变持久化状态
+    for (int i = 0; i < 10; ++i) {
+        clock.advance(std::chrono::seconds(1));
+        timer.tick();
+    }
+    CHECK_EQ(changes, 1);
+
+    timer.onUserActivity(); // 未启用无操作检测：无变化
+    CHECK_EQ(changes, 1);
+
+    timer.pause();
+    CHECK_EQ(changes, 2);
+
+    // finishNow 内部多次迁移（结束 -> 休息开始），只通知一次
+    timer.resume();
+    timer.finishNow();
+    CHECK_EQ(changes, 4);
+}
+
+// MARK: - 映射文件存储
+
+TEST_CASE(testStoreRoundTripAcrossReopen) {
+    const auto path = tempSnapshotPath("roundtrip");
+    PomodoroTimer timer;
+    timer.start();
+    const auto first = timer.captureSnapshot(kWallStart);
+
+    {
+        TimerSnapshotStore store;
+        CHECK(store.open(path));
+        CHECK(!store.load().has_value());
+        store.save(first);
+        timer.pause();
+        store.save(timer.captureSnapshot(kWallStart + 1000));
+    }
+
+    TimerSnapshotStore reopened;
+    CHECK(reopened.open(path));
+    const auto loaded = reopened.load();
+    CHECK(loaded.has_value());
+    CHECK(loaded && loaded->savedAtUnixMs == kWallStart + 1000);
+    CHECK(loaded && loaded->state == static_cast<std::uint8_t>(AutoRestartState::TimerPausedByUser));
+    reopened.close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(testTornSlotFallsBackToPreviousSnapshot) {
+    const auto path = tempSnapshotPath("torn");
+    PomodoroTimer timer;
+    timer.start();
+    {
+        TimerSnapshotStore store;
+        CHECK(store.open(path));
+        store.save(timer.captureSnapshot(kWallStart));        // 序号 1 -> 槽位 1
+        store.save(timer.captureSnapshot(kWallStart + 500));  // 序号 2 -> 槽位 0
+    }
+
+    // 模拟写到一半崩溃：破坏最新的槽位
+    if (std::FILE* f = std::fopen(path.string().c_str(), "r+b")) {
+        std::fseek(f, 20, SEEK_SET);
+        std::fputc(0x5A, f);
+        std::fclose(f);
+    }
+
+    TimerSnapshotStore reopened;
+    CHECK(reopened.open(path));
+    const auto loaded = reopened.load();
+    CHECK(loaded && loaded->savedAtUnixMs == kWallStart);
+    reopened.close();
+    std::filesystem::remove(path);
+}